@@ -5,10 +5,431 @@
 #include "Mongoose_Logger.hpp"
 #include "Mongoose_Version.hpp"
 
+#include <cstdio>
+#include <cstring>
 #include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if CPP11_OR_LATER
+#include <thread>
+#endif
 
 using namespace Mongoose;
 
+/* Binary partition container: a 64-byte header followed by the partition
+ * packed eight vertices per byte, least-significant bit first. Selected by
+ * a ".bin" output extension; native-endian, like the binary graph files. */
+struct PartitionHeader
+{
+    char magic[8]; /* "MNGPART1"                      */
+    Int int_size;  /* sizeof(Int) at write time       */
+    Int n;         /* # vertices                      */
+    Int cut_size;  /* Number of edges in cut set      */
+    double cut_cost;
+    double imbalance;
+    Int reserved[2]; /* written as zero               */
+};
+
+static bool writeBinaryPartition(const std::string &filename,
+                                 const EdgeCut *result)
+{
+    FILE *file = fopen(filename.c_str(), "wb");
+    if (!file)
+        return false;
+
+    PartitionHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, "MNGPART1", sizeof(header.magic));
+    header.int_size  = (Int)sizeof(Int);
+    header.n         = result->n;
+    header.cut_size  = result->cut_size;
+    header.cut_cost  = result->cut_cost;
+    header.imbalance = result->imbalance;
+
+    bool ok = (fwrite(&header, sizeof(header), 1, file) == 1);
+
+    /* Pack and write the bitmap in fixed-size chunks. */
+    unsigned char buffer[1 << 16];
+    size_t used = 0;
+    for (Int i = 0; i < result->n; i += 8)
+    {
+        unsigned char byte = 0;
+        for (Int b = 0; b < 8 && i + b < result->n; b++)
+        {
+            if (result->partition[i + b])
+                byte |= (unsigned char)(1 << b);
+        }
+        buffer[used++] = byte;
+        if (used == sizeof(buffer))
+        {
+            ok = ok && (fwrite(buffer, 1, used, file) == used);
+            used = 0;
+        }
+    }
+    if (used > 0)
+        ok = ok && (fwrite(buffer, 1, used, file) == used);
+
+    return (fclose(file) == 0) && ok;
+}
+
+/* Formats the per-vertex lines into a buffer and writes them in bulk, so
+ * large partitions are not bottlenecked on per-line flushes. */
+static void writeTextPartition(std::ofstream &ofs, const EdgeCut *result)
+{
+    char buffer[1 << 16];
+    size_t used = 0;
+    for (Int i = 0; i < result->n; i++)
+    {
+        used += (size_t)snprintf(buffer + used, sizeof(buffer) - used,
+                                 "%ld %d\n", (long)i,
+                                 (int)result->partition[i]);
+        if (used > sizeof(buffer) - 64)
+        {
+            ofs.write(buffer, (std::streamsize)used);
+            used = 0;
+        }
+    }
+    if (used > 0)
+        ofs.write(buffer, (std::streamsize)used);
+}
+
+/* One batch job: an input matrix and where its partition goes. */
+struct BatchJob
+{
+    std::string input;
+    std::string output;
+};
+
+/* Parses a manifest with one job per line: an input file, optionally
+ * followed by an output file (default <input>.part; a .bin output selects
+ * the binary container). Blank lines and lines starting with # are
+ * skipped. */
+static bool readManifest(const char *filename, std::vector<BatchJob> &jobs)
+{
+    std::ifstream manifest(filename);
+    if (!manifest)
+        return false;
+    std::string line;
+    while (std::getline(manifest, line))
+    {
+        std::istringstream fields(line);
+        BatchJob job;
+        if (!(fields >> job.input) || job.input[0] == '#')
+            continue;
+        if (!(fields >> job.output))
+            job.output = job.input + ".part";
+        jobs.push_back(job);
+    }
+    return true;
+}
+
+static void writePartitionFile(const std::string &outputFile,
+                               const EdgeCut *result)
+{
+    bool binaryOutput = outputFile.size() >= 4
+        && outputFile.compare(outputFile.size() - 4, 4, ".bin") == 0;
+    if (binaryOutput)
+    {
+        if (!writeBinaryPartition(outputFile, result))
+        {
+            LogError("Error writing output file " << outputFile);
+        }
+        return;
+    }
+    std::ofstream ofs(outputFile.c_str(), std::ofstream::out);
+    writeTextPartition(ofs, result);
+    ofs.close();
+}
+
+#if CPP11_OR_LATER
+static void batchLoadWorker(const std::string *path, Graph **out)
+{
+    *out = read_graph(*path);
+}
+#endif
+
+/* Batch mode: partitions every job in the manifest with one process and
+ * one options struct. With C++11 threads the next graph is loaded on an
+ * I/O thread while the current one is partitioned, so the load time of
+ * job k+1 hides behind the solve of job k. */
+static int runBatch(const char *manifestFile, const EdgeCut_Options *options)
+{
+    std::vector<BatchJob> jobs;
+    if (!readManifest(manifestFile, jobs))
+    {
+        LogError("Error reading manifest file " << manifestFile);
+        return EXIT_FAILURE;
+    }
+
+    int failures = 0;
+    Graph *next  = NULL;
+#if CPP11_OR_LATER
+    std::thread loader;
+#endif
+
+    for (size_t k = 0; k < jobs.size(); k++)
+    {
+        Graph *graph = NULL;
+#if CPP11_OR_LATER
+        if (k == 0)
+        {
+            graph = read_graph(jobs[k].input);
+        }
+        else
+        {
+            loader.join();
+            graph = next;
+        }
+        next = NULL;
+        if (k + 1 < jobs.size())
+        {
+            loader = std::thread(batchLoadWorker, &jobs[k + 1].input, &next);
+        }
+#else
+        graph = read_graph(jobs[k].input);
+#endif
+
+        if (!graph)
+        {
+            LogError("Error reading Graph from file " << jobs[k].input);
+            failures++;
+            continue;
+        }
+
+        clock_t t       = clock();
+        EdgeCut *result = edge_cut(graph, options);
+        t               = clock() - t;
+
+        if (!result)
+        {
+            LogError("Error computing edge separator for " << jobs[k].input);
+            failures++;
+        }
+        else
+        {
+            std::cout << jobs[k].input << ": n " << graph->n << ", cut size "
+                      << result->cut_size << ", cut cost " << result->cut_cost
+                      << ", imbalance " << result->imbalance << ", "
+                      << ((double)t) / CLOCKS_PER_SEC << "s\n";
+            writePartitionFile(jobs[k].output, result);
+            result->~EdgeCut();
+        }
+        graph->~Graph();
+    }
+
+#if CPP11_OR_LATER
+    if (loader.joinable())
+    {
+        loader.join();
+        if (next)
+            next->~Graph();
+    }
+#endif
+
+    return (failures == 0) ? 0 : EXIT_FAILURE;
+}
+
+/* Server mode: a line-oriented command loop over stdin/stdout, so a
+ * long-lived coprocess can load a graph once and answer repeated
+ * partition requests with different options, paying load and sanitize
+ * cost only when the graph changes. Commands:
+ *
+ *   load <file>          read and sanitize a matrix, replacing the
+ *                        resident graph
+ *   set <option> <value> change one EdgeCut_Options field by name
+ *   cut [output-file]    partition the resident graph (optionally
+ *                        writing the partition, .bin for binary)
+ *   quit                 exit
+ *
+ * Every command answers exactly one line starting with "ok" or "error",
+ * flushed immediately so pipes never stall. */
+static bool setServerOption(EdgeCut_Options *options, const std::string &name,
+                            const std::string &value)
+{
+    std::istringstream parse(value);
+
+    struct IntField
+    {
+        const char *name;
+        Int *field;
+    };
+    struct DoubleField
+    {
+        const char *name;
+        double *field;
+    };
+    struct BoolField
+    {
+        const char *name;
+        bool *field;
+    };
+
+    const IntField int_fields[] = {
+        { "random_seed", &options->random_seed },
+        { "num_threads", &options->num_threads },
+        { "coarsen_limit", &options->coarsen_limit },
+        { "num_dances", &options->num_dances },
+        { "FM_search_depth", &options->FM_search_depth },
+        { "FM_consider_count", &options->FM_consider_count },
+        { "FM_max_num_refinements", &options->FM_max_num_refinements },
+        { "FM_num_tries", &options->FM_num_tries },
+        { "gradproj_iteration_limit", &options->gradproj_iteration_limit },
+    };
+    const DoubleField double_fields[] = {
+        { "high_degree_threshold", &options->high_degree_threshold },
+        { "dance_tolerance", &options->dance_tolerance },
+        { "QP_gate_tolerance", &options->QP_gate_tolerance },
+        { "gradproj_tolerance", &options->gradproj_tolerance },
+        { "target_split", &options->target_split },
+        { "soft_split_tolerance", &options->soft_split_tolerance },
+    };
+    const BoolField bool_fields[] = {
+        { "do_community_matching", &options->do_community_matching },
+        { "use_dance_racing", &options->use_dance_racing },
+        { "use_dance_convergence", &options->use_dance_convergence },
+        { "use_FM", &options->use_FM },
+        { "use_gain_buckets", &options->use_gain_buckets },
+        { "use_deferred_heap_repair", &options->use_deferred_heap_repair },
+        { "use_FM_move_journal", &options->use_FM_move_journal },
+        { "use_FM_tie_sampling", &options->use_FM_tie_sampling },
+        { "use_QP_gradproj", &options->use_QP_gradproj },
+        { "use_QP_sparse_gradient", &options->use_QP_sparse_gradient },
+        { "use_QP_BB_step", &options->use_QP_BB_step },
+        { "use_QP_adaptive_gate", &options->use_QP_adaptive_gate },
+    };
+
+    for (size_t k = 0; k < sizeof(int_fields) / sizeof(int_fields[0]); k++)
+    {
+        if (name == int_fields[k].name)
+        {
+            long v;
+            if (!(parse >> v))
+                return false;
+            *int_fields[k].field = (Int)v;
+            return true;
+        }
+    }
+    for (size_t k = 0; k < sizeof(double_fields) / sizeof(double_fields[0]);
+         k++)
+    {
+        if (name == double_fields[k].name)
+        {
+            double v;
+            if (!(parse >> v))
+                return false;
+            *double_fields[k].field = v;
+            return true;
+        }
+    }
+    for (size_t k = 0; k < sizeof(bool_fields) / sizeof(bool_fields[0]); k++)
+    {
+        if (name == bool_fields[k].name)
+        {
+            int v;
+            if (!(parse >> v))
+                return false;
+            *bool_fields[k].field = (v != 0);
+            return true;
+        }
+    }
+    if (name == "matching_strategy")
+    {
+        long v;
+        if (!(parse >> v) || v < Random || v > RandomBlock)
+            return false;
+        options->matching_strategy = (MatchingStrategy)v;
+        return true;
+    }
+    if (name == "initial_cut_type")
+    {
+        long v;
+        if (!(parse >> v) || v < InitialEdgeCut_QP
+            || v > InitialEdgeCut_NaturalOrder)
+            return false;
+        options->initial_cut_type = (InitialEdgeCutType)v;
+        return true;
+    }
+    return false;
+}
+
+static int runServer(EdgeCut_Options *options)
+{
+    Graph *graph = NULL;
+    std::string line;
+    while (std::getline(std::cin, line))
+    {
+        std::istringstream fields(line);
+        std::string command;
+        if (!(fields >> command) || command[0] == '#')
+            continue;
+
+        if (command == "quit")
+            break;
+        else if (command == "load")
+        {
+            std::string file;
+            if (!(fields >> file))
+            {
+                std::cout << "error: load needs a file" << std::endl;
+                continue;
+            }
+            Graph *loaded = read_graph(file);
+            if (!loaded)
+            {
+                std::cout << "error: cannot load " << file << std::endl;
+                continue;
+            }
+            if (graph)
+                graph->~Graph();
+            graph = loaded;
+            std::cout << "ok n=" << graph->n << " nz=" << graph->nz
+                      << std::endl;
+        }
+        else if (command == "set")
+        {
+            std::string name, value;
+            if (!(fields >> name >> value)
+                || !setServerOption(options, name, value))
+            {
+                std::cout << "error: cannot set option" << std::endl;
+                continue;
+            }
+            std::cout << "ok" << std::endl;
+        }
+        else if (command == "cut")
+        {
+            if (!graph)
+            {
+                std::cout << "error: no graph loaded" << std::endl;
+                continue;
+            }
+            EdgeCut *result = edge_cut(graph, options);
+            if (!result)
+            {
+                std::cout << "error: edge cut failed" << std::endl;
+                continue;
+            }
+            std::string outputFile;
+            if (fields >> outputFile)
+                writePartitionFile(outputFile, result);
+            std::cout << "ok cut_size=" << result->cut_size
+                      << " cut_cost=" << result->cut_cost
+                      << " imbalance=" << result->imbalance << std::endl;
+            result->~EdgeCut();
+        }
+        else
+        {
+            std::cout << "error: unknown command " << command << std::endl;
+        }
+    }
+
+    if (graph)
+        graph->~Graph();
+    return 0;
+}
+
 int main(int argn, const char **argv)
 {
     SuiteSparse_start();
@@ -22,10 +443,43 @@ int main(int argn, const char **argv)
     {
         // Wrong number of arguments - return error
         LogError("Usage: mongoose <MM-input-file.mtx> [output-file]");
+        LogError("       mongoose --batch <manifest-file>");
+        LogError("       mongoose --server");
         SuiteSparse_finish();
         return EXIT_FAILURE;
     }
 
+    if (argn == 2 && strcmp(argv[1], "--server") == 0)
+    {
+        EdgeCut_Options *server_options = EdgeCut_Options::create();
+        if (!server_options)
+        {
+            LogError("Error creating Options struct");
+            SuiteSparse_finish();
+            return EXIT_FAILURE;
+        }
+        int status = runServer(server_options);
+        server_options->~EdgeCut_Options();
+        SuiteSparse_finish();
+        return status;
+    }
+
+    if (argn == 3
+        && (strcmp(argv[1], "--batch") == 0 || strcmp(argv[1], "-b") == 0))
+    {
+        EdgeCut_Options *batch_options = EdgeCut_Options::create();
+        if (!batch_options)
+        {
+            LogError("Error creating Options struct");
+            SuiteSparse_finish();
+            return EXIT_FAILURE;
+        }
+        int status = runBatch(argv[2], batch_options);
+        batch_options->~EdgeCut_Options();
+        SuiteSparse_finish();
+        return status;
+    }
+
     // Read in input file name
     std::string inputFile = std::string(argv[1]);
 
@@ -96,7 +550,17 @@ int main(int argn, const char **argv)
         std::cout << " Imbalance:      " << result->imbalance << "\n";
 
         // Write results to file
-        if (!outputFile.empty())
+        bool binaryOutput = outputFile.size() >= 4
+            && outputFile.compare(outputFile.size() - 4, 4, ".bin") == 0;
+        if (!outputFile.empty() && binaryOutput)
+        {
+            LogTest("Writing binary results to file: " << outputFile);
+            if (!writeBinaryPartition(outputFile, result))
+            {
+                LogError("Error writing output file");
+            }
+        }
+        else if (!outputFile.empty())
         {
             LogTest("Writing results to file: " << outputFile);
             std::ofstream ofs (outputFile.c_str(), std::ofstream::out);
@@ -116,12 +580,9 @@ int main(int argn, const char **argv)
             ofs << "  \"Imbalance\": " << result->imbalance << std::endl;
             ofs << "}" << std::endl;
 
-            ofs << std::endl;
-            for (Int i = 0; i < graph->n; i++)
-            {
-                ofs << i << " " << result->partition[i] << std::endl;
-            }
-            ofs << std::endl;
+            ofs << "\n";
+            writeTextPartition(ofs, result);
+            ofs << "\n";
 
             ofs.close();
         }
@@ -16,11 +16,30 @@
 #include "SuiteSparse_config.h"
 #include <string>
 
+#if __cplusplus > 199711L
+#include <future>
+#endif
+
 namespace Mongoose
 {
 
-/* Type definitions */
+/* Type definitions. Int is 32-bit when the library was built with
+ * -DMONGOOSE_INT32 (see BUILD_INT32_LIBRARY in CMakeLists.txt); the
+ * application must be compiled with the same flag. */
+#ifdef MONGOOSE_INT32
+typedef int Int;
+#else
 typedef SuiteSparse_long Int;
+#endif
+
+/* Edge and vertex weights are stored in single precision when the library
+ * was built with -DMONGOOSE_WEIGHT_FLOAT; the application must be compiled
+ * with the same flag. */
+#ifdef MONGOOSE_WEIGHT_FLOAT
+typedef float WeightType;
+#else
+typedef double WeightType;
+#endif
 
 typedef struct cs_sparse /* matrix in compressed-column or triplet form */
 {
@@ -29,7 +48,7 @@ typedef struct cs_sparse /* matrix in compressed-column or triplet form */
     Int n;     /* number of columns */
     Int *p;    /* column pointers (size n+1) or col indices (size nzmax) */
     Int *i;    /* row indices, size nzmax */
-    double *x; /* numerical values, size nzmax */
+    WeightType *x; /* numerical values, size nzmax */
     Int nz;    /* # of entries in triplet matrix, -1 for compressed-col */
 } cs;
 
@@ -39,25 +58,76 @@ enum MatchingStrategy
     Random,
     HEM,
     HEMSR,
-    HEMSRdeg
+    HEMSRdeg,
+    RandomBlock
 };
 
 enum InitialEdgeCutType
 {
     InitialEdgeCut_QP,
     InitialEdgeCut_Random,
-    InitialEdgeCut_NaturalOrder
+    InitialEdgeCut_NaturalOrder,
+    InitialEdgeCut_BranchAndBound,
+    InitialEdgeCut_Spectral,
+    InitialEdgeCut_GraphGrowing,
+    InitialEdgeCut_Best
 };
 
+/* Progress callback invoked at level boundaries during edge_cut: once per
+ * level built while coarsening and once per level refined on the way back
+ * up. heu_cost is the current heuristic cost (0 while coarsening, before
+ * any cut exists) and elapsed is wall-clock seconds since the solve
+ * started. The callback runs on the solving thread; it must not modify
+ * the graph or options. */
+typedef void (*EdgeCut_ProgressFn)(Int level, Int n, double heu_cost,
+                                   double elapsed, void *context);
+
 struct EdgeCut_Options
 {
     Int random_seed;
 
+    /** Parallelism Options **************************************************/
+    Int num_threads; /* Worker threads used by parallel phases (e.g. the
+                        heavy-edge matching sweep). A value of 1 (the
+                        default) keeps every phase serial. */
+    Int ensemble_size; /* Run this many full multilevel cuts with
+                          different seeds (derived from random_seed) on
+                          the thread pool, sharing the input graph
+                          read-only, and keep the lowest-heuCost result.
+                          1 (the default) runs the single seeded cut. */
+
+    /** Memory Options *******************************************************/
+    double memory_budget_mb; /* Cap, in MiB, on the coarsening hierarchy's
+                                footprint beyond the input graph. Once a
+                                solve's hierarchy passes the cap, levels
+                                already descended from shed their edge and
+                                vertex weight arrays and get them
+                                recomputed from the level above when
+                                refinement returns. 0 (the default) never
+                                sheds. The cap is advisory: structure,
+                                matching, and scratch arrays are always
+                                retained. */
+
+    /** Preprocessing Options ************************************************/
+    bool use_vertex_reordering; /* Relabel the vertices in reverse
+                                   Cuthill-McKee order on a deep copy
+                                   before partitioning, so the CSR walks
+                                   in matching, coarsening, FM, and QP
+                                   index their per-vertex arrays with
+                                   small strides. The final partition is
+                                   mapped back to the caller's numbering.
+                                   Costs one BFS and one graph copy up
+                                   front; worthwhile when the input
+                                   numbering is essentially random.
+                                   false (the default) solves in the
+                                   input numbering. */
+
     /** Coarsening Options ***************************************************/
     Int coarsen_limit;
     MatchingStrategy matching_strategy;
     bool do_community_matching;
     double high_degree_threshold;
+    Int matching_sample_size;
 
     /** Guess Partitioning Options *******************************************/
     InitialEdgeCutType initial_cut_type; /* The guess cut type to use */
@@ -65,18 +135,109 @@ struct EdgeCut_Options
     /** Waterdance Options ***************************************************/
     Int num_dances; /* The number of interplays between FM and QP
                       at any one coarsening level. */
+    bool use_dance_racing; /* Run FM and QP concurrently within each dance
+                              instead of alternating them: FM refines the
+                              cut in place while QP runs on a clone of the
+                              same starting cut, and the dance keeps
+                              whichever found the lower heuristic cost.
+                              Requires C++11 threads; falls back to the
+                              alternating dance if the clone cannot be
+                              allocated.                                */
+    bool use_dance_convergence; /* Exit the dance loop before num_dances
+                                   once a full dance improves heuCost by
+                                   less than dance_tolerance (relative).
+                                   Easy graphs converge after the first
+                                   dance or two; the remaining dances
+                                   re-run FM and QP to no effect.       */
+    double dance_tolerance; /* Relative heuCost improvement below which
+                               the dance loop is considered converged.  */
 
     /**** Fidducia-Mattheyes Options *****************************************/
     bool use_FM;              /* Flag governing the use of FM             */
+    bool use_gain_buckets;    /* Keep boundary vertices in gain buckets
+                                 (O(1) updates) instead of binary heaps.
+                                 Only takes effect when every edge weight
+                                 is an integer; otherwise heaps are used. */
+    bool use_deferred_heap_repair; /* Batch the heap repairs for neighbor
+                                 gain updates in fmSwap instead of
+                                 re-heapifying after every touched
+                                 neighbor. Faster on high-degree graphs;
+                                 the heap order between flushes is only
+                                 approximate, so FM may pick slightly
+                                 different (equally valid) candidates.  */
+    bool use_FM_move_journal; /* Record every gain/degree mutation in a
+                                 journal so the speculative tail of a
+                                 sweep is rolled back by restoring old
+                                 values instead of executing inverse
+                                 moves. Costs O(n + nz) extra memory per
+                                 sweep; worthwhile for deep search
+                                 depths. */
+    bool use_FM_tie_sampling; /* Draw the candidate scan from the boundary
+                                 heaps' top window (the approximate top-k)
+                                 instead of the strict first-k heap
+                                 prefix, and break ties among the scanned
+                                 candidates uniformly at random (reservoir
+                                 sampling). Useful on meshes where many
+                                 boundary vertices share the same gain;
+                                 makes refinement depend on the random
+                                 seed.                                    */
     Int FM_search_depth;       /* The # of non-positive gain move to make  */
     Int FM_consider_count;     /* The # of heap entries to consider        */
     Int FM_max_num_refinements; /* Max # of times to run FidduciaMattheyes  */
+    Int FM_num_tries;          /* Speculative FM sweeps run on thread-private
+                                 copies of the partition state; the sweep
+                                 with the lowest heuristic cost wins. Each
+                                 try widens the candidate scan a little so
+                                 the sweeps explore different move orders.
+                                 1 (the default) refines in place.        */
 
     /**** Quadratic Programming Options **************************************/
     bool use_QP_gradproj;         /* Flag governing the use of gradproj       */
+    bool use_QP_sparse_gradient; /* Confine the per-iteration gradient-change
+                                    scatters and updates in gradproj to the
+                                    entries actually written (tracked with a
+                                    touch list) instead of making O(n)
+                                    clear/update sweeps. Pays off late in
+                                    convergence when few variables are free;
+                                    the iterates are unchanged.             */
+    bool use_QP_BB_step;         /* Use a Barzilai-Borwein step length in
+                                    gradproj, computed from the previous
+                                    iteration's accepted move. BB iterations
+                                    skip the stepsize matrix-vector product,
+                                    and the adaptive length typically reaches
+                                    gradproj_tolerance in fewer iterations on
+                                    ill-conditioned weight distributions.   */
+    bool use_QP_adaptive_gate;   /* Track the heuCost improvement each QP
+                                    pass realizes and stop running QP for
+                                    the remaining dances at a level once a
+                                    pass improves by less than
+                                    QP_gate_tolerance (relative). Saves the
+                                    QPLinks setup and full-array sweeps when
+                                    FM has already converged to a cut that
+                                    QP cannot better.                       */
+    double QP_gate_tolerance;    /* Relative heuCost improvement below which
+                                    the adaptive gate retires QP at the
+                                    current level.                          */
     double gradproj_tolerance;   /* Convergence tol for projected gradient   */
     Int gradproj_iteration_limit; /* Max # of iterations for gradproj         */
 
+    /** Telemetry Options ****************************************************/
+    EdgeCut_ProgressFn progress_callback; /* Invoked at level boundaries with
+                                   (level, n, heuCost, elapsed, context).
+                                   NULL (the default) costs one branch per
+                                   level and nothing on the hot path.     */
+    void *progress_context;     /* Opaque pointer passed to the callback    */
+
+    /** Time Budget **********************************************************/
+    double time_limit;          /* Wall-clock budget in seconds for the whole
+                                   solve; 0 (the default) means no limit.
+                                   Checked at level and dance boundaries:
+                                   once exceeded, coarsening stops,
+                                   waterdance stops improving, the remaining
+                                   uncoarsening projects the partition up
+                                   without further refinement, and the
+                                   result is marked budget_truncated.     */
+
     /** Final Partition Target Metrics ***************************************/
     double target_split;        /* The desired split ratio (default 50/50)  */
     double soft_split_tolerance; /* The allowable soft split tolerance.      */
@@ -85,6 +246,9 @@ struct EdgeCut_Options
 
     /* Constructor & Destructor */
     static EdgeCut_Options *create();
+    static EdgeCut_Options *fast();
+    static EdgeCut_Options *balanced();
+    static EdgeCut_Options *quality();
     ~EdgeCut_Options();
 };
 
@@ -96,12 +260,13 @@ public:
     Int nz;    /** # edges                         */
     Int *p;    /** Column pointers                 */
     Int *i;    /** Row indices                     */
-    double *x; /** Edge weight                     */
-    double *w; /** Node weight                     */
+    WeightType *x; /** Edge weight                     */
+    WeightType *w; /** Node weight                     */
 
     /* Constructors & Destructor */
     static Graph *create(const Int _n, const Int _nz, Int *_p = NULL,
-                         Int *_i = NULL, double *_x = NULL, double *_w = NULL);
+                         Int *_i = NULL, WeightType *_x = NULL,
+                         WeightType *_w = NULL);
     static Graph *create(cs *matrix);
     ~Graph();
 
@@ -120,26 +285,135 @@ private:
  *
  * Generate a Graph class instance from a Matrix Market file. The matrix
  * contained in the file must be sparse, real, and square. If the matrix
- * is not symmetric, it will be made symmetric with (A+A')/2. If the matrix has
- * more than one connected component, the largest will be found and the rest
- * discarded. If a diagonal is present, it will be removed.
+ * is not symmetric, it will be made symmetric with (A+A')/2. If the matrix
+ * has more than one connected component, pass keep_largest_component = true
+ * to keep only the largest and discard the rest; by default the graph is
+ * returned whole. If a diagonal is present, it will be removed. Files
+ * compressed with gzip or zstd are detected by their magic bytes and
+ * decompressed transparently (POSIX platforms only).
  *
  * @param filename the filename or path to the Matrix Market File.
+ * @param keep_largest_component reduce a disconnected matrix to its largest
+ * connected component (default false).
  */
 Graph *read_graph(const std::string &filename);
+Graph *read_graph(const std::string &filename, bool keep_largest_component);
 
 /**
  * Generate a Graph from a Matrix Market file.
  *
  * Generate a Graph class instance from a Matrix Market file. The matrix
  * contained in the file must be sparse, real, and square. If the matrix
- * is not symmetric, it will be made symmetric with (A+A')/2. If the matrix has
- * more than one connected component, the largest will be found and the rest
- * discarded. If a diagonal is present, it will be removed.
+ * is not symmetric, it will be made symmetric with (A+A')/2. If the matrix
+ * has more than one connected component, pass keep_largest_component = true
+ * to keep only the largest and discard the rest; by default the graph is
+ * returned whole. If a diagonal is present, it will be removed. Files
+ * compressed with gzip or zstd are detected by their magic bytes and
+ * decompressed transparently (POSIX platforms only).
  *
  * @param filename the filename or path to the Matrix Market File.
+ * @param keep_largest_component reduce a disconnected matrix to its largest
+ * connected component (default false).
  */
 Graph *read_graph(const char *filename);
+Graph *read_graph(const char *filename, bool keep_largest_component);
+
+/**
+ * Generate a Graph from a Matrix Market file with bounded peak memory.
+ *
+ * Produces the same sanitized graph as read_graph (symmetrized, zero-free
+ * diagonal, positive weights), but streams the entry lines in two passes
+ * instead of materializing the triplet list, the compressed matrix, and
+ * the sanitized copy at once: the first pass counts the symmetrized
+ * column degrees and the second scatters the entries directly into the
+ * final CSR arrays, which are then sorted and merged column by column.
+ * Peak resident memory stays near the size of the returned Graph, at the
+ * cost of parsing the file twice. On platforms without mmap this falls
+ * back to read_graph.
+ *
+ * @param filename the filename or path to the Matrix Market File.
+ */
+Graph *read_graph_streaming(const std::string &filename);
+Graph *read_graph_streaming(const char *filename);
+
+/**
+ * Write a Graph to a binary CSR file.
+ *
+ * The container is a 64-byte header followed by the raw p, i, x, and w
+ * arrays (x and w only if present), each 8-byte aligned, so the file can
+ * later be mapped and used in place with zero parsing or copying. The
+ * graph is written as-is: it is expected to already be sanitized (square,
+ * symmetric, zero-free diagonal), as produced by read_graph. The format
+ * is native-endian and records sizeof(Int); files do not port across
+ * architectures with a different byte order or integer width.
+ *
+ * @param graph the graph to write.
+ * @param filename the filename or path to write to.
+ * @return true on success, false on I/O failure.
+ */
+bool write_graph_binary(const Graph *graph, const std::string &filename);
+bool write_graph_binary(const Graph *graph, const char *filename);
+
+/**
+ * Generate a Graph from a binary CSR file.
+ *
+ * Maps a file written by write_graph_binary and wraps the mapped arrays
+ * with Graph::create's shallow-pointer constructor: no parsing, no
+ * sanitizing, and no copies -- the graph data is paged in on demand.
+ * Returns NULL if the file cannot be opened or is not a valid container
+ * (wrong magic, integer width, or size). The returned graph must be
+ * released with free_graph_binary, which also unmaps the file.
+ *
+ * @param filename the filename or path to the binary graph file.
+ */
+Graph *read_graph_binary(const std::string &filename);
+Graph *read_graph_binary(const char *filename);
+
+/**
+ * Release a Graph returned by read_graph_binary.
+ *
+ * Destroys the graph and unmaps the backing file. The graph's arrays
+ * point into the mapping, so destroying the graph directly would leak it.
+ *
+ * @param graph a graph returned by read_graph_binary (NULL is ignored).
+ */
+void free_graph_binary(Graph *graph);
+
+/**
+ * Generate a Graph from a Matrix Market file, caching the sanitized result.
+ *
+ * Behaves like read_graph, but keeps a binary sidecar file
+ * (filename + ".graphbin") beside the input: the first call parses and
+ * sanitizes the matrix and writes the sidecar, stamped with a content hash
+ * of the input bytes, and later calls load the sidecar directly and skip
+ * parsing and sanitization entirely. A changed input hashes differently, so
+ * a stale sidecar is ignored and rewritten; a sidecar that cannot be
+ * written is simply skipped. The returned graph owns its arrays and is
+ * freed like any read_graph result.
+ *
+ * @param filename the filename or path to the Matrix Market File.
+ */
+Graph *read_graph_cached(const std::string &filename);
+Graph *read_graph_cached(const char *filename);
+
+/* One per-level instrumentation record from a multilevel solve. The times
+ * are wall-clock seconds; on a hierarchy kept across re-solves they
+ * accumulate over the solves. */
+struct EdgeCut_LevelStats
+{
+    Int level;           /** Coarsening level (0 = input graph) */
+    Int n;               /** # vertices at this level           */
+    Int nz;              /** # edges at this level              */
+    double shrink;       /** n divided by the next-finer level's
+                             n (1 at level 0)                   */
+    double match_time;   /** Seconds spent matching this level  */
+    double coarsen_time; /** Seconds spent building the
+                             next-coarser level                 */
+    double refine_time;  /** Seconds of refinement (FM/QP) at
+                             this level                         */
+    double cut_cost;     /** Cut cost after refinement at this
+                             level                              */
+};
 
 struct EdgeCut
 {
@@ -155,13 +429,188 @@ struct EdgeCut
                             is imbalanced, and this is
                             computed as (0.5 - W0/W).         */
 
+    /** Level Statistics *****************************************************/
+    EdgeCut_LevelStats *level_stats; /** One record per coarsening level,
+                                         ordered finest (level 0) first.
+                                         NULL if the stats allocation
+                                         failed or the result came from a
+                                         cache file.          */
+    Int num_levels;      /** # entries in level_stats        */
+    bool budget_truncated; /** True if the options' time_limit
+                               expired mid-solve and the later
+                               levels were projected up without
+                               refinement.                    */
+
     // desctructor (no constructor)
     ~EdgeCut();
 };
 
+/* Cut metrics for the caller-buffer variant of edge_cut. A plain struct
+ * with no destructor, safe to place on the stack (unlike EdgeCut, whose
+ * destructor frees `this`). */
+struct EdgeCut_Result
+{
+    Int n;              /** # vertices                        */
+    double cut_cost;    /** Sum of edge weights in cut set    */
+    Int cut_size;       /** Number of edges in cut set        */
+    double w0;          /** Sum of partition 0 vertex weights */
+    double w1;          /** Sum of partition 1 vertex weights */
+    double imbalance;   /** Same as EdgeCut::imbalance        */
+    bool budget_truncated; /** Same as EdgeCut::budget_truncated */
+};
+
 EdgeCut *edge_cut(const Graph *);
 EdgeCut *edge_cut(const Graph *, const EdgeCut_Options *);
 
+/* Caller-buffer variant: the final partition is written into the
+ * caller's buffer (length graph->n) and the cut metrics into the
+ * caller-owned result struct, so a loop cutting many small subdomains
+ * allocates nothing for its results and skips the copy out of an
+ * EdgeCut. Per-level statistics are not collected. Returns false on
+ * error, leaving the buffers unspecified. */
+bool edge_cut(const Graph *graph, const EdgeCut_Options *options,
+              bool *partition, EdgeCut_Result *result);
+
+#if __cplusplus > 199711L
+/* Submits a full edge_cut solve to the library thread pool and returns
+ * immediately; the future yields what edge_cut would have returned (NULL
+ * on failure). The graph must stay alive and unmodified until the future
+ * is ready, and may be shared read-only by any number of queued jobs.
+ * The options are copied at submission, so the caller may reuse or
+ * destroy theirs right away; NULL means defaults. Each job occupies one
+ * pool worker and runs its internal parallel phases inline there, so
+ * queued cuts run side by side, one worker each. On a machine with no
+ * pool workers the solve runs before edge_cut_async returns. */
+std::future<EdgeCut *> edge_cut_async(const Graph *graph,
+                                      const EdgeCut_Options *options = NULL);
+#endif
+
+/* One changed edge for edge_cut_refresh: the endpoints of an edge that
+ * was inserted into or deleted from the graph since the previous solve. */
+struct EdgeCut_Delta
+{
+    Int u;
+    Int v;
+};
+
+/* Incremental repartitioning after a small topology change: the graph is
+ * the already-updated CSR, previous is the prior solve's result, and the
+ * deltas list the changed edges. The previous partition is kept, the cut
+ * metrics and gains are re-derived in one sweep, and the boundary heaps
+ * are re-seeded with only the perturbed neighborhood, so the bounded FM
+ * that follows works around the perturbation instead of the whole
+ * boundary -- no multilevel solve. Intended for deltas that are a tiny
+ * fraction of the edges; a large change deserves a fresh edge_cut. */
+EdgeCut *edge_cut_refresh(const Graph *graph, const EdgeCut *previous,
+                          const EdgeCut_Delta *deltas, Int ndeltas,
+                          const EdgeCut_Options *options);
+
+/* Result-cache layer in front of edge_cut: the CSR arrays and every
+ * cut-affecting option are hashed, and the partition plus its metrics are
+ * kept one file per key under cache_dir (which must already exist). A hit
+ * returns the stored partition without running the multilevel solve; a
+ * miss solves as usual and stores the result best-effort. Pass a NULL
+ * cache_dir to bypass the cache. */
+EdgeCut *edge_cut_cached(const Graph *, const EdgeCut_Options *,
+                         const std::string &cache_dir);
+EdgeCut *edge_cut_cached(const Graph *, const EdgeCut_Options *,
+                         const char *cache_dir);
+
+struct KWayCut
+{
+    Int *partition; /** Part id per vertex, in [0, k)   */
+    Int n;          /** # vertices                      */
+    Int k;          /** # parts                         */
+
+    /** Cut Cost Metrics *****************************************************/
+    double cut_cost;      /** Sum of edge weights between parts */
+    double *part_weights; /** Sum of vertex weights per part,
+                              k entries                         */
+
+    // destructor (no constructor)
+    ~KWayCut();
+};
+
+/* K-way partitioning by task-parallel recursive bisection. The graph is
+ * expected to be sanitized (as from read_graph), like for edge_cut; each
+ * level of the recursion extracts the side subgraphs directly, with no
+ * re-sanitization, and independent branches run in parallel. The options'
+ * target_split is ignored: each bisection's split ratio comes from how
+ * many parts land on each side. */
+KWayCut *kway_cut(const Graph *, Int k);
+KWayCut *kway_cut(const Graph *, Int k, const EdgeCut_Options *);
+
+struct VertexSeparator
+{
+    Int *partition; /** Per vertex: 0 or 1 for the sides,
+                        2 for the separator             */
+    Int n;          /** # vertices                      */
+
+    /** Separator Metrics ****************************************************/
+    Int sep_size;      /** # separator vertices            */
+    double sep_weight; /** Sum of separator vertex weights */
+    double w0;         /** Sum of side 0 vertex weights    */
+    double w1;         /** Sum of side 1 vertex weights    */
+
+    // destructor (no constructor)
+    ~VertexSeparator();
+};
+
+/* Vertex separator extraction: the refined edge cut is converted into the
+ * minimum vertex cover of its cut edges (maximum bipartite matching plus
+ * Konig's theorem), so removing the separator leaves no edge between the
+ * sides. The graph is expected to be sanitized, like for edge_cut. */
+VertexSeparator *vertex_separator(const Graph *);
+VertexSeparator *vertex_separator(const Graph *, const EdgeCut_Options *);
+
+/* Synthetic graph generators for benchmarking: unit-weight meshes,
+ * power-law (RMAT), and random geometric graphs of controlled size,
+ * symmetric with no self edges and sorted adjacency, ready for
+ * edge_cut. NULL on allocation failure; the random generators draw
+ * from the library RNG stream. */
+Graph *generate_grid(Int k);
+Graph *generate_grid_3d(Int k);
+Graph *generate_rmat(Int scale, Int edge_factor, double a, double b,
+                     double c);
+Graph *generate_geometric(Int n, double radius);
+
+/* Sample-based options autotuner: extracts a BFS-sampled subgraph,
+ * sweeps the key tuning knobs (matching strategy, dance count, FM
+ * search depth) on it by coordinate descent within the wall-clock
+ * budget (seconds; 0 = no limit), and returns the options that cut the
+ * sample best for the time they spend. The second form starts from the
+ * given options instead of the defaults. The caller owns the result. */
+EdgeCut_Options *autotune(const Graph *, double time_budget);
+EdgeCut_Options *autotune(const Graph *, const EdgeCut_Options *,
+                          double time_budget);
+
+/* Independent release-mode partition verifier: one parallel edge sweep
+ * recomputes cut_cost, cut_size, w0, w1, and imbalance from scratch and
+ * checks them against the stored values (cut_size exactly, the
+ * floating-point metrics to a small relative tolerance). The stored
+ * imbalance is checked against target_split; the two-argument form
+ * assumes the 50/50 default. Failures are reported through the error
+ * log. */
+bool verify(const EdgeCut *result, const Graph *graph);
+bool verify(const EdgeCut *result, const Graph *graph, double target_split);
+
+struct Ordering
+{
+    Int *perm;  /** perm[k] = the vertex eliminated k-th */
+    Int *iperm; /** iperm[v] = position of v in perm     */
+    Int n;      /** # vertices                           */
+
+    // destructor (no constructor)
+    ~Ordering();
+};
+
+/* Fill-reducing ordering by parallel nested dissection: each level orders
+ * a vertex separator last and recurses on the two sides, switching to a
+ * local minimum-degree order on small subgraphs. The graph is expected to
+ * be sanitized, like for edge_cut. */
+Ordering *nested_dissection(const Graph *);
+Ordering *nested_dissection(const Graph *, const EdgeCut_Options *);
+
 /* Version information */
 int major_version();
 int minor_version();
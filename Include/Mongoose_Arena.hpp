@@ -0,0 +1,78 @@
+/* ========================================================================== */
+/* === Include/Mongoose_Arena.hpp =========================================== */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * Bump allocator for the coarsening hierarchy.
+ *
+ * Every coarsening level needs roughly a dozen O(n) arrays; with deep
+ * hierarchies that is hundreds of malloc/free pairs per edge_cut() call.
+ * The arena hands out per-level arrays by bumping a pointer inside large
+ * blocks and releases the whole hierarchy's memory in one shot when the
+ * root EdgeCutProblem that owns it is destroyed.
+ */
+
+// #pragma once
+#ifndef MONGOOSE_ARENA_HPP
+#define MONGOOSE_ARENA_HPP
+
+#include "Mongoose_Internal.hpp"
+
+namespace Mongoose
+{
+
+class Arena
+{
+public:
+    /* Constructor & Destructor */
+    static Arena *create();
+    ~Arena();
+
+    /** Bump-allocate nitems * itemSize bytes (16-byte aligned).
+     *  Returns NULL if a fresh block cannot be obtained. */
+    void *allocate(size_t nitems, size_t itemSize);
+
+    /** Same as allocate, but the returned memory is zeroed. */
+    void *allocateZeroed(size_t nitems, size_t itemSize);
+
+private:
+    Arena();
+
+    /** Blocks are singly linked; allocation always bumps inside the head
+     *  block and prepends a new block when it runs out of room. */
+    struct Block
+    {
+        Block *next;
+        size_t capacity; /* usable bytes after the header */
+        size_t used;     /* bytes already handed out      */
+    };
+
+    Block *blocks;
+
+    /* Usable data begins at this offset within a block allocation, keeping
+     * every handed-out pointer 16-byte aligned. */
+    static const size_t headerSize = 32;
+
+    /* Fresh blocks are at least this large (4 MB of usable space). */
+    static const size_t minBlockSize = ((size_t)1) << 22;
+};
+
+/** Ask the kernel to back a large allocation with 2 MB transparent huge
+ *  pages (Linux madvise; a no-op elsewhere). Multi-gigabyte CSR arrays
+ *  walked with random access spend measurable time in TLB misses on 4 KB
+ *  pages; huge pages cut the TLB entry count 512-fold. Purely advisory:
+ *  if the kernel declines, the allocation keeps working on small pages.
+ *  Applied only above an internal threshold, so small arrays are
+ *  untouched. */
+void adviseHugePages(void *ptr, size_t bytes);
+
+} // end namespace Mongoose
+
+#endif
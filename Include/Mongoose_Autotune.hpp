@@ -0,0 +1,45 @@
+/* ========================================================================== */
+/* === Include/Mongoose_Autotune.hpp ======================================== */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * Sample-based options autotuner.
+ *
+ * Extracts a BFS-sampled subgraph of the input, sweeps the key tuning
+ * knobs (matching strategy, dance count, FM search depth) on it by
+ * coordinate descent, and returns the options that cut the sample best
+ * for the time they spend. Meant to be run once per graph family and
+ * amortized over many production solves.
+ */
+
+// #pragma once
+#ifndef MONGOOSE_AUTOTUNE_HPP
+#define MONGOOSE_AUTOTUNE_HPP
+
+#include "Mongoose_EdgeCutOptions.hpp"
+#include "Mongoose_Graph.hpp"
+
+namespace Mongoose
+{
+
+/* The graph is expected to be sanitized (as from read_graph), like for
+ * edge_cut. time_budget is wall-clock seconds the sweep may spend; once
+ * it is exhausted the best tuning found so far is returned, and a budget
+ * of 0 means no limit. The second form starts the sweep from the given
+ * options instead of the defaults (seed, split targets, and every
+ * unswept knob are preserved). Returns NULL on allocation failure; the
+ * caller owns the returned options. */
+EdgeCut_Options *autotune(const Graph *, double time_budget);
+EdgeCut_Options *autotune(const Graph *, const EdgeCut_Options *,
+                          double time_budget);
+
+} // end namespace Mongoose
+
+#endif
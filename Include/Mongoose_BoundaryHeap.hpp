@@ -27,11 +27,9 @@ void bhInsert(EdgeCutProblem *, Int vertex);
 void bhRemove(EdgeCutProblem *, const EdgeCut_Options *, Int vertex, double gain, bool partition,
               Int bhPosition);
 
-void heapifyUp(EdgeCutProblem *, Int *bhHeap, double *gains, Int vertex, Int position,
-               double gain);
+void heapifyUp(EdgeCutProblem *, BHEntry *bhHeap, Int position);
 
-void heapifyDown(EdgeCutProblem *, Int *bhHeap, Int size, double *gains, Int vertex,
-                 Int position, double gain);
+void heapifyDown(EdgeCutProblem *, BHEntry *bhHeap, Int size, Int position);
 
 } // end namespace Mongoose
 
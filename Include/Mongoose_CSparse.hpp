@@ -33,7 +33,11 @@
 #endif
 
 /* same as Int in Mongoose */
+#ifdef MONGOOSE_INT32
+typedef int csi;
+#else
 typedef SuiteSparse_long csi;
+#endif
 
 /* CSparse Macros */
 #ifndef CS_CSC
@@ -54,7 +58,7 @@ typedef struct cs_sparse /* matrix in compressed-column or triplet form */
     csi n;     /* number of columns */
     csi *p;    /* column pointers (size n+1) or col indices (size nzmax) */
     csi *i;    /* row indices, size nzmax */
-    double *x; /* numerical values, size nzmax */
+    WeightType *x; /* numerical values, size nzmax */
     csi nz;    /* # of entries in triplet matrix, -1 for compressed-col */
 } cs;
 
@@ -31,6 +31,7 @@ namespace Mongoose
 {
 
 EdgeCutProblem *coarsen(EdgeCutProblem *, const EdgeCut_Options *);
+bool coarsen_numeric(EdgeCutProblem *);
 
 } // end namespace Mongoose
 
@@ -93,7 +93,7 @@ void QPcheckCom(EdgeCutProblem *G, const EdgeCut_Options *O, QPDelta *QP, bool c
                 Int nFreeSet, double b);
 
 void FreeSet_dump(const char *where, Int n, Int *FreeSet_list, Int nFreeSet,
-                  Int *FreeSet_status, Int verbose, double *x);
+                  Int *FreeSet_status, Int verbose, QPScalar *x);
 
 } // end namespace Mongoose
 
@@ -16,10 +16,34 @@
 #include "Mongoose_Graph.hpp"
 #include "Mongoose_EdgeCutOptions.hpp"
 #include "Mongoose_EdgeCutProblem.hpp"
+#include <string>
+
+#if CPP11_OR_LATER
+#include <future>
+#endif
 
 namespace Mongoose
 {
 
+/* One per-level instrumentation record from a multilevel solve. The times
+ * are wall-clock seconds; on a hierarchy kept across re-solves they
+ * accumulate over the solves. */
+struct EdgeCut_LevelStats
+{
+    Int level;           /** Coarsening level (0 = input graph) */
+    Int n;               /** # vertices at this level           */
+    Int nz;              /** # edges at this level              */
+    double shrink;       /** n divided by the next-finer level's
+                             n (1 at level 0)                   */
+    double match_time;   /** Seconds spent matching this level  */
+    double coarsen_time; /** Seconds spent building the
+                             next-coarser level                 */
+    double refine_time;  /** Seconds of refinement (FM/QP) at
+                             this level                         */
+    double cut_cost;     /** Cut cost after refinement at this
+                             level                              */
+};
+
 struct EdgeCut
 {
     bool *partition;     /** T/F denoting partition side     */
@@ -34,14 +58,110 @@ struct EdgeCut
                             is imbalanced, and this is
                             computed as (0.5 - W0/W).         */
 
+    /** Level Statistics *****************************************************/
+    EdgeCut_LevelStats *level_stats; /** One record per coarsening level,
+                                         ordered finest (level 0) first.
+                                         NULL if the stats allocation
+                                         failed or the result came from a
+                                         cache file.          */
+    Int num_levels;      /** # entries in level_stats        */
+    bool budget_truncated; /** True if the options' time_limit
+                               expired mid-solve and the later
+                               levels were projected up without
+                               refinement.                    */
+
     // desctructor (no constructor)
     ~EdgeCut();
 };
 
+/* Cut metrics for the caller-buffer variant of edge_cut. A plain struct
+ * with no destructor, safe to place on the stack (unlike EdgeCut, whose
+ * destructor frees `this`). */
+struct EdgeCut_Result
+{
+    Int n;              /** # vertices                        */
+    double cut_cost;    /** Sum of edge weights in cut set    */
+    Int cut_size;       /** Number of edges in cut set        */
+    double w0;          /** Sum of partition 0 vertex weights */
+    double w1;          /** Sum of partition 1 vertex weights */
+    double imbalance;   /** Same as EdgeCut::imbalance        */
+    bool budget_truncated; /** Same as EdgeCut::budget_truncated */
+};
+
 EdgeCut *edge_cut(const Graph *);
 EdgeCut *edge_cut(const Graph *, const EdgeCut_Options *);
 EdgeCut *edge_cut(EdgeCutProblem *problem, const EdgeCut_Options *options);
 
+/* Caller-buffer variant: the final partition is written into the
+ * caller's buffer (length graph->n) and the cut metrics into the
+ * caller-owned result struct, so a loop cutting many small subdomains
+ * allocates nothing for its results and skips the copy out of an
+ * EdgeCut. Per-level statistics are not collected. Returns false on
+ * error, leaving the buffers unspecified. */
+bool edge_cut(const Graph *graph, const EdgeCut_Options *options,
+              bool *partition, EdgeCut_Result *result);
+
+#if CPP11_OR_LATER
+/* Submits a full edge_cut solve to the library thread pool and returns
+ * immediately; the future yields what edge_cut would have returned (NULL
+ * on failure). The graph must stay alive and unmodified until the future
+ * is ready, and may be shared read-only by any number of queued jobs.
+ * The options are copied at submission, so the caller may reuse or
+ * destroy theirs right away; NULL means defaults. Each job occupies one
+ * pool worker and runs its internal parallel phases inline there, so
+ * queued cuts run side by side, one worker each. On a machine with no
+ * pool workers the solve runs before edge_cut_async returns. */
+std::future<EdgeCut *> edge_cut_async(const Graph *graph,
+                                      const EdgeCut_Options *options = NULL);
+#endif
+
+/* With keep_hierarchy, the coarsening hierarchy (matchings and coarse
+ * graph structures) stays attached to the problem after the solve, so
+ * edge_cut_numeric can re-partition after weight-only changes without
+ * redoing the symbolic work. */
+EdgeCut *edge_cut(EdgeCutProblem *problem, const EdgeCut_Options *options,
+                  bool keep_hierarchy);
+
+/* Numeric-only re-solve: reuses the hierarchy retained by a prior
+ * edge_cut(problem, options, true) call after the problem's x/w arrays
+ * have been updated in place. The sparsity structure must be unchanged.
+ * The previous solve's partition is the starting guess -- only the
+ * waterdance refinement reruns, which is what a load-rebalancing loop
+ * between timesteps wants. */
+EdgeCut *edge_cut_numeric(EdgeCutProblem *problem,
+                          const EdgeCut_Options *options);
+
+/* One changed edge for edge_cut_refresh: the endpoints of an edge that
+ * was inserted into or deleted from the graph since the previous solve. */
+struct EdgeCut_Delta
+{
+    Int u;
+    Int v;
+};
+
+/* Incremental repartitioning after a small topology change: the graph is
+ * the already-updated CSR, previous is the prior solve's result, and the
+ * deltas list the changed edges. The previous partition is kept, the cut
+ * metrics and gains are re-derived in one sweep, and the boundary heaps
+ * are re-seeded with only the perturbed neighborhood, so the bounded FM
+ * that follows works around the perturbation instead of the whole
+ * boundary -- no multilevel solve. Intended for deltas that are a tiny
+ * fraction of the edges; a large change deserves a fresh edge_cut. */
+EdgeCut *edge_cut_refresh(const Graph *graph, const EdgeCut *previous,
+                          const EdgeCut_Delta *deltas, Int ndeltas,
+                          const EdgeCut_Options *options);
+
+/* Result-cache layer in front of edge_cut: the CSR arrays and every
+ * cut-affecting option are hashed, and the partition plus its metrics are
+ * kept one file per key under cache_dir (which must already exist). A hit
+ * returns the stored partition without running the multilevel solve; a
+ * miss solves as usual and stores the result best-effort. Pass a NULL
+ * cache_dir to bypass the cache. */
+EdgeCut *edge_cut_cached(const Graph *graph, const EdgeCut_Options *options,
+                         const std::string &cache_dir);
+EdgeCut *edge_cut_cached(const Graph *graph, const EdgeCut_Options *options,
+                         const char *cache_dir);
+
 } // end namespace Mongoose
 
 #endif
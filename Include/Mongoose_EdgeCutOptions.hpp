@@ -18,15 +18,74 @@
 namespace Mongoose
 {
 
+/* Progress callback invoked at level boundaries during edge_cut: once per
+ * level built while coarsening and once per level refined on the way back
+ * up. heu_cost is the current heuristic cost (0 while coarsening, before
+ * any cut exists) and elapsed is wall-clock seconds since the solve
+ * started. The callback runs on the solving thread; it must not modify
+ * the graph or options. */
+typedef void (*EdgeCut_ProgressFn)(Int level, Int n, double heu_cost,
+                                   double elapsed, void *context);
+
+/* NOTE to maintainers: when adding a field that can affect the computed
+ * cut, also add it to hashOptions in Mongoose_EdgeCut.cpp (the result
+ * cache's options hash) and mirror it in Mongoose.hpp. An omitted field
+ * makes edge_cut_cached serve stale partitions across values of the new
+ * option. */
 struct EdgeCut_Options
 {
     Int random_seed;
 
+    /** Parallelism Options **************************************************/
+    Int num_threads; /* Worker threads used by parallel phases (e.g. the
+                        heavy-edge matching sweep). A value of 1 (the
+                        default) keeps every phase serial. */
+    Int ensemble_size; /* Run this many full multilevel cuts with
+                          different seeds (derived from random_seed) on
+                          the thread pool, sharing the input graph
+                          read-only, and keep the lowest-heuCost result.
+                          1 (the default) runs the single seeded cut. */
+
+    /** Memory Options *******************************************************/
+    double memory_budget_mb; /* Cap, in MiB, on the coarsening hierarchy's
+                                footprint beyond the input graph. Once a
+                                solve's hierarchy passes the cap, levels
+                                already descended from shed their edge and
+                                vertex weight arrays and get them
+                                recomputed from the level above when
+                                refinement returns. 0 (the default) never
+                                sheds. The cap is advisory: structure,
+                                matching, and scratch arrays are always
+                                retained. */
+
+    /** Preprocessing Options ************************************************/
+    bool use_vertex_reordering; /* Relabel the vertices in reverse
+                                   Cuthill-McKee order on a deep copy
+                                   before partitioning, so the CSR walks
+                                   in matching, coarsening, FM, and QP
+                                   index their per-vertex arrays with
+                                   small strides. The final partition is
+                                   mapped back to the caller's numbering.
+                                   Costs one BFS and one graph copy up
+                                   front; worthwhile when the input
+                                   numbering is essentially random.
+                                   false (the default) solves in the
+                                   input numbering. */
+
     /** Coarsening Options ***************************************************/
     Int coarsen_limit;
     MatchingStrategy matching_strategy;
     bool do_community_matching;
     double high_degree_threshold;
+    Int matching_sample_size; /* When positive, heavy-edge matching scans
+                                 only this many randomly sampled edges of
+                                 each high-degree row (degree above four
+                                 times the sample) when picking a
+                                 partner, falling back to the full row
+                                 only when no sampled neighbor is free.
+                                 Caps per-vertex matching work on the
+                                 finest level of edge-heavy graphs.
+                                 0 (the default) always scans full rows. */
 
     /** Guess Partitioning Options *******************************************/
     InitialEdgeCutType initial_cut_type; /* The guess cut type to use */
@@ -34,18 +93,109 @@ struct EdgeCut_Options
     /** Waterdance Options ***************************************************/
     Int num_dances; /* The number of interplays between FM and QP
                       at any one coarsening level. */
+    bool use_dance_racing; /* Run FM and QP concurrently within each dance
+                              instead of alternating them: FM refines the
+                              cut in place while QP runs on a clone of the
+                              same starting cut, and the dance keeps
+                              whichever found the lower heuristic cost.
+                              Requires C++11 threads; falls back to the
+                              alternating dance if the clone cannot be
+                              allocated.                                */
+    bool use_dance_convergence; /* Exit the dance loop before num_dances
+                                   once a full dance improves heuCost by
+                                   less than dance_tolerance (relative).
+                                   Easy graphs converge after the first
+                                   dance or two; the remaining dances
+                                   re-run FM and QP to no effect.       */
+    double dance_tolerance; /* Relative heuCost improvement below which
+                               the dance loop is considered converged.  */
 
     /**** Fidducia-Mattheyes Options *****************************************/
     bool use_FM;              /* Flag governing the use of FM               */
+    bool use_gain_buckets;    /* Keep boundary vertices in gain buckets
+                                 (O(1) updates) instead of binary heaps.
+                                 Only takes effect when every edge weight
+                                 is an integer; otherwise heaps are used. */
+    bool use_deferred_heap_repair; /* Batch the heap repairs for neighbor
+                                 gain updates in fmSwap instead of
+                                 re-heapifying after every touched
+                                 neighbor. Faster on high-degree graphs;
+                                 the heap order between flushes is only
+                                 approximate, so FM may pick slightly
+                                 different (equally valid) candidates.  */
+    bool use_FM_move_journal; /* Record every gain/degree mutation in a
+                                 journal so the speculative tail of a
+                                 sweep is rolled back by restoring old
+                                 values instead of executing inverse
+                                 moves. Costs O(n + nz) extra memory per
+                                 sweep; worthwhile for deep search
+                                 depths. */
+    bool use_FM_tie_sampling; /* Draw the candidate scan from the boundary
+                                 heaps' top window (the approximate top-k)
+                                 instead of the strict first-k heap
+                                 prefix, and break ties among the scanned
+                                 candidates uniformly at random (reservoir
+                                 sampling). Useful on meshes where many
+                                 boundary vertices share the same gain;
+                                 makes refinement depend on the random
+                                 seed.                                    */
     Int FM_search_depth;       /* The # of non-positive gain move to make    */
     Int FM_consider_count;     /* The # of heap entries to consider          */
     Int FM_max_num_refinements; /* Max # of times to run Fiduccia-Mattheyses  */
+    Int FM_num_tries;          /* Speculative FM sweeps run on thread-private
+                                 copies of the partition state; the sweep
+                                 with the lowest heuristic cost wins. Each
+                                 try widens the candidate scan a little so
+                                 the sweeps explore different move orders.
+                                 1 (the default) refines in place.          */
 
     /**** Quadratic Programming Options **************************************/
     bool use_QP_gradproj;         /* Flag governing the use of gradproj       */
+    bool use_QP_sparse_gradient; /* Confine the per-iteration gradient-change
+                                    scatters and updates in gradproj to the
+                                    entries actually written (tracked with a
+                                    touch list) instead of making O(n)
+                                    clear/update sweeps. Pays off late in
+                                    convergence when few variables are free;
+                                    the iterates are unchanged.             */
+    bool use_QP_BB_step;         /* Use a Barzilai-Borwein step length in
+                                    gradproj, computed from the previous
+                                    iteration's accepted move. BB iterations
+                                    skip the stepsize matrix-vector product,
+                                    and the adaptive length typically reaches
+                                    gradproj_tolerance in fewer iterations on
+                                    ill-conditioned weight distributions.   */
+    bool use_QP_adaptive_gate;   /* Track the heuCost improvement each QP
+                                    pass realizes and stop running QP for
+                                    the remaining dances at a level once a
+                                    pass improves by less than
+                                    QP_gate_tolerance (relative). Saves the
+                                    QPLinks setup and full-array sweeps when
+                                    FM has already converged to a cut that
+                                    QP cannot better.                       */
+    double QP_gate_tolerance;    /* Relative heuCost improvement below which
+                                    the adaptive gate retires QP at the
+                                    current level.                          */
     double gradproj_tolerance;   /* Convergence tol for projected gradient   */
     Int gradproj_iteration_limit; /* Max # of iterations for gradproj         */
 
+    /** Telemetry Options ****************************************************/
+    EdgeCut_ProgressFn progress_callback; /* Invoked at level boundaries with
+                                   (level, n, heuCost, elapsed, context).
+                                   NULL (the default) costs one branch per
+                                   level and nothing on the hot path.     */
+    void *progress_context;     /* Opaque pointer passed to the callback    */
+
+    /** Time Budget **********************************************************/
+    double time_limit;          /* Wall-clock budget in seconds for the whole
+                                   solve; 0 (the default) means no limit.
+                                   Checked at level and dance boundaries:
+                                   once exceeded, coarsening stops,
+                                   waterdance stops improving, the remaining
+                                   uncoarsening projects the partition up
+                                   without further refinement, and the
+                                   result is marked budget_truncated.     */
+
     /** Final Partition Target Metrics ***************************************/
     double target_split;        /* The desired split ratio (default 50/50)  */
     double soft_split_tolerance; /* The allowable soft split tolerance.      */
@@ -54,6 +204,16 @@ struct EdgeCut_Options
 
     /* Constructor & Destructor */
     static EdgeCut_Options *create();
+
+    /** Named preset tunings, built on top of create()'s defaults.
+     *  fast() minimizes latency: one FM-only dance with a shallow
+     *  search and no gradient projection. quality() spends the racing
+     *  guess, extra dances, deeper FM, and a larger QP budget for the
+     *  lowest cuts. balanced() is an alias for the defaults. All three
+     *  return NULL on OOM. */
+    static EdgeCut_Options *fast();
+    static EdgeCut_Options *balanced();
+    static EdgeCut_Options *quality();
     ~EdgeCut_Options();
 };
 
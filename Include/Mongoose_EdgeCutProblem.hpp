@@ -24,10 +24,42 @@
 #include "Mongoose_Graph.hpp"
 #include "Mongoose_Internal.hpp"
 #include "Mongoose_EdgeCutOptions.hpp"
+#include <cstdint>
 
 namespace Mongoose
 {
 
+class Arena;
+class QPDelta;
+class Workspace;
+
+/* A boundary heap entry packs the vertex with a copy of its gain, so heap
+ * sift operations compare against the contiguous heap array instead of
+ * chasing the per-vertex records. The cached gain is kept in sync with
+ * fmData by fmSwap whenever a boundary vertex's gain changes. */
+struct BHEntry
+{
+    Int vertex;
+    double gain;
+};
+
+/* Interleaved per-vertex FM metadata. fmSwap and calculateGain read a
+ * neighbor's gain, external degree, and heap slot together for every edge
+ * they walk, so the three live in one record (and one cache line) instead
+ * of three scattered arrays. The partition side stays bit-packed below:
+ * at 64 vertices per word it is already far denser than a record field
+ * could be. */
+struct FMVertexData
+{
+    double gain;        /* Gain for moving the vertex        */
+    Int externalDegree; /* # edges lying across the cut      */
+    Int bhIndex;        /* Index+1 of the vertex in the heap */
+#ifndef MONGOOSE_INT32
+    Int padding;        /* Round the record up to 32 bytes so no
+                           record straddles a cache line      */
+#endif
+};
+
 class EdgeCutProblem
 {
 public:
@@ -36,8 +68,8 @@ public:
     Int nz;    /** # edges                         */
     Int *p;    /** Column pointers                 */
     Int *i;    /** Row indices                     */
-    double *x; /** Edge weight                     */
-    double *w; /** Node weight                     */
+    WeightType *x; /** Edge weight                     */
+    WeightType *w; /** Node weight                     */
     double X;  /** Sum of edge weights             */
     double W;  /** Sum of vertex weights           */
 
@@ -45,11 +77,13 @@ public:
     double worstCaseRatio;
 
     /** Partition Data *******************************************************/
-    bool *partition;     /** T/F denoting partition side     */
-    double *vertexGains; /** Gains for each vertex           */
-    Int *externalDegree; /** # edges lying across the cut    */
-    Int *bhIndex;        /** Index+1 of a vertex in the heap */
-    Int *bhHeap[2];      /** Heap data structure organized by
+    uint64_t *partition; /** Partition sides, bit-packed 64
+                            vertices per word; all access goes
+                            through the accessors below       */
+    FMVertexData *fmData; /** Interleaved gain / external degree
+                             / heap index record per vertex   */
+    Int *fmStack;        /** Stack of vertices moved by FM   */
+    BHEntry *bhHeap[2];  /** Heap data structure organized by
                             boundaryGains descending         */
     Int bhSize[2];       /** Size of the boundary heap       */
 
@@ -62,9 +96,46 @@ public:
     double imbalance; /** Degree to which the partitioning
                           is imbalanced, and this is
                           computed as (0.5 - W0/W).         */
+    double qpLambda;  /** Converged napsack dual multiplier,
+                          carried across QP passes (and down
+                          the hierarchy) as a warm start    */
+
+    /** Level Instrumentation ************************************************/
+    double matchTime;   /** Wall seconds spent matching this level      */
+    double coarsenTime; /** Wall seconds building the next-coarser level */
+    double refineTime;  /** Wall seconds of refinement at this level    */
+    double deadline;    /** Absolute monotonic timestamp after which
+                            waterdance stops improving; 0 = no limit.
+                            Set by edge_cut from options->time_limit.  */
+
+    /** QP Workspace *********************************************************/
+    QPDelta *qpWorkspace; /** Pooled QP workspace, sized for the
+                              finest level and shared down the
+                              hierarchy; owned by the root problem
+                              (like the arena). NULL if pooling
+                              failed, in which case improveCutUsingQP
+                              allocates per call.            */
+
+    /** QP Accelerator Backend ***********************************************/
+    void *qpBackendHandle; /** Per-level handle from the registered
+                               QP_Backend's setup(), NULL until bound;
+                               released by the destructor.          */
+    int qpBackendState;    /** 0 = setup not yet tried, 1 = bound,
+                               -1 = the backend declined this level */
+
+    /** Scratch Workspace ****************************************************/
+    Workspace *workspace; /** Pooled per-phase scratch (matching
+                              waiting lists, FM dirty lists and
+                              journals), owned by the root problem
+                              like the QP workspace. Borrow through
+                              getWorkspace(), which creates it
+                              lazily; borrowers fall back to their
+                              own allocations when it is NULL.  */
 
     /** Matching Data ********************************************************/
     EdgeCutProblem *parent;    /** Link to the parent graph        */
+    EdgeCutProblem *child;     /** Link to the coarsened graph, when
+                                   the hierarchy is retained        */
     Int clevel;       /** Coarsening level for this graph */
     Int cn;           /** # vertices in coarse graph      */
     Int *matching;    /** Linked List of matched vertices */
@@ -79,12 +150,83 @@ public:
 
     /* Constructor & Destructor */
     static EdgeCutProblem *create(const Int _n, const Int _nz, Int *_p = NULL,
-                                  Int *_i = NULL, double *_x = NULL, double *_w = NULL);
+                                  Int *_i = NULL, WeightType *_x = NULL,
+                                  WeightType *_w = NULL);
     static EdgeCutProblem *create(const Graph *_graph);
     static EdgeCutProblem *create(EdgeCutProblem *_parent);
     ~EdgeCutProblem();
     void initialize(const EdgeCut_Options *options);
 
+    /** Recompute the weight sums (W, X, H), the initial gains, and the
+     *  worst-case ratio from the current x/w arrays. */
+    void refreshNumeric();
+
+    /** Clear all partition/boundary state so the level can be re-refined. */
+    void resetCutState();
+
+    /** Write the whole hierarchy (every level's structure and matchings,
+     *  plus the finest level's weights) to a binary file so a preempted
+     *  job can resume at guess-cut/refinement -- possibly on another
+     *  machine -- via loadHierarchy + edge_cut_numeric. Native-endian;
+     *  the header records the integer and weight widths, and load
+     *  refuses a mismatch. */
+    bool saveHierarchy(const char *filename) const;
+
+    /** Rebuild a hierarchy written by saveHierarchy. The result is ready
+     *  for edge_cut_numeric, which re-derives every coarse level's
+     *  weights from the matchings on the way down. NULL on I/O, format,
+     *  or allocation failure. */
+    static EdgeCutProblem *loadHierarchy(const char *filename);
+
+    /** The root problem's scratch workspace, created on first use; NULL
+     *  only if its allocation failed. */
+    Workspace *getWorkspace();
+
+    inline bool isInitialized() const
+    {
+        return initialized;
+    }
+
+    /** Partition Functions ***************************************************/
+    /* The partition is stored one bit per vertex rather than one byte, so
+     * the whole partition of even a very large graph stays cache-resident
+     * during the FM and QP adjacency walks, which read a random neighbor's
+     * side on every edge. */
+
+    /* Number of 64-bit words backing a partition of n vertices. */
+    static inline Int partitionWords(Int n)
+    {
+        return ((n + 63) >> 6);
+    }
+
+    inline bool getPartition(Int vertex) const
+    {
+        return ((partition[vertex >> 6] >> (vertex & 63)) & 1);
+    }
+
+    inline void setPartition(Int vertex, bool side)
+    {
+        uint64_t mask = ((uint64_t)1) << (vertex & 63);
+        if (side)
+        {
+            partition[vertex >> 6] |= mask;
+        }
+        else
+        {
+            partition[vertex >> 6] &= ~mask;
+        }
+    }
+
+    inline void flipPartition(Int vertex)
+    {
+        partition[vertex >> 6] ^= ((uint64_t)1) << (vertex & 63);
+    }
+
+    inline void prefetchPartition(Int vertex) const
+    {
+        MONGOOSE_PREFETCH(&partition[vertex >> 6]);
+    }
+
     /** Matching Functions ****************************************************/
     inline bool isMatched(Int vertex)
     {
@@ -135,32 +277,28 @@ public:
     /** Boundary Heap Functions ***********************************************/
     inline Int BH_getParent(Int a)
     {
-        return ((a - 1) / 2);
+        return ((a - 1) / MONGOOSE_BH_ARITY);
     }
 
-    inline Int BH_getLeftChild(Int a)
+    /* The c-th child of a node, for c in [0, MONGOOSE_BH_ARITY). */
+    inline Int BH_getChild(Int a, Int c)
     {
-        return (2 * a + 1);
-    }
-
-    inline Int BH_getRightChild(Int a)
-    {
-        return (2 * a + 2);
+        return (MONGOOSE_BH_ARITY * a + 1 + c);
     }
 
     inline bool BH_inBoundary(Int v)
     {
-        return (bhIndex[v] > 0);
+        return (fmData[v].bhIndex > 0);
     }
 
     inline void BH_putIndex(Int v, Int pos)
     {
-        bhIndex[v] = (pos + 1);
+        fmData[v].bhIndex = (pos + 1);
     }
 
     inline Int BH_getIndex(Int v)
     {
-        return (bhIndex[v] - 1);
+        return (fmData[v].bhIndex - 1);
     }
 
     /** Mark Array Functions **************************************************/
@@ -196,6 +334,41 @@ private:
     bool shallow_x;
     bool shallow_w;
 
+    void *vertexArrays; /** Single block holding every O(n) per-vertex
+                            array, carved at cache-line offsets. NULL if
+                            the arrays were allocated individually.     */
+
+    /** Hierarchy Arena *******************************************************/
+    Arena *arena;    /** Bump allocator for coarse levels; owned by
+                         the root problem, shared by its children  */
+    bool ownsArena;  /** True on the root problem only             */
+    bool ownsQPWorkspace; /** True on the problem that created the
+                              pooled QP workspace             */
+    bool ownsWorkspace;   /** True on the problem that created the
+                              scratch workspace               */
+    bool arenaBacked; /** True if this level's arrays live in the
+                         arena and must not be freed individually */
+
+public:
+    /** Memory Budget *********************************************************/
+    size_t memoryBudgetBytes; /** Root only: cap from
+                                  options->memory_budget_mb; 0 = off */
+    size_t hierarchyBytes;    /** Root only: running footprint of the
+                                  coarse levels built so far          */
+    bool numericOwned;   /** x/w are individually malloc'd (budget
+                             mode) rather than arena-carved         */
+    bool numericDropped; /** x/w currently shed under the budget    */
+
+    /** Free this level's x/w under the memory budget (no-op unless they
+     *  are individually owned). The caller recomputes them later with
+     *  coarsen_numeric from the parent, which is kept intact. */
+    void dropNumeric();
+
+    /** Reallocate shed x/w; the contents are garbage until the caller
+     *  reruns coarsen_numeric on the parent. False on OOM. */
+    bool restoreNumeric();
+
+private:
     /** Mark Data *************************************************************/
     Int *markArray; /** O(n) mark array                 */
     Int markValue;  /** Mark array can be cleared in O(k)
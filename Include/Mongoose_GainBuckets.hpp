@@ -0,0 +1,90 @@
+/* ========================================================================== */
+/* === Include/Mongoose_GainBuckets.hpp ===================================== */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * Gain-bucket boundary structure for FM refinement.
+ *
+ * Keeps the boundary vertices of each partition side in an array of
+ * doubly-linked lists indexed by integer gain, so insert, remove, and
+ * gain updates are all O(1) instead of the O(log n) of the binary
+ * boundary heaps. Only usable when every edge weight (and therefore
+ * every gain) is an integer; see gainBucketsSuitable.
+ */
+
+// #pragma once
+#ifndef MONGOOSE_GAINBUCKETS_HPP
+#define MONGOOSE_GAINBUCKETS_HPP
+
+#include "Mongoose_EdgeCutProblem.hpp"
+#include "Mongoose_Internal.hpp"
+
+namespace Mongoose
+{
+
+class GainBuckets
+{
+public:
+    /* maxGain bounds |gain| for every vertex; gains map to buckets
+     * [0, 2*maxGain] via an offset of maxGain. */
+    static GainBuckets *create(Int _n, Int _maxGain);
+    ~GainBuckets();
+
+    void insert(Int vertex, bool side, Int gain);
+    void remove(Int vertex);
+    void update(Int vertex, bool side, Int gain);
+
+    inline bool contains(Int vertex) const
+    {
+        return (slot[vertex] != -1);
+    }
+
+    /* Highest non-empty bucket for a side, or -1 if the side is empty.
+     * Callers walk downward from here; the cursor is maintained lazily. */
+    Int maxBucket(bool side);
+
+    /* First vertex in a bucket, or -1. */
+    inline Int head(bool side, Int bucket) const
+    {
+        return heads[(side ? nBuckets : 0) + bucket];
+    }
+
+    inline Int nextVertex(Int vertex) const
+    {
+        return next[vertex];
+    }
+
+    inline Int gainToBucket(Int gain) const
+    {
+        return gain + maxGain;
+    }
+
+private:
+    GainBuckets();
+
+    Int n;        /* # vertices the structure covers        */
+    Int maxGain;  /* Bucket offset; buckets span 2*maxGain+1 */
+    Int nBuckets; /* Buckets per side (2*maxGain+1)          */
+
+    Int *heads; /* Bucket list heads, one run per side  */
+    Int *next;  /* Doubly-linked list threading, or -1  */
+    Int *prev;
+    Int *slot; /* Bucket a vertex occupies, offset by
+                  side*nBuckets; -1 if not in a bucket */
+    Int top[2]; /* Lazy max-bucket cursor per side      */
+};
+
+/* Returns true if the graph's gains are integral and small enough to
+ * bucket; on success *out_maxGain holds the gain bound. */
+bool gainBucketsSuitable(const EdgeCutProblem *graph, Int *out_maxGain);
+
+} // end namespace Mongoose
+
+#endif
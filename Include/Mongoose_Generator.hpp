@@ -0,0 +1,56 @@
+/* ========================================================================== */
+/* === Include/Mongoose_Generator.hpp ======================================= */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * Synthetic graph generators.
+ *
+ * Produce unit-weight Graph objects of controlled size and structure --
+ * regular meshes, power-law (RMAT), and random geometric -- directly in
+ * memory, so benchmarks and the autotuner can sweep sizes without
+ * hauling collection files. Every generator returns a sanitized-shape
+ * graph (symmetric, no self edges, sorted adjacency) ready for
+ * edge_cut, or NULL on allocation failure. The random generators draw
+ * from the library RNG stream; call setRandomSeed first for
+ * reproducible graphs.
+ */
+
+// #pragma once
+#ifndef MONGOOSE_GENERATOR_HPP
+#define MONGOOSE_GENERATOR_HPP
+
+#include "Mongoose_Graph.hpp"
+
+namespace Mongoose
+{
+
+/* k-by-k 5-point grid mesh: n = k^2, nz = 4k(k-1). */
+Graph *generate_grid(Int k);
+
+/* k-by-k-by-k 7-point grid mesh: n = k^3, nz = 6k^2(k-1). */
+Graph *generate_grid_3d(Int k);
+
+/* RMAT power-law graph with n = 2^scale vertices: edge_factor * n
+ * directed edge draws from the recursive (a, b, c, 1-a-b-c) quadrant
+ * distribution, then symmetrized with self edges and duplicates
+ * dropped, so nz is a little under 2 * edge_factor * n. The standard
+ * Graph500 skew is a = 0.57, b = c = 0.19. */
+Graph *generate_rmat(Int scale, Int edge_factor, double a, double b,
+                     double c);
+
+/* Random geometric graph: n points uniform in the unit square, an edge
+ * between every pair closer than radius. Neighbor search uses a bucket
+ * grid of radius-sized cells, so generation is linear in n + nz.
+ * Expected degree is about n * pi * radius^2. */
+Graph *generate_geometric(Int n, double radius);
+
+} // end namespace Mongoose
+
+#endif
@@ -33,12 +33,13 @@ public:
     Int nz;    /** # edges                         */
     Int *p;    /** Column pointers                 */
     Int *i;    /** Row indices                     */
-    double *x; /** Edge weight                     */
-    double *w; /** Node weight                     */
+    WeightType *x; /** Edge weight                     */
+    WeightType *w; /** Node weight                     */
 
     /* Constructors & Destructor */
     static Graph *create(const Int _n, const Int _nz, Int *_p = NULL,
-                         Int *_i = NULL, double *_x = NULL, double *_w = NULL);
+                         Int *_i = NULL, WeightType *_x = NULL,
+                         WeightType *_w = NULL);
     static Graph *create(cs *matrix);
     static Graph *create(cs *matrix, bool free_when_done);
     ~Graph();
@@ -40,13 +40,19 @@ namespace Mongoose
  *
  * Generate a Graph class instance from a Matrix Market file. The matrix
  * contained in the file must be sparse, real, and square. If the matrix
- * is not symmetric, it will be made symmetric with (A+A')/2. If the matrix has
- * more than one connected component, the largest will be found and the rest
- * discarded. If a diagonal is present, it will be removed.
+ * is not symmetric, it will be made symmetric with (A+A')/2. If the matrix
+ * has more than one connected component, pass keep_largest_component = true
+ * to keep only the largest and discard the rest; by default the graph is
+ * returned whole. If a diagonal is present, it will be removed. Files
+ * compressed with gzip or zstd are detected by their magic bytes and
+ * decompressed transparently (POSIX platforms only).
  *
  * @param filename the filename or path to the Matrix Market File.
+ * @param keep_largest_component reduce a disconnected matrix to its largest
+ * connected component (default false).
  */
 Graph *read_graph(const std::string &filename);
+Graph *read_graph(const std::string &filename, bool keep_largest_component);
 
 /**
  * Generate a CSparse matrix from a Matrix Market file.
@@ -55,7 +61,9 @@ Graph *read_graph(const std::string &filename);
  * contained in the file must be sparse, real, and square. If the matrix
  * is not symmetric, it will be made symmetric with (A+A')/2. If the matrix has
  * more than one connected component, the largest will be found and the rest
- * discarded. If a diagonal is present, it will be removed.
+ * discarded. If a diagonal is present, it will be removed. Files compressed
+ * with gzip or zstd are detected by their magic bytes and decompressed
+ * transparently (POSIX platforms only).
  *
  * @param filename the filename or path to the Matrix Market File.
  * @param matcode the four character Matrix Market type code.
@@ -67,13 +75,19 @@ cs *read_matrix(const std::string &filename, MM_typecode &matcode);
  *
  * Generate a Graph class instance from a Matrix Market file. The matrix
  * contained in the file must be sparse, real, and square. If the matrix
- * is not symmetric, it will be made symmetric with (A+A')/2. If the matrix has
- * more than one connected component, the largest will be found and the rest
- * discarded. If a diagonal is present, it will be removed.
+ * is not symmetric, it will be made symmetric with (A+A')/2. If the matrix
+ * has more than one connected component, pass keep_largest_component = true
+ * to keep only the largest and discard the rest; by default the graph is
+ * returned whole. If a diagonal is present, it will be removed. Files
+ * compressed with gzip or zstd are detected by their magic bytes and
+ * decompressed transparently (POSIX platforms only).
  *
  * @param filename the filename or path to the Matrix Market File.
+ * @param keep_largest_component reduce a disconnected matrix to its largest
+ * connected component (default false).
  */
 Graph *read_graph(const char *filename);
+Graph *read_graph(const char *filename, bool keep_largest_component);
 
 /**
  * Generate a CSparse matrix from a Matrix Market file.
@@ -82,13 +96,93 @@ Graph *read_graph(const char *filename);
  * contained in the file must be sparse, real, and square. If the matrix
  * is not symmetric, it will be made symmetric with (A+A')/2. If the matrix has
  * more than one connected component, the largest will be found and the rest
- * discarded. If a diagonal is present, it will be removed.
+ * discarded. If a diagonal is present, it will be removed. Files compressed
+ * with gzip or zstd are detected by their magic bytes and decompressed
+ * transparently (POSIX platforms only).
  *
  * @param filename the filename or path to the Matrix Market File.
  * @param matcode the four character Matrix Market type code.
  */
 cs *read_matrix(const char *filename, MM_typecode &matcode);
 
+/**
+ * Generate a Graph from a Matrix Market file with bounded peak memory.
+ *
+ * Produces the same sanitized graph as read_graph (symmetrized, zero-free
+ * diagonal, positive weights), but streams the entry lines in two passes
+ * instead of materializing the triplet list, the compressed matrix, and
+ * the sanitized copy at once: the first pass counts the symmetrized
+ * column degrees and the second scatters the entries directly into the
+ * final CSR arrays, which are then sorted and merged column by column.
+ * Peak resident memory stays near the size of the returned Graph, at the
+ * cost of parsing the file twice. On platforms without mmap this falls
+ * back to read_graph.
+ *
+ * @param filename the filename or path to the Matrix Market File.
+ */
+Graph *read_graph_streaming(const std::string &filename);
+Graph *read_graph_streaming(const char *filename);
+
+/**
+ * Write a Graph to a binary CSR file.
+ *
+ * The container is a 64-byte header followed by the raw p, i, x, and w
+ * arrays (x and w only if present), each 8-byte aligned, so the file can
+ * later be mapped and used in place with zero parsing or copying. The
+ * graph is written as-is: it is expected to already be sanitized (square,
+ * symmetric, zero-free diagonal), as produced by read_graph. The format
+ * is native-endian and records sizeof(Int); files do not port across
+ * architectures with a different byte order or integer width.
+ *
+ * @param graph the graph to write.
+ * @param filename the filename or path to write to.
+ * @return true on success, false on I/O failure.
+ */
+bool write_graph_binary(const Graph *graph, const std::string &filename);
+bool write_graph_binary(const Graph *graph, const char *filename);
+
+/**
+ * Generate a Graph from a binary CSR file.
+ *
+ * Maps a file written by write_graph_binary and wraps the mapped arrays
+ * with Graph::create's shallow-pointer constructor: no parsing, no
+ * sanitizing, and no copies -- the graph data is paged in on demand.
+ * Returns NULL if the file cannot be opened or is not a valid container
+ * (wrong magic, integer width, or size). The returned graph must be
+ * released with free_graph_binary, which also unmaps the file.
+ *
+ * @param filename the filename or path to the binary graph file.
+ */
+Graph *read_graph_binary(const std::string &filename);
+Graph *read_graph_binary(const char *filename);
+
+/**
+ * Release a Graph returned by read_graph_binary.
+ *
+ * Destroys the graph and unmaps the backing file. The graph's arrays
+ * point into the mapping, so destroying the graph directly would leak it.
+ *
+ * @param graph a graph returned by read_graph_binary (NULL is ignored).
+ */
+void free_graph_binary(Graph *graph);
+
+/**
+ * Generate a Graph from a Matrix Market file, caching the sanitized result.
+ *
+ * Behaves like read_graph, but keeps a binary sidecar file
+ * (filename + ".graphbin") beside the input: the first call parses and
+ * sanitizes the matrix and writes the sidecar, stamped with a content hash
+ * of the input bytes, and later calls load the sidecar directly and skip
+ * parsing and sanitization entirely. A changed input hashes differently, so
+ * a stale sidecar is ignored and rewritten; a sidecar that cannot be
+ * written is simply skipped. The returned graph owns its arrays and is
+ * freed like any read_graph result.
+ *
+ * @param filename the filename or path to the Matrix Market File.
+ */
+Graph *read_graph_cached(const std::string &filename);
+Graph *read_graph_cached(const char *filename);
+
 } // end namespace Mongoose
 
 #endif
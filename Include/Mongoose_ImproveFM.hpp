@@ -46,11 +46,17 @@ struct SwapCandidate
 
 void improveCutUsingFM(EdgeCutProblem *, const EdgeCut_Options *);
 
+/* Copy the partition/boundary refinement state between two problems that
+ * share the same structure (n, nz, p, i, x, w). */
+void copyRefinementState(EdgeCutProblem *dst, const EdgeCutProblem *src);
+
 void fmSwap(EdgeCutProblem *, const EdgeCut_Options *, Int vertex, double gain,
             bool oldPartition);
 void fmRefine_worker(EdgeCutProblem *graph, const EdgeCut_Options *options);
 void calculateGain(EdgeCutProblem *, const EdgeCut_Options *, Int vertex, double *out_gain,
                    Int *out_externalDegree);
+void calculateGainAndCut(EdgeCutProblem *, Int vertex, double *out_gain,
+                         double *out_cutWeight, Int *out_externalDegree);
 
 } // end namespace Mongoose
 
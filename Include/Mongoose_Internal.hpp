@@ -33,26 +33,98 @@
 namespace Mongoose
 {
 
-/* Type definitions */
+/* Type definitions. Int defaults to SuiteSparse_long (64-bit). Graphs with
+ * fewer than 2^31 edges fit 32-bit indices, and building with
+ * -DMONGOOSE_INT32 halves the size (and memory bandwidth) of every
+ * p/i/matching/heap array, a direct win for this memory-bound code. The
+ * int32 build is a parallel library (see BUILD_INT32_LIBRARY in
+ * CMakeLists.txt); the whole program must agree on the flag. */
+#ifdef MONGOOSE_INT32
+typedef int Int;
+#ifndef MAX_INT
+#define MAX_INT INT_MAX
+#endif
+#else
 typedef SuiteSparse_long Int;
 #ifndef MAX_INT
 #define MAX_INT SuiteSparse_long_max
 #endif
+#endif
+
+/* Arity of the boundary heaps. The default of 2 keeps the classic binary
+ * layout; building with (say) -DMONGOOSE_BH_ARITY=4 packs each group of
+ * children into one cache line of BHEntry records, which shortens sift
+ * paths at the cost of more comparisons per level. */
+#ifndef MONGOOSE_BH_ARITY
+#define MONGOOSE_BH_ARITY 2
+#endif
+
+/* Software prefetch distance (in edges) for the FM adjacency walks. Each
+ * edge triggers three dependent random reads (partition, gain, and heap
+ * index of the neighbor), but upcoming neighbor IDs are already known
+ * from the CSR index array, so we prefetch them this many edges ahead.
+ * Build with -DMONGOOSE_PREFETCH_DISTANCE=0 to disable prefetching. */
+#ifndef MONGOOSE_PREFETCH_DISTANCE
+#define MONGOOSE_PREFETCH_DISTANCE 8
+#endif
+#if (MONGOOSE_PREFETCH_DISTANCE > 0) && (defined(__GNUC__) || defined(__clang__))
+#define MONGOOSE_PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define MONGOOSE_PREFETCH(addr)
+#endif
+
+/* Storage type of the edge and vertex weights (the x and w arrays on
+ * Graph, EdgeCutProblem, and the CSparse cs struct). Building with
+ * -DMONGOOSE_WEIGHT_FLOAT stores them in single precision, halving the
+ * weight-array footprint at every level of the hierarchy; the cost
+ * accumulators (cutCost, W0, W1, gains, weight sums) stay double in
+ * either build. Weights are part of the public Graph API, so the whole
+ * program must agree on the flag (as with MONGOOSE_INT32). */
+#ifdef MONGOOSE_WEIGHT_FLOAT
+typedef float WeightType;
+#else
+typedef double WeightType;
+#endif
+
+/* Building with -DMONGOOSE_NUMA tunes the parallel phases for multi-socket
+ * machines: the thread pool pins its workers to consecutive CPUs (Linux
+ * only), and the large per-level arrays are first-touch-initialized by the
+ * pool in the same block partition the parallel kernels use, so each
+ * worker's chunk lands on its own node's memory instead of wherever the
+ * constructor happened to run. Off by default; on a single-socket machine
+ * the pinning only restricts the scheduler. */
+
+/* Storage type of the QP iterates (QPDelta's x, gradient, D, and the wx
+ * workspaces). The QP guess is rounded to a boolean partition as soon as it
+ * converges, so it only needs a few digits; building with
+ * -DMONGOOSE_QP_FLOAT stores these arrays in single precision, halving the
+ * QP memory traffic. The loop-carried sums (a'x, step-size numerator and
+ * denominator, cut cost, napsack multiplier) are double in either build. */
+#ifdef MONGOOSE_QP_FLOAT
+typedef float QPScalar;
+#else
+typedef double QPScalar;
+#endif
 
 /* Enumerations */
 enum MatchingStrategy
 {
-    Random   = 0,
-    HEM      = 1,
-    HEMSR    = 2,
-    HEMSRdeg = 3
+    Random      = 0,
+    HEM         = 1,
+    HEMSR       = 2,
+    HEMSRdeg    = 3,
+    RandomBlock = 4
 };
 
 enum InitialEdgeCutType
 {
-    InitialEdgeCut_QP           = 0,
-    InitialEdgeCut_Random       = 1,
-    InitialEdgeCut_NaturalOrder = 2
+    InitialEdgeCut_QP             = 0,
+    InitialEdgeCut_Random         = 1,
+    InitialEdgeCut_NaturalOrder   = 2,
+    InitialEdgeCut_BranchAndBound = 3,
+    InitialEdgeCut_Spectral       = 4,
+    InitialEdgeCut_GraphGrowing   = 5,
+    InitialEdgeCut_Best           = 6
 };
 
 enum MatchType
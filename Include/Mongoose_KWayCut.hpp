@@ -0,0 +1,58 @@
+/* ========================================================================== */
+/* === Include/Mongoose_KWayCut.hpp ========================================= */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * K-way partitioning by task-parallel recursive bisection.
+ *
+ * Each bisection level extracts the two side subgraphs directly from the
+ * already-sanitized parent (no re-sanitization), and the independent
+ * branches of the recursion tree run as parallel tasks on the thread
+ * pool, one batch per recursion depth. Per-bisection balance targets are
+ * derived from the part counts, so uneven k (say 5) still yields parts
+ * of near-equal vertex weight.
+ */
+
+// #pragma once
+#ifndef MONGOOSE_KWAYCUT_HPP
+#define MONGOOSE_KWAYCUT_HPP
+
+#include "Mongoose_EdgeCut.hpp"
+#include "Mongoose_EdgeCutOptions.hpp"
+#include "Mongoose_Graph.hpp"
+
+namespace Mongoose
+{
+
+struct KWayCut
+{
+    Int *partition; /** Part id per vertex, in [0, k)   */
+    Int n;          /** # vertices                      */
+    Int k;          /** # parts                         */
+
+    /** Cut Cost Metrics *****************************************************/
+    double cut_cost;      /** Sum of edge weights between parts */
+    double *part_weights; /** Sum of vertex weights per part,
+                              k entries                         */
+
+    // destructor (no constructor)
+    ~KWayCut();
+};
+
+/* The graph is expected to be sanitized (as from read_graph), like for
+ * edge_cut. k = 1 returns the trivial one-part partition. The options'
+ * target_split is ignored: each bisection's split ratio comes from how
+ * many parts land on each side. */
+KWayCut *kway_cut(const Graph *, Int k);
+KWayCut *kway_cut(const Graph *, Int k, const EdgeCut_Options *);
+
+} // end namespace Mongoose
+
+#endif
@@ -22,10 +22,17 @@
 #ifndef MONGOOSE_LOGGER_HPP
 #define MONGOOSE_LOGGER_HPP
 
+#include "Mongoose_Internal.hpp"
 #include <iostream>
+#include <stdio.h>
 #include <string>
 #include <time.h>
 
+#if CPP11_OR_LATER
+#include <atomic>
+#include <chrono>
+#endif
+
 // Default Logging Levels
 #ifndef LOG_ERROR
 #define LOG_ERROR 1
@@ -69,6 +76,24 @@
             (std::cout << msg);                                                \
     } while (0)
 
+// Hot-path operation counters. Disabled by default so instrumented inner
+// loops compile to nothing; build with -DMONGOOSE_COUNTERS=1 (library and
+// application together) to collect them. printTimingInfo dumps the counts.
+#ifndef MONGOOSE_COUNTERS
+#define MONGOOSE_COUNTERS 0
+#endif
+
+#if MONGOOSE_COUNTERS
+#define MONGOOSE_COUNT_ADD(counterType, k)                                     \
+    Mongoose::Logger::bump(counterType, k)
+#else
+#define MONGOOSE_COUNT_ADD(counterType, k)                                     \
+    do                                                                         \
+    {                                                                          \
+    } while (0)
+#endif
+#define MONGOOSE_COUNT(counterType) MONGOOSE_COUNT_ADD(counterType, 1)
+
 namespace Mongoose
 {
 
@@ -92,22 +117,91 @@ typedef enum TimingType
     IOTiming         = 5
 } TimingType;
 
+typedef enum CounterType
+{
+    FMMovesAttemptedCounter     = 0, /* FM moves made during a sweep       */
+    FMMovesAcceptedCounter      = 1, /* FM moves kept after the undo pass  */
+    HeapSiftUpCounter           = 2, /* heapifyUp swap steps               */
+    HeapSiftDownCounter         = 3, /* heapifyDown swap steps             */
+    QPGradProjIterationsCounter = 4, /* QP gradient projection iterations  */
+    NapsackBreakpointsCounter   = 5, /* napsack breakpoint heap pops       */
+    MarkArrayClearsCounter      = 6  /* mark-array clears                  */
+} CounterType;
+
+#define MONGOOSE_COUNTER_COUNT 7
+
+/* Allocation accounting phases: one per TimingType plus a final slot for
+ * allocations made outside any tic/toc window. */
+#define MONGOOSE_ALLOC_PHASES 7
+
 class Logger
 {
 private:
     static int debugLevel;
     static bool timingOn;
     static clock_t clocks[6];
-    static float times[6];
+    static float cpuTimes[6];
+#if CPP11_OR_LATER
+    static std::chrono::steady_clock::time_point wallClocks[6];
+    static float wallTimes[6];
+    /* Atomic because FM multi-try and other parallel phases bump counters
+     * from worker threads; relaxed increments are all that's needed. */
+    static std::atomic<Int> counters[MONGOOSE_COUNTER_COUNT];
+#else
+    static Int counters[MONGOOSE_COUNTER_COUNT];
+#endif
+    static bool tracingOn;
+    static FILE *traceFile;
+    static bool traceFirstEvent;
+    static void traceEvent(bool begin, TimingType timingType);
+
+    /** Allocation accounting (see startAllocAccounting) ********************/
+    static bool allocAccountingOn;
+    static bool allocAccountingUsed;
+    static int allocPhaseStack[8]; /* nested tic phases; [0] = outside */
+    static int allocPhaseDepth;
+    static size_t allocLiveBytes;
+    static size_t allocCounts[MONGOOSE_ALLOC_PHASES];
+    static size_t allocBytes[MONGOOSE_ALLOC_PHASES];
+    static size_t allocPeaks[MONGOOSE_ALLOC_PHASES];
+    static void allocPushPhase(TimingType timingType);
+    static void allocPopPhase();
 
 public:
     static inline void tic(TimingType timingType);
     static inline void toc(TimingType timingType);
     static inline float getTime(TimingType timingType);
+    static inline float getCPUTime(TimingType timingType);
+    static inline double wallSeconds();
+    static inline void bump(CounterType counterType, Int k);
+    static inline Int getCounter(CounterType counterType);
+    static void resetCounters();
     static inline int getDebugLevel();
     static void setDebugLevel(int debugType);
     static void setTimingFlag(bool tFlag);
+    static void setTraceFile(const char *path);
+    static void closeTraceFile();
     static void printTimingInfo();
+
+    /** Route SuiteSparse_malloc/calloc/realloc/free through an accounting
+     *  shim that records, per tic/toc phase, the allocation count, total
+     *  bytes requested, and the high-water mark of live bytes observed
+     *  while that phase was active. printTimingInfo then reports the
+     *  table alongside the times, and the getters below expose it to
+     *  tests. The shim tags each block with a small header, so the
+     *  start/stop calls must bracket a region whose allocations are also
+     *  freed (or realloc'd) inside it -- a whole read_graph + edge_cut
+     *  is such a region; stopAllocAccounting restores the previous
+     *  SuiteSparse handlers. */
+    static void startAllocAccounting();
+    static void stopAllocAccounting();
+    static size_t getAllocCount(int phase);
+    static size_t getAllocBytes(int phase);
+    static size_t getAllocPeak(int phase);
+
+    /* Called by the accounting shim only. */
+    static void recordAlloc(size_t size);
+    static void recordFree(size_t size);
 };
 
 /**
@@ -129,6 +223,17 @@ inline void Logger::tic(TimingType timingType)
     if (timingOn)
     {
         clocks[timingType] = clock();
+#if CPP11_OR_LATER
+        wallClocks[timingType] = std::chrono::steady_clock::now();
+#endif
+    }
+    if (tracingOn)
+    {
+        traceEvent(true, timingType);
+    }
+    if (allocAccountingOn)
+    {
+        allocPushPhase(timingType);
     }
 }
 
@@ -150,23 +255,110 @@ inline void Logger::toc(TimingType timingType)
 {
     if (timingOn)
     {
-        times[timingType]
+        cpuTimes[timingType]
             += ((float)(clock() - clocks[timingType])) / CLOCKS_PER_SEC;
+#if CPP11_OR_LATER
+        wallTimes[timingType]
+            += std::chrono::duration<float>(std::chrono::steady_clock::now()
+                                            - wallClocks[timingType])
+                   .count();
+#endif
+    }
+    if (tracingOn)
+    {
+        traceEvent(false, timingType);
+    }
+    if (allocAccountingOn)
+    {
+        allocPopPhase();
     }
 }
 
 /**
- * Get the time recorded for a given timing type.
+ * Get the wall-clock time recorded for a given timing type.
  *
- * Retreive the total clock time for a given timing type (MatchingTiming,
- * CoarseningTiming, RefinementTiming, FMTiming, QPTiming, or IOTiming).
+ * Retrieve the total elapsed (monotonic wall-clock) time for a given timing
+ * type (MatchingTiming, CoarseningTiming, RefinementTiming, FMTiming,
+ * QPTiming, or IOTiming). Wall time stays meaningful for parallel phases
+ * and I/O waits, where CPU time over- or under-counts. When built without
+ * C++11 this falls back to the CPU time.
  *
  * @param timingType The portion of the library being timed (MatchingTiming,
  *   CoarseningTiming, RefinementTiming, FMTiming, QPTiming, or IOTiming).
  */
 inline float Logger::getTime(TimingType timingType)
 {
-    return times[timingType];
+#if CPP11_OR_LATER
+    return wallTimes[timingType];
+#else
+    return cpuTimes[timingType];
+#endif
+}
+
+/**
+ * Get the CPU time recorded for a given timing type.
+ *
+ * Retrieve the total process CPU time (clock()) for a given timing type.
+ * CPU time sums across threads, so it exceeds wall time for parallel
+ * phases and undercounts I/O waits.
+ *
+ * @param timingType The portion of the library being timed (MatchingTiming,
+ *   CoarseningTiming, RefinementTiming, FMTiming, QPTiming, or IOTiming).
+ */
+inline float Logger::getCPUTime(TimingType timingType)
+{
+    return cpuTimes[timingType];
+}
+
+/**
+ * Get a monotonic timestamp in seconds.
+ *
+ * The epoch is arbitrary; only differences are meaningful. Used for the
+ * per-level statistics and for deadline checks. Falls back to CPU time on
+ * pre-C++11 builds.
+ */
+inline double Logger::wallSeconds()
+{
+#if CPP11_OR_LATER
+    return std::chrono::duration<double>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+#else
+    return ((double)clock()) / CLOCKS_PER_SEC;
+#endif
+}
+
+/**
+ * Add k to an operation counter.
+ *
+ * Normally reached through the MONGOOSE_COUNT / MONGOOSE_COUNT_ADD macros,
+ * which compile to nothing unless MONGOOSE_COUNTERS is set, so hot loops
+ * pay nothing in production builds.
+ *
+ * @param counterType The operation being counted (see CounterType).
+ * @param k The amount to add.
+ */
+inline void Logger::bump(CounterType counterType, Int k)
+{
+#if CPP11_OR_LATER
+    counters[counterType].fetch_add(k, std::memory_order_relaxed);
+#else
+    counters[counterType] += k;
+#endif
+}
+
+/**
+ * Get the current value of an operation counter.
+ *
+ * @param counterType The operation being counted (see CounterType).
+ */
+inline Int Logger::getCounter(CounterType counterType)
+{
+#if CPP11_OR_LATER
+    return counters[counterType].load(std::memory_order_relaxed);
+#else
+    return counters[counterType];
+#endif
 }
 
 inline int Logger::getDebugLevel()
@@ -23,6 +23,7 @@ namespace Mongoose
 void match(EdgeCutProblem *, const EdgeCut_Options *);
 
 void matching_Random(EdgeCutProblem *, const EdgeCut_Options *);
+void matching_RandomBlock(EdgeCutProblem *, const EdgeCut_Options *);
 void matching_HEM(EdgeCutProblem *, const EdgeCut_Options *);
 void matching_SR(EdgeCutProblem *, const EdgeCut_Options *);
 void matching_SRdeg(EdgeCutProblem *, const EdgeCut_Options *);
@@ -0,0 +1,87 @@
+/* ========================================================================== */
+/* === Include/Mongoose_QPBackend.hpp ======================================= */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * Pluggable accelerator backend for the QP gradient-projection phase.
+ *
+ * QPGradProj's per-iteration work is an SpMV plus vector operations, a
+ * natural fit for a GPU. Mongoose itself stays free of any device
+ * toolchain: an application links its CUDA/HIP (or other) implementation
+ * separately and registers it with setQPBackend(), and every
+ * improveCutUsingQP call then routes its gradient-projection passes
+ * through the backend instead of the CPU QPGradProj. Without a
+ * registered backend -- or when the backend declines a level -- nothing
+ * changes.
+ *
+ * Lifecycle: setup() runs once per coarsening level, on the first
+ * gradient-projection pass touching that level, and receives the level's
+ * CSR so the device copy is uploaded once and reused across the dances
+ * at that level. The handle it returns is kept on the level and passed
+ * back to gradproj() and, when the level is destroyed, to release().
+ * Returning NULL from setup() declines the level (too small to be worth
+ * the transfer, device out of memory, ...) permanently; the CPU path
+ * runs and setup is not retried.
+ *
+ * Contract for gradproj(): behave exactly like QPGradProj -- consume and
+ * update qpDelta (x, gradient, FreeSet) and return the error estimate --
+ * so QPBoundary can round the FreeSet afterwards without knowing where
+ * the iterations ran. The level's p/i structure is immutable for the
+ * life of the problem, but the x/w numeric arrays may be updated in
+ * place between solves (edge_cut_numeric), so a backend that caches
+ * numeric values device-side must re-upload them per call or decline.
+ *
+ * The registered backend must outlive every problem whose levels it
+ * accepted; registration is not synchronized against concurrent solves.
+ */
+
+// #pragma once
+#ifndef MONGOOSE_QPBACKEND_HPP
+#define MONGOOSE_QPBACKEND_HPP
+
+#include "Mongoose_EdgeCutProblem.hpp"
+#include "Mongoose_QPDelta.hpp"
+
+namespace Mongoose
+{
+
+struct QP_Backend
+{
+    /* Bind one level; return a per-level handle or NULL to decline. */
+    void *(*setup)(void *context, Int n, Int nz, const Int *p, const Int *i,
+                   const WeightType *x, const WeightType *w);
+
+    /* One gradient-projection pass; same contract as QPGradProj. */
+    double (*gradproj)(void *context, void *handle, EdgeCutProblem *graph,
+                       const EdgeCut_Options *options, QPDelta *qpDelta);
+
+    /* Drop the per-level state created by setup(). */
+    void (*release)(void *context, void *handle);
+
+    /* Opaque state passed back to every callback. */
+    void *context;
+};
+
+/* Register a backend (all three callbacks required), or NULL to restore
+ * the CPU path for levels not yet bound. */
+void setQPBackend(const QP_Backend *backend);
+const QP_Backend *getQPBackend();
+
+/* Route one gradient-projection pass: through the registered backend if
+ * it accepts (or already accepted) this level, else QPGradProj. */
+double qpGradProjDispatch(EdgeCutProblem *graph,
+                          const EdgeCut_Options *options, QPDelta *qpDelta);
+
+/* Called by the problem destructor to release the level's device state. */
+void qpBackendReleaseLevel(EdgeCutProblem *graph);
+
+} // end namespace Mongoose
+
+#endif
@@ -25,7 +25,7 @@ private:
     static const Int WISIZE = 2;
 
 public:
-    double *x; /* current estimate of solution                    */
+    QPScalar *x; /* current estimate of solution                  */
 
     // FreeSet:
     Int nFreeSet;        /* number of i such that 0 < x_i < 1               */
@@ -33,15 +33,23 @@ public:
     Int *FreeSet_list;   /* list for free indices                    */
     //---
 
-    double *gradient; /* gradient at current x                           */
-    double *D;        /* max value along the column.                     */
+    QPScalar *gradient; /* gradient at current x                         */
+    QPScalar *D;        /* max value along the column.                   */
 
     double lo; // lo <= a'*x <= hi must always hold
     double hi;
 
     // workspace
     Int *wi[WISIZE];
-    double *wx[WXSIZE];
+    QPScalar *wx[WXSIZE];
+
+    // Sparse-gradient workspace (used when options->use_QP_sparse_gradient).
+    // Dgrad is a dedicated gradient-change array that is kept all-zero
+    // between uses so it never needs an O(n) clear; touchList/touched track
+    // exactly which entries the scatter kernels wrote.
+    QPScalar *Dgrad;
+    Int *touchList;
+    bool *touched;
 
     Int its;
     double err;
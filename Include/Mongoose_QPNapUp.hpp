@@ -19,12 +19,12 @@ namespace Mongoose
 {
 
 double QPNapUp         /* return lambda */
-    (const double *x,  /* holds y on input, not modified */
+    (const QPScalar *x,  /* holds y on input, not modified */
      Int n,            /* size of x */
      double lambda,    /* initial guess for the shift */
-     const double *a,  /* input constraint vector */
+     const WeightType *a, /* input constraint vector */
      double b,         /* input constraint scalar */
-     double *breakpts, /* break points */
+     QPScalar *breakpts, /* break points */
      Int *bound_heap,  /* work array */
      Int *free_heap    /* work array */
     );
@@ -0,0 +1,35 @@
+/* ========================================================================== */
+/* === Include/Mongoose_Reorder.hpp ========================================= */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+// #pragma once
+#ifndef MONGOOSE_REORDER_HPP
+#define MONGOOSE_REORDER_HPP
+
+#include "Mongoose_Graph.hpp"
+#include "Mongoose_Internal.hpp"
+
+namespace Mongoose
+{
+
+// Builds a deep copy of the graph with its vertices relabeled in reverse
+// Cuthill-McKee order, so that neighboring vertices get nearby numbers and
+// the CSR-walking phases (matching, coarsening, FM, QP) index their
+// per-vertex arrays with small strides instead of random scatter. Requires
+// the sanitized form every edge_cut input already has: square, symmetric in
+// pattern and values, sorted columns, zero-free diagonal. On success
+// *perm_out receives the permutation as an n-array with perm[new] = old
+// (freed by the caller with SuiteSparse_free); the copy's columns come out
+// sorted. Returns NULL on out of memory, with *perm_out untouched.
+Graph *reorderGraph(const Graph *graph, Int **perm_out);
+
+} // end namespace Mongoose
+
+#endif
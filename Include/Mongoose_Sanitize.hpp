@@ -20,10 +20,23 @@ namespace Mongoose
 {
 
 cs *sanitizeMatrix(cs *compressed_A, bool symmetricTriangular,
-                   bool makeEdgeWeightsBinary);
+                   bool makeEdgeWeightsBinary,
+                   bool keepLargestComponent = false);
+// True if A is already in the form sanitizeMatrix produces -- square,
+// sorted columns, symmetric in pattern and values, zero-free diagonal
+// (and all-ones values when requireBinary) -- so callers holding such a
+// matrix can skip the sanitize copy and wrap its arrays directly. One
+// O(n + nz) sweep with an n-cursor workspace; false on out of memory.
+bool matrixIsSanitized(const cs *A, bool requireBinary);
 void removeDiagonal(cs *A);
 // Requires A to be a triangular matrix with no diagonal.
 cs *mirrorTriangular(cs *A);
+// Reduces A to its largest connected component, renumbering the kept
+// vertices in their original order. Returns A itself (not a copy) when the
+// graph is already connected, and NULL when out of memory. Components are
+// labeled with parallel label propagation when C++11 threads are available
+// and the graph is large; smaller graphs use serial union-find.
+cs *extractLargestComponent(cs *A);
 
 } // end namespace Mongoose
 
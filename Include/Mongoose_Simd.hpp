@@ -0,0 +1,90 @@
+/* ========================================================================== */
+/* === Include/Mongoose_Simd.hpp ============================================ */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * Runtime SIMD dispatch for the vectorized kernels.
+ *
+ * The vectorized loop bodies (matching scan, gain computation, napsack
+ * classification) are compiled with a per-function target attribute, so
+ * one binary carries both the scalar and the AVX2 paths regardless of
+ * the baseline -m flags, and the ISA actually present is detected once
+ * at startup. Call sites test simdAVX2() -- a read of one cached flag,
+ * cheap enough for per-row decisions -- and fall through to the scalar
+ * loop when the hardware (or the build knob below) says no.
+ *
+ * The MONGOOSE_FORCE_SIMD CMake knob (AUTO, SCALAR, AVX2) pins the
+ * dispatch at build time for benchmarking variants against each other;
+ * forcing AVX2 on hardware without it will fault, so it is a
+ * benchmarking knob, not a deployment one. setSimdIsa() does the same
+ * within one process and clamps to what the hardware supports, so an
+ * A/B run does not need two binaries.
+ *
+ * AVX-512 hardware is detected and reported but currently binds the
+ * AVX2 kernels (no 512-bit kernels exist yet, and 256-bit operation
+ * avoids the frequency-license penalty on most parts). Non-x86 targets
+ * (and compilers without target attributes) always run the scalar
+ * paths.
+ */
+
+// #pragma once
+#ifndef MONGOOSE_SIMD_HPP
+#define MONGOOSE_SIMD_HPP
+
+#include "Mongoose_Internal.hpp"
+
+/* MONGOOSE_SIMD_AVX2: this build can contain AVX2 kernels. Either the
+ * compiler supports per-function target attributes (GCC/Clang on
+ * x86-64), or the whole build is already compiled for AVX2 and the
+ * attribute is unnecessary. */
+#if defined(__AVX2__)
+#define MONGOOSE_SIMD_AVX2 1
+#define MONGOOSE_TARGET_AVX2
+#elif (defined(__x86_64__) || defined(_M_X64))                                 \
+    && (defined(__GNUC__) || defined(__clang__))
+#define MONGOOSE_SIMD_AVX2 1
+#define MONGOOSE_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define MONGOOSE_SIMD_AVX2 0
+#define MONGOOSE_TARGET_AVX2
+#endif
+
+namespace Mongoose
+{
+
+typedef enum
+{
+    SimdIsa_Scalar = 0, /* Plain loops only                          */
+    SimdIsa_AVX2   = 1, /* 256-bit x86 kernels                       */
+    SimdIsa_AVX512 = 2  /* Detected only; binds the AVX2 kernels     */
+} SimdIsa;
+
+/* The ISA the hardware supports (clamped by MONGOOSE_FORCE_SIMD). */
+SimdIsa simdIsaDetected();
+
+/* The ISA the dispatch is currently bound to. */
+SimdIsa simdIsa();
+
+/* Rebind the dispatch, clamped to simdIsaDetected(); lowering to
+ * SimdIsa_Scalar always works. For benchmarking, not thread-safe
+ * against concurrent solves. */
+void setSimdIsa(SimdIsa isa);
+
+/* Cached dispatch flag read by the kernel call sites. */
+extern bool simd_avx2_enabled;
+
+static inline bool simdAVX2()
+{
+    return simd_avx2_enabled;
+}
+
+} // end namespace Mongoose
+
+#endif
@@ -0,0 +1,75 @@
+/* ========================================================================== */
+/* === Include/Mongoose_ThreadPool.hpp ====================================== */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * Persistent worker pool for the parallel phases.
+ *
+ * Every parallel phase used to spin up and join its own std::threads, so
+ * a deep hierarchy paid thread creation per level per phase. The pool
+ * creates its workers once, lazily on the first batch, and every phase
+ * (matching, coarsening, the FM tries, the QP SpMV, sanitization, and
+ * the parallel readers) submits batches of numbered jobs to the same
+ * workers. Work partitioning stays with the callers, keyed off the job
+ * number, so the decomposition -- and with it the result -- is the same
+ * no matter which worker runs which job.
+ */
+
+// #pragma once
+#ifndef MONGOOSE_THREADPOOL_HPP
+#define MONGOOSE_THREADPOOL_HPP
+
+#include "Mongoose_Internal.hpp"
+
+#if CPP11_OR_LATER
+
+#include <functional>
+
+namespace Mongoose
+{
+
+class ThreadPool
+{
+public:
+    /** Execute job(t) for every t in [0, njobs) and return when all have
+     *  finished. The calling thread participates, so the batch completes
+     *  even when no workers could be created. Batches from different
+     *  threads are serialized; a job that submits a batch of its own runs
+     *  it inline, so nesting cannot deadlock the pool. */
+    static void run(Int njobs, const std::function<void(Int)> &job);
+
+    /** Run task() on a pool worker as soon as one is free and return
+     *  immediately. Tasks coexist with batches: a worker is either
+     *  claiming batch jobs or running one task, and a task's own nested
+     *  batches run inline on its worker. When the pool has no workers, or
+     *  the submitter is itself a pool worker, the task runs inline before
+     *  submit returns. Tasks still queued at process exit run on the
+     *  thread destroying the pool, so a task's side effects (promises,
+     *  callbacks) always happen. */
+    static void submit(const std::function<void()> &task);
+
+    /** Upper bound on useful batch sizes: the pool's worker count plus
+     *  the calling thread (hardware concurrency, at least 1). */
+    static Int maxThreads();
+
+    /** First-touch a freshly allocated, not-yet-written buffer: zero it in
+     *  nparts contiguous chunks, one pool job each, matching the block
+     *  partition the parallel kernels use, so each chunk's pages land on
+     *  the node of the worker that will scan them. Only meaningful in
+     *  MONGOOSE_NUMA builds (where the workers are pinned); a no-op
+     *  otherwise, since whatever fills the buffer touches its pages. */
+    static void firstTouch(void *ptr, size_t bytes, Int nparts);
+};
+
+} // end namespace Mongoose
+
+#endif
+
+#endif
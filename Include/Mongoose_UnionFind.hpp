@@ -0,0 +1,92 @@
+/* ========================================================================== */
+/* === Include/Mongoose_UnionFind.hpp ======================================= */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * Union-find structure for vertex aggregation.
+ *
+ * Tracks which vertices have been merged into the same coarse aggregate
+ * during the matching phase. Uses a single parent array with path halving;
+ * aggregate sizes are stored at the roots as negative values, so the whole
+ * structure is one O(n) array instead of separate parent and size arrays.
+ */
+
+// #pragma once
+#ifndef MONGOOSE_UNIONFIND_HPP
+#define MONGOOSE_UNIONFIND_HPP
+
+#include "Mongoose_Internal.hpp"
+
+namespace Mongoose
+{
+
+class UnionFind
+{
+public:
+    /* Constructor & Destructor */
+    static UnionFind *create(const Int _n);
+    ~UnionFind();
+
+    /** Find the root of the aggregate containing vertex v, compressing the
+     *  path along the way. */
+    inline Int find(Int v)
+    {
+        while (parent[v] >= 0)
+        {
+            Int grandparent = parent[v];
+            if (parent[grandparent] >= 0)
+            {
+                /* Path halving: point v at its grandparent. */
+                parent[v]   = parent[grandparent];
+                grandparent = parent[v];
+            }
+            v = grandparent;
+        }
+        return v;
+    }
+
+    /** Merge the aggregates containing a and b (union by size) and return
+     *  the root of the merged aggregate. */
+    inline Int unite(Int a, Int b)
+    {
+        Int rootA = find(a);
+        Int rootB = find(b);
+        if (rootA == rootB)
+            return rootA;
+
+        /* Sizes are stored negated at the roots. */
+        if (parent[rootA] > parent[rootB])
+        {
+            Int swap = rootA;
+            rootA    = rootB;
+            rootB    = swap;
+        }
+        parent[rootA] += parent[rootB];
+        parent[rootB] = rootA;
+        return rootA;
+    }
+
+    /** Number of vertices in the aggregate containing v. */
+    inline Int size(Int v)
+    {
+        return -parent[find(v)];
+    }
+
+private:
+    UnionFind();
+
+    Int n;       /** # vertices                                   */
+    Int *parent; /** parent[v] is the parent of v, or the negated
+                     aggregate size if v is a root                */
+};
+
+} // end namespace Mongoose
+
+#endif
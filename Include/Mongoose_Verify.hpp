@@ -0,0 +1,45 @@
+/* ========================================================================== */
+/* === Include/Mongoose_Verify.hpp ========================================== */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * Independent partition verifier, available in release builds.
+ *
+ * The consistency checks in Mongoose_Debug.cpp exist only in debug
+ * builds and walk the internal problem state. verify() instead checks a
+ * finished EdgeCut against the input Graph from scratch: one sweep over
+ * the edges recomputes cut_cost, cut_size, w0, w1, and imbalance, and
+ * the recomputed values must agree with the stored ones (exactly for
+ * cut_size, to a small relative tolerance for the floating-point
+ * metrics, since summation order differs from the solver's). The sweep
+ * is parallelized over the thread pool, so running it after every
+ * production solve costs a small fraction of the solve itself.
+ */
+
+// #pragma once
+#ifndef MONGOOSE_VERIFY_HPP
+#define MONGOOSE_VERIFY_HPP
+
+#include "Mongoose_EdgeCut.hpp"
+#include "Mongoose_Graph.hpp"
+
+namespace Mongoose
+{
+
+/* True if the result is a self-consistent partition of the graph. The
+ * stored imbalance is checked against the options' target_split (the
+ * two-argument form assumes the 50/50 default). Failures are reported
+ * through the error log. */
+bool verify(const EdgeCut *result, const Graph *graph);
+bool verify(const EdgeCut *result, const Graph *graph, double target_split);
+
+} // end namespace Mongoose
+
+#endif
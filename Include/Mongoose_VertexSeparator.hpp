@@ -0,0 +1,59 @@
+/* ========================================================================== */
+/* === Include/Mongoose_VertexSeparator.hpp ================================= */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * Vertex separator extraction.
+ *
+ * Converts a refined edge cut into a vertex separator: a maximum matching
+ * on the bipartite graph of cut edges gives, by Konig's theorem, a
+ * minimum vertex cover of those edges, and removing the cover leaves no
+ * edge between the two sides. The separator is therefore the smallest
+ * vertex set that covers this edge cut -- the post-processing that
+ * nested-dissection consumers otherwise approximate outside the library.
+ */
+
+// #pragma once
+#ifndef MONGOOSE_VERTEXSEPARATOR_HPP
+#define MONGOOSE_VERTEXSEPARATOR_HPP
+
+#include "Mongoose_EdgeCut.hpp"
+#include "Mongoose_EdgeCutOptions.hpp"
+#include "Mongoose_Graph.hpp"
+
+namespace Mongoose
+{
+
+struct VertexSeparator
+{
+    Int *partition; /** Per vertex: 0 or 1 for the sides,
+                        2 for the separator             */
+    Int n;          /** # vertices                      */
+
+    /** Separator Metrics ****************************************************/
+    Int sep_size;      /** # separator vertices            */
+    double sep_weight; /** Sum of separator vertex weights */
+    double w0;         /** Sum of side 0 vertex weights    */
+    double w1;         /** Sum of side 1 vertex weights    */
+
+    // destructor (no constructor)
+    ~VertexSeparator();
+};
+
+/* The graph is expected to be sanitized (as from read_graph), like for
+ * edge_cut. The underlying edge cut honors the options (target_split,
+ * refinement knobs, seed); the separator is then the minimum vertex cover
+ * of that cut's edges. */
+VertexSeparator *vertex_separator(const Graph *);
+VertexSeparator *vertex_separator(const Graph *, const EdgeCut_Options *);
+
+} // end namespace Mongoose
+
+#endif
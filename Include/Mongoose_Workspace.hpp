@@ -0,0 +1,72 @@
+/* ========================================================================== */
+/* === Include/Mongoose_Workspace.hpp ======================================= */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+/**
+ * Reusable scratch workspace for the solve phases.
+ *
+ * Matching and refinement each allocate private O(n) scratch on entry
+ * (two-hop waiting lists, block shuffle orders, parallel claim arrays,
+ * deferred-repair dirty lists, FM journals). One Workspace hangs off the
+ * root EdgeCutProblem -- alongside the pooled QPDelta -- and hands the
+ * same memory out again at every level and every phase, so a solve pays
+ * for each scratch array once instead of once per level. For callers
+ * partitioning many small graphs through a retained hierarchy, the
+ * workspace survives re-solves as well.
+ */
+
+// #pragma once
+#ifndef MONGOOSE_WORKSPACE_HPP
+#define MONGOOSE_WORKSPACE_HPP
+
+#include "Mongoose_Internal.hpp"
+
+namespace Mongoose
+{
+
+class Workspace
+{
+public:
+    /* Constructor & Destructor */
+    static Workspace *create();
+    ~Workspace();
+
+    /** Borrow count uninitialized Ints. The buffer grows to the largest
+     *  request seen (the finest level sizes it; coarser levels fit for
+     *  free) and is handed out again on every call, so a phase must not
+     *  hold two Int borrows at once. Returns NULL on allocation failure,
+     *  and the borrower falls back as if its own malloc had failed. */
+    Int *getInts(size_t count);
+
+    /** Borrow count bools, all false (the buffer is cleared before it is
+     *  handed out, replacing the callers' callocs). Same growth, reuse,
+     *  and failure rules as getInts. */
+    bool *getFlags(size_t count);
+
+    /** Borrow raw uninitialized bytes, for scratch whose element type is
+     *  private to one translation unit (FM journal entries, the parallel
+     *  matching claim array). Same rules as getInts; the returned pointer
+     *  is 16-byte aligned. */
+    void *getBytes(size_t bytes);
+
+private:
+    Workspace();
+
+    Int *ints;
+    size_t intCount;
+    bool *flags;
+    size_t flagCount;
+    void *raw;
+    size_t rawBytes;
+};
+
+} // end namespace Mongoose
+
+#endif
@@ -4,6 +4,7 @@
 %   coarsen         - coarsen a graph unsafely but quickly.
 %   edgecut         - find an edge separator in a graph.
 %   edgecut_options - create a struct of default options for edge cuts.
+%   hierarchy       - iterate coarsening through a persistent hierarchy handle.
 %   mongoose_demo   - a simple demo of Mongoose graph partitioner.
 %   mongoose_make   - compiles the Mongoose mexFunctions.
 %   mongoose_plot   - use graphvis to create a plot of a graph.
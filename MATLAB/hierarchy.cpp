@@ -0,0 +1,268 @@
+
+#include "mongoose_mex.hpp"
+#include <cstring>
+
+using namespace Mongoose;
+
+/* A hierarchy handle owns a deep copy of the caller's graph (the mxArray
+ * data only lives for the duration of one mex call) plus every coarsening
+ * level built so far, so iterated coarsening and the final edge cut cross
+ * the mex boundary without re-marshaling the graph each level. Handles
+ * are returned to MATLAB as uint64 scalars and validated against this
+ * registry on every call. */
+struct HierarchyHandle
+{
+    Int *p;                   /* owned copies of the finest graph */
+    Int *i;
+    WeightType *x;
+    WeightType *w;            /* NULL when no vertex weights given */
+    EdgeCutProblem *finest;
+    EdgeCutProblem *coarsest; /* == finest before any coarsening */
+    HierarchyHandle *next;
+};
+
+static HierarchyHandle *registry = NULL;
+
+static void freeHandle(HierarchyHandle *handle)
+{
+    /* The finest problem's destructor tears down the whole child chain. */
+    handle->finest->~EdgeCutProblem();
+    SuiteSparse_free(handle->p);
+    SuiteSparse_free(handle->i);
+    SuiteSparse_free(handle->x);
+    SuiteSparse_free(handle->w);
+    SuiteSparse_free(handle);
+}
+
+static void freeAllHandles(void)
+{
+    while (registry)
+    {
+        HierarchyHandle *next = registry->next;
+        freeHandle(registry);
+        registry = next;
+    }
+}
+
+static mxArray *putHandle(HierarchyHandle *handle)
+{
+    mxArray *H = mxCreateNumericMatrix(1, 1, mxUINT64_CLASS, mxREAL);
+    *(uint64_t *)mxGetData(H) = (uint64_t)(size_t)handle;
+    return H;
+}
+
+static HierarchyHandle *getHandle(const mxArray *H)
+{
+    if (!mxIsUint64(H) || mxGetNumberOfElements(H) != 1)
+    {
+        mexErrMsgTxt("h must be a hierarchy handle (uint64 scalar)");
+    }
+    HierarchyHandle *handle
+        = (HierarchyHandle *)(size_t)(*(uint64_t *)mxGetData(H));
+    for (HierarchyHandle *live = registry; live; live = live->next)
+    {
+        if (live == handle)
+            return handle;
+    }
+    mexErrMsgTxt("not a live hierarchy handle");
+    return NULL;
+}
+
+static HierarchyHandle *newHandle(const mxArray *matGraph,
+                                  const mxArray *matNodeWeights)
+{
+    cs_mex_check(0, -1, -1, 1, 1, 1, matGraph);
+    Int n          = mxGetN(matGraph);
+    mwIndex *Gp    = mxGetJc(matGraph);
+    mwIndex *Gi    = mxGetIr(matGraph);
+    double *Gx     = mxGetPr(matGraph);
+    Int nz         = (Int)Gp[n];
+
+    HierarchyHandle *handle
+        = (HierarchyHandle *)SuiteSparse_calloc(1, sizeof(HierarchyHandle));
+    if (!handle)
+        mexErrMsgTxt("Out of memory");
+
+    handle->p = (Int *)SuiteSparse_malloc(n + 1, sizeof(Int));
+    handle->i = (Int *)SuiteSparse_malloc(nz, sizeof(Int));
+    handle->x = (WeightType *)SuiteSparse_malloc(nz, sizeof(WeightType));
+    handle->w = NULL;
+    if (!handle->p || !handle->i || !handle->x)
+    {
+        mexErrMsgTxt("Out of memory");
+    }
+    for (Int k = 0; k <= n; k++)
+        handle->p[k] = (Int)Gp[k];
+    for (Int k = 0; k < nz; k++)
+        handle->i[k] = (Int)Gi[k];
+    for (Int k = 0; k < nz; k++)
+        handle->x[k] = (WeightType)Gx[k];
+
+    if (matNodeWeights)
+    {
+        cs_mex_check(0, n, 1, 0, 0, 1, matNodeWeights);
+        double *Gw = mxGetPr(matNodeWeights);
+        handle->w  = (WeightType *)SuiteSparse_malloc(n, sizeof(WeightType));
+        if (!handle->w)
+            mexErrMsgTxt("Out of memory");
+        for (Int k = 0; k < n; k++)
+            handle->w[k] = (WeightType)Gw[k];
+    }
+
+    handle->finest = EdgeCutProblem::create(n, nz, handle->p, handle->i,
+                                            handle->x, handle->w);
+    if (!handle->finest)
+        mexErrMsgTxt("Out of memory");
+    handle->coarsest = handle->finest;
+
+    if (!registry)
+    {
+        mexAtExit(freeAllHandles);
+        mexLock();
+    }
+    handle->next = registry;
+    registry     = handle;
+    return handle;
+}
+
+static void dropHandle(HierarchyHandle *handle)
+{
+    HierarchyHandle **slot = &registry;
+    while (*slot != handle)
+        slot = &(*slot)->next;
+    *slot = handle->next;
+    freeHandle(handle);
+    if (!registry)
+        mexUnlock();
+}
+
+/* Marshal the coarsest level back to MATLAB; cs_mex_put_sparse takes
+ * ownership of the arrays it is given, so the level's live arrays are
+ * copied first. */
+static void putCoarsest(const HierarchyHandle *handle, int nargout,
+                        mxArray *pargout[])
+{
+    EdgeCutProblem *G = handle->coarsest;
+    Int n             = G->n;
+    Int nz            = G->p[n];
+
+    cs *G_matrix = cs_spalloc(n, n, (nz > 1 ? nz : 1), 1, 0);
+    if (!G_matrix)
+        mexErrMsgTxt("Out of memory");
+    for (Int k = 0; k <= n; k++)
+        G_matrix->p[k] = G->p[k];
+    for (Int k = 0; k < nz; k++)
+        G_matrix->i[k] = G->i[k];
+    for (Int k = 0; k < nz; k++)
+        G_matrix->x[k] = (G->x) ? G->x[k] : 1;
+    pargout[0] = cs_mex_put_sparse(&G_matrix);
+
+    if (nargout > 1)
+    {
+        pargout[1] = mxCreateDoubleMatrix(n, 1, mxREAL);
+        double *w  = mxGetPr(pargout[1]);
+        for (Int k = 0; k < n; k++)
+            w[k] = (G->w) ? (double)G->w[k] : 1;
+    }
+    if (nargout > 2)
+    {
+        /* Map from the previous level's vertices to the coarsest; the
+         * identity when nothing has been coarsened yet. */
+        EdgeCutProblem *fine = (G->parent) ? G->parent : G;
+        pargout[2] = gp_mex_put_int((G->parent) ? fine->matchmap : NULL,
+                                    fine->n, 1, 0);
+    }
+}
+
+void mexFunction
+(
+    int nargout,
+    mxArray *pargout [ ],
+    int nargin,
+    const mxArray *pargin [ ]
+)
+{
+    const char *usage =
+        "Usage: h = hierarchy('new', G, (A))\n"
+        "       nc = hierarchy('coarsen', h, (O))\n"
+        "       [G_coarse, A_coarse, map] = hierarchy('get', h)\n"
+        "       partition = hierarchy('edgecut', h, (O))\n"
+        "       hierarchy('free', h)";
+    char command[32];
+    if (nargin < 2 || !mxIsChar(pargin[0])
+        || mxGetString(pargin[0], command, sizeof(command)) != 0)
+    {
+        mexErrMsgTxt(usage);
+    }
+
+    if (strcmp(command, "new") == 0)
+    {
+        if (nargin > 3 || nargout > 1)
+            mexErrMsgTxt(usage);
+        HierarchyHandle *handle
+            = newHandle(pargin[1], (nargin == 3 ? pargin[2] : NULL));
+        pargout[0] = putHandle(handle);
+        return;
+    }
+
+    HierarchyHandle *handle = getHandle(pargin[1]);
+
+    if (strcmp(command, "coarsen") == 0)
+    {
+        if (nargin > 3 || nargout > 1)
+            mexErrMsgTxt(usage);
+        EdgeCut_Options *O = mex_get_options(nargin == 3 ? pargin[2] : NULL);
+        if (!O)
+            mexErrMsgTxt("Unable to get Options struct");
+
+        EdgeCutProblem *G = handle->coarsest;
+        G->initialize(O);
+        match(G, O);
+        EdgeCutProblem *G_coarse = coarsen(G, O);
+        O->~EdgeCut_Options();
+        if (!G_coarse)
+            mexErrMsgTxt("Unable to coarsen the graph");
+        handle->coarsest = G_coarse;
+
+        if (nargout == 1)
+            pargout[0] = mxCreateDoubleScalar((double)G_coarse->n);
+    }
+    else if (strcmp(command, "get") == 0)
+    {
+        if (nargin > 2 || nargout > 3)
+            mexErrMsgTxt(usage);
+        putCoarsest(handle, (nargout > 1 ? nargout : 1), pargout);
+    }
+    else if (strcmp(command, "edgecut") == 0)
+    {
+        if (nargin > 3 || nargout > 1)
+            mexErrMsgTxt(usage);
+        EdgeCut_Options *O = mex_get_options(nargin == 3 ? pargin[2] : NULL);
+        if (!O)
+            mexErrMsgTxt("Unable to get Options struct");
+
+        /* The solve consumes the hierarchy directly: coarsening resumes
+         * from the handle's coarsest level, and refinement walks the
+         * parent chain back to the finest graph, destroying the coarse
+         * levels as it goes. The handle stays live holding the finest
+         * graph (with the final partition on it), ready to coarsen again. */
+        EdgeCut *result = edge_cut(handle->coarsest, O);
+        O->~EdgeCut_Options();
+        handle->coarsest = handle->finest;
+        if (!result)
+            mexErrMsgTxt("Unable to compute the edge cut");
+
+        pargout[0] = gp_mex_put_logical(result->partition, result->n);
+        result->~EdgeCut();
+    }
+    else if (strcmp(command, "free") == 0)
+    {
+        if (nargin > 2 || nargout > 0)
+            mexErrMsgTxt(usage);
+        dropHandle(handle);
+    }
+    else
+    {
+        mexErrMsgTxt(usage);
+    }
+}
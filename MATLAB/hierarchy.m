@@ -0,0 +1,46 @@
+function varargout = hierarchy (varargin)                   %#ok
+%HIERARCHY iterate coarsening through a persistent hierarchy handle.
+%   hierarchy keeps the coarsening hierarchy inside the mex state, so
+%   driving the multilevel method from MATLAB does not re-cross the mex
+%   boundary with a full copy of the graph at every level. Like COARSEN,
+%   it assumes the matrix supplied to 'new' has a zero diagonal, is
+%   symmetric, and has all positive edge weights (see SANITIZE); the
+%   input is not checked.
+%
+%   h = hierarchy('new', G) copies the sparse adjacency matrix G into a
+%   new hierarchy and returns an opaque handle h. An optional vertex
+%   weight vector A can be given as a third argument. Handles persist
+%   until freed (or MATLAB exits) and must be released with 'free'.
+%
+%   nc = hierarchy('coarsen', h, O) extends the hierarchy by one
+%   coarsening level in place, using the option struct O (e.g. matching
+%   strategies) if given, and returns the coarsest vertex count nc.
+%   Nothing is marshaled back to MATLAB.
+%
+%   [G_coarse, A_coarse, map] = hierarchy('get', h) returns the current
+%   coarsest level: its adjacency matrix, its vertex weights, and the
+%   mapping from the previous level's vertices to its supervertices
+%   (the identity if nothing has been coarsened yet).
+%
+%   partition = hierarchy('edgecut', h, O) computes an edge cut that
+%   consumes the hierarchy directly: coarsening resumes from the current
+%   coarsest level and refinement runs back up to the original graph,
+%   whose partition is returned. Afterward h holds just the original
+%   graph again and can be re-coarsened.
+%
+%   hierarchy('free', h) releases the handle and everything it holds.
+%
+%   Example:
+%       Prob = ssget('DNVS/troll'); A = Prob.A;
+%       G = sanitize(A);
+%       h = hierarchy('new', G);
+%       while (hierarchy('coarsen', h) > 256)
+%       end
+%       part = hierarchy('edgecut', h);
+%       hierarchy('free', h);
+%
+%   See also COARSEN, EDGECUT, EDGECUT_OPTIONS.
+
+%   Copyright (c) 2018, N. Yeralan, S. Kolodziej, T. Davis, W. Hager
+
+error ('hierarchy mexFunction not found') ;
@@ -91,6 +91,7 @@ mongoose_mex_src = {
     'edgecut_options', ...
     'edgecut', ...
     'coarsen', ...
+    'hierarchy', ...
     'sanitize' } ;
 
 % Keep track of object files
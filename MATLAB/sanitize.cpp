@@ -28,6 +28,18 @@ void mexFunction
     cs *A = (cs *) SuiteSparse_malloc(1, sizeof(cs));
     A = cs_mex_get_sparse (A, 0, 1, A_matlab);
 
+    /* Already in sanitized form: hand back a shared-data duplicate of the
+     * input (copy-on-write in MATLAB) instead of rebuilding the matrix. */
+    if (matrixIsSanitized(A, makeBinary))
+    {
+        A->p = NULL;
+        A->i = NULL;
+        A->x = NULL;
+        cs_spfree(A);
+        pargout[0] = mxDuplicateArray(A_matlab);
+        return;
+    }
+
     cs *A_safe = sanitizeMatrix(A, false, makeBinary);
     A->p = NULL;
     A->i = NULL;
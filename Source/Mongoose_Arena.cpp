@@ -0,0 +1,117 @@
+/* ========================================================================== */
+/* === Source/Mongoose_Arena.cpp ============================================ */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+#include "Mongoose_Arena.hpp"
+#include "Mongoose_Debug.hpp"
+
+#include <cstring>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace Mongoose
+{
+
+/* Constructor & Destructor */
+Arena::Arena()
+{
+    blocks = NULL;
+}
+
+Arena *Arena::create()
+{
+    void *memoryLocation = SuiteSparse_malloc(1, sizeof(Arena));
+    if (!memoryLocation)
+        return NULL;
+
+    // Placement new
+    Arena *arena = new (memoryLocation) Arena();
+    return arena;
+}
+
+Arena::~Arena()
+{
+    while (blocks)
+    {
+        Block *next = blocks->next;
+        SuiteSparse_free(blocks);
+        blocks = next;
+    }
+    SuiteSparse_free(this);
+}
+
+void *Arena::allocate(size_t nitems, size_t itemSize)
+{
+    ASSERT(headerSize >= sizeof(Block));
+
+    /* Round up to a multiple of 16 to keep bump pointers aligned. */
+    size_t bytes = nitems * itemSize;
+    bytes        = (bytes + 15) & ~((size_t)15);
+
+    if (!blocks || blocks->used + bytes > blocks->capacity)
+    {
+        /* Head block is out of room: prepend a fresh one. */
+        size_t capacity = (bytes > minBlockSize) ? bytes : minBlockSize;
+        Block *block    = (Block *)SuiteSparse_malloc(1, headerSize + capacity);
+        if (!block)
+            return NULL;
+
+        adviseHugePages(block, headerSize + capacity);
+
+        block->next     = blocks;
+        block->capacity = capacity;
+        block->used     = 0;
+        blocks          = block;
+    }
+
+    char *result = reinterpret_cast<char *>(blocks) + headerSize + blocks->used;
+    blocks->used += bytes;
+    return result;
+}
+
+void *Arena::allocateZeroed(size_t nitems, size_t itemSize)
+{
+    void *result = allocate(nitems, itemSize);
+    if (result)
+    {
+        memset(result, 0, nitems * itemSize);
+    }
+    return result;
+}
+
+void adviseHugePages(void *ptr, size_t bytes)
+{
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    /* Two huge pages of payload; below that the madvise syscall costs
+     * more than the TLB entries it saves. */
+    const size_t threshold = ((size_t)1) << 22;
+    if (!ptr || bytes < threshold)
+        return;
+
+    /* madvise wants a page-aligned range; shrink to the pages wholly
+     * inside the allocation. */
+    size_t page  = (size_t)sysconf(_SC_PAGESIZE);
+    size_t start = ((size_t)ptr + page - 1) & ~(page - 1);
+    size_t end   = ((size_t)ptr + bytes) & ~(page - 1);
+    if (end > start)
+    {
+        madvise((void *)start, end - start, MADV_HUGEPAGE);
+    }
+#else
+    (void)ptr;
+    (void)bytes;
+#endif
+}
+
+} // end namespace Mongoose
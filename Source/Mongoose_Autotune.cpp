@@ -0,0 +1,305 @@
+/* ========================================================================== */
+/* === Source/Mongoose_Autotune.cpp ========================================= */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+#include "Mongoose_Autotune.hpp"
+#include "Mongoose_EdgeCut.hpp"
+#include "Mongoose_Internal.hpp"
+#include "Mongoose_Logger.hpp"
+#include "Mongoose_Random.hpp"
+
+#include <algorithm>
+#include <ctime>
+
+namespace Mongoose
+{
+
+/* Sample size for the tuning subgraph. Large enough that coarsening and
+ * refinement behave as they do on the full graph, small enough that the
+ * whole sweep costs a handful of full-size solves. */
+static const Int AUTOTUNE_SAMPLE = 4096;
+
+/* Candidates whose sample cut is within this relative slack of the best
+ * cut count as ties, and the fastest tie wins; this is what turns the
+ * sweep into quality-per-second rather than quality-at-any-price. */
+static const double AUTOTUNE_CUT_SLACK = 0.02;
+
+static inline double tuneTimestamp()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
+
+//-----------------------------------------------------------------------------
+// Extracts the induced subgraph of a BFS ball around a random start
+// vertex (restarting on exhausted components), so the sample keeps the
+// input's local structure instead of being a sprinkle of disconnected
+// vertices. Returns the whole graph's copy when it is already small.
+// NULL on allocation failure.
+//-----------------------------------------------------------------------------
+static Graph *sampleSubgraph(const Graph *G, Int target)
+{
+    Int n                = G->n;
+    const Int *Gp        = G->p;
+    const Int *Gi        = G->i;
+    const WeightType *Gx = G->x;
+    const WeightType *Gw = G->w;
+
+    Int nsub = std::min(n, target);
+
+    Int *queue   = (Int *)SuiteSparse_malloc(static_cast<size_t>(nsub),
+                                             sizeof(Int));
+    Int *localId = (Int *)SuiteSparse_malloc(static_cast<size_t>(n),
+                                             sizeof(Int));
+    if (!queue || !localId)
+    {
+        SuiteSparse_free(queue);
+        SuiteSparse_free(localId);
+        return NULL;
+    }
+    for (Int v = 0; v < n; v++)
+    {
+        localId[v] = -1;
+    }
+
+    /* BFS ball: collect nsub vertices, restarting from the scan cursor
+     * when a component is exhausted before the sample is full. */
+    Int head = 0, tail = 0, scan = 0;
+    Int start      = random() % n;
+    queue[tail]    = start;
+    localId[start] = tail++;
+    while (head < nsub)
+    {
+        if (head == tail)
+        {
+            while (localId[scan] >= 0)
+                scan++;
+            queue[tail]    = scan;
+            localId[scan]  = tail++;
+        }
+        Int v = queue[head++];
+        for (Int q = Gp[v]; q < Gp[v + 1] && tail < nsub; q++)
+        {
+            Int u = Gi[q];
+            if (localId[u] < 0)
+            {
+                queue[tail] = u;
+                localId[u]  = tail++;
+            }
+        }
+    }
+
+    /* Count the induced edges, then build the subgraph the same way the
+     * dissection tree extracts its sides. */
+    Int nzsub = 0;
+    for (Int j = 0; j < nsub; j++)
+    {
+        Int v = queue[j];
+        for (Int q = Gp[v]; q < Gp[v + 1]; q++)
+        {
+            if (localId[Gi[q]] >= 0)
+                nzsub++;
+        }
+    }
+
+    Graph *sub = Graph::create(nsub, nzsub);
+    if (sub && Gx)
+    {
+        sub->x = (WeightType *)SuiteSparse_malloc(
+            static_cast<size_t>(nzsub), sizeof(WeightType));
+    }
+    if (sub && Gw)
+    {
+        sub->w = (WeightType *)SuiteSparse_malloc(static_cast<size_t>(nsub),
+                                                  sizeof(WeightType));
+    }
+    if (!sub || (Gx && !sub->x) || (Gw && !sub->w))
+    {
+        SuiteSparse_free(queue);
+        SuiteSparse_free(localId);
+        if (sub)
+            sub->~Graph();
+        return NULL;
+    }
+
+    Int nz = 0;
+    for (Int j = 0; j < nsub; j++)
+    {
+        Int v = queue[j];
+        if (Gw)
+        {
+            sub->w[j] = Gw[v];
+        }
+        for (Int q = Gp[v]; q < Gp[v + 1]; q++)
+        {
+            Int u = localId[Gi[q]];
+            if (u < 0)
+                continue;
+            sub->i[nz] = u;
+            if (Gx)
+            {
+                sub->x[nz] = Gx[q];
+            }
+            nz++;
+        }
+        sub->p[j + 1] = nz;
+    }
+
+    SuiteSparse_free(queue);
+    SuiteSparse_free(localId);
+    return sub;
+}
+
+//-----------------------------------------------------------------------------
+// Solves the sample with one candidate tuning and reports its cut cost
+// and wall time. Returns false on solve failure (the candidate is then
+// skipped, not fatal to the sweep).
+//-----------------------------------------------------------------------------
+static bool evaluateCandidate(const Graph *sample,
+                              const EdgeCut_Options *candidate, double *cut,
+                              double *seconds)
+{
+    double t0      = tuneTimestamp();
+    EdgeCut *result = edge_cut(sample, candidate);
+    *seconds       = tuneTimestamp() - t0;
+    if (!result)
+        return false;
+    *cut = result->cut_cost;
+    result->~EdgeCut();
+    return true;
+}
+
+/* True if (cut, seconds) beats the incumbent under the
+ * quality-per-second rule: a clearly lower cut always wins, and within
+ * the slack the faster solve wins. */
+static bool beats(double cut, double seconds, double bestCut,
+                  double bestSeconds)
+{
+    if (cut < bestCut * (1 - AUTOTUNE_CUT_SLACK))
+        return true;
+    if (cut > bestCut * (1 + AUTOTUNE_CUT_SLACK))
+        return false;
+    return seconds < bestSeconds;
+}
+
+EdgeCut_Options *autotune(const Graph *graph, double time_budget)
+{
+    EdgeCut_Options *defaults = EdgeCut_Options::create();
+    if (!defaults)
+        return NULL;
+
+    EdgeCut_Options *result = autotune(graph, defaults, time_budget);
+
+    defaults->~EdgeCut_Options();
+    return result;
+}
+
+EdgeCut_Options *autotune(const Graph *graph, const EdgeCut_Options *options,
+                          double time_budget)
+{
+    if (!graph || !options)
+        return NULL;
+
+    double sweepStart = tuneTimestamp();
+    double deadline = (time_budget > 0) ? sweepStart + time_budget : 0;
+
+    setRandomSeed(options->random_seed);
+    Graph *sample = sampleSubgraph(graph, AUTOTUNE_SAMPLE);
+    if (!sample)
+        return NULL;
+
+    EdgeCut_Options *best = EdgeCut_Options::create();
+    if (!best)
+    {
+        sample->~Graph();
+        return NULL;
+    }
+    *best = *options;
+
+    /* Baseline: the starting options themselves, so the sweep always has
+     * an incumbent and a no-op budget still returns something sane. */
+    double bestCut, bestSeconds;
+    if (!evaluateCandidate(sample, best, &bestCut, &bestSeconds))
+    {
+        sample->~Graph();
+        best->~EdgeCut_Options();
+        return NULL;
+    }
+
+    /* Coordinate descent over the key knobs, one knob at a time, keeping
+     * the winner before moving to the next. The sweep order puts the
+     * knob with the largest typical effect first, so an exhausted budget
+     * still leaves the most valuable knob tuned. */
+    const MatchingStrategy strategies[] = { HEM, HEMSR, HEMSRdeg, Random };
+    const Int dances[]                  = { 1, 2, 4 };
+    const Int depths[]                  = { 10, 50, 100 };
+
+    /* Raw copy for the trial tunings: ~EdgeCut_Options frees `this`
+     * (the factory pattern), so the copy must never be destroyed as a
+     * C++ object -- in particular it cannot live on the stack. */
+    EdgeCut_Options *trial
+        = (EdgeCut_Options *)SuiteSparse_malloc(1, sizeof(EdgeCut_Options));
+    if (!trial)
+    {
+        sample->~Graph();
+        return best;
+    }
+
+    for (int knob = 0; knob < 3; knob++)
+    {
+        Int count = (knob == 0) ? 4 : 3;
+        for (Int c = 0; c < count; c++)
+        {
+            if (deadline > 0 && tuneTimestamp() >= deadline)
+            {
+                SuiteSparse_free(trial);
+                sample->~Graph();
+                return best;
+            }
+
+            *trial = *best;
+            switch (knob)
+            {
+            case 0:
+                trial->matching_strategy = strategies[c];
+                break;
+            case 1:
+                trial->num_dances = dances[c];
+                break;
+            default:
+                trial->FM_search_depth = depths[c];
+                break;
+            }
+
+            double cut, seconds;
+            if (!evaluateCandidate(sample, trial, &cut, &seconds))
+                continue;
+            if (beats(cut, seconds, bestCut, bestSeconds))
+            {
+                *best       = *trial;
+                bestCut     = cut;
+                bestSeconds = seconds;
+            }
+        }
+    }
+
+    LogInfo("Autotune: matching " << best->matching_strategy << ", dances "
+                                  << best->num_dances << ", FM depth "
+                                  << best->FM_search_depth << " (sample cut "
+                                  << bestCut << " in " << bestSeconds
+                                  << " sec)\n");
+
+    SuiteSparse_free(trial);
+    sample->~Graph();
+    return best;
+}
+
+} // end namespace Mongoose
@@ -11,6 +11,7 @@
 
 #include "Mongoose_BoundaryHeap.hpp"
 #include "Mongoose_CutCost.hpp"
+#include "Mongoose_ImproveFM.hpp"
 #include "Mongoose_Debug.hpp"
 #include "Mongoose_Internal.hpp"
 #include "Mongoose_Logger.hpp"
@@ -24,14 +25,9 @@ namespace Mongoose
 void bhLoad(EdgeCutProblem *graph, const EdgeCut_Options *options)
 {
     /* Load the boundary heaps. */
-    Int n               = graph->n;
-    Int *Gp             = graph->p;
-    Int *Gi             = graph->i;
-    double *Gx          = graph->x;
-    double *Gw          = graph->w;
-    bool *partition     = graph->partition;
-    double *gains       = graph->vertexGains;
-    Int *externalDegree = graph->externalDegree;
+    Int n            = graph->n;
+    WeightType *Gw   = graph->w;
+    FMVertexData *fm = graph->fmData;
 
     /* Keep track of the cut cost. */
     CutCost cost;
@@ -44,26 +40,40 @@ void bhLoad(EdgeCutProblem *graph, const EdgeCut_Options *options)
     /* Compute the gains & discover if the vertex is on the boundary. */
     for (Int k = 0; k < n; k++)
     {
-        bool kPartition = partition[k];
+        bool kPartition = graph->getPartition(k);
         cost.W[kPartition] += (Gw) ? Gw[k] : 1;
 
-        double gain = 0.0;
-        Int exD     = 0;
-        for (Int p = Gp[k]; p < Gp[k + 1]; p++)
+        double gain      = 0.0;
+        double cutWeight = 0.0;
+        Int exD          = 0;
+        calculateGainAndCut(graph, k, &gain, &cutWeight, &exD);
+        cost.cutCost += cutWeight;
+
+        fm[k].gain           = gain;
+        fm[k].externalDegree = exD;
+        if (exD > 0)
         {
-            double edgeWeight = (Gx) ? Gx[p] : 1;
-            bool onSameSide   = (kPartition == partition[Gi[p]]);
-            gain += (onSameSide ? -edgeWeight : edgeWeight);
-            if (!onSameSide)
-            {
-                exD++;
-                cost.cutCost += edgeWeight;
-            }
+            /* Append to the heap array; the bulk heapify below orders it. */
+            BHEntry *bhHeap = graph->bhHeap[kPartition];
+            Int size        = graph->bhSize[kPartition]++;
+
+            bhHeap[size].vertex = k;
+            bhHeap[size].gain   = gain;
+            graph->BH_putIndex(k, size);
+        }
+    }
+
+    /* Floyd bottom-up construction: with the full candidate set in place,
+     * one sift-down per internal node builds each heap in O(size) instead
+     * of the O(size log size) of repeated bhInsert sift-ups. */
+    for (Int h = 0; h < 2; h++)
+    {
+        BHEntry *bhHeap = graph->bhHeap[h];
+        Int size        = graph->bhSize[h];
+        for (Int p = graph->BH_getParent(size - 1); p >= 0; p--)
+        {
+            heapifyDown(graph, bhHeap, size, p);
         }
-        gains[k]          = gain;
-        externalDegree[k] = exD;
-        if (exD > 0)
-            bhInsert(graph, k);
     }
 
     /* Save the cut cost to the graph. */
@@ -88,15 +98,15 @@ void bhLoad(EdgeCutProblem *graph, const EdgeCut_Options *options)
 void bhInsert(EdgeCutProblem *graph, Int vertex)
 {
     /* Unpack structures */
-    Int vp        = graph->partition[vertex];
-    Int *bhHeap   = graph->bhHeap[vp];
-    Int size      = graph->bhSize[vp];
-    double *gains = graph->vertexGains;
+    Int vp          = graph->getPartition(vertex);
+    BHEntry *bhHeap = graph->bhHeap[vp];
+    Int size        = graph->bhSize[vp];
 
-    bhHeap[size] = vertex;
+    bhHeap[size].vertex = vertex;
+    bhHeap[size].gain   = graph->fmData[vertex].gain;
     graph->BH_putIndex(vertex, size);
 
-    heapifyUp(graph, bhHeap, gains, vertex, size, gains[vertex]);
+    heapifyUp(graph, bhHeap, size);
 
     /* Save the size. */
     graph->bhSize[vp] = size + 1;
@@ -113,93 +123,93 @@ void bhRemove(EdgeCutProblem *graph, const EdgeCut_Options *options, Int vertex,
     (void)options; // Unused variable
     (void)gain;    // Unused variable
 
-    double *gains = graph->vertexGains;
-    Int *bhIndex  = graph->bhIndex;
-    Int *bhHeap   = graph->bhHeap[partition];
-    Int size      = (--graph->bhSize[partition]);
+    FMVertexData *fm = graph->fmData;
+    BHEntry *bhHeap  = graph->bhHeap[partition];
+    Int size         = (--graph->bhSize[partition]);
 
     /* If we removed the last position in the heap, there's nothing to do. */
     if (bhPosition == size)
     {
-        bhIndex[vertex] = 0;
+        fm[vertex].bhIndex = 0;
         return;
     }
 
-    /* Replace the vertex with the last element in the heap. */
-    Int v = bhHeap[bhPosition] = bhHeap[size];
-    graph->BH_putIndex(v, bhPosition);
+    /* Replace the entry with the last element in the heap. */
+    bhHeap[bhPosition] = bhHeap[size];
+    graph->BH_putIndex(bhHeap[bhPosition].vertex, bhPosition);
 
     /* Finish the delete of "vertex" from the heap. */
-    bhIndex[vertex] = 0;
+    fm[vertex].bhIndex = 0;
 
-    /* Bubble up then bubble down with a reread of v because it may have
-     * changed during heapifyUp. */
-    heapifyUp(graph, bhHeap, gains, v, bhPosition, gains[v]);
-    v = bhHeap[bhPosition];
-    heapifyDown(graph, bhHeap, size, gains, v, bhPosition, gains[v]);
+    /* Bubble up, then bubble down whatever entry lands at the position. */
+    heapifyUp(graph, bhHeap, bhPosition);
+    heapifyDown(graph, bhHeap, size, bhPosition);
 }
 
 //-----------------------------------------------------------------------------
-// Starting at a position, this function will heapify from a vertex upwards
+// Starting at a position, this function will heapify the entry there upwards.
+// Comparisons read the gains packed into the heap entries, so a sift touches
+// only the contiguous heap array.
 //-----------------------------------------------------------------------------
-void heapifyUp(EdgeCutProblem *graph, Int *bhHeap, double *gains, Int vertex,
-               Int position, double gain)
+void heapifyUp(EdgeCutProblem *graph, BHEntry *bhHeap, Int position)
 {
     if (position == 0)
         return;
 
     Int posParent = graph->BH_getParent(position);
-    Int pVertex   = bhHeap[posParent];
-    double pGain  = gains[pVertex];
 
-    /* If we need to swap this vertex with the parent then: */
-    if (pGain < gain)
+    /* If we need to swap this entry with the parent then: */
+    if (bhHeap[posParent].gain < bhHeap[position].gain)
     {
-        bhHeap[posParent] = vertex;
-        bhHeap[position]  = pVertex;
-        graph->BH_putIndex(vertex, posParent);
-        graph->BH_putIndex(pVertex, position);
-        heapifyUp(graph, bhHeap, gains, vertex, posParent, gain);
+        MONGOOSE_COUNT(HeapSiftUpCounter);
+        BHEntry temp      = bhHeap[posParent];
+        bhHeap[posParent] = bhHeap[position];
+        bhHeap[position]  = temp;
+        graph->BH_putIndex(bhHeap[posParent].vertex, posParent);
+        graph->BH_putIndex(bhHeap[position].vertex, position);
+        heapifyUp(graph, bhHeap, posParent);
     }
 }
 
 //-----------------------------------------------------------------------------
-// Starting at a position, this function will heapify from a vertex downwards
+// Starting at a position, this function will heapify the entry there
+// downwards. The scan over the MONGOOSE_BH_ARITY children is a fixed-trip
+// max-reduction over consecutive entries, so wider arities trade sift depth
+// for comparisons the compiler can vectorize.
 //-----------------------------------------------------------------------------
-void heapifyDown(EdgeCutProblem *graph, Int *bhHeap, Int size, double *gains, Int vertex,
-                 Int position, double gain)
+void heapifyDown(EdgeCutProblem *graph, BHEntry *bhHeap, Int size, Int position)
 {
     if (position >= size)
         return;
 
-    Int lp = graph->BH_getLeftChild(position);
-    Int rp = graph->BH_getRightChild(position);
-
-    Int lv = (lp < size ? bhHeap[lp] : -1);
-    Int rv = (rp < size ? bhHeap[rp] : -1);
+    double gain = bhHeap[position].gain;
 
-    double lg = (lv >= 0 ? gains[lv] : -INFINITY);
-    double rg = (rv >= 0 ? gains[rv] : -INFINITY);
-
-    if (gain < lg || gain < rg)
+    /* Find the largest-gain child; later children win ties, which keeps
+     * the arity-2 results identical to the old left/right comparison. */
+    Int cp        = -1;
+    double cpGain = -INFINITY;
+    for (Int c = 0; c < MONGOOSE_BH_ARITY; c++)
     {
-        if (lg > rg)
-        {
-            bhHeap[position] = lv;
-            graph->BH_putIndex(lv, position);
-            bhHeap[lp] = vertex;
-            graph->BH_putIndex(vertex, lp);
-            heapifyDown(graph, bhHeap, size, gains, vertex, lp, gain);
-        }
-        else
+        Int childPosition = graph->BH_getChild(position, c);
+        if (childPosition >= size)
+            break;
+        if (bhHeap[childPosition].gain >= cpGain)
         {
-            bhHeap[position] = rv;
-            graph->BH_putIndex(rv, position);
-            bhHeap[rp] = vertex;
-            graph->BH_putIndex(vertex, rp);
-            heapifyDown(graph, bhHeap, size, gains, vertex, rp, gain);
+            cp     = childPosition;
+            cpGain = bhHeap[childPosition].gain;
         }
     }
+
+    if (cp != -1 && gain < cpGain)
+    {
+        MONGOOSE_COUNT(HeapSiftDownCounter);
+        BHEntry temp     = bhHeap[cp];
+        bhHeap[cp]       = bhHeap[position];
+        bhHeap[position] = temp;
+        graph->BH_putIndex(bhHeap[cp].vertex, cp);
+        graph->BH_putIndex(bhHeap[position].vertex, position);
+        heapifyDown(graph, bhHeap, size, cp);
+    }
 }
 
 } // end namespace Mongoose
@@ -16,11 +16,18 @@
  * structure and efficient fundamental matrix operations, such as adding,
  * transposing, and converting from triplet to CSC form.
  */
+#include "Mongoose_Arena.hpp"
 #include "Mongoose_CSparse.hpp"
+#include "Mongoose_ThreadPool.hpp"
 #include "Mongoose_Debug.hpp"
 #include "Mongoose_Internal.hpp"
 #include "Mongoose_Logger.hpp"
 
+#if CPP11_OR_LATER
+#include <algorithm>
+#include <vector>
+#endif
+
 namespace Mongoose
 {
 
@@ -51,7 +58,7 @@ cs *cs_done(cs *C, void *w, void *x, csi ok);
 cs *cs_transpose(const cs *A, csi values)
 {
     csi p, q, j, *Cp, *Ci, n, m, *Ap, *Ai, *w;
-    double *Cx, *Ax;
+    WeightType *Cx, *Ax;
     cs *C;
     ASSERT(A != NULL);
     ASSERT(CS_CSC(A));
@@ -107,7 +114,8 @@ cs *cs_transpose(const cs *A, csi values)
 cs *cs_add(const cs *A, const cs *B, double alpha, double beta)
 {
     csi p, j, nz = 0, anz, *Cp, *Ci, *Bp, m, n, bnz, *w, values;
-    double *x, *Bx, *Cx;
+    double *x; /* dense accumulator workspace, double in either build */
+    WeightType *Bx, *Cx;
     cs *C;
     ASSERT(A != NULL);
     ASSERT(CS_CSC(A));
@@ -146,11 +154,140 @@ cs *cs_add(const cs *A, const cs *B, double alpha, double beta)
     return (cs_done(C, w, x, 1)); /* success; release workspace, return C */
 }
 
+#if CPP11_OR_LATER
+
+/* Parallel triplet-to-CSC compression: a stable counting sort over the
+ * triplets, with a per-thread histogram pass, a serial prefix sum over the
+ * column totals (O(n), the only serial stretch), and a parallel scatter
+ * into disjoint output slots. Each thread owns a contiguous triplet range
+ * and its own row of column cursors, so the entry order within every
+ * column -- and therefore the result, duplicates included -- is
+ * bit-identical to the serial scatter in cs_compress. */
+
+static void cs_count_worker(const csi *Tj, csi lo, csi hi, csi *hist)
+{
+    for (csi k = lo; k < hi; k++)
+        hist[Tj[k]]++;
+}
+
+/* Sums the per-thread counts of each column in the chunk into Cp[j+1]. */
+static void cs_total_worker(csi col_lo, csi col_hi, csi nthreads, csi n,
+                            const csi *hist, csi *Cp)
+{
+    for (csi j = col_lo; j < col_hi; j++)
+    {
+        csi total = 0;
+        for (csi t = 0; t < nthreads; t++)
+            total += hist[t * n + j];
+        Cp[j + 1] = total;
+    }
+}
+
+/* Turns the per-thread counts of each column in the chunk into write
+ * cursors: thread t starts where threads 0..t-1 of the column end. */
+static void cs_offset_worker(csi col_lo, csi col_hi, csi nthreads, csi n,
+                             csi *hist, const csi *Cp)
+{
+    for (csi j = col_lo; j < col_hi; j++)
+    {
+        csi nz = Cp[j];
+        for (csi t = 0; t < nthreads; t++)
+        {
+            csi count = hist[t * n + j];
+            hist[t * n + j] = nz;
+            nz += count;
+        }
+    }
+}
+
+static void cs_scatter_worker(const csi *Ti, const csi *Tj,
+                              const WeightType *Tx, csi lo, csi hi,
+                              csi *cursor, csi *Ci, WeightType *Cx)
+{
+    for (csi k = lo; k < hi; k++)
+    {
+        csi p = cursor[Tj[k]]++;
+        Ci[p] = Ti[k];
+        if (Cx)
+            Cx[p] = Tx[k];
+    }
+}
+
+/* Attempts the parallel compression of T into the preallocated C. Returns
+ * false (leaving C untouched) when the triplet matrix is too small to
+ * benefit, the hardware is serial, or the histogram workspace cannot be
+ * allocated; the caller then runs the serial scatter. */
+static bool cs_compress_parallel(const cs *T, cs *C)
+{
+    csi n  = T->n;
+    csi nz = T->nz;
+
+    csi hw = (csi)ThreadPool::maxThreads();
+    if (hw < 2 || nz < (csi)(1 << 20) || n > nz)
+        return false;
+    csi nthreads = std::min(hw, (csi)16);
+
+    /* One histogram row per thread; bounded by 16*nz since n <= nz. */
+    csi *hist = (csi *)SuiteSparse_calloc(
+        static_cast<size_t>(nthreads) * static_cast<size_t>(n), sizeof(csi));
+    if (!hist)
+        return false;
+
+    const csi *Ti    = T->i;
+    const csi *Tj    = T->p;
+    const WeightType *Tx = T->x;
+    csi *Cp          = C->p;
+    csi *Ci          = C->i;
+    WeightType *Cx   = C->x;
+
+    csi chunk    = (nz + nthreads - 1) / nthreads;
+    csi colChunk = (n + nthreads - 1) / nthreads;
+
+    ThreadPool::run((Int)nthreads, [=](Int t) {
+        csi lo = t * chunk;
+        csi hi = std::min(lo + chunk, nz);
+        if (lo < hi)
+            cs_count_worker(Tj, lo, hi, hist + t * n);
+    });
+
+    ThreadPool::run((Int)nthreads, [=](Int t) {
+        csi lo = t * colChunk;
+        csi hi = std::min(lo + colChunk, n);
+        if (lo < hi)
+            cs_total_worker(lo, hi, nthreads, n, hist, Cp);
+    });
+
+    Cp[0] = 0;
+    for (csi j = 0; j < n; j++)
+        Cp[j + 1] += Cp[j];
+
+    ThreadPool::run((Int)nthreads, [=](Int t) {
+        csi lo = t * colChunk;
+        csi hi = std::min(lo + colChunk, n);
+        if (lo < hi)
+            cs_offset_worker(lo, hi, nthreads, n, hist, Cp);
+    });
+
+    ThreadPool::run((Int)nthreads, [=](Int t) {
+        csi lo = t * chunk;
+        csi hi = std::min(lo + chunk, nz);
+        if (lo < hi)
+            cs_scatter_worker(Ti, Tj, Tx, lo, hi, hist + t * n, Ci, Cx);
+    });
+
+    SuiteSparse_free(hist);
+    return true;
+}
+
+#endif
+
 /**
  * C = compressed-column form of a triplet matrix T
  *
  * Given a CSparse matrix @p T in triplet form, cs_compress returns
- * the same matrix in compressed sparse column (CSC) format.
+ * the same matrix in compressed sparse column (CSC) format. Large triplet
+ * matrices are compressed with a parallel stable counting sort when C++11
+ * threads are available; the result is identical to the serial scatter.
  *
  * A triplet form matrix is a simple listing of the nonzeros in the matrix and
  * their row, column coordinates. For example, the 2x2 identity matrix would be
@@ -165,7 +302,7 @@ cs *cs_add(const cs *A, const cs *B, double alpha, double beta)
 cs *cs_compress(const cs *T)
 {
     csi m, n, nz, k, *Cp, *Ci, *w, *Ti, *Tj;
-    double *Cx, *Tx;
+    WeightType *Cx, *Tx;
     cs *C;
     ASSERT(CS_TRIPLET(T));
     m  = T->m;
@@ -175,9 +312,15 @@ cs *cs_compress(const cs *T)
     Tx = T->x;
     nz = T->nz;
     C  = cs_spalloc(m, n, nz, Tx != NULL, 0); /* allocate result */
-    w  = (csi *)SuiteSparse_calloc(static_cast<size_t>(n),
+    if (!C)
+        return (cs_done(C, NULL, NULL, 0)); /* out of memory */
+#if CPP11_OR_LATER
+    if (cs_compress_parallel(T, C))
+        return C;
+#endif
+    w = (csi *)SuiteSparse_calloc(static_cast<size_t>(n),
                                   sizeof(csi)); /* get workspace */
-    if (!C || !w)
+    if (!w)
         return (cs_done(C, w, NULL, 0)); /* out of memory */
     Cp = C->p;
     Ci = C->i;
@@ -230,7 +373,7 @@ csi cs_scatter(const cs *A, csi j, double beta, csi *w, double *x, csi mark,
                cs *C, csi nz)
 {
     csi p, *Ap, *Ai, *Ci;
-    double *Ax;
+    WeightType *Ax;
     ASSERT(CS_CSC(A));
     ASSERT(CS_CSC(C));
     ASSERT(w != NULL);
@@ -271,10 +414,16 @@ cs *cs_spalloc(csi m, csi n, csi nzmax, csi values, csi triplet)
     A->p             = (csi *)SuiteSparse_malloc(
         static_cast<size_t>(triplet ? nzmax : n + 1), sizeof(csi));
     A->i = (csi *)SuiteSparse_malloc(static_cast<size_t>(nzmax), sizeof(csi));
-    A->x = values ? (double *)SuiteSparse_malloc(static_cast<size_t>(nzmax),
-                                                 sizeof(double))
-                  : NULL;
-    return ((!A->p || !A->i || (values && !A->x)) ? cs_spfree(A) : A);
+    A->x = values
+               ? (WeightType *)SuiteSparse_malloc(static_cast<size_t>(nzmax),
+                                                  sizeof(WeightType))
+               : NULL;
+    if (!A->p || !A->i || (values && !A->x))
+        return (cs_spfree(A));
+    adviseHugePages(A->i, static_cast<size_t>(nzmax) * sizeof(csi));
+    if (A->x)
+        adviseHugePages(A->x, static_cast<size_t>(nzmax) * sizeof(WeightType));
+    return (A);
 }
 
 /* release a sparse matrix */
@@ -19,13 +19,252 @@
  */
 
 #include "Mongoose_Coarsening.hpp"
+#include "Mongoose_ThreadPool.hpp"
 #include "Mongoose_Debug.hpp"
 #include "Mongoose_Internal.hpp"
 #include "Mongoose_Logger.hpp"
 
+#if CPP11_OR_LATER
+#include <algorithm>
+#include <vector>
+#endif
+
 namespace Mongoose
 {
 
+//-----------------------------------------------------------------------------
+// Scatters the coarse edges of coarse column k (whose fine vertices are in
+// v) into Ci/Cx, merging duplicate entries through the hashtable, and
+// returns the column's sum of edge weights. The compiler specializes the
+// body per the unitWeights flag: in the unit-weight case the per-edge
+// weight loads vanish and a merged coarse edge just counts its fine
+// multiplicity.
+//-----------------------------------------------------------------------------
+template <bool unitWeights>
+static inline double scatterCoarseColumn(const Int *Gp, const Int *Gi,
+                                         const WeightType *Gx,
+                                         const Int *matchmap, Int k,
+                                         const Int *v, Int ps, Int *htable,
+                                         Int *Ci, WeightType *Cx, Int *munch_io)
+{
+    double sumEdgeWeights = 0.0;
+    Int munch             = *munch_io;
+    for (Int i = 0; i < 3 && v[i] != -1; i++)
+    {
+        Int vertex = v[i];
+        for (Int p = Gp[vertex]; p < Gp[vertex + 1]; p++)
+        {
+            Int toCoarsened = matchmap[Gi[p]];
+            if (toCoarsened == k)
+                continue; /* Delete self-edges */
+
+            double edgeWeight = (unitWeights) ? 1.0 : Gx[p];
+            sumEdgeWeights += edgeWeight;
+
+            /* Check the hashtable before scattering. */
+            Int cp = htable[toCoarsened];
+            if (cp < ps) /* Hasn't been seen yet this column */
+            {
+                htable[toCoarsened] = munch;
+                Ci[munch]           = toCoarsened;
+                Cx[munch]           = edgeWeight;
+                munch++;
+            }
+            else
+            {
+                Cx[cp] += edgeWeight;
+            }
+        }
+    }
+    *munch_io = munch;
+    return sumEdgeWeights;
+}
+
+#if CPP11_OR_LATER
+
+//-----------------------------------------------------------------------------
+// Loads the (up to 3) fine vertices matched into coarse vertex k.
+//-----------------------------------------------------------------------------
+static inline void loadInverseMatching(EdgeCutProblem *graph, Int k, Int *v)
+{
+    v[0] = graph->invmatchmap[k];
+    v[1] = graph->getMatch(v[0]);
+    v[2] = -1;
+    if (v[0] == v[1])
+    {
+        v[1] = -1;
+    }
+    else
+    {
+        v[2] = graph->getMatch(v[1]);
+        if (v[0] == v[2])
+        {
+            v[2] = -1;
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Pass 1: count the deduplicated coarse degree of each coarse vertex in
+// [kBegin, kEnd) into Cp[k+1], and accumulate the coarse vertex weights.
+// htable is thread-private scratch of size cn, initialized to -1.
+//-----------------------------------------------------------------------------
+static void coarsenCountWorker(EdgeCutProblem *graph,
+                               EdgeCutProblem *coarseGraph, Int *htable,
+                               Int kBegin, Int kEnd)
+{
+    Int *Gp       = graph->p;
+    Int *Gi       = graph->i;
+    WeightType *Gw = graph->w;
+    Int *matchmap = graph->matchmap;
+    Int *Cp       = coarseGraph->p;
+    WeightType *Cw = coarseGraph->w;
+
+    Int counter = 0;
+    for (Int k = kBegin; k < kEnd; k++)
+    {
+        Int v[3];
+        loadInverseMatching(graph, k, v);
+
+        Int ps              = counter;
+        Int count           = 0;
+        double vertexWeight = 0.0;
+        for (Int i = 0; i < 3 && v[i] != -1; i++)
+        {
+            Int vertex = v[i];
+            vertexWeight += (Gw) ? Gw[vertex] : 1;
+
+            for (Int p = Gp[vertex]; p < Gp[vertex + 1]; p++)
+            {
+                Int toCoarsened = matchmap[Gi[p]];
+                if (toCoarsened == k)
+                    continue; /* Delete self-edges */
+
+                if (htable[toCoarsened] < ps)
+                {
+                    htable[toCoarsened] = counter;
+                    counter++;
+                    count++;
+                }
+            }
+        }
+
+        Cw[k]     = vertexWeight;
+        Cp[k + 1] = count;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Pass 2: scatter the coarse edges of columns [kBegin, kEnd) into Ci/Cx at
+// the final offsets computed by the prefix sum over Cp. Returns the partial
+// sum of edge weights for this range through *X.
+//-----------------------------------------------------------------------------
+static void coarsenScatterWorker(EdgeCutProblem *graph,
+                                 EdgeCutProblem *coarseGraph, Int *htable,
+                                 Int kBegin, Int kEnd, double *X)
+{
+    Int *Gp       = graph->p;
+    Int *Gi       = graph->i;
+    WeightType *Gx = graph->x;
+    Int *matchmap = graph->matchmap;
+    Int *Cp       = coarseGraph->p;
+    Int *Ci       = coarseGraph->i;
+    WeightType *Cx = coarseGraph->x;
+    FMVertexData *fm = coarseGraph->fmData;
+
+    double Xpartial = 0.0;
+    Int munch       = Cp[kBegin];
+    for (Int k = kBegin; k < kEnd; k++)
+    {
+        Int v[3];
+        loadInverseMatching(graph, k, v);
+
+        Int ps = munch;
+        double sumEdgeWeights
+            = (Gx) ? scatterCoarseColumn<false>(Gp, Gi, Gx, matchmap, k, v, ps,
+                                                htable, Ci, Cx, &munch)
+                   : scatterCoarseColumn<true>(Gp, Gi, Gx, matchmap, k, v, ps,
+                                               htable, Ci, Cx, &munch);
+
+        Xpartial += sumEdgeWeights;
+        fm[k].gain = -sumEdgeWeights;
+    }
+
+    ASSERT(munch == Cp[kEnd]);
+    *X = Xpartial;
+}
+
+//-----------------------------------------------------------------------------
+// Builds the coarse graph CSR in parallel: per-coarse-vertex edge counting,
+// a chunked prefix sum over Cp, and parallel scattering of the edge weights.
+// Each worker owns a private size-cn hashtable, so scratch memory scales
+// with the thread count. Returns false (leaving the coarse graph untouched)
+// if the scratch allocation fails, in which case the caller falls back to
+// the serial path.
+//-----------------------------------------------------------------------------
+static bool coarsen_parallel(EdgeCutProblem *graph,
+                             EdgeCutProblem *coarseGraph,
+                             const EdgeCut_Options *options)
+{
+    Int cn       = graph->cn;
+    Int *Cp      = coarseGraph->p;
+    Int nthreads = std::min(options->num_threads, cn);
+
+    /* One private hashtable per worker. */
+    Int *htables = (Int *)SuiteSparse_malloc(
+        static_cast<size_t>(nthreads * cn), sizeof(Int));
+    if (!htables)
+        return false;
+
+    Int chunk = (cn + nthreads - 1) / nthreads;
+
+    /* Pass 1: count deduplicated coarse degrees into Cp[k+1], one pool
+     * job per coarse-vertex range. */
+    ThreadPool::run(nthreads, [=](Int t) {
+        Int *htable = htables + t * cn;
+        for (Int i = 0; i < cn; i++)
+            htable[i] = -1;
+        Int kBegin = t * chunk;
+        Int kEnd   = std::min(kBegin + chunk, cn);
+        if (kBegin < kEnd)
+            coarsenCountWorker(graph, coarseGraph, htable, kBegin, kEnd);
+    });
+
+    /* Prefix sum over the counts to get the final column pointers. */
+    Cp[0] = 0;
+    for (Int k = 0; k < cn; k++)
+    {
+        Cp[k + 1] += Cp[k];
+    }
+    coarseGraph->nz = Cp[cn];
+
+    /* Pass 2: scatter edges and weights at the final offsets. */
+    std::vector<double> Xpartial(static_cast<size_t>(nthreads), 0.0);
+    double *XpartialData = Xpartial.data();
+    ThreadPool::run(nthreads, [=](Int t) {
+        Int *htable = htables + t * cn;
+        for (Int i = 0; i < cn; i++)
+            htable[i] = -1;
+        Int kBegin = t * chunk;
+        Int kEnd   = std::min(kBegin + chunk, cn);
+        if (kBegin < kEnd)
+            coarsenScatterWorker(graph, coarseGraph, htable, kBegin, kEnd,
+                                 &XpartialData[t]);
+    });
+
+    double X = 0.0;
+    for (Int t = 0; t < nthreads; t++)
+        X += Xpartial[t];
+
+    coarseGraph->X = X;
+    coarseGraph->H = 2.0 * X;
+
+    SuiteSparse_free(htables);
+    return true;
+}
+
+#endif
+
 /**
  * @brief Coarsen a Graph given a previously calculated matching
  *
@@ -57,8 +296,8 @@ EdgeCutProblem *coarsen(EdgeCutProblem *graph, const EdgeCut_Options *options)
     Int cn     = graph->cn;
     Int *Gp    = graph->p;
     Int *Gi    = graph->i;
-    double *Gx = graph->x;
-    double *Gw = graph->w;
+    WeightType *Gx = graph->x;
+    WeightType *Gw = graph->w;
 
     Int *matchmap    = graph->matchmap;
     Int *invmatchmap = graph->invmatchmap;
@@ -70,9 +309,9 @@ EdgeCutProblem *coarsen(EdgeCutProblem *graph, const EdgeCut_Options *options)
 
     Int *Cp       = coarseGraph->p;
     Int *Ci       = coarseGraph->i;
-    double *Cx    = coarseGraph->x;
-    double *Cw    = coarseGraph->w;
-    double *gains = coarseGraph->vertexGains;
+    WeightType *Cx = coarseGraph->x;
+    WeightType *Cw = coarseGraph->w;
+    FMVertexData *fm = coarseGraph->fmData;
     Int munch     = 0;
     double X      = 0.0;
 
@@ -80,6 +319,19 @@ EdgeCutProblem *coarsen(EdgeCutProblem *graph, const EdgeCut_Options *options)
     ASSERT(Cx != NULL);
     ASSERT(Cw != NULL);
 
+#if CPP11_OR_LATER
+    /* Build the coarse CSR with all cores if requested. Falls through to
+     * the serial path if the parallel scratch cannot be allocated. */
+    if (options->num_threads > 1 && cn > 1
+        && coarsen_parallel(graph, coarseGraph, options))
+    {
+        coarseGraph->worstCaseRatio = graph->worstCaseRatio;
+        graph->child                = coarseGraph;
+        Logger::toc(CoarseningTiming);
+        return coarseGraph;
+    }
+#endif
+
     /* Hashtable stores column pointer values. */
     Int *htable
         = (Int *)SuiteSparse_malloc(static_cast<size_t>(cn), sizeof(Int));
@@ -113,49 +365,26 @@ EdgeCutProblem *coarsen(EdgeCutProblem *graph, const EdgeCut_Options *options)
 
         Int ps = Cp[k] = munch; /* The munch start for this column */
 
-        double vertexWeight   = 0.0;
-        double sumEdgeWeights = 0.0;
+        /* Accumulate the coarse vertex weight. */
+        double vertexWeight = 0.0;
         for (Int i = 0; i < 3 && v[i] != -1; i++)
         {
-            /* Read the matched vertex and accumulate the vertex weight. */
-            Int vertex = v[i];
-            vertexWeight += (Gw) ? Gw[vertex] : 1;
-
-            for (Int p = Gp[vertex]; p < Gp[vertex + 1]; p++)
-            {
-                Int toCoarsened = matchmap[Gi[p]];
-                if (toCoarsened == k)
-                    continue; /* Delete self-edges */
-
-                /* Read the edge weight and accumulate the sum of edge weights.
-                 */
-                double edgeWeight = (Gx) ? Gx[p] : 1;
-                sumEdgeWeights += (Gx) ? Gx[p] : 1;
-
-                /* Check the hashtable before scattering. */
-                Int cp = htable[toCoarsened];
-                if (cp < ps) /* Hasn't been seen yet this column */
-                {
-                    htable[toCoarsened] = munch;
-                    Ci[munch]           = toCoarsened;
-                    Cx[munch]           = edgeWeight;
-                    munch++;
-                }
-                /* If the entry already exists & we have edge weights,
-                 * sum the edge weights here. */
-                else
-                {
-                    Cx[cp] += edgeWeight;
-                }
-            }
+            vertexWeight += (Gw) ? Gw[v[i]] : 1;
         }
 
+        /* Scatter the column's edges, merging duplicates. */
+        double sumEdgeWeights
+            = (Gx) ? scatterCoarseColumn<false>(Gp, Gi, Gx, matchmap, k, v, ps,
+                                                htable, Ci, Cx, &munch)
+                   : scatterCoarseColumn<true>(Gp, Gi, Gx, matchmap, k, v, ps,
+                                               htable, Ci, Cx, &munch);
+
         /* Save the vertex weight. */
         Cw[k] = vertexWeight;
 
         /* Save the sum of edge weights and initialize the gain for k. */
         X += sumEdgeWeights;
-        gains[k] = -sumEdgeWeights;
+        fm[k].gain = -sumEdgeWeights;
     }
 
     /* Set the last column pointer */
@@ -182,10 +411,115 @@ EdgeCutProblem *coarsen(EdgeCutProblem *graph, const EdgeCut_Options *options)
     ASSERT(W == coarseGraph->W);
 #endif
 
+    graph->child = coarseGraph;
+
     Logger::toc(CoarseningTiming);
 
     /* Return the coarse graph */
     return coarseGraph;
 }
 
+/**
+ * @brief Recompute a coarse graph's weights from its fine graph
+ *
+ * Numeric-only counterpart of coarsen() for reusing a retained hierarchy:
+ * the coarse graph's structure (p, i) and the matching are kept, and only
+ * the edge weights, vertex weights, weight sums, and initial gains are
+ * rebuilt from the fine graph's current x/w arrays. The fine edges scatter
+ * in the same deterministic order as in coarsen(), so the rebuilt columns
+ * land at the existing column offsets.
+ *
+ * @param graph Fine graph whose child (from a prior coarsen) is refreshed
+ * @return true on success, false if the hashtable cannot be allocated
+ */
+bool coarsen_numeric(EdgeCutProblem *graph)
+{
+    Logger::tic(CoarseningTiming);
+
+    EdgeCutProblem *coarseGraph = graph->child;
+    ASSERT(coarseGraph != NULL);
+
+    Int cn     = graph->cn;
+    Int *Gp    = graph->p;
+    Int *Gi    = graph->i;
+    WeightType *Gx = graph->x;
+    WeightType *Gw = graph->w;
+
+    Int *matchmap    = graph->matchmap;
+    Int *invmatchmap = graph->invmatchmap;
+
+#ifndef NDEBUG
+    Int *Cp       = coarseGraph->p; /* referenced only by the ASSERTs below */
+#endif
+    Int *Ci       = coarseGraph->i;
+    WeightType *Cx = coarseGraph->x;
+    WeightType *Cw = coarseGraph->w;
+    FMVertexData *fm = coarseGraph->fmData;
+    Int munch     = 0;
+    double X      = 0.0;
+
+    /* Hashtable stores column pointer values. */
+    Int *htable
+        = (Int *)SuiteSparse_malloc(static_cast<size_t>(cn), sizeof(Int));
+    if (!htable)
+    {
+        Logger::toc(CoarseningTiming);
+        return false;
+    }
+    for (Int i = 0; i < cn; i++)
+        htable[i] = -1;
+
+    for (Int k = 0; k < cn; k++)
+    {
+        /* Load up the inverse matching */
+        Int v[3] = { -1, -1, -1 };
+        v[0]     = invmatchmap[k];
+        v[1]     = graph->getMatch(v[0]);
+        if (v[0] == v[1])
+        {
+            v[1] = -1;
+        }
+        else
+        {
+            v[2] = graph->getMatch(v[1]);
+            if (v[0] == v[2])
+            {
+                v[2] = -1;
+            }
+        }
+
+        Int ps = munch;
+        ASSERT(Cp[k] == ps);
+
+        double vertexWeight = 0.0;
+        for (Int i = 0; i < 3 && v[i] != -1; i++)
+        {
+            vertexWeight += (Gw) ? Gw[v[i]] : 1;
+        }
+
+        double sumEdgeWeights
+            = (Gx) ? scatterCoarseColumn<false>(Gp, Gi, Gx, matchmap, k, v, ps,
+                                                htable, Ci, Cx, &munch)
+                   : scatterCoarseColumn<true>(Gp, Gi, Gx, matchmap, k, v, ps,
+                                               htable, Ci, Cx, &munch);
+
+        Cw[k] = vertexWeight;
+        X += sumEdgeWeights;
+        fm[k].gain = -sumEdgeWeights;
+    }
+
+    ASSERT(munch == Cp[cn]);
+
+    coarseGraph->X = X;
+    coarseGraph->H = 2.0 * X;
+    coarseGraph->W = graph->W;
+
+    coarseGraph->worstCaseRatio = graph->worstCaseRatio;
+
+    SuiteSparse_free(htable);
+
+    Logger::toc(CoarseningTiming);
+    return true;
+}
+
 } // end namespace Mongoose
@@ -22,7 +22,7 @@ void print(cs *G)
     ASSERT(G);
     Int *Gp    = G->p;
     Int *Gi    = G->i;
-    double *Gx = G->x;
+    WeightType *Gx = G->x;
     for (Int j = 0; j < G->n; j++)
     {
         for (int p = Gp[j]; p < Gp[j + 1]; p++)
@@ -38,7 +38,7 @@ void print(Graph *G)
     ASSERT(G);
     Int *Gp    = G->p;
     Int *Gi    = G->i;
-    double *Gx = G->x;
+    WeightType *Gx = G->x;
     for (Int j = 0; j < G->n; j++)
     {
         for (int p = Gp[j]; p < Gp[j + 1]; p++)
@@ -79,19 +79,19 @@ void QPcheckCom(EdgeCutProblem *G, const EdgeCut_Options *O, QPDelta *QP, bool c
     /* FreeSet_status [i] = +1, -1, or 0 if x_i = 1, 0, or 0 < x_i < 1*/
     //---
 
-    double *x = QP->x; /* current estimate of solution */
+    QPScalar *x = QP->x; /* current estimate of solution */
 
     /* problem specification */
     Int n      = G->n; /* problem dimension */
-    double *Ex = G->x; /* numerical values for edge weights */
+    WeightType *Ex = G->x; /* numerical values for edge weights */
     Int *Ei    = G->i; /* adjacent vertices for each vertex */
     Int *Ep    = G->p; /* points into Ex or Ei */
-    double *a  = G->w; /* a'x = b, lo <= b <= hi */
+    WeightType *a = G->w; /* a'x = b, lo <= b <= hi */
 
     double lo    = QP->lo;
     double hi    = QP->hi;
-    double *D    = QP->D;        /* diagonal of quadratic */
-    double *grad = QP->gradient; /* gradient at current x */
+    QPScalar *D  = QP->D;        /* diagonal of quadratic */
+    QPScalar *grad = QP->gradient; /* gradient at current x */
     double tol   = std::max(log10(O->gradproj_tolerance * G->worstCaseRatio),
                           O->gradproj_tolerance);
 
@@ -321,7 +321,7 @@ void QPcheckCom(EdgeCutProblem *G, const EdgeCut_Options *O, QPDelta *QP, bool c
 //------------------------------------------------------------------------------
 
 void FreeSet_dump(const char *where, Int n, Int *FreeSet_list, Int nFreeSet,
-                  Int *FreeSet_status, Int verbose, double *x)
+                  Int *FreeSet_status, Int verbose, QPScalar *x)
 {
     Int death = 0;
 
@@ -11,15 +11,25 @@
 
 #include "Mongoose_EdgeCut.hpp"
 #include "Mongoose_EdgeCutProblem.hpp"
+#include "Mongoose_BoundaryHeap.hpp"
 #include "Mongoose_Coarsening.hpp"
 #include "Mongoose_GuessCut.hpp"
+#include "Mongoose_ImproveFM.hpp"
 #include "Mongoose_Internal.hpp"
 #include "Mongoose_Logger.hpp"
 #include "Mongoose_Random.hpp"
 #include "Mongoose_Refinement.hpp"
+#include "Mongoose_Reorder.hpp"
+#include "Mongoose_ThreadPool.hpp"
 #include "Mongoose_Waterdance.hpp"
 
 #include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#if CPP11_OR_LATER
+#include <vector>
+#endif
 
 namespace Mongoose
 {
@@ -30,9 +40,18 @@ void cleanup(EdgeCutProblem *graph);
 EdgeCut::~EdgeCut()
 {
     SuiteSparse_free(partition);
+    SuiteSparse_free(level_stats);
     SuiteSparse_free(this);
 }
 
+/* Monotonic timestamp in seconds for the per-level statistics and the
+ * time-budget checks. Cheap enough to leave on: one call per phase per
+ * level. */
+static inline double levelTimestamp()
+{
+    return Logger::wallSeconds();
+}
+
 EdgeCut *edge_cut(const Graph *graph)
 {
     // use default options if not present
@@ -48,17 +67,98 @@ EdgeCut *edge_cut(const Graph *graph)
     return (result);
 }
 
-EdgeCut *edge_cut(const Graph *graph, const EdgeCut_Options *options)
+#if CPP11_OR_LATER
+
+/* Runs one ensemble member: an independent full multilevel cut over a
+ * shallow, read-only view of the shared graph. The member's heuristic
+ * cost is reported separately because the public EdgeCut does not carry
+ * it. */
+static void ensembleWorker(const Graph *graph,
+                           const EdgeCut_Options *memberOptions,
+                           EdgeCut **resultSlot, double *heuCostSlot)
 {
-    // Check inputs
-    if (!optionsAreValid(options))
-        return NULL;
+    EdgeCutProblem *problem = EdgeCutProblem::create(graph);
+    if (!problem)
+        return;
 
-    setRandomSeed(options->random_seed);
+    *resultSlot  = edge_cut(problem, memberOptions);
+    *heuCostSlot = problem->heuCost;
 
-    if (!graph)
+    problem->~EdgeCutProblem();
+}
+
+/* Best-of-N racing: N full multilevel cuts with seeds derived from
+ * options->random_seed run on the thread pool, every member sharing the
+ * loaded graph read-only (each gets its own shallow EdgeCutProblem), and
+ * the lowest-heuCost member wins. This replaces orchestrating N processes
+ * that each pay a graph load and sanitization. Members that fail (out of
+ * memory) are simply dropped; the ensemble fails only if every member
+ * does. */
+static EdgeCut *edge_cut_ensemble(const Graph *graph,
+                                  const EdgeCut_Options *options)
+{
+    Int members = options->ensemble_size;
+
+    /* Raw array for the per-member options: ~EdgeCut_Options frees `this`
+     * (the factory pattern), so these copies must never be destroyed as
+     * C++ objects. */
+    EdgeCut_Options *memberOptions = (EdgeCut_Options *)SuiteSparse_malloc(
+        static_cast<size_t>(members), sizeof(EdgeCut_Options));
+    if (!memberOptions)
         return NULL;
 
+    std::vector<EdgeCut *> results(static_cast<size_t>(members),
+                                   (EdgeCut *)NULL);
+    std::vector<double> heuCosts(static_cast<size_t>(members), 0.0);
+    EdgeCut **resultsData = results.data();
+    double *heuCostsData  = heuCosts.data();
+
+    for (Int t = 0; t < members; t++)
+    {
+        memberOptions[t]               = *options;
+        memberOptions[t].ensemble_size = 1;
+        memberOptions[t].random_seed   = options->random_seed + t;
+    }
+
+    ThreadPool::run(members, [=](Int t) {
+        ensembleWorker(graph, &memberOptions[t], &resultsData[t],
+                       &heuCostsData[t]);
+    });
+
+    Int best = -1;
+    for (Int t = 0; t < members; t++)
+    {
+        if (results[t] && (best < 0 || heuCosts[t] < heuCosts[best]))
+        {
+            best = t;
+        }
+    }
+    for (Int t = 0; t < members; t++)
+    {
+        if (t != best && results[t])
+        {
+            results[t]->~EdgeCut();
+        }
+    }
+
+    SuiteSparse_free(memberOptions);
+    return (best >= 0) ? results[best] : NULL;
+}
+
+#endif
+
+/* The solve itself, in whatever numbering `graph` carries; inputs were
+ * validated by the public wrapper. */
+static EdgeCut *edge_cut_given_order(const Graph *graph,
+                                     const EdgeCut_Options *options)
+{
+#if CPP11_OR_LATER
+    if (options->ensemble_size > 1)
+    {
+        return edge_cut_ensemble(graph, options);
+    }
+#endif
+
     // Create an EdgeCutProblem
     EdgeCutProblem *problem = EdgeCutProblem::create(graph);
 
@@ -72,7 +172,7 @@ EdgeCut *edge_cut(const Graph *graph, const EdgeCut_Options *options)
     return result;
 }
 
-EdgeCut *edge_cut(EdgeCutProblem *problem, const EdgeCut_Options *options)
+EdgeCut *edge_cut(const Graph *graph, const EdgeCut_Options *options)
 {
     // Check inputs
     if (!optionsAreValid(options))
@@ -80,81 +180,679 @@ EdgeCut *edge_cut(EdgeCutProblem *problem, const EdgeCut_Options *options)
 
     setRandomSeed(options->random_seed);
 
-    if (!problem)
+    if (!graph)
         return NULL;
 
-    /* Finish initialization */
-    problem->initialize(options);
+    if (options->use_vertex_reordering)
+    {
+        /* Solve on an RCM-relabeled copy, then map the partition back to
+         * the caller's numbering. Reordering is an optimization, so a
+         * failed copy (out of memory) falls through to the plain solve. */
+        Int *perm      = NULL;
+        Graph *ordered = reorderGraph(graph, &perm);
+        if (ordered)
+        {
+            EdgeCut *result = edge_cut_given_order(ordered, options);
+            if (result)
+            {
+                bool *original = (bool *)SuiteSparse_malloc(
+                    static_cast<size_t>(result->n), sizeof(bool));
+                if (!original)
+                {
+                    result->~EdgeCut();
+                    result = NULL;
+                }
+                else
+                {
+                    for (Int k = 0; k < result->n; k++)
+                    {
+                        original[perm[k]] = result->partition[k];
+                    }
+                    SuiteSparse_free(result->partition);
+                    result->partition = original;
+                }
+            }
+            ordered->~Graph();
+            SuiteSparse_free(perm);
+            return result;
+        }
+    }
+
+    return edge_cut_given_order(graph, options);
+}
+
+#if CPP11_OR_LATER
+
+std::future<EdgeCut *> edge_cut_async(const Graph *graph,
+                                      const EdgeCut_Options *options)
+{
+    auto promise = std::make_shared<std::promise<EdgeCut *>>();
+    std::future<EdgeCut *> result = promise->get_future();
+
+    /* The job gets its own raw copy of the options: the caller may change
+     * or destroy theirs as soon as this returns. (~EdgeCut_Options frees
+     * `this`, so the copy is freed, never destroyed as a C++ object.) */
+    EdgeCut_Options *jobOptions = NULL;
+    if (options)
+    {
+        jobOptions = (EdgeCut_Options *)SuiteSparse_malloc(
+            1, sizeof(EdgeCut_Options));
+        if (!jobOptions)
+        {
+            promise->set_value(NULL);
+            return result;
+        }
+        *jobOptions = *options;
+    }
+
+    ThreadPool::submit([graph, jobOptions, promise]() {
+        EdgeCut *cut
+            = jobOptions ? edge_cut(graph, jobOptions) : edge_cut(graph);
+        SuiteSparse_free(jobOptions);
+        promise->set_value(cut);
+    });
+
+    return result;
+}
+
+#endif
+
+/* A coarsening level whose vertex count shrinks by less than this factor
+ * counts as stalled: matching left most vertices unpaired, so the level
+ * multiplies total work instead of halving it. A stall escalates the
+ * matching (community matching plus the degree-based brotherly pass) and
+ * a second stall accepts the level as coarsest, so the hierarchy's total
+ * size stays geometric in the finest level. */
+static const double COARSEN_STALL_SHRINK = 0.9;
+
+/* Unwinds a partially built hierarchy after a failure. */
+static void unwindHierarchy(EdgeCutProblem *problem, EdgeCutProblem *current)
+{
+    while (current != problem)
+    {
+        EdgeCutProblem *next = current->parent;
+        next->child          = NULL;
+        current->~EdgeCutProblem();
+        current = next;
+    }
+}
+
+/* Invokes the user's progress callback for one level boundary. A NULL
+ * callback costs just this branch, once per level. */
+static inline void reportProgress(const EdgeCut_Options *options,
+                                  const EdgeCutProblem *level,
+                                  double solveStart)
+{
+    if (options->progress_callback)
+    {
+        options->progress_callback(level->clevel, level->n, level->heuCost,
+                                   levelTimestamp() - solveStart,
+                                   options->progress_context);
+    }
+}
+
+/* Copies one level's statistics into its slot of the stats array. stats
+ * may be NULL (the allocation failed); the solve then proceeds
+ * uninstrumented. */
+static void recordLevelStats(EdgeCut_LevelStats *stats,
+                             const EdgeCutProblem *level)
+{
+    if (!stats)
+        return;
+    EdgeCut_LevelStats *entry = &stats[level->clevel];
+    entry->level        = level->clevel;
+    entry->n            = level->n;
+    entry->nz           = level->nz;
+    entry->shrink       = level->parent
+                              ? (double)level->n / (double)level->parent->n
+                              : 1.0;
+    entry->match_time   = level->matchTime;
+    entry->coarsen_time = level->coarsenTime;
+    entry->refine_time  = level->refineTime;
+    entry->cut_cost     = level->cutCost;
+}
+
+/* Refines the cut from the coarsest level back up to the finest,
+ * recording per-level statistics along the way (stats may be NULL).
+ * Returns the refined finest level, or NULL on out of memory. Shared by
+ * the full, numeric-only, and caller-buffer solves. */
+static EdgeCutProblem *refineToTop(EdgeCutProblem *problem,
+                                   EdgeCutProblem *current,
+                                   const EdgeCut_Options *options,
+                                   bool keep_hierarchy, double solveStart,
+                                   bool *io_truncated,
+                                   EdgeCut_LevelStats *stats)
+{
+    double deadline = problem->deadline;
+    recordLevelStats(stats, current);
+
+    /*
+     * Refine the guess cut back to the beginning.
+     */
+    while (current->parent != NULL)
+    {
+        EdgeCutProblem *coarse = current;
+        double tRefine         = levelTimestamp();
+
+        /* A level that shed its weights under the memory budget gets
+         * them back before refinement lands on it: one numeric
+         * coarsening pass from its (intact) parent. */
+        EdgeCutProblem *fine = current->parent;
+        if (fine->numericDropped)
+        {
+            if (!fine->restoreNumeric() || !coarsen_numeric(fine->parent))
+            {
+                return NULL;
+            }
+        }
 
+        current = refine(current, options);
+
+        /* Past the time budget, the projection from refine is kept as-is
+         * and the improvement dances are skipped for the remaining
+         * levels; the solve still finishes with a valid partition. */
+        if (deadline > 0 && levelTimestamp() >= deadline)
+        {
+            *io_truncated = true;
+        }
+        else
+        {
+            waterdance(current, options);
+        }
+        current->refineTime += levelTimestamp() - tRefine;
+        recordLevelStats(stats, current);
+        reportProgress(options, current, solveStart);
+
+        if (!keep_hierarchy)
+        {
+            current->child = NULL;
+            coarse->~EdgeCutProblem();
+        }
+    }
+
+    cleanup(current);
+
+    /* cleanup recomputes the finest level's cut metrics from the final
+     * partition, so re-record level 0 with the settled cut cost. */
+    recordLevelStats(stats, current);
+
+    return current;
+}
+
+/* Refines the cut back to the finest level and packages the result.
+ * Shared by the full and numeric-only solves. */
+static EdgeCut *refineAndFinish(EdgeCutProblem *problem,
+                                EdgeCutProblem *current,
+                                const EdgeCut_Options *options,
+                                bool keep_hierarchy, double solveStart,
+                                bool truncated)
+{
+    /* The per-level statistics are gathered while refining back up,
+     * before each coarse level is destroyed. */
+    Int num_levels            = current->clevel + 1;
+    EdgeCut_LevelStats *stats = (EdgeCut_LevelStats *)SuiteSparse_calloc(
+        static_cast<size_t>(num_levels), sizeof(EdgeCut_LevelStats));
+
+    current = refineToTop(problem, current, options, keep_hierarchy,
+                          solveStart, &truncated, stats);
+    if (!current)
+    {
+        SuiteSparse_free(stats);
+        return NULL;
+    }
+
+    EdgeCut *result = (EdgeCut*)SuiteSparse_malloc(1, sizeof(EdgeCut));
+
+    if (!result)
+    {
+        SuiteSparse_free(stats);
+        return NULL;
+    }
+
+    /* The result gets its own copy of the partition, widened from the
+     * problem's bit-packed words to the public one-bool-per-vertex array:
+     * the problem's words live inside its coalesced per-vertex block (and
+     * are still needed for a numeric re-solve when the hierarchy is kept),
+     * so they can never be handed to the EdgeCut destructor. */
+    size_t n          = static_cast<size_t>(current->n);
+    result->partition = (bool *)SuiteSparse_malloc(n, sizeof(bool));
+    if (!result->partition)
+    {
+        SuiteSparse_free(stats);
+        SuiteSparse_free(result);
+        return NULL;
+    }
+    for (Int k = 0; k < current->n; k++)
+    {
+        result->partition[k] = current->getPartition(k);
+    }
+    result->n         = current->n;
+    result->cut_cost  = current->cutCost;
+    result->cut_size  = current->cutSize;
+    result->w0               = current->W0;
+    result->w1               = current->W1;
+    result->imbalance        = current->imbalance;
+    result->level_stats      = stats;
+    result->num_levels       = stats ? num_levels : 0;
+    result->budget_truncated = truncated;
+
+    return result;
+}
+
+EdgeCut *edge_cut(EdgeCutProblem *problem, const EdgeCut_Options *options)
+{
+    return edge_cut(problem, options, false);
+}
+
+/* Runs the coarsening loop down from problem and the coarsest-level
+ * guess cut. Returns the coarsest level ready for refinement, or NULL on
+ * out of memory (the hierarchy is then already unwound). io_truncated is
+ * set when the time budget expires during coarsening. */
+static EdgeCutProblem *coarsenAndGuess(EdgeCutProblem *problem,
+                                       const EdgeCut_Options *options,
+                                       double solveStart, bool *io_truncated)
+{
     /* Keep track of what the current graph is at any stage */
     EdgeCutProblem *current = problem;
 
+    /* Shrink-rate monitoring. On the first stalled level the matching is
+     * escalated through a heap copy of the options (~EdgeCut_Options
+     * frees `this`, so the copy must never be destroyed as a C++
+     * object); on a stall after that the loop stops coarsening and the
+     * stalled level becomes the coarsest. */
+    const EdgeCut_Options *levelOptions = options;
+    EdgeCut_Options *escalated          = NULL;
+
     /* If we need to coarsen the graph, do the coarsening. */
     while (current->n >= options->coarsen_limit)
     {
-        match(current, options);
-        EdgeCutProblem *next = coarsen(current, options);
+        /* Past the time budget, stop coarsening and guess-cut right here;
+         * the levels built so far still refine back up (projection only). */
+        if (problem->deadline > 0 && levelTimestamp() >= problem->deadline)
+        {
+            *io_truncated = true;
+            break;
+        }
+
+        double t = levelTimestamp();
+        match(current, levelOptions);
+        current->matchTime += levelTimestamp() - t;
+
+        t                    = levelTimestamp();
+        EdgeCutProblem *next = coarsen(current, levelOptions);
+        current->coarsenTime += levelTimestamp() - t;
 
         /* If we ran out of memory during coarsening, unwind the stack. */
         if (!next)
         {
-            while (current != problem)
+            SuiteSparse_free(escalated);
+            unwindHierarchy(problem, current);
+            return NULL;
+        }
+
+        current           = next;
+        current->deadline = problem->deadline;
+
+        if ((double)current->n
+            > COARSEN_STALL_SHRINK * (double)current->parent->n)
+        {
+            if (levelOptions != options)
             {
-                next = current->parent;
-                current->~EdgeCutProblem();
-                current = next;
+                /* Already escalated and still stalling: accept this
+                 * level as the coarsest rather than piling up levels
+                 * that barely shrink. */
+                break;
+            }
+            escalated = (EdgeCut_Options *)SuiteSparse_malloc(
+                1, sizeof(EdgeCut_Options));
+            if (escalated)
+            {
+                *escalated                        = *options;
+                escalated->matching_strategy      = HEMSRdeg;
+                escalated->do_community_matching  = true;
+                levelOptions                      = escalated;
+            }
+            else
+            {
+                /* Out of memory for the copy: treat it as the second
+                 * stall and stop coarsening here. */
+                break;
             }
-            return NULL;
         }
 
-        current = next;
+        /* Memory budget: once the hierarchy's running footprint passes
+         * the cap, the level just descended from sheds its weight
+         * arrays; refineAndFinish recomputes them from the level above
+         * when refinement returns. Two adjacent levels never both shed,
+         * so each recompute is a single coarsen_numeric pass. */
+        EdgeCutProblem *shed = current->parent;
+        if (problem->memoryBudgetBytes > 0 && shed != problem
+            && !shed->parent->numericDropped
+            && problem->hierarchyBytes > problem->memoryBudgetBytes)
+        {
+            shed->dropNumeric();
+        }
+
+        reportProgress(options, current, solveStart);
     }
 
     /*
      * Generate a guess cut and do FM refinement.
      * On failure, unwind the stack.
      */
+    SuiteSparse_free(escalated);
+
+    double tGuess = levelTimestamp();
     if (!guessCut(current, options))
     {
-        while (current != problem)
+        unwindHierarchy(problem, current);
+        return NULL;
+    }
+    /* The guess cut's refinement passes count as the coarsest level's
+     * refinement time. */
+    current->refineTime += levelTimestamp() - tGuess;
+    reportProgress(options, current, solveStart);
+
+    return current;
+}
+
+EdgeCut *edge_cut(EdgeCutProblem *problem, const EdgeCut_Options *options,
+                  bool keep_hierarchy)
+{
+    // Check inputs
+    if (!optionsAreValid(options))
+        return NULL;
+
+    setRandomSeed(options->random_seed);
+
+    if (!problem)
+        return NULL;
+
+    /* Finish initialization */
+    problem->initialize(options);
+
+    double solveStart = levelTimestamp();
+    problem->deadline
+        = (options->time_limit > 0) ? solveStart + options->time_limit : 0;
+    bool truncated = false;
+
+    EdgeCutProblem *current
+        = coarsenAndGuess(problem, options, solveStart, &truncated);
+    if (!current)
+        return NULL;
+
+    return refineAndFinish(problem, current, options, keep_hierarchy,
+                           solveStart, truncated);
+}
+
+/* Caller-buffer solve in whatever numbering `graph` carries. When `perm`
+ * is non-NULL the graph is a relabeled copy and each vertex's side is
+ * written to the caller's buffer at its original index perm[k]; the cut
+ * metrics are numbering-independent and copy through unchanged. */
+static bool edge_cut_into_buffer(const Graph *graph,
+                                 const EdgeCut_Options *options,
+                                 bool *partition, EdgeCut_Result *result,
+                                 const Int *perm)
+{
+#if CPP11_OR_LATER
+    if (options->ensemble_size > 1)
+    {
+        /* The ensemble members keep their results on the heap regardless;
+         * copy the winner out rather than duplicating the racing driver. */
+        EdgeCut *won = edge_cut_ensemble(graph, options);
+        if (!won)
+            return false;
+        for (Int k = 0; k < won->n; k++)
         {
-            EdgeCutProblem *next = current->parent;
-            current->~EdgeCutProblem();
-            current = next;
+            partition[perm ? perm[k] : k] = won->partition[k];
         }
-        return NULL;
+        result->n                = won->n;
+        result->cut_cost         = won->cut_cost;
+        result->cut_size         = won->cut_size;
+        result->w0               = won->w0;
+        result->w1               = won->w1;
+        result->imbalance        = won->imbalance;
+        result->budget_truncated = won->budget_truncated;
+        won->~EdgeCut();
+        return true;
     }
+#endif
 
-    /*
-     * Refine the guess cut back to the beginning.
-     */
-    while (current->parent != NULL)
+    EdgeCutProblem *problem = EdgeCutProblem::create(graph);
+    if (!problem)
+        return false;
+
+    problem->initialize(options);
+
+    double solveStart = levelTimestamp();
+    problem->deadline
+        = (options->time_limit > 0) ? solveStart + options->time_limit : 0;
+    bool truncated = false;
+
+    EdgeCutProblem *current
+        = coarsenAndGuess(problem, options, solveStart, &truncated);
+    if (current)
     {
-        current = refine(current, options);
-        waterdance(current, options);
+        current = refineToTop(problem, current, options, false, solveStart,
+                              &truncated, NULL);
+    }
+    if (!current)
+    {
+        problem->~EdgeCutProblem();
+        return false;
     }
 
-    cleanup(current);
+    /* Widen the bit-packed partition straight into the caller's buffer. */
+    for (Int k = 0; k < current->n; k++)
+    {
+        partition[perm ? perm[k] : k] = current->getPartition(k);
+    }
+    result->n                = current->n;
+    result->cut_cost         = current->cutCost;
+    result->cut_size         = current->cutSize;
+    result->w0               = current->W0;
+    result->w1               = current->W1;
+    result->imbalance        = current->imbalance;
+    result->budget_truncated = truncated;
 
-    EdgeCut *result = (EdgeCut*)SuiteSparse_malloc(1, sizeof(EdgeCut));
+    problem->~EdgeCutProblem();
+    return true;
+}
 
-    if (!result)
+bool edge_cut(const Graph *graph, const EdgeCut_Options *options,
+              bool *partition, EdgeCut_Result *result)
+{
+    // Check inputs
+    if (!optionsAreValid(options))
+        return false;
+
+    setRandomSeed(options->random_seed);
+
+    if (!graph || !partition || !result)
+        return false;
+
+    if (options->use_vertex_reordering)
     {
+        /* Solve on an RCM-relabeled copy; the write indirection puts each
+         * vertex's side at its original index, so no second pass over the
+         * caller's buffer is needed. A failed copy (out of memory) falls
+         * through to the plain solve. */
+        Int *perm      = NULL;
+        Graph *ordered = reorderGraph(graph, &perm);
+        if (ordered)
+        {
+            bool ok
+                = edge_cut_into_buffer(ordered, options, partition, result,
+                                       perm);
+            ordered->~Graph();
+            SuiteSparse_free(perm);
+            return ok;
+        }
+    }
+
+    return edge_cut_into_buffer(graph, options, partition, result, NULL);
+}
+
+EdgeCut *edge_cut_refresh(const Graph *graph, const EdgeCut *previous,
+                          const EdgeCut_Delta *deltas, Int ndeltas,
+                          const EdgeCut_Options *options)
+{
+    // Check inputs
+    if (!optionsAreValid(options))
+        return NULL;
+
+    setRandomSeed(options->random_seed);
+
+    if (!graph || !previous || ndeltas < 0 || (ndeltas > 0 && !deltas))
+        return NULL;
+
+    if (previous->n != graph->n)
+    {
+        LogError("Fatal Error: edge_cut_refresh requires a previous result "
+                 "for the same vertex set.");
         return NULL;
     }
 
-    result->partition = current->partition;
-    current->partition = NULL; // Unlink pointer
-    result->n         = current->n;
-    result->cut_cost  = current->cutCost;
-    result->cut_size  = current->cutSize;
-    result->w0        = current->W0;
-    result->w1        = current->W1;
-    result->imbalance = current->imbalance;
+    EdgeCutProblem *problem = EdgeCutProblem::create(graph);
+    if (!problem)
+        return NULL;
+
+    problem->initialize(options);
+
+    double solveStart = levelTimestamp();
+    problem->deadline
+        = (options->time_limit > 0) ? solveStart + options->time_limit : 0;
+
+    /* Keep the previous partition. */
+    for (Int k = 0; k < problem->n; k++)
+    {
+        problem->setPartition(k, previous->partition[k]);
+    }
+
+    /* One sweep re-derives the gains, external degrees, and cut metrics
+     * against the updated topology. The heaps it loads hold the whole
+     * boundary, so empty them and re-seed with just the perturbed
+     * neighborhood: the delta endpoints and their neighbors. The FM that
+     * follows then works around the perturbation (growing the region
+     * organically as moves create new boundary) instead of sweeping the
+     * entire cut. */
+    bhLoad(problem, options);
+
+    for (Int h = 0; h < 2; h++)
+    {
+        BHEntry *bhHeap = problem->bhHeap[h];
+        for (Int e = 0; e < problem->bhSize[h]; e++)
+        {
+            problem->fmData[bhHeap[e].vertex].bhIndex = 0;
+        }
+        problem->bhSize[h] = 0;
+    }
+
+    const Int *Gp = problem->p;
+    const Int *Gi = problem->i;
+    for (Int d = 0; d < ndeltas; d++)
+    {
+        Int endpoint[2] = { deltas[d].u, deltas[d].v };
+        for (int e = 0; e < 2; e++)
+        {
+            Int v = endpoint[e];
+            if (v < 0 || v >= problem->n)
+                continue;
+            if (problem->fmData[v].externalDegree > 0
+                && !problem->BH_inBoundary(v))
+            {
+                bhInsert(problem, v);
+            }
+            for (Int q = Gp[v]; q < Gp[v + 1]; q++)
+            {
+                Int u = Gi[q];
+                if (problem->fmData[u].externalDegree > 0
+                    && !problem->BH_inBoundary(u))
+                {
+                    bhInsert(problem, u);
+                }
+            }
+        }
+    }
+
+    improveCutUsingFM(problem, options);
+
+    EdgeCut *result
+        = refineAndFinish(problem, problem, options, false, solveStart, false);
+
+    problem->~EdgeCutProblem();
 
     return result;
 }
 
+EdgeCut *edge_cut_numeric(EdgeCutProblem *problem,
+                          const EdgeCut_Options *options)
+{
+    // Check inputs
+    if (!optionsAreValid(options))
+        return NULL;
+
+    setRandomSeed(options->random_seed);
+
+    if (!problem)
+        return NULL;
+
+    if (!problem->isInitialized())
+    {
+        LogError("Fatal Error: edge_cut_numeric requires a prior "
+                 "edge_cut(problem, options, true) call.");
+        return NULL;
+    }
+
+    double solveStart = levelTimestamp();
+    problem->deadline
+        = (options->time_limit > 0) ? solveStart + options->time_limit : 0;
+
+    /* Refresh the finest level's weight sums and gains, and re-derive each
+     * coarse level's weights from its (unchanged) matching and structure. */
+    problem->resetCutState();
+    problem->refreshNumeric();
+
+    EdgeCutProblem *current = problem;
+    while (current->child != NULL)
+    {
+        if (!coarsen_numeric(current))
+            return NULL;
+        current = current->child;
+        current->resetCutState();
+        current->deadline = problem->deadline;
+        reportProgress(options, current, solveStart);
+    }
+
+    /*
+     * Warm start from the previous solve instead of a fresh guess cut:
+     * the finest partition survives resetCutState, so project it down the
+     * retained hierarchy (a coarse vertex takes its representative fine
+     * vertex's side) and rerun only the waterdance refinement from it.
+     * The hierarchy is never unwound here; it stays usable for further
+     * re-solves.
+     */
+    for (EdgeCutProblem *fine = problem; fine->child != NULL;
+         fine = fine->child)
+    {
+        EdgeCutProblem *coarse = fine->child;
+        for (Int cv = 0; cv < coarse->n; cv++)
+        {
+            coarse->setPartition(cv,
+                                 fine->getPartition(fine->invmatchmap[cv]));
+        }
+    }
+
+    double tGuess = levelTimestamp();
+    bhLoad(current, options);
+    waterdance(current, options);
+    current->refineTime += levelTimestamp() - tGuess;
+    reportProgress(options, current, solveStart);
+
+    return refineAndFinish(problem, current, options, true, solveStart,
+                           false);
+}
+
 bool optionsAreValid(const EdgeCut_Options *options)
 {
     if (!options)
@@ -176,6 +874,27 @@ bool optionsAreValid(const EdgeCut_Options *options)
         return (false);
     }
 
+    if (options->matching_sample_size < 0)
+    {
+        LogError("Fatal Error: options->matching_sample_size cannot be less "
+                 "than zero.");
+        return (false);
+    }
+
+    if (options->ensemble_size < 1)
+    {
+        LogError("Fatal Error: options->ensemble_size cannot be less than "
+                 "one.");
+        return (false);
+    }
+
+    if (options->memory_budget_mb < 0)
+    {
+        LogError("Fatal Error: options->memory_budget_mb cannot be less "
+                 "than zero.");
+        return (false);
+    }
+
     if (options->num_dances < 0)
     {
         LogError("Fatal Error: options->num_dances cannot be less than zero.");
@@ -236,13 +955,21 @@ bool optionsAreValid(const EdgeCut_Options *options)
 
 void cleanup(EdgeCutProblem *G)
 {
-    Int cutSize = 0;
-    for (Int p = 0; p < 2; p++)
+    /* Count the cut edges with one sweep over the adjacency rather than
+     * by summing external degrees over the boundary heaps: the heaps do
+     * not always hold the whole boundary (edge_cut_refresh re-seeds them
+     * with just the perturbed neighborhood), and this runs once per
+     * solve, at the finest level only. Each cut edge is seen from both
+     * ends. */
+    const Int *Gp = G->p;
+    const Int *Gi = G->i;
+    Int cutSize   = 0;
+    for (Int k = 0; k < G->n; k++)
     {
-        Int *bhHeap = G->bhHeap[p];
-        for (Int i = 0; i < G->bhSize[p]; i++)
+        bool part = G->getPartition(k);
+        for (Int p = Gp[k]; p < Gp[k + 1]; p++)
         {
-            cutSize += G->externalDegree[bhHeap[i]];
+            cutSize += (part != G->getPartition(Gi[p]));
         }
     }
 
@@ -251,4 +978,262 @@ void cleanup(EdgeCutProblem *G)
     G->cutCost   = G->cutCost / 2;
 }
 
+/* On-disk cache for edge_cut results, keyed by a hash of the CSR arrays
+ * and a hash of every option that affects the cut. One file per key in
+ * the caller's cache directory: a small header with the cut metrics and
+ * both hashes, followed by the partition packed eight vertices per byte. */
+
+struct EdgeCutCacheHeader
+{
+    char magic[8]; /* "MNGEDCUT"                       */
+    Int version;   /* Cache entry version, currently 1 */
+    Int int_size;  /* sizeof(Int) at write time        */
+    Int n;         /* # vertices                       */
+    Int cut_size;  /* Number of edges in cut set       */
+    Int graph_hash;
+    Int options_hash;
+    double cut_cost;
+    double w0;
+    double w1;
+    double imbalance;
+};
+
+static const char edge_cut_cache_magic[8]
+    = { 'M', 'N', 'G', 'E', 'D', 'C', 'U', 'T' };
+
+/* FNV-1a accumulation over raw bytes. */
+static inline void hashBytes(unsigned long long *hash, const void *data,
+                             size_t bytes)
+{
+    const unsigned char *s = static_cast<const unsigned char *>(data);
+    unsigned long long h   = *hash;
+    for (size_t k = 0; k < bytes; k++)
+    {
+        h ^= s[k];
+        h *= 0x100000001b3ULL;
+    }
+    *hash = h;
+}
+
+static Int hashGraph(const Graph *graph)
+{
+    unsigned long long hash = 0xcbf29ce484222325ULL;
+    size_t n  = static_cast<size_t>(graph->n);
+    size_t nz = static_cast<size_t>(graph->nz);
+    hashBytes(&hash, &graph->n, sizeof(Int));
+    hashBytes(&hash, &graph->nz, sizeof(Int));
+    hashBytes(&hash, graph->p, (n + 1) * sizeof(Int));
+    hashBytes(&hash, graph->i, nz * sizeof(Int));
+    unsigned char present = (graph->x != NULL) | ((graph->w != NULL) << 1);
+    hashBytes(&hash, &present, 1);
+    if (graph->x)
+        hashBytes(&hash, graph->x, nz * sizeof(WeightType));
+    if (graph->w)
+        hashBytes(&hash, graph->w, n * sizeof(WeightType));
+    return static_cast<Int>(hash);
+}
+
+/* Hashes the options field by field (never the raw struct, whose padding
+ * bytes are indeterminate), in declaration order. Every field that can
+ * change the cut participates, so any option tweak misses the cache.
+ *
+ * MAINTENANCE: this list must be kept in lockstep with EdgeCut_Options
+ * (see the note on the struct in Mongoose_EdgeCutOptions.hpp). A field
+ * missing here makes the cache serve one configuration's partition for
+ * another's. Only fields that cannot change the cut (progress_callback,
+ * progress_context) are deliberately left out. */
+static Int hashOptions(const EdgeCut_Options *o)
+{
+    unsigned long long hash = 0xcbf29ce484222325ULL;
+#define MONGOOSE_HASH_FIELD(field) hashBytes(&hash, &o->field, sizeof(o->field))
+    MONGOOSE_HASH_FIELD(random_seed);
+    MONGOOSE_HASH_FIELD(num_threads);
+    MONGOOSE_HASH_FIELD(ensemble_size);
+    MONGOOSE_HASH_FIELD(use_vertex_reordering);
+    MONGOOSE_HASH_FIELD(coarsen_limit);
+    MONGOOSE_HASH_FIELD(matching_strategy);
+    MONGOOSE_HASH_FIELD(do_community_matching);
+    MONGOOSE_HASH_FIELD(high_degree_threshold);
+    MONGOOSE_HASH_FIELD(matching_sample_size);
+    MONGOOSE_HASH_FIELD(initial_cut_type);
+    MONGOOSE_HASH_FIELD(num_dances);
+    MONGOOSE_HASH_FIELD(use_dance_racing);
+    MONGOOSE_HASH_FIELD(use_dance_convergence);
+    MONGOOSE_HASH_FIELD(dance_tolerance);
+    MONGOOSE_HASH_FIELD(use_FM);
+    MONGOOSE_HASH_FIELD(use_gain_buckets);
+    MONGOOSE_HASH_FIELD(use_deferred_heap_repair);
+    MONGOOSE_HASH_FIELD(use_FM_move_journal);
+    MONGOOSE_HASH_FIELD(use_FM_tie_sampling);
+    MONGOOSE_HASH_FIELD(FM_search_depth);
+    MONGOOSE_HASH_FIELD(FM_consider_count);
+    MONGOOSE_HASH_FIELD(FM_max_num_refinements);
+    MONGOOSE_HASH_FIELD(FM_num_tries);
+    MONGOOSE_HASH_FIELD(use_QP_gradproj);
+    MONGOOSE_HASH_FIELD(use_QP_sparse_gradient);
+    MONGOOSE_HASH_FIELD(use_QP_BB_step);
+    MONGOOSE_HASH_FIELD(use_QP_adaptive_gate);
+    MONGOOSE_HASH_FIELD(QP_gate_tolerance);
+    MONGOOSE_HASH_FIELD(gradproj_tolerance);
+    MONGOOSE_HASH_FIELD(gradproj_iteration_limit);
+    MONGOOSE_HASH_FIELD(time_limit);
+    MONGOOSE_HASH_FIELD(target_split);
+    MONGOOSE_HASH_FIELD(soft_split_tolerance);
+#undef MONGOOSE_HASH_FIELD
+    return static_cast<Int>(hash);
+}
+
+static std::string edgeCutCachePath(const char *cache_dir, Int graph_hash,
+                                    Int options_hash)
+{
+    unsigned long long key = (unsigned long long)graph_hash;
+    key ^= (unsigned long long)options_hash * 0x9e3779b97f4a7c15ULL;
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.edgecut", key);
+    std::string path(cache_dir);
+    if (!path.empty() && path[path.size() - 1] != '/')
+        path += '/';
+    path += name;
+    return path;
+}
+
+static EdgeCut *readEdgeCutCache(const char *path, Int n, Int graph_hash,
+                                 Int options_hash)
+{
+    FILE *file = fopen(path, "rb");
+    if (!file)
+        return NULL;
+
+    EdgeCutCacheHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1
+        || memcmp(header.magic, edge_cut_cache_magic, sizeof(header.magic))
+               != 0
+        || header.version != 1 || header.int_size != (Int)sizeof(Int)
+        || header.n != n || header.graph_hash != graph_hash
+        || header.options_hash != options_hash)
+    {
+        fclose(file);
+        return NULL;
+    }
+
+    size_t bytes = (static_cast<size_t>(n) + 7) / 8;
+    unsigned char *bitmap
+        = (unsigned char *)SuiteSparse_malloc(bytes, sizeof(unsigned char));
+    EdgeCut *result = (EdgeCut *)SuiteSparse_malloc(1, sizeof(EdgeCut));
+    bool *partition
+        = (bool *)SuiteSparse_malloc(static_cast<size_t>(n), sizeof(bool));
+
+    bool ok = bitmap && result && partition
+              && (bytes == 0 || fread(bitmap, 1, bytes, file) == bytes);
+    fclose(file);
+    if (!ok)
+    {
+        SuiteSparse_free(bitmap);
+        SuiteSparse_free(result);
+        SuiteSparse_free(partition);
+        return NULL;
+    }
+
+    for (Int k = 0; k < n; k++)
+    {
+        partition[k] = (bitmap[k >> 3] >> (k & 7)) & 1;
+    }
+    SuiteSparse_free(bitmap);
+
+    result->partition   = partition;
+    result->n           = header.n;
+    result->cut_cost    = header.cut_cost;
+    result->cut_size    = header.cut_size;
+    result->w0          = header.w0;
+    result->w1          = header.w1;
+    result->imbalance        = header.imbalance;
+    result->level_stats      = NULL;
+    result->num_levels       = 0;
+    result->budget_truncated = false;
+    return result;
+}
+
+static void writeEdgeCutCache(const char *path, const EdgeCut *result,
+                              Int graph_hash, Int options_hash)
+{
+    size_t n     = static_cast<size_t>(result->n);
+    size_t bytes = (n + 7) / 8;
+    unsigned char *bitmap
+        = (unsigned char *)SuiteSparse_calloc(bytes, sizeof(unsigned char));
+    if (!bitmap)
+        return;
+    for (size_t k = 0; k < n; k++)
+    {
+        if (result->partition[k])
+            bitmap[k >> 3] |= (unsigned char)(1 << (k & 7));
+    }
+
+    EdgeCutCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, edge_cut_cache_magic, sizeof(header.magic));
+    header.version      = 1;
+    header.int_size     = static_cast<Int>(sizeof(Int));
+    header.n            = result->n;
+    header.cut_size     = result->cut_size;
+    header.graph_hash   = graph_hash;
+    header.options_hash = options_hash;
+    header.cut_cost     = result->cut_cost;
+    header.w0           = result->w0;
+    header.w1           = result->w1;
+    header.imbalance    = result->imbalance;
+
+    FILE *file = fopen(path, "wb");
+    if (file)
+    {
+        bool ok = (fwrite(&header, sizeof(header), 1, file) == 1)
+                  && (bytes == 0 || fwrite(bitmap, 1, bytes, file) == bytes);
+        ok = (fclose(file) == 0) && ok;
+        if (!ok)
+        {
+            /* Never leave a truncated entry behind. */
+            remove(path);
+        }
+    }
+    SuiteSparse_free(bitmap);
+}
+
+EdgeCut *edge_cut_cached(const Graph *graph, const EdgeCut_Options *options,
+                         const std::string &cache_dir)
+{
+    return edge_cut_cached(graph, options, cache_dir.c_str());
+}
+
+EdgeCut *edge_cut_cached(const Graph *graph, const EdgeCut_Options *options,
+                         const char *cache_dir)
+{
+    if (!optionsAreValid(options))
+        return NULL;
+    if (!graph)
+        return NULL;
+    if (!cache_dir)
+        return edge_cut(graph, options);
+
+    Int graph_hash   = hashGraph(graph);
+    Int options_hash = hashOptions(options);
+    std::string path = edgeCutCachePath(cache_dir, graph_hash, options_hash);
+
+    EdgeCut *cached = readEdgeCutCache(path.c_str(), graph->n, graph_hash,
+                                       options_hash);
+    if (cached)
+    {
+        LogInfo("Loaded edge cut from cache " << path << "\n");
+        return cached;
+    }
+
+    EdgeCut *result = edge_cut(graph, options);
+    if (result && !result->budget_truncated)
+    {
+        /* Best effort: a failed write just means the next call recomputes.
+         * Budget-truncated cuts are never cached; they reflect how much
+         * time this run happened to have, not the options. */
+        writeEdgeCutCache(path.c_str(), result, graph_hash, options_hash);
+    }
+    return result;
+}
+
 } // end namespace Mongoose
@@ -25,24 +25,48 @@ EdgeCut_Options *EdgeCut_Options::create()
     {
         ret->random_seed = 0;
 
+        ret->num_threads = 1;
+        ret->ensemble_size = 1;
+    ret->memory_budget_mb = 0;
+
+        ret->use_vertex_reordering = false;
+
         ret->coarsen_limit        = 64;
         ret->matching_strategy    = HEMSR;
         ret->do_community_matching = false;
         ret->high_degree_threshold = 2.0;
+        ret->matching_sample_size  = 0;
 
         ret->initial_cut_type = InitialEdgeCut_Random;
 
-        ret->num_dances = 1;
+        ret->num_dances            = 1;
+        ret->use_dance_racing      = false;
+        ret->use_dance_convergence = false;
+        ret->dance_tolerance       = 0.001;
 
         ret->use_FM               = true;
+        ret->use_gain_buckets     = false;
+        ret->use_deferred_heap_repair = false;
+        ret->use_FM_move_journal  = false;
+        ret->use_FM_tie_sampling  = false;
         ret->FM_search_depth       = 50;
         ret->FM_consider_count     = 3;
         ret->FM_max_num_refinements = 20;
+        ret->FM_num_tries          = 1;
 
         ret->use_QP_gradproj          = true;
+        ret->use_QP_sparse_gradient   = false;
+        ret->use_QP_BB_step           = false;
+        ret->use_QP_adaptive_gate     = false;
+        ret->QP_gate_tolerance        = 0.001;
         ret->gradproj_tolerance      = 0.001;
         ret->gradproj_iteration_limit = 50;
 
+        ret->progress_callback = NULL;
+        ret->progress_context  = NULL;
+
+        ret->time_limit = 0;
+
         ret->target_split        = 0.5;
         ret->soft_split_tolerance = 0;
     }
@@ -50,6 +74,59 @@ EdgeCut_Options *EdgeCut_Options::create()
     return ret;
 }
 
+/* Minimum-latency preset: a single FM-only dance with a shallow search,
+ * gradient projection disabled, and an earlier coarsening stop. On the
+ * Tests matrices this runs several times faster than the defaults at a
+ * small (usually zero on small graphs) cut-quality cost. */
+EdgeCut_Options *EdgeCut_Options::fast()
+{
+    EdgeCut_Options *ret = create();
+
+    if (ret != NULL)
+    {
+        ret->coarsen_limit          = 256;
+        ret->matching_strategy      = HEM;
+        ret->num_dances             = 1;
+        ret->use_dance_convergence  = true;
+        ret->FM_search_depth        = 10;
+        ret->FM_max_num_refinements = 4;
+        ret->use_QP_gradproj        = false;
+    }
+
+    return ret;
+}
+
+/* The default tuning under its preset name, so call sites can spell the
+ * latency/quality choice uniformly. */
+EdgeCut_Options *EdgeCut_Options::balanced()
+{
+    return create();
+}
+
+/* Quality preset: the racing guess, more dances with the convergence
+ * exit, a deeper FM search, and a larger gradient-projection budget.
+ * Several times slower than the defaults; finds the lowest cuts of the
+ * three presets on the Tests matrices. (Heavier matching variants were
+ * tried here and cut quality got worse, so coarsening stays at the
+ * defaults.) */
+EdgeCut_Options *EdgeCut_Options::quality()
+{
+    EdgeCut_Options *ret = create();
+
+    if (ret != NULL)
+    {
+        ret->initial_cut_type         = InitialEdgeCut_Best;
+        ret->num_dances               = 4;
+        ret->use_dance_convergence    = true;
+        ret->FM_search_depth          = 100;
+        ret->FM_max_num_refinements   = 40;
+        ret->use_QP_sparse_gradient   = true;
+        ret->gradproj_iteration_limit = 100;
+    }
+
+    return ret;
+}
+
 EdgeCut_Options::~EdgeCut_Options()
 {
     SuiteSparse_free(this);
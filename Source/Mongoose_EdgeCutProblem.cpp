@@ -10,8 +10,16 @@
  * -------------------------------------------------------------------------- */
 
 #include "Mongoose_EdgeCutProblem.hpp"
+#include "Mongoose_Arena.hpp"
+#include "Mongoose_Logger.hpp"
+#include "Mongoose_QPBackend.hpp"
+#include "Mongoose_QPDelta.hpp"
+#include "Mongoose_ThreadPool.hpp"
+#include "Mongoose_Workspace.hpp"
 
 #include <algorithm>
+#include <cstdio>
+#include <cstring>
 #include <new>
 
 namespace Mongoose
@@ -29,10 +37,9 @@ EdgeCutProblem::EdgeCutProblem()
     W      = 0.0;
     H      = 0.0;
 
-    partition      = NULL;
-    vertexGains    = NULL;
-    externalDegree = NULL;
-    bhIndex        = NULL;
+    partition = NULL;
+    fmData    = NULL;
+    fmStack   = NULL;
     bhHeap[0] = bhHeap[1] = NULL;
     bhSize[0] = bhSize[1] = 0;
 
@@ -41,8 +48,15 @@ EdgeCutProblem::EdgeCutProblem()
     W0        = 0.0;
     W1        = 0.0;
     imbalance = 0.0;
+    qpLambda  = 0.0;
+
+    matchTime   = 0.0;
+    coarsenTime = 0.0;
+    refineTime  = 0.0;
+    deadline    = 0.0;
 
     parent      = NULL;
+    child       = NULL;
     clevel      = 0;
     cn          = 0;
     matching    = NULL;
@@ -52,10 +66,37 @@ EdgeCutProblem::EdgeCutProblem()
 
     markArray = NULL;
     markValue = 1;
+
+    arena        = NULL;
+    ownsArena    = false;
+    arenaBacked  = false;
+    vertexArrays = NULL;
+
+    memoryBudgetBytes = 0;
+    hierarchyBytes    = 0;
+    numericOwned      = false;
+    numericDropped    = false;
+
+    qpWorkspace     = NULL;
+    ownsQPWorkspace = false;
+
+    qpBackendHandle = NULL;
+    qpBackendState  = 0;
+
+    workspace     = NULL;
+    ownsWorkspace = false;
+}
+
+/* Round a byte count up to a whole number of cache lines so consecutive
+ * sub-arrays carved from one block start on cache-line boundaries. */
+static inline size_t roundUpCacheLine(size_t bytes)
+{
+    const size_t line = 64;
+    return (bytes + line - 1) & ~(line - 1);
 }
 
 EdgeCutProblem *EdgeCutProblem::create(const Int _n, const Int _nz, Int *_p,
-                                       Int *_i, double *_x, double *_w)
+                                       Int *_i, WeightType *_x, WeightType *_w)
 {
     void *memoryLocation = SuiteSparse_malloc(1, sizeof(EdgeCutProblem));
     if (!memoryLocation)
@@ -90,20 +131,73 @@ EdgeCutProblem *EdgeCutProblem::create(const Int _n, const Int _nz, Int *_p,
         graph->~EdgeCutProblem();
         return NULL;
     }
+    if (!graph->shallow_i)
+    {
+        adviseHugePages(graph->i, nz * sizeof(Int));
+    }
 
-    graph->partition      = (bool *)SuiteSparse_malloc(n, sizeof(bool));
-    graph->vertexGains    = (double *)SuiteSparse_malloc(n, sizeof(double));
-    graph->externalDegree = (Int *)SuiteSparse_calloc(n, sizeof(Int));
-    graph->bhIndex        = (Int *)SuiteSparse_calloc(n, sizeof(Int));
-    graph->bhHeap[0]      = (Int *)SuiteSparse_malloc(n, sizeof(Int));
-    graph->bhHeap[1]      = (Int *)SuiteSparse_malloc(n, sizeof(Int));
-    graph->bhSize[0] = graph->bhSize[1] = 0;
-    if (!graph->partition || !graph->vertexGains || !graph->externalDegree
-        || !graph->bhIndex || !graph->bhHeap[0] || !graph->bhHeap[1])
+    /* All of the O(n) per-vertex arrays are carved out of one contiguous
+     * zeroed block, with each sub-array starting on a cache-line boundary.
+     * A single allocation per level keeps the working set in far fewer TLB
+     * entries than a dozen scattered mallocs, and the destructor releases
+     * it with one free. The arrays that logically start zeroed
+     * (the fmData degrees and heap slots, matching, markArray) get that
+     * from the calloc of the whole block. */
+    size_t partitionBytes = roundUpCacheLine(
+        static_cast<size_t>(partitionWords(_n)) * sizeof(uint64_t));
+    size_t recordBytes = roundUpCacheLine(n * sizeof(FMVertexData));
+    size_t intBytes    = roundUpCacheLine(n * sizeof(Int));
+    size_t entryBytes  = roundUpCacheLine(n * sizeof(BHEntry));
+    size_t blockBytes
+        = partitionBytes + recordBytes + 6 * intBytes + 2 * entryBytes + 64;
+
+    char *block = (char *)SuiteSparse_calloc(blockBytes, sizeof(char));
+    if (!block)
     {
         graph->~EdgeCutProblem();
         return NULL;
     }
+    graph->vertexArrays = block;
+    adviseHugePages(block, blockBytes);
+
+    /* malloc only guarantees 16-byte alignment; bump the carving cursor up
+     * to the first cache line inside the block. */
+    char *cursor = (char *)(((size_t)block + 63) & ~((size_t)63));
+
+    graph->partition = (uint64_t *)cursor;
+    cursor += partitionBytes;
+    graph->fmData = (FMVertexData *)cursor;
+    cursor += recordBytes;
+    graph->fmStack = (Int *)cursor;
+    cursor += intBytes;
+    graph->bhHeap[0] = (BHEntry *)cursor;
+    cursor += entryBytes;
+    graph->bhHeap[1] = (BHEntry *)cursor;
+    cursor += entryBytes;
+    graph->matching = (Int *)cursor;
+    cursor += intBytes;
+    graph->matchmap = (Int *)cursor;
+    cursor += intBytes;
+    graph->invmatchmap = (Int *)cursor;
+    cursor += intBytes;
+    graph->matchtype = (Int *)cursor;
+    cursor += intBytes;
+    graph->markArray = (Int *)cursor;
+
+#if CPP11_OR_LATER
+    /* NUMA builds: place the pages of the scan-heavy arrays by touching
+     * them in the kernels' block partition before anything writes them
+     * serially. (calloc of a large block maps untouched zero pages, so
+     * the calloc above has not placed them yet.) */
+    if (!graph->shallow_i)
+    {
+        ThreadPool::firstTouch(graph->i, nz * sizeof(Int),
+                               ThreadPool::maxThreads());
+    }
+    ThreadPool::firstTouch(block, blockBytes, ThreadPool::maxThreads());
+#endif
+
+    graph->bhSize[0] = graph->bhSize[1] = 0;
 
     graph->heuCost   = 0.0;
     graph->cutCost   = 0.0;
@@ -111,22 +205,11 @@ EdgeCutProblem *EdgeCutProblem::create(const Int _n, const Int _nz, Int *_p,
     graph->W1        = 0.0;
     graph->imbalance = 0.0;
 
-    graph->parent      = NULL;
-    graph->clevel      = 0;
-    graph->cn          = 0;
-    graph->matching    = (Int *)SuiteSparse_calloc(n, sizeof(Int));
-    graph->matchmap    = (Int *)SuiteSparse_malloc(n, sizeof(Int));
-    graph->invmatchmap = (Int *)SuiteSparse_malloc(n, sizeof(Int));
-    graph->matchtype   = (Int *)SuiteSparse_malloc(n, sizeof(Int));
-    graph->markArray   = (Int *)SuiteSparse_calloc(n, sizeof(Int));
-    graph->markValue   = 1;
-    graph->singleton   = -1;
-    if (!graph->matching || !graph->matchmap || !graph->invmatchmap
-        || !graph->markArray || !graph->matchtype)
-    {
-        graph->~EdgeCutProblem();
-        return NULL;
-    }
+    graph->parent    = NULL;
+    graph->clevel    = 0;
+    graph->cn        = 0;
+    graph->markValue = 1;
+    graph->singleton = -1;
 
     graph->initialized = false;
 
@@ -143,46 +226,239 @@ EdgeCutProblem *EdgeCutProblem::create(const Graph *_graph)
 
 EdgeCutProblem *EdgeCutProblem::create(EdgeCutProblem *_parent)
 {
-    EdgeCutProblem *graph = create(_parent->cn, _parent->nz);
+    /* Coarse levels draw their arrays from a bump arena owned by the root
+     * problem, so a deep hierarchy costs a handful of large block
+     * allocations instead of a dozen malloc/free pairs per level. The
+     * arena (and with it the whole hierarchy) is released in one shot when
+     * the root is destroyed. */
+    EdgeCutProblem *root = _parent;
+    while (root->parent)
+    {
+        root = root->parent;
+    }
+    if (!root->arena)
+    {
+        root->arena     = Arena::create();
+        root->ownsArena = (root->arena != NULL);
+    }
+    Arena *arena = root->arena;
+
+    /* The QP workspace is pooled the same way: one QPDelta sized for the
+     * finest level serves every level below it (coarse levels only shrink),
+     * so each call to improveCutUsingQP reuses hot memory instead of
+     * reallocating. A NULL pool is tolerated: improveCutUsingQP falls back
+     * to a per-call workspace. */
+    if (!root->qpWorkspace)
+    {
+        root->qpWorkspace     = QPDelta::Create(root->n);
+        root->ownsQPWorkspace = (root->qpWorkspace != NULL);
+    }
+
+    if (!arena)
+    {
+        /* Arena creation failed: fall back to individual allocations. */
+        EdgeCutProblem *graph = create(_parent->cn, _parent->nz);
+
+        if (!graph)
+            return NULL;
 
-    if (!graph)
+        graph->x = (WeightType *)SuiteSparse_malloc(_parent->nz,
+                                                    sizeof(WeightType));
+        graph->w = (WeightType *)SuiteSparse_malloc(_parent->cn,
+                                                    sizeof(WeightType));
+
+        if (!graph->x || !graph->w)
+        {
+            graph->~EdgeCutProblem();
+            return NULL;
+        }
+
+        graph->W            = _parent->W;
+        graph->parent       = _parent;
+        graph->clevel       = graph->parent->clevel + 1;
+        graph->qpWorkspace  = root->qpWorkspace;
+        graph->numericOwned = true;
+
+        return graph;
+    }
+
+    void *memoryLocation = SuiteSparse_malloc(1, sizeof(EdgeCutProblem));
+    if (!memoryLocation)
         return NULL;
 
-    graph->x = (double *)SuiteSparse_malloc(_parent->nz, sizeof(double));
-    graph->w = (double *)SuiteSparse_malloc(_parent->cn, sizeof(double));
+    // Placement new
+    EdgeCutProblem *graph = new (memoryLocation) EdgeCutProblem();
+
+    size_t n  = static_cast<size_t>(_parent->cn);
+    size_t nz = static_cast<size_t>(_parent->nz);
+    graph->n  = _parent->cn;
+    graph->nz = _parent->nz;
+
+    graph->arena       = arena;
+    graph->arenaBacked = true;
 
-    if (!graph->x || !graph->w)
+    /* The shallow flags keep the destructor from freeing arena memory. */
+    graph->shallow_p = graph->shallow_i = true;
+    graph->shallow_x = graph->shallow_w = true;
+
+    graph->p = (Int *)arena->allocateZeroed(n + 1, sizeof(Int));
+    graph->i = (Int *)arena->allocate(nz, sizeof(Int));
+
+    if (root->memoryBudgetBytes > 0)
+    {
+        /* Budget mode: the weights are the arrays a level can shed, so
+         * they bypass the arena and stay individually freeable. */
+        graph->x = (WeightType *)SuiteSparse_malloc(nz, sizeof(WeightType));
+        graph->w = (WeightType *)SuiteSparse_malloc(n, sizeof(WeightType));
+        graph->numericOwned = true;
+    }
+    else
+    {
+        graph->x = (WeightType *)arena->allocate(nz, sizeof(WeightType));
+        graph->w = (WeightType *)arena->allocate(n, sizeof(WeightType));
+    }
+
+    graph->partition = (uint64_t *)arena->allocateZeroed(
+        static_cast<size_t>(partitionWords(graph->n)), sizeof(uint64_t));
+    graph->fmData
+        = (FMVertexData *)arena->allocateZeroed(n, sizeof(FMVertexData));
+    graph->fmStack   = (Int *)arena->allocate(n, sizeof(Int));
+    graph->bhHeap[0] = (BHEntry *)arena->allocate(n, sizeof(BHEntry));
+    graph->bhHeap[1] = (BHEntry *)arena->allocate(n, sizeof(BHEntry));
+
+    graph->matching    = (Int *)arena->allocateZeroed(n, sizeof(Int));
+    graph->matchmap    = (Int *)arena->allocate(n, sizeof(Int));
+    graph->invmatchmap = (Int *)arena->allocate(n, sizeof(Int));
+    graph->matchtype   = (Int *)arena->allocate(n, sizeof(Int));
+    graph->markArray   = (Int *)arena->allocateZeroed(n, sizeof(Int));
+    graph->markValue   = 1;
+    graph->singleton   = -1;
+
+    if (!graph->p || !graph->i || !graph->x || !graph->w || !graph->partition
+        || !graph->fmData || !graph->fmStack
+        || !graph->bhHeap[0] || !graph->bhHeap[1] || !graph->matching
+        || !graph->matchmap || !graph->invmatchmap || !graph->matchtype
+        || !graph->markArray)
     {
         graph->~EdgeCutProblem();
         return NULL;
     }
 
-    graph->W      = _parent->W;
-    graph->parent = _parent;
-    graph->clevel = graph->parent->clevel + 1;
+#if CPP11_OR_LATER
+    /* NUMA builds: the arena hands out untouched pages for the non-zeroed
+     * arrays; place the big ones (O(nz) adjacency and the weights) where
+     * their chunks will be scanned. */
+    ThreadPool::firstTouch(graph->i, nz * sizeof(Int),
+                           ThreadPool::maxThreads());
+    ThreadPool::firstTouch(graph->x, nz * sizeof(WeightType),
+                           ThreadPool::maxThreads());
+    ThreadPool::firstTouch(graph->w, n * sizeof(WeightType),
+                           ThreadPool::maxThreads());
+#endif
+
+    graph->initialized = false;
+
+    graph->W           = _parent->W;
+    graph->parent      = _parent;
+    graph->clevel      = graph->parent->clevel + 1;
+    graph->qpWorkspace = root->qpWorkspace;
+
+    /* Running footprint of the hierarchy, for the memory budget: the
+     * O(nz) structure and weights plus the per-vertex arrays. */
+    root->hierarchyBytes
+        += (nz + n + 1) * sizeof(Int)      /* p, i */
+           + (nz + n) * sizeof(WeightType) /* x, w */
+           + n * (6 * sizeof(Int) + sizeof(FMVertexData) + 2 * sizeof(BHEntry))
+           + static_cast<size_t>(partitionWords(graph->n))
+                 * sizeof(uint64_t);
 
     return graph;
 }
 
 EdgeCutProblem::~EdgeCutProblem()
 {
-    p = (shallow_p) ? NULL : (Int *)SuiteSparse_free(p);
-    i = (shallow_i) ? NULL : (Int *)SuiteSparse_free(i);
-    x = (shallow_x) ? NULL : (double *)SuiteSparse_free(x);
-    w = (shallow_w) ? NULL : (double *)SuiteSparse_free(w);
-
-    partition      = (bool *)SuiteSparse_free(partition);
-    vertexGains    = (double *)SuiteSparse_free(vertexGains);
-    externalDegree = (Int *)SuiteSparse_free(externalDegree);
-    bhIndex        = (Int *)SuiteSparse_free(bhIndex);
-    bhHeap[0]      = (Int *)SuiteSparse_free(bhHeap[0]);
-    bhHeap[1]      = (Int *)SuiteSparse_free(bhHeap[1]);
-    matching       = (Int *)SuiteSparse_free(matching);
-    matchmap       = (Int *)SuiteSparse_free(matchmap);
-    invmatchmap    = (Int *)SuiteSparse_free(invmatchmap);
-    matchtype      = (Int *)SuiteSparse_free(matchtype);
-
-    markArray = (Int *)SuiteSparse_free(markArray);
+    /* Destroy any retained coarse levels below this one (iteratively, to
+     * avoid deep recursion on tall hierarchies). */
+    EdgeCutProblem *c = child;
+    child             = NULL;
+    while (c)
+    {
+        EdgeCutProblem *next = c->child;
+        c->child             = NULL;
+        c->~EdgeCutProblem();
+        c = next;
+    }
+
+    if (arenaBacked && numericOwned)
+    {
+        /* Budget mode keeps the weights out of the arena so they can be
+         * shed; they are the only arrays an arena-backed level owns. */
+        x = (WeightType *)SuiteSparse_free(x);
+        w = (WeightType *)SuiteSparse_free(w);
+    }
+
+    if (!arenaBacked)
+    {
+        p = (shallow_p) ? NULL : (Int *)SuiteSparse_free(p);
+        i = (shallow_i) ? NULL : (Int *)SuiteSparse_free(i);
+        x = (shallow_x) ? NULL : (WeightType *)SuiteSparse_free(x);
+        w = (shallow_w) ? NULL : (WeightType *)SuiteSparse_free(w);
+
+        if (vertexArrays)
+        {
+            /* Every per-vertex array lives in the coalesced block. */
+            vertexArrays = SuiteSparse_free(vertexArrays);
+            partition    = NULL;
+            fmData       = NULL;
+            fmStack      = NULL;
+            bhHeap[0] = bhHeap[1] = NULL;
+            matching    = NULL;
+            matchmap    = NULL;
+            invmatchmap = NULL;
+            matchtype   = NULL;
+            markArray   = NULL;
+        }
+        else
+        {
+            partition   = (uint64_t *)SuiteSparse_free(partition);
+            fmData      = (FMVertexData *)SuiteSparse_free(fmData);
+            fmStack     = (Int *)SuiteSparse_free(fmStack);
+            bhHeap[0]   = (BHEntry *)SuiteSparse_free(bhHeap[0]);
+            bhHeap[1]   = (BHEntry *)SuiteSparse_free(bhHeap[1]);
+            matching    = (Int *)SuiteSparse_free(matching);
+            matchmap    = (Int *)SuiteSparse_free(matchmap);
+            invmatchmap = (Int *)SuiteSparse_free(invmatchmap);
+            matchtype   = (Int *)SuiteSparse_free(matchtype);
+
+            markArray = (Int *)SuiteSparse_free(markArray);
+        }
+    }
+
+    /* Arena-backed levels leave their arrays behind; the root releases the
+     * whole hierarchy's memory in one shot here. */
+    if (ownsArena && arena)
+    {
+        arena->~Arena();
+        arena = NULL;
+    }
+
+    /* Coarse levels only borrow the pooled QP workspace. */
+    if (ownsQPWorkspace && qpWorkspace)
+    {
+        qpWorkspace->~QPDelta();
+        SuiteSparse_free(qpWorkspace);
+        qpWorkspace = NULL;
+    }
+
+    /* Drop any device-side state the QP backend bound to this level. */
+    qpBackendReleaseLevel(this);
+
+    /* Likewise for the scratch workspace. */
+    if (ownsWorkspace && workspace)
+    {
+        workspace->~Workspace();
+        workspace = NULL;
+    }
 
     SuiteSparse_free(this);
 }
@@ -190,44 +466,85 @@ EdgeCutProblem::~EdgeCutProblem()
 /* Initialize a top level graph with a a set of options. */
 void EdgeCutProblem::initialize(const EdgeCut_Options *options)
 {
-    (void)options; // Unused variable
+    memoryBudgetBytes
+        = (options->memory_budget_mb > 0)
+              ? static_cast<size_t>(options->memory_budget_mb * 1048576.)
+              : 0;
+    hierarchyBytes = 0;
 
     if (initialized)
     {
         // Graph has been previously initialized. We need to clear some extra
         // data structures to be able to reuse it.
 
-        X = 0.0;
-        W = 0.0;
-        H = 0.0;
-
-        bhSize[0] = bhSize[1] = 0;
-
-        heuCost   = 0.0;
-        cutCost   = 0.0;
-        W0        = 0.0;
-        W1        = 0.0;
-        imbalance = 0.0;
+        resetCutState();
 
         clevel = 0;
         cn     = 0;
+
+        matchTime   = 0.0;
+        coarsenTime = 0.0;
+        refineTime  = 0.0;
         for (Int k = 0; k < n; k++)
         {
-            externalDegree[k] = 0;
-            bhIndex[k]        = 0;
-            matching[k]       = 0;
+            matching[k] = 0;
         }
         singleton = -1;
 
-        clearMarkArray();
+        /* Release the previous call's hierarchy, if it was retained, along
+         * with its arena. */
+        EdgeCutProblem *c = child;
+        child             = NULL;
+        while (c)
+        {
+            EdgeCutProblem *next = c->child;
+            c->child             = NULL;
+            c->~EdgeCutProblem();
+            c = next;
+        }
+        if (ownsArena && arena)
+        {
+            arena->~Arena();
+            arena     = NULL;
+            ownsArena = false;
+        }
+    }
+
+    refreshNumeric();
+
+    initialized = true;
+}
+
+Workspace *EdgeCutProblem::getWorkspace()
+{
+    /* The workspace lives on the root problem, like the arena and the QP
+     * workspace, so one set of scratch arrays serves every level. */
+    EdgeCutProblem *root = this;
+    while (root->parent)
+    {
+        root = root->parent;
     }
+    if (!root->workspace)
+    {
+        root->workspace     = Workspace::create();
+        root->ownsWorkspace = (root->workspace != NULL);
+    }
+    return root->workspace;
+}
 
+/* Recompute W, X, H, the initial vertex gains, and the worst-case ratio
+ * from the current edge and vertex weights. */
+void EdgeCutProblem::refreshNumeric()
+{
     Int *Gp    = p;
-    double *Gx = x;
-    double *Gw = w;
+    WeightType *Gx = x;
+    WeightType *Gw = w;
+
+    X = 0.0;
+    W = 0.0;
 
     /* Compute worst-case gains, and compute X. */
-    double *gains = vertexGains;
+    FMVertexData *fm = fmData;
     double min    = fabs((Gx) ? Gx[0] : 1);
     double max    = fabs((Gx) ? Gx[0] : 1);
     for (Int k = 0; k < n; k++)
@@ -250,19 +567,307 @@ void EdgeCutProblem::initialize(const EdgeCut_Options *options)
             }
         }
 
-        gains[k] = -sumEdgeWeights;
+        fm[k].gain = -sumEdgeWeights;
         X += sumEdgeWeights;
     }
     H = 2.0 * X;
 
     // May need to correct tolerance for very ill-conditioned problems
     worstCaseRatio = max / (1E-9 + min);
+}
 
-    initialized = true;
+/* Clear the partition/boundary state so the level can be cut again. The
+ * weight sums (W, X, H) are left alone; refreshNumeric and coarsen_numeric
+ * own those. */
+/* Fixed header of the binary hierarchy format. The widths let load
+ * refuse a file written by a build with different Int/WeightType sizes
+ * instead of misreading it. */
+struct HierarchyFileHeader
+{
+    char magic[8]; /* "MngsHier" */
+    int32_t version;
+    int32_t intBytes;
+    int32_t weightBytes;
+    int32_t nlevels;
+};
+
+bool EdgeCutProblem::saveHierarchy(const char *filename) const
+{
+    if (!filename)
+        return false;
+
+    FILE *file = fopen(filename, "wb");
+    if (!file)
+    {
+        LogError("Error: Unable to open hierarchy file for writing.");
+        return false;
+    }
+
+    Int nlevels = 0;
+    for (const EdgeCutProblem *level = this; level; level = level->child)
+    {
+        nlevels++;
+    }
+
+    HierarchyFileHeader header;
+    memcpy(header.magic, "MngsHier", 8);
+    header.version     = 1;
+    header.intBytes    = (int32_t)sizeof(Int);
+    header.weightBytes = (int32_t)sizeof(WeightType);
+    header.nlevels     = (int32_t)nlevels;
+
+    bool ok = (fwrite(&header, sizeof(header), 1, file) == 1);
+
+    for (const EdgeCutProblem *level = this; ok && level; level = level->child)
+    {
+        size_t ln  = static_cast<size_t>(level->n);
+        size_t lnz = static_cast<size_t>(level->nz);
+
+        /* Only the finest level's weights are inputs; every coarse
+         * level's numerics are re-derived on resume (coarsen_numeric). */
+        Int flags = 0;
+        if (level == this)
+        {
+            flags = (level->x ? 1 : 0) | (level->w ? 2 : 0);
+        }
+        Int meta[5] = { level->n, level->nz, level->cn, level->singleton,
+                        flags };
+
+        ok = ok && (fwrite(meta, sizeof(Int), 5, file) == 5);
+        ok = ok && (fwrite(level->p, sizeof(Int), ln + 1, file) == ln + 1);
+        ok = ok && (fwrite(level->i, sizeof(Int), lnz, file) == lnz);
+        if (flags & 1)
+        {
+            ok = ok
+                 && (fwrite(level->x, sizeof(WeightType), lnz, file) == lnz);
+        }
+        if (flags & 2)
+        {
+            ok = ok && (fwrite(level->w, sizeof(WeightType), ln, file) == ln);
+        }
+        if (level == this)
+        {
+            /* The finest partition bits ride along so edge_cut_numeric
+             * warm-starts a resumed job from the cut it had. */
+            size_t words = static_cast<size_t>(partitionWords(level->n));
+            ok = ok
+                 && (fwrite(level->partition, sizeof(uint64_t), words, file)
+                     == words);
+        }
+        if (level->child)
+        {
+            size_t lcn = static_cast<size_t>(level->cn);
+            ok = ok && (fwrite(level->matching, sizeof(Int), ln, file) == ln);
+            ok = ok && (fwrite(level->matchmap, sizeof(Int), ln, file) == ln);
+            ok = ok
+                 && (fwrite(level->invmatchmap, sizeof(Int), lcn, file)
+                     == lcn);
+        }
+    }
+
+    if (fclose(file) != 0)
+    {
+        ok = false;
+    }
+    if (!ok)
+    {
+        LogError("Error: Unable to write the hierarchy file.");
+    }
+    return ok;
+}
+
+EdgeCutProblem *EdgeCutProblem::loadHierarchy(const char *filename)
+{
+    if (!filename)
+        return NULL;
+
+    FILE *file = fopen(filename, "rb");
+    if (!file)
+    {
+        LogError("Error: Unable to open hierarchy file for reading.");
+        return NULL;
+    }
+
+    HierarchyFileHeader header;
+    bool ok = (fread(&header, sizeof(header), 1, file) == 1)
+              && (memcmp(header.magic, "MngsHier", 8) == 0)
+              && (header.version == 1)
+              && (header.intBytes == (int32_t)sizeof(Int))
+              && (header.weightBytes == (int32_t)sizeof(WeightType))
+              && (header.nlevels >= 1);
+
+    EdgeCutProblem *root = NULL;
+    EdgeCutProblem *fine = NULL;
+
+    for (Int l = 0; ok && l < (Int)header.nlevels; l++)
+    {
+        Int meta[5];
+        ok = (fread(meta, sizeof(Int), 5, file) == 5);
+        if (!ok)
+            break;
+
+        Int ln    = meta[0];
+        Int lnz   = meta[1];
+        Int flags = meta[4];
+        ok        = (ln >= 0 && lnz >= 0);
+
+        EdgeCutProblem *level = NULL;
+        if (ok && !fine)
+        {
+            level = create(ln, lnz);
+            if (level && (flags & 1))
+            {
+                level->x = (WeightType *)SuiteSparse_malloc(
+                    static_cast<size_t>(lnz), sizeof(WeightType));
+                ok = (level->x != NULL);
+            }
+            if (level && ok && (flags & 2))
+            {
+                level->w = (WeightType *)SuiteSparse_malloc(
+                    static_cast<size_t>(ln), sizeof(WeightType));
+                ok = (level->w != NULL);
+            }
+            root = level;
+        }
+        else if (ok)
+        {
+            /* Coarse levels go through the normal factory (arena-backed,
+             * sized from the parent like the builder), so a loaded
+             * hierarchy is indistinguishable from a built one. */
+            ok = (fine->cn == ln && fine->nz >= lnz);
+            if (ok)
+            {
+                level = create(fine);
+                if (level)
+                {
+                    fine->child = level;
+                    level->nz   = lnz;
+                }
+            }
+        }
+        if (!level)
+        {
+            ok = false;
+            break;
+        }
+
+        size_t un  = static_cast<size_t>(ln);
+        size_t unz = static_cast<size_t>(lnz);
+        ok = ok && (fread(level->p, sizeof(Int), un + 1, file) == un + 1);
+        ok = ok && (fread(level->i, sizeof(Int), unz, file) == unz);
+        if (ok && (flags & 1))
+        {
+            ok = (fread(level->x, sizeof(WeightType), unz, file) == unz);
+        }
+        if (ok && (flags & 2))
+        {
+            ok = (fread(level->w, sizeof(WeightType), un, file) == un);
+        }
+        if (ok && l == 0)
+        {
+            size_t words = static_cast<size_t>(partitionWords(ln));
+            ok = (fread(level->partition, sizeof(uint64_t), words, file)
+                  == words);
+        }
+
+        level->cn        = meta[2];
+        level->singleton = meta[3];
+
+        if (ok && l + 1 < (Int)header.nlevels)
+        {
+            size_t ucn = static_cast<size_t>(level->cn);
+            ok = (fread(level->matching, sizeof(Int), un, file) == un)
+                 && (fread(level->matchmap, sizeof(Int), un, file) == un)
+                 && (fread(level->invmatchmap, sizeof(Int), ucn, file)
+                     == ucn);
+        }
+
+        /* Mark ready for the numeric-only path: edge_cut_numeric resets
+         * the cut state and re-derives every numeric quantity itself. */
+        level->initialized = true;
+
+        fine = level;
+    }
+
+    fclose(file);
+
+    if (!ok)
+    {
+        LogError("Error: Unable to read the hierarchy file.");
+        if (root)
+        {
+            root->~EdgeCutProblem();
+        }
+        return NULL;
+    }
+    return root;
+}
+
+void EdgeCutProblem::dropNumeric()
+{
+    if (!numericOwned || numericDropped)
+        return;
+
+    x = (WeightType *)SuiteSparse_free(x);
+    w = (WeightType *)SuiteSparse_free(w);
+    numericDropped = true;
+
+    EdgeCutProblem *root = this;
+    while (root->parent)
+    {
+        root = root->parent;
+    }
+    root->hierarchyBytes -= (nz + n) * sizeof(WeightType);
+}
+
+bool EdgeCutProblem::restoreNumeric()
+{
+    if (!numericDropped)
+        return true;
+
+    x = (WeightType *)SuiteSparse_malloc(nz, sizeof(WeightType));
+    w = (WeightType *)SuiteSparse_malloc(n, sizeof(WeightType));
+    if (!x || !w)
+    {
+        /* Partial allocations are released by the destructor (the level
+         * still owns its weights). */
+        return false;
+    }
+    numericDropped = false;
+
+    EdgeCutProblem *root = this;
+    while (root->parent)
+    {
+        root = root->parent;
+    }
+    root->hierarchyBytes += (nz + n) * sizeof(WeightType);
+    return true;
+}
+
+void EdgeCutProblem::resetCutState()
+{
+    bhSize[0] = bhSize[1] = 0;
+
+    heuCost   = 0.0;
+    cutCost   = 0.0;
+    cutSize   = 0;
+    W0        = 0.0;
+    W1        = 0.0;
+    imbalance = 0.0;
+    qpLambda  = 0.0;
+
+    for (Int k = 0; k < n; k++)
+    {
+        fmData[k].externalDegree = 0;
+        fmData[k].bhIndex        = 0;
+    }
+
+    clearMarkArray();
 }
 
 void EdgeCutProblem::clearMarkArray()
 {
+    MONGOOSE_COUNT(MarkArrayClearsCounter);
     markValue += 1;
     if (markValue < 0)
     {
@@ -272,6 +877,7 @@ void EdgeCutProblem::clearMarkArray()
 
 void EdgeCutProblem::clearMarkArray(Int incrementBy)
 {
+    MONGOOSE_COUNT(MarkArrayClearsCounter);
     markValue += incrementBy;
     if (markValue < 0)
     {
@@ -0,0 +1,201 @@
+/* ========================================================================== */
+/* === Source/Mongoose_GainBuckets.cpp ====================================== */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+#include "Mongoose_GainBuckets.hpp"
+#include "Mongoose_Debug.hpp"
+#include "Mongoose_Internal.hpp"
+
+#include <new>
+
+namespace Mongoose
+{
+
+GainBuckets::GainBuckets()
+{
+    n        = 0;
+    maxGain  = 0;
+    nBuckets = 0;
+    heads    = NULL;
+    next     = NULL;
+    prev     = NULL;
+    slot     = NULL;
+    top[0] = top[1] = -1;
+}
+
+GainBuckets *GainBuckets::create(Int _n, Int _maxGain)
+{
+    void *memoryLocation = SuiteSparse_malloc(1, sizeof(GainBuckets));
+    if (!memoryLocation)
+        return NULL;
+
+    // Placement new
+    GainBuckets *buckets = new (memoryLocation) GainBuckets();
+
+    size_t n          = static_cast<size_t>(_n);
+    buckets->n        = _n;
+    buckets->maxGain  = _maxGain;
+    buckets->nBuckets = 2 * _maxGain + 1;
+
+    size_t nb      = static_cast<size_t>(buckets->nBuckets);
+    buckets->heads = (Int *)SuiteSparse_malloc(2 * nb, sizeof(Int));
+    buckets->next  = (Int *)SuiteSparse_malloc(n, sizeof(Int));
+    buckets->prev  = (Int *)SuiteSparse_malloc(n, sizeof(Int));
+    buckets->slot  = (Int *)SuiteSparse_malloc(n, sizeof(Int));
+
+    if (!buckets->heads || !buckets->next || !buckets->prev || !buckets->slot)
+    {
+        buckets->~GainBuckets();
+        return NULL;
+    }
+
+    for (Int b = 0; b < 2 * buckets->nBuckets; b++)
+    {
+        buckets->heads[b] = -1;
+    }
+    for (Int k = 0; k < _n; k++)
+    {
+        buckets->slot[k] = -1;
+    }
+    buckets->top[0] = buckets->top[1] = -1;
+
+    return buckets;
+}
+
+GainBuckets::~GainBuckets()
+{
+    heads = (Int *)SuiteSparse_free(heads);
+    next  = (Int *)SuiteSparse_free(next);
+    prev  = (Int *)SuiteSparse_free(prev);
+    slot  = (Int *)SuiteSparse_free(slot);
+    SuiteSparse_free(this);
+}
+
+void GainBuckets::insert(Int vertex, bool side, Int gain)
+{
+    ASSERT(!contains(vertex));
+
+    Int bucket = gainToBucket(gain);
+    ASSERT(bucket >= 0 && bucket < nBuckets);
+    Int index = (side ? nBuckets : 0) + bucket;
+
+    Int first    = heads[index];
+    next[vertex] = first;
+    prev[vertex] = -1;
+    if (first != -1)
+    {
+        prev[first] = vertex;
+    }
+    heads[index] = vertex;
+    slot[vertex] = index;
+
+    Int s = (side ? 1 : 0);
+    if (bucket > top[s])
+    {
+        top[s] = bucket;
+    }
+}
+
+void GainBuckets::remove(Int vertex)
+{
+    ASSERT(contains(vertex));
+
+    Int index = slot[vertex];
+    Int pv    = prev[vertex];
+    Int nv    = next[vertex];
+
+    if (pv != -1)
+    {
+        next[pv] = nv;
+    }
+    else
+    {
+        heads[index] = nv;
+    }
+    if (nv != -1)
+    {
+        prev[nv] = pv;
+    }
+
+    slot[vertex] = -1;
+    /* top[] is left as an upper bound; maxBucket walks it down lazily. */
+}
+
+void GainBuckets::update(Int vertex, bool side, Int gain)
+{
+    remove(vertex);
+    insert(vertex, side, gain);
+}
+
+Int GainBuckets::maxBucket(bool side)
+{
+    Int s      = (side ? 1 : 0);
+    Int offset = (side ? nBuckets : 0);
+    Int b      = top[s];
+    while (b >= 0 && heads[offset + b] == -1)
+    {
+        b--;
+    }
+    top[s] = b;
+    return b;
+}
+
+//-----------------------------------------------------------------------------
+// A graph can use gain buckets if all of its edge weights are integers (so
+// gains stay integral under FM moves, which change them by 2x an edge
+// weight) and the largest possible |gain| - the biggest adjacent weight
+// sum over all vertices - is small enough that the bucket array stays a
+// modest multiple of n.
+//-----------------------------------------------------------------------------
+bool gainBucketsSuitable(const EdgeCutProblem *graph, Int *out_maxGain)
+{
+    Int n      = graph->n;
+    Int *Gp    = graph->p;
+    WeightType *Gx = graph->x;
+
+    double maxAdjSum = 0.0;
+    if (!Gx)
+    {
+        /* Unweighted: the gain bound is the maximum degree. */
+        for (Int k = 0; k < n; k++)
+        {
+            double degree = static_cast<double>(Gp[k + 1] - Gp[k]);
+            if (degree > maxAdjSum)
+                maxAdjSum = degree;
+        }
+    }
+    else
+    {
+        for (Int k = 0; k < n; k++)
+        {
+            double adjSum = 0.0;
+            for (Int p = Gp[k]; p < Gp[k + 1]; p++)
+            {
+                double ex = Gx[p];
+                if (ex != floor(ex))
+                    return false;
+                adjSum += fabs(ex);
+            }
+            if (adjSum > maxAdjSum)
+                maxAdjSum = adjSum;
+        }
+    }
+
+    /* Cap the bucket array at a small multiple of n so a few huge
+     * aggregated weights can't blow up the allocation. */
+    double cap = 4.0 * static_cast<double>(n) + 1024.0;
+    if (maxAdjSum > cap)
+        return false;
+
+    *out_maxGain = static_cast<Int>(maxAdjSum);
+    return true;
+}
+
+} // end namespace Mongoose
@@ -0,0 +1,385 @@
+/* ========================================================================== */
+/* === Source/Mongoose_Generator.cpp ======================================== */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+#include "Mongoose_Generator.hpp"
+#include "Mongoose_Internal.hpp"
+#include "Mongoose_Random.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Mongoose
+{
+
+Graph *generate_grid(Int k)
+{
+    if (k < 1)
+        return NULL;
+
+    Int n  = k * k;
+    Int nz = 4 * k * (k - 1);
+
+    Graph *graph = Graph::create(n, nz);
+    if (!graph)
+        return NULL;
+
+    Int *Gp = graph->p;
+    Int *Gi = graph->i;
+    Int q   = 0;
+    for (Int v = 0; v < n; v++)
+    {
+        Int row = v / k, col = v % k;
+        if (row > 0)
+            Gi[q++] = v - k;
+        if (col > 0)
+            Gi[q++] = v - 1;
+        if (col + 1 < k)
+            Gi[q++] = v + 1;
+        if (row + 1 < k)
+            Gi[q++] = v + k;
+        Gp[v + 1] = q;
+    }
+    return graph;
+}
+
+Graph *generate_grid_3d(Int k)
+{
+    if (k < 1)
+        return NULL;
+
+    Int n  = k * k * k;
+    Int nz = 6 * k * k * (k - 1);
+
+    Graph *graph = Graph::create(n, nz);
+    if (!graph)
+        return NULL;
+
+    Int *Gp = graph->p;
+    Int *Gi = graph->i;
+    Int q   = 0;
+    for (Int v = 0; v < n; v++)
+    {
+        Int plane = v / (k * k);
+        Int row   = (v / k) % k;
+        Int col   = v % k;
+        if (plane > 0)
+            Gi[q++] = v - k * k;
+        if (row > 0)
+            Gi[q++] = v - k;
+        if (col > 0)
+            Gi[q++] = v - 1;
+        if (col + 1 < k)
+            Gi[q++] = v + 1;
+        if (row + 1 < k)
+            Gi[q++] = v + k;
+        if (plane + 1 < k)
+            Gi[q++] = v + k * k;
+        Gp[v + 1] = q;
+    }
+    return graph;
+}
+
+//-----------------------------------------------------------------------------
+// Builds a sorted symmetric CSR graph from an arbitrary list of ndraws
+// directed edge draws (self edges allowed in the input; they are
+// dropped, as are duplicates after symmetrization). Shared by the RMAT
+// and geometric generators; frees nothing on success, NULL on OOM.
+//-----------------------------------------------------------------------------
+static Graph *buildFromEdges(Int n, const Int *src, const Int *dst,
+                             Int ndraws)
+{
+    /* Count both directions of every non-self draw. */
+    Int *count = (Int *)SuiteSparse_calloc(static_cast<size_t>(n + 1),
+                                           sizeof(Int));
+    if (!count)
+        return NULL;
+    for (Int e = 0; e < ndraws; e++)
+    {
+        if (src[e] != dst[e])
+        {
+            count[src[e] + 1]++;
+            count[dst[e] + 1]++;
+        }
+    }
+    for (Int v = 0; v < n; v++)
+    {
+        count[v + 1] += count[v];
+    }
+    Int total = count[n];
+
+    Graph *graph = Graph::create(n, total);
+    if (!graph)
+    {
+        SuiteSparse_free(count);
+        return NULL;
+    }
+    Int *Gp = graph->p;
+    Int *Gi = graph->i;
+
+    /* Scatter (counting sort by source), then sort and deduplicate each
+     * adjacency list in place, compacting the arrays as we go. */
+    for (Int v = 0; v <= n; v++)
+    {
+        Gp[v] = count[v];
+    }
+    for (Int e = 0; e < ndraws; e++)
+    {
+        if (src[e] != dst[e])
+        {
+            Gi[count[src[e]]++] = dst[e];
+            Gi[count[dst[e]]++] = src[e];
+        }
+    }
+
+    Int nz = 0;
+    Int at = 0;
+    for (Int v = 0; v < n; v++)
+    {
+        Int rowEnd = count[v];
+        std::sort(Gi + at, Gi + rowEnd);
+        Int dedupFrom = nz;
+        for (Int q = at; q < rowEnd; q++)
+        {
+            if (nz == dedupFrom || Gi[nz - 1] != Gi[q])
+            {
+                Gi[nz++] = Gi[q];
+            }
+        }
+        at    = rowEnd;
+        Gp[v] = dedupFrom;
+    }
+    Gp[n] = nz;
+
+    /* Gp was rewritten to the deduplicated offsets above; shift it into
+     * the conventional layout (Gp[0] = 0 already holds). */
+    graph->nz = nz;
+
+    SuiteSparse_free(count);
+    return graph;
+}
+
+Graph *generate_rmat(Int scale, Int edge_factor, double a, double b, double c)
+{
+    if (scale < 1 || scale > 40 || edge_factor < 1 || a < 0 || b < 0 || c < 0
+        || a + b + c > 1)
+        return NULL;
+
+    Int n      = ((Int)1) << scale;
+    Int ndraws = edge_factor * n;
+
+    Int *src = (Int *)SuiteSparse_malloc(static_cast<size_t>(ndraws),
+                                         sizeof(Int));
+    Int *dst = (Int *)SuiteSparse_malloc(static_cast<size_t>(ndraws),
+                                         sizeof(Int));
+    if (!src || !dst)
+    {
+        SuiteSparse_free(src);
+        SuiteSparse_free(dst);
+        return NULL;
+    }
+
+    for (Int e = 0; e < ndraws; e++)
+    {
+        Int u = 0, v = 0;
+        for (Int bit = 0; bit < scale; bit++)
+        {
+            /* Pick the quadrant with the (a, b, c, d) skew at every
+             * level of the adjacency-matrix recursion. */
+            double r = (double)(random() % 1000000) / 1000000.;
+            u <<= 1;
+            v <<= 1;
+            if (r < a)
+            {
+                /* top-left: neither bit set */
+            }
+            else if (r < a + b)
+            {
+                v |= 1;
+            }
+            else if (r < a + b + c)
+            {
+                u |= 1;
+            }
+            else
+            {
+                u |= 1;
+                v |= 1;
+            }
+        }
+        src[e] = u;
+        dst[e] = v;
+    }
+
+    Graph *graph = buildFromEdges(n, src, dst, ndraws);
+    SuiteSparse_free(src);
+    SuiteSparse_free(dst);
+    return graph;
+}
+
+Graph *generate_geometric(Int n, double radius)
+{
+    if (n < 1 || radius <= 0 || radius > 1)
+        return NULL;
+
+    double *px = (double *)SuiteSparse_malloc(static_cast<size_t>(n),
+                                              sizeof(double));
+    double *py = (double *)SuiteSparse_malloc(static_cast<size_t>(n),
+                                              sizeof(double));
+    if (!px || !py)
+    {
+        SuiteSparse_free(px);
+        SuiteSparse_free(py);
+        return NULL;
+    }
+    for (Int v = 0; v < n; v++)
+    {
+        px[v] = (double)(random() % 1000000) / 1000000.;
+        py[v] = (double)(random() % 1000000) / 1000000.;
+    }
+
+    /* Bucket grid of radius-sized cells: every neighbor of a point lies
+     * in its own or an adjacent cell, so the pair search is linear in
+     * the output. */
+    Int cells = (Int)(1. / radius);
+    if (cells < 1)
+        cells = 1;
+    Int ncells = cells * cells;
+
+    Int *cellStart = (Int *)SuiteSparse_calloc(
+        static_cast<size_t>(ncells + 1), sizeof(Int));
+    Int *order = (Int *)SuiteSparse_malloc(static_cast<size_t>(n),
+                                           sizeof(Int));
+    if (!cellStart || !order)
+    {
+        SuiteSparse_free(px);
+        SuiteSparse_free(py);
+        SuiteSparse_free(cellStart);
+        SuiteSparse_free(order);
+        return NULL;
+    }
+
+    #define GEO_CELL(v)                                                       \
+        (std::min((Int)(py[v] * cells), cells - 1) * cells                    \
+         + std::min((Int)(px[v] * cells), cells - 1))
+
+    for (Int v = 0; v < n; v++)
+    {
+        cellStart[GEO_CELL(v) + 1]++;
+    }
+    for (Int cell = 0; cell < ncells; cell++)
+    {
+        cellStart[cell + 1] += cellStart[cell];
+    }
+    /* Temporarily advance cellStart while scattering; rewind after. */
+    for (Int v = 0; v < n; v++)
+    {
+        order[cellStart[GEO_CELL(v)]++] = v;
+    }
+    for (Int cell = ncells; cell > 0; cell--)
+    {
+        cellStart[cell] = cellStart[cell - 1];
+    }
+    cellStart[0] = 0;
+
+    /* Two passes over the 3x3 cell neighborhoods: count each vertex's
+     * degree, then fill the sorted-by-construction... the neighbor
+     * order within a row is by cell then by position, so rows are
+     * sorted explicitly afterwards by buildFromEdges's machinery being
+     * bypassed -- instead collect directed pairs (u < v) and reuse
+     * buildFromEdges for the symmetric sorted CSR. */
+    Int ndraws = 0;
+    double r2  = radius * radius;
+    for (int pass = 0; pass < 2; pass++)
+    {
+        Int *src = NULL, *dst = NULL;
+        if (pass == 1)
+        {
+            src = (Int *)SuiteSparse_malloc(
+                static_cast<size_t>(std::max(ndraws, (Int)1)), sizeof(Int));
+            dst = (Int *)SuiteSparse_malloc(
+                static_cast<size_t>(std::max(ndraws, (Int)1)), sizeof(Int));
+            if (!src || !dst)
+            {
+                SuiteSparse_free(src);
+                SuiteSparse_free(dst);
+                SuiteSparse_free(px);
+                SuiteSparse_free(py);
+                SuiteSparse_free(cellStart);
+                SuiteSparse_free(order);
+                return NULL;
+            }
+        }
+
+        Int found = 0;
+        for (Int cy = 0; cy < cells; cy++)
+        {
+            for (Int cx = 0; cx < cells; cx++)
+            {
+                Int cell = cy * cells + cx;
+                for (Int s = cellStart[cell]; s < cellStart[cell + 1]; s++)
+                {
+                    Int u = order[s];
+                    for (Int dy = -1; dy <= 1; dy++)
+                    {
+                        for (Int dx = -1; dx <= 1; dx++)
+                        {
+                            Int ny = cy + dy, nx = cx + dx;
+                            if (ny < 0 || ny >= cells || nx < 0
+                                || nx >= cells)
+                                continue;
+                            Int ncell = ny * cells + nx;
+                            for (Int t = cellStart[ncell];
+                                 t < cellStart[ncell + 1]; t++)
+                            {
+                                Int v = order[t];
+                                if (v <= u)
+                                    continue;
+                                double ex = px[u] - px[v];
+                                double ey = py[u] - py[v];
+                                if (ex * ex + ey * ey > r2)
+                                    continue;
+                                if (pass == 1)
+                                {
+                                    src[found] = u;
+                                    dst[found] = v;
+                                }
+                                found++;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        if (pass == 0)
+        {
+            ndraws = found;
+        }
+        else
+        {
+            Graph *graph = buildFromEdges(n, src, dst, ndraws);
+            SuiteSparse_free(src);
+            SuiteSparse_free(dst);
+            SuiteSparse_free(px);
+            SuiteSparse_free(py);
+            SuiteSparse_free(cellStart);
+            SuiteSparse_free(order);
+            return graph;
+        }
+    }
+
+    /* Unreachable; the second pass always returns. */
+    return NULL;
+
+    #undef GEO_CELL
+}
+
+} // end namespace Mongoose
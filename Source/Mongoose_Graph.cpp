@@ -9,6 +9,7 @@
  * Mongoose is also available under other licenses; contact authors for details.
  * -------------------------------------------------------------------------- */
 
+#include "Mongoose_Arena.hpp"
 #include "Mongoose_Graph.hpp"
 
 #include <algorithm>
@@ -27,8 +28,8 @@ Graph::Graph()
     w      = NULL;
 }
 
-Graph *Graph::create(const Int _n, const Int _nz, Int *_p, Int *_i, double *_x,
-                     double *_w)
+Graph *Graph::create(const Int _n, const Int _nz, Int *_p, Int *_i,
+                     WeightType *_x, WeightType *_w)
 {
     void *memoryLocation = SuiteSparse_malloc(1, sizeof(Graph));
     if (!memoryLocation)
@@ -61,6 +62,10 @@ Graph *Graph::create(const Int _n, const Int _nz, Int *_p, Int *_i, double *_x,
         graph->~Graph();
         return NULL;
     }
+    if (!graph->shallow_i)
+    {
+        adviseHugePages(graph->i, nz * sizeof(Int));
+    }
 
     return graph;
 }
@@ -102,6 +107,8 @@ Graph *Graph::create(cs *matrix, bool free_when_done)
     graph->shallow_p = !free_when_done;
     graph->shallow_i = !free_when_done;
     graph->shallow_x = !free_when_done;
+    graph->shallow_w = false; /* no w yet; the destructor must not read an
+                                 uninitialized flag */
 
     return graph;
 }
@@ -110,8 +117,8 @@ Graph::~Graph()
 {
     p = (shallow_p) ? NULL : (Int *)SuiteSparse_free(p);
     i = (shallow_i) ? NULL : (Int *)SuiteSparse_free(i);
-    x = (shallow_x) ? NULL : (double *)SuiteSparse_free(x);
-    w = (shallow_w) ? NULL : (double *)SuiteSparse_free(w);
+    x = (shallow_x) ? NULL : (WeightType *)SuiteSparse_free(x);
+    w = (shallow_w) ? NULL : (WeightType *)SuiteSparse_free(w);
 
     SuiteSparse_free(this);
 }
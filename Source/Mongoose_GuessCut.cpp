@@ -10,14 +10,529 @@
  * -------------------------------------------------------------------------- */
 
 #include "Mongoose_GuessCut.hpp"
+#include "Mongoose_ImproveFM.hpp"
 #include "Mongoose_ImproveQP.hpp"
 #include "Mongoose_Internal.hpp"
 #include "Mongoose_Random.hpp"
+#include "Mongoose_ThreadPool.hpp"
 #include "Mongoose_Waterdance.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if CPP11_OR_LATER
+#include <vector>
+#endif
+
 namespace Mongoose
 {
 
+/* Coarsest graphs at or below this many vertices get the exact
+ * branch-and-bound bisection; anything larger falls back to the QP
+ * guess. At 40 vertices the pruned search is microseconds. */
+static const Int BB_GUESS_LIMIT = 40;
+
+/* State threaded through the branch-and-bound recursion. Costs use the
+ * solve-time convention (doubled cut weight, like bhLoad), so the bound
+ * and the final selection agree with the heuristic cost the refinement
+ * minimizes: cutCost + |imbalance| * H past the soft tolerance. */
+struct BBContext
+{
+    Int n;
+    const double *adj; /* dense n-by-n edge weights, search order */
+    const double *vw;  /* vertex weights, search order            */
+    double *suffixW;   /* total vertex weight from position k on  */
+    double W;
+    double H;
+    double targetSplit;
+    double tol;
+    double bestCost;
+    uint64_t bestMask; /* side-1 bits of the incumbent            */
+    uint64_t mask;     /* side-1 bits along the current path      */
+    long nodes;        /* node budget; exhausting it keeps the
+                          incumbent (the first descent always
+                          completes, so one always exists)        */
+};
+
+static void bbSearch(BBContext *bb, Int k, double cut2, double w0, double w1)
+{
+    if (bb->nodes-- <= 0)
+        return;
+
+    if (k == bb->n)
+    {
+        double imbalance
+            = fabs(bb->targetSplit - std::min(w0, w1) / bb->W);
+        double cost
+            = cut2 + (imbalance > bb->tol ? imbalance * bb->H : 0.0);
+        if (cost < bb->bestCost)
+        {
+            bb->bestCost = cost;
+            bb->bestMask = bb->mask;
+        }
+        return;
+    }
+
+    /* Bound: the cut only grows, and the best balance still reachable
+     * with the unassigned weight caps how small the penalty can get. */
+    double remaining = bb->suffixW[k];
+    double lo        = std::min(w0, w1);
+    double hi        = std::min(lo + remaining, bb->W / 2);
+    double reachable = std::min(std::max(bb->targetSplit * bb->W, lo), hi);
+    double imbalance = fabs(bb->targetSplit - reachable / bb->W);
+    double bound = cut2 + (imbalance > bb->tol ? imbalance * bb->H : 0.0);
+    if (bound >= bb->bestCost)
+        return;
+
+    /* Cut weight added by each side choice, against the assigned prefix. */
+    const double *row = bb->adj + (size_t)k * bb->n;
+    double d0 = 0., d1 = 0.;
+    for (Int j = 0; j < k; j++)
+    {
+        if ((bb->mask >> j) & 1)
+            d0 += row[j];
+        else
+            d1 += row[j];
+    }
+
+    /* Cheaper side first, so the first descent is greedy and every later
+     * prune has a strong incumbent to cut against. */
+    for (int pass = 0; pass < 2; pass++)
+    {
+        bool side1 = (d1 <= d0) == (pass == 0);
+        if (k == 0 && side1)
+            continue; /* fix vertex 0 to side 0: halves the space */
+        if (side1)
+        {
+            bb->mask |= ((uint64_t)1 << k);
+            bbSearch(bb, k + 1, cut2 + 2. * d1, w0, w1 + bb->vw[k]);
+            bb->mask &= ~((uint64_t)1 << k);
+        }
+        else
+        {
+            bbSearch(bb, k + 1, cut2 + 2. * d0, w0 + bb->vw[k], w1);
+        }
+    }
+}
+
+/* Decreasing incident-weight order, ties by vertex id (deterministic). */
+struct BBOrder
+{
+    const double *incident;
+    explicit BBOrder(const double *_incident) : incident(_incident) {}
+    bool operator()(Int a, Int b) const
+    {
+        return incident[a] > incident[b]
+               || (incident[a] == incident[b] && a < b);
+    }
+};
+
+/* Exact bisection of a tiny coarsest graph: branch-and-bound over the
+ * vertices in decreasing incident-weight order. Writes the partition;
+ * the caller loads the boundary heaps. */
+static bool guessCutExact(EdgeCutProblem *graph,
+                          const EdgeCut_Options *options)
+{
+    Int n = graph->n;
+    if (n > BB_GUESS_LIMIT)
+        return false;
+
+    const Int *Gp        = graph->p;
+    const Int *Gi        = graph->i;
+    const WeightType *Gx = graph->x;
+    const WeightType *Gw = graph->w;
+
+    /* One block for the dense adjacency and the small per-vertex arrays. */
+    size_t items = (size_t)n * n + 4 * (size_t)n + 1;
+    double *scratch
+        = (double *)SuiteSparse_calloc(items, sizeof(double));
+    if (!scratch)
+        return false;
+    double *adj      = scratch;
+    double *vw       = adj + (size_t)n * n;
+    double *incident = vw + n;
+    double *suffixW  = incident + n;
+
+    /* Order vertices by decreasing incident weight; heavy rows assigned
+     * early give the cut bound its bite. */
+    Int order[BB_GUESS_LIMIT];
+    Int rank[BB_GUESS_LIMIT];
+    for (Int v = 0; v < n; v++)
+    {
+        order[v] = v;
+        for (Int q = Gp[v]; q < Gp[v + 1]; q++)
+        {
+            incident[v] += (Gx) ? fabs((double)Gx[q]) : 1.;
+        }
+    }
+    std::sort(order, order + n, BBOrder(incident));
+    for (Int k = 0; k < n; k++)
+    {
+        rank[order[k]] = k;
+        vw[k]          = (Gw) ? (double)Gw[order[k]] : 1.;
+    }
+    for (Int v = 0; v < n; v++)
+    {
+        for (Int q = Gp[v]; q < Gp[v + 1]; q++)
+        {
+            Int u = Gi[q];
+            if (u == v)
+                continue;
+            adj[(size_t)rank[v] * n + rank[u]]
+                += (Gx) ? (double)Gx[q] : 1.;
+        }
+    }
+    for (Int k = n - 1; k >= 0; k--)
+    {
+        suffixW[k] = suffixW[k + 1] + vw[k];
+    }
+
+    BBContext bb;
+    bb.n           = n;
+    bb.adj         = adj;
+    bb.vw          = vw;
+    bb.suffixW     = suffixW;
+    bb.W           = graph->W;
+    bb.H           = graph->H;
+    bb.targetSplit = options->target_split;
+    bb.tol         = options->soft_split_tolerance;
+    bb.bestCost    = INFINITY;
+    bb.bestMask    = 0;
+    bb.mask        = 0;
+    bb.nodes       = 1L << 22;
+    bbSearch(&bb, 0, 0., 0., 0.);
+
+    for (Int v = 0; v < n; v++)
+    {
+        graph->setPartition(v, (bb.bestMask >> rank[v]) & 1);
+    }
+
+    SuiteSparse_free(scratch);
+    return true;
+}
+
+/* Iteration count for the spectral guess. The vector only seeds a cut
+ * that waterdance refines anyway, so a fixed small count beats a
+ * convergence test. */
+static const Int SPECTRAL_ITERATIONS = 64;
+
+/* Increasing Fiedler-coordinate order, ties by vertex id. */
+struct SpectralOrder
+{
+    const double *fiedler;
+    explicit SpectralOrder(const double *_fiedler) : fiedler(_fiedler) {}
+    bool operator()(Int a, Int b) const
+    {
+        return fiedler[a] < fiedler[b]
+               || (fiedler[a] == fiedler[b] && a < b);
+    }
+};
+
+/* Spectral guess: approximate the Fiedler vector of the coarsest
+ * graph's Laplacian L = D - A by shift-deflated power iteration
+ * (iterate v <- (sI - L)v with s past the Gershgorin bound, centering
+ * each step to deflate the constant eigenvector), then split at the
+ * weighted quantile that puts target_split of the vertex weight on
+ * side 1. The coarsest graph is tiny, so the iterations are noise next
+ * to one waterdance. */
+static bool guessCutSpectral(EdgeCutProblem *graph,
+                             const EdgeCut_Options *options)
+{
+    Int n = graph->n;
+    if (n < 2)
+        return false;
+
+    const Int *Gp        = graph->p;
+    const Int *Gi        = graph->i;
+    const WeightType *Gx = graph->x;
+    const WeightType *Gw = graph->w;
+
+    double *scratch = (double *)SuiteSparse_malloc(3 * (size_t)n,
+                                                   sizeof(double));
+    Int *order = (Int *)SuiteSparse_malloc((size_t)n, sizeof(Int));
+    if (!scratch || !order)
+    {
+        SuiteSparse_free(scratch);
+        SuiteSparse_free(order);
+        return false;
+    }
+    double *v      = scratch;
+    double *u      = v + n;
+    double *degree = u + n;
+
+    double shift = 0.;
+    for (Int k = 0; k < n; k++)
+    {
+        double d = 0.;
+        for (Int q = Gp[k]; q < Gp[k + 1]; q++)
+        {
+            d += (Gx) ? fabs((double)Gx[q]) : 1.;
+        }
+        degree[k] = d;
+        shift     = std::max(shift, 2. * d);
+    }
+    shift += 1.;
+
+    for (Int k = 0; k < n; k++)
+    {
+        v[k] = (double)(random() % 2001 - 1000) / 1000.;
+    }
+
+    for (Int iter = 0; iter < SPECTRAL_ITERATIONS; iter++)
+    {
+        /* Deflate the constant eigenvector and renormalize. */
+        double mean = 0.;
+        for (Int k = 0; k < n; k++)
+            mean += v[k];
+        mean /= n;
+        double norm = 0.;
+        for (Int k = 0; k < n; k++)
+        {
+            v[k] -= mean;
+            norm += v[k] * v[k];
+        }
+        if (norm == 0.)
+            break;
+        norm = 1. / sqrt(norm);
+        for (Int k = 0; k < n; k++)
+            v[k] *= norm;
+
+        /* u = (sI - L) v = (s - d) v + A v */
+        for (Int k = 0; k < n; k++)
+        {
+            double sum = (shift - degree[k]) * v[k];
+            for (Int q = Gp[k]; q < Gp[k + 1]; q++)
+            {
+                sum += ((Gx) ? (double)Gx[q] : 1.) * v[Gi[q]];
+            }
+            u[k] = sum;
+        }
+        std::swap(u, v);
+    }
+
+    /* Split at the weighted quantile: the smallest Fiedler coordinates
+     * take side 1 until it holds target_split of the vertex weight. */
+    for (Int k = 0; k < n; k++)
+        order[k] = k;
+    std::sort(order, order + n, SpectralOrder(v));
+
+    double side1 = 0.;
+    double want  = options->target_split * graph->W;
+    for (Int k = 0; k < n; k++)
+    {
+        Int vertex = order[k];
+        bool takes = (side1 < want);
+        graph->setPartition(vertex, takes);
+        if (takes)
+        {
+            side1 += (Gw) ? (double)Gw[vertex] : 1.;
+        }
+    }
+
+    SuiteSparse_free(scratch);
+    SuiteSparse_free(order);
+    return true;
+}
+
+/* BFS graph-growing guess: two breadth-first sweeps and no numerics at
+ * all, for callers who partition tiny subdomain graphs at high rates
+ * where the QP guess dominates the solve. The first BFS (from a random
+ * seed) finds a pseudo-peripheral vertex; the second grows a region
+ * from it until target_split of the vertex weight is absorbed into
+ * side 1. Disconnected remainders restart the sweep, so every vertex
+ * is visited and weight keeps accruing until the share is met. */
+static bool guessCutGrow(EdgeCutProblem *graph,
+                         const EdgeCut_Options *options)
+{
+    Int n = graph->n;
+    if (n < 1)
+        return false;
+
+    const Int *Gp        = graph->p;
+    const Int *Gi        = graph->i;
+    const WeightType *Gw = graph->w;
+
+    Int *queue = (Int *)SuiteSparse_malloc((size_t)n, sizeof(Int));
+    char *seen = (char *)SuiteSparse_calloc((size_t)n, sizeof(char));
+    if (!queue || !seen)
+    {
+        SuiteSparse_free(queue);
+        SuiteSparse_free(seen);
+        return false;
+    }
+
+    /* First sweep: the last vertex dequeued from a full BFS is
+     * pseudo-peripheral; growing from the periphery keeps the region's
+     * boundary short. */
+    Int start      = random() % n;
+    Int peripheral = start;
+    Int head = 0, tail = 0, scan = 0;
+    queue[tail++] = start;
+    seen[start]   = 1;
+    while (head < n)
+    {
+        if (head == tail)
+        {
+            /* Disconnected: restart from the lowest unseen vertex (the
+             * cursor only moves forward; seen bits never clear). */
+            while (seen[scan])
+                scan++;
+            queue[tail++] = scan;
+            seen[scan]    = 1;
+        }
+        Int v      = queue[head++];
+        peripheral = v;
+        for (Int q = Gp[v]; q < Gp[v + 1]; q++)
+        {
+            Int u = Gi[q];
+            if (!seen[u])
+            {
+                seen[u]       = 1;
+                queue[tail++] = u;
+            }
+        }
+    }
+
+    /* Second sweep: absorb BFS layers from the peripheral vertex into
+     * side 1 until it holds target_split of the vertex weight. */
+    memset(seen, 0, (size_t)n);
+    double want  = options->target_split * graph->W;
+    double side1 = 0.;
+    head = tail = scan = 0;
+    queue[tail++]    = peripheral;
+    seen[peripheral] = 1;
+    while (head < n)
+    {
+        if (head == tail)
+        {
+            while (seen[scan])
+                scan++;
+            queue[tail++] = scan;
+            seen[scan]    = 1;
+        }
+        Int v       = queue[head++];
+        bool absorb = (side1 < want);
+        graph->setPartition(v, absorb);
+        if (absorb)
+        {
+            side1 += (Gw) ? (double)Gw[v] : 1.;
+        }
+        for (Int q = Gp[v]; q < Gp[v + 1]; q++)
+        {
+            Int u = Gi[q];
+            if (!seen[u])
+            {
+                seen[u]       = 1;
+                queue[tail++] = u;
+            }
+        }
+    }
+
+    SuiteSparse_free(queue);
+    SuiteSparse_free(seen);
+    return true;
+}
+
+#if CPP11_OR_LATER
+
+//-----------------------------------------------------------------------------
+// One raced guess strategy on a thread-private clone: seed that clone's
+// RNG stream, then run the normal guess (including its brief waterdance).
+//-----------------------------------------------------------------------------
+static void guessRaceWorker(EdgeCutProblem *clone,
+                            const EdgeCut_Options *options)
+{
+    setRandomSeed(options->random_seed);
+    guessCut(clone, options);
+}
+
+//-----------------------------------------------------------------------------
+// Runs every concrete guess strategy concurrently on partition-state
+// clones, refines each for one dance, and commits the lowest heuCost.
+// The coarsest graph is tiny and the cores are otherwise idle during
+// this serial phase, so the race removes the guess-choice gamble for
+// negligible cost. Returns false if the clones could not be allocated
+// (caller falls back to the QP guess).
+//-----------------------------------------------------------------------------
+static bool guessCutBest(EdgeCutProblem *graph,
+                         const EdgeCut_Options *options)
+{
+    InitialEdgeCutType strategies[6]
+        = { InitialEdgeCut_QP,       InitialEdgeCut_Random,
+            InitialEdgeCut_NaturalOrder, InitialEdgeCut_Spectral,
+            InitialEdgeCut_GraphGrowing, InitialEdgeCut_QP };
+    Int ns = 5;
+    if (graph->n <= BB_GUESS_LIMIT)
+    {
+        /* Small enough for the exact search: let it join the race. */
+        strategies[ns++] = InitialEdgeCut_BranchAndBound;
+    }
+
+    /* Raw array for the per-strategy options: ~EdgeCut_Options frees
+     * `this` (the factory pattern), so these copies must never be
+     * destroyed as C++ objects. */
+    EdgeCut_Options *memberOptions = (EdgeCut_Options *)SuiteSparse_malloc(
+        static_cast<size_t>(ns), sizeof(EdgeCut_Options));
+    if (!memberOptions)
+        return false;
+
+    std::vector<EdgeCutProblem *> clones(static_cast<size_t>(ns),
+                                         (EdgeCutProblem *)NULL);
+    for (Int t = 0; t < ns; t++)
+    {
+        clones[t] = EdgeCutProblem::create(graph->n, graph->nz, graph->p,
+                                           graph->i, graph->x, graph->w);
+        if (!clones[t])
+        {
+            for (Int u = 0; u < t; u++)
+            {
+                clones[u]->~EdgeCutProblem();
+            }
+            SuiteSparse_free(memberOptions);
+            return false;
+        }
+        copyRefinementState(clones[t], graph);
+        clones[t]->worstCaseRatio = graph->worstCaseRatio;
+        clones[t]->deadline       = graph->deadline;
+        /* The pooled QP workspace is not thread-safe to share; a NULL
+         * pool makes improveCutUsingQP allocate per call. */
+
+        memberOptions[t]                  = *options;
+        memberOptions[t].initial_cut_type = strategies[t];
+        memberOptions[t].random_seed      = options->random_seed + t;
+        /* Refine each candidate briefly; the winner gets the full
+         * waterdance from the caller. */
+        memberOptions[t].num_dances       = std::min(options->num_dances,
+                                                     (Int)1);
+        memberOptions[t].use_dance_racing = false;
+    }
+
+    EdgeCutProblem **clonesData = clones.data();
+    ThreadPool::run(ns, [=](Int t) {
+        guessRaceWorker(clonesData[t], &memberOptions[t]);
+    });
+
+    EdgeCutProblem *best = clones[0];
+    for (Int t = 1; t < ns; t++)
+    {
+        if (clones[t]->heuCost < best->heuCost)
+        {
+            best = clones[t];
+        }
+    }
+    copyRefinementState(graph, best);
+
+    for (Int t = 0; t < ns; t++)
+    {
+        clones[t]->~EdgeCutProblem();
+    }
+    SuiteSparse_free(memberOptions);
+    return true;
+}
+
+#endif
+
 //-----------------------------------------------------------------------------
 // This function takes a graph with options and computes the initial guess cut
 //-----------------------------------------------------------------------------
@@ -25,12 +540,49 @@ bool guessCut(EdgeCutProblem *graph, const EdgeCut_Options *options)
 {
     switch (options->initial_cut_type)
     {
+    case InitialEdgeCut_Best:
+#if CPP11_OR_LATER
+        if (guessCutBest(graph, options))
+        {
+            /* The winner's state (already bhLoaded and briefly refined)
+             * is in place; the shared waterdance below finishes it. */
+            break;
+        }
+#endif
+        /* No C++11 threads or OOM: fall through to the QP guess. */
+        // fall-through
+    case InitialEdgeCut_BranchAndBound:
+        if (guessCutExact(graph, options))
+        {
+            bhLoad(graph, options);
+            break;
+        }
+        /* Too large for the exact search: fall through to the QP guess. */
+        // fall-through
+    case InitialEdgeCut_Spectral:
+        if (options->initial_cut_type == InitialEdgeCut_Spectral
+            && guessCutSpectral(graph, options))
+        {
+            bhLoad(graph, options);
+            break;
+        }
+        /* Degenerate graph or OOM: fall through to the QP guess. */
+        // fall-through
+    case InitialEdgeCut_GraphGrowing:
+        if (options->initial_cut_type == InitialEdgeCut_GraphGrowing
+            && guessCutGrow(graph, options))
+        {
+            bhLoad(graph, options);
+            break;
+        }
+        /* OOM: fall through to the QP guess. */
+        // fall-through
     case InitialEdgeCut_QP:
         for (Int k = 0; k < graph->n; k++)
         {
-            graph->partition[k] = false;
+            graph->setPartition(k, false);
         }
-        graph->partition[0] = true;
+        graph->setPartition(0, true);
 
         bhLoad(graph, options);
         if (!improveCutUsingQP(graph, options, true))
@@ -42,7 +594,7 @@ bool guessCut(EdgeCutProblem *graph, const EdgeCut_Options *options)
     case InitialEdgeCut_Random:
         for (Int k = 0; k < graph->n; k++)
         {
-            graph->partition[k] = (random() % 2 == 0);
+            graph->setPartition(k, (random() % 2 == 0));
         }
 
         bhLoad(graph, options);
@@ -50,7 +602,7 @@ bool guessCut(EdgeCutProblem *graph, const EdgeCut_Options *options)
     case InitialEdgeCut_NaturalOrder:
         for (Int k = 0; k < graph->n; k++)
         {
-            graph->partition[k] = (k < graph->n / 2);
+            graph->setPartition(k, (k < graph->n / 2));
         }
         bhLoad(graph, options);
         break;
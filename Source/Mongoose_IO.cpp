@@ -19,27 +19,83 @@
  */
 
 #include "Mongoose_IO.hpp"
+#include "Mongoose_ThreadPool.hpp"
 #include "Mongoose_Internal.hpp"
 #include "Mongoose_Logger.hpp"
 #include "Mongoose_Sanitize.hpp"
+#include <cstring>
 #include <iostream>
 
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if CPP11_OR_LATER && !defined(_WIN32)
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+#endif
+
 using namespace std;
 
 namespace Mongoose
 {
 
+/* Binary graph container header. The header is 64 bytes, and every array
+ * that follows it (p, i, x, w) holds 8-byte elements, so each starts
+ * 8-byte aligned within the mapping. */
+struct BinaryGraphHeader
+{
+    char magic[8];   /* "MNGGRAPH"                                */
+    Int version;     /* Container version, currently 2            */
+    Int int_size;    /* sizeof(Int) at write time                 */
+    Int weight_size; /* sizeof(WeightType) at write time          */
+    Int n;         /* # vertices                                */
+    Int nz;        /* # edges                                   */
+    Int has_x;        /* 1 if the edge weight array follows i      */
+    Int has_w;        /* 1 if the node weight array follows x      */
+    Int content_hash; /* hash of the source file for cache sidecar
+                         files; zero when unused                  */
+};
+
+static const char binary_graph_magic[8]
+    = { 'M', 'N', 'G', 'G', 'R', 'A', 'P', 'H' };
+
+/* Mappings (or heap buffers, on platforms without mmap) backing the graphs
+ * returned by read_graph_binary, so free_graph_binary can release them. */
+struct BinaryGraphMapping
+{
+    Graph *graph;
+    void *base;
+    size_t length; /* 0 for a heap buffer */
+    BinaryGraphMapping *next;
+};
+static BinaryGraphMapping *binary_graph_mappings = NULL;
+
 Graph *read_graph(const std::string &filename)
 {
     return read_graph(filename.c_str());
 }
 
+Graph *read_graph(const std::string &filename, bool keep_largest_component)
+{
+    return read_graph(filename.c_str(), keep_largest_component);
+}
+
 cs *read_matrix(const std::string &filename, MM_typecode &matcode)
 {
     return read_matrix(filename.c_str(), matcode);
 }
 
 Graph *read_graph(const char *filename)
+{
+    return read_graph(filename, false);
+}
+
+Graph *read_graph(const char *filename, bool keep_largest_component)
 {
     Logger::tic(IOTiming);
     LogInfo("Reading graph from file " << std::string(filename) << "\n");
@@ -51,7 +107,8 @@ Graph *read_graph(const char *filename)
         LogError("Error reading matrix from file\n");
         return NULL;
     }
-    cs *sanitized_A = sanitizeMatrix(A, mm_is_symmetric(matcode), false);
+    cs *sanitized_A = sanitizeMatrix(A, mm_is_symmetric(matcode), false,
+                                     keep_largest_component);
     cs_spfree(A);
     if (!sanitized_A)
         return NULL;
@@ -76,6 +133,375 @@ Graph *read_graph(const char *filename)
     return G;
 }
 
+#if CPP11_OR_LATER && !defined(_WIN32)
+
+/* Parallel Matrix Market entry parser. The entry lines are mapped and
+ * split at newline boundaries into per-thread chunks; each chunk is
+ * scanned once to count its entries and once to parse them directly into
+ * the shared triplet arrays at precomputed offsets. The custom number
+ * routines below run branch-light over the mapped bytes instead of one
+ * fscanf call per entry. */
+
+static inline bool mtxIsSpace(char c)
+{
+    return (c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v'
+            || c == '\f');
+}
+
+/* Parse a (possibly signed) decimal integer. Returns the position past
+ * the number, or NULL if no digits were found. */
+static const char *mtxParseLong(const char *s, const char *end, long *out)
+{
+    while (s < end && mtxIsSpace(*s))
+        s++;
+    bool negative = false;
+    if (s < end && (*s == '+' || *s == '-'))
+    {
+        negative = (*s == '-');
+        s++;
+    }
+    long value = 0;
+    bool any   = false;
+    while (s < end && *s >= '0' && *s <= '9')
+    {
+        value = 10 * value + (*s - '0');
+        s++;
+        any = true;
+    }
+    if (!any)
+        return NULL;
+    *out = (negative) ? -value : value;
+    return s;
+}
+
+/* Powers of ten exactly representable in double (10^0 .. 10^22). */
+static const double mtxPow10[]
+    = { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+        1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+        1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+/* Parse a floating-point value. The common case -- at most 15 significant
+ * digits and a scale within 10^+-22 -- is one integer accumulation plus
+ * one exactly-rounded multiply or divide, matching strtod bit-for-bit.
+ * Longer or unusual tokens (inf, nan, extreme exponents) are copied out
+ * and handed to strtod. Returns NULL on a malformed token. */
+static const char *mtxParseDouble(const char *s, const char *end, double *out)
+{
+    while (s < end && mtxIsSpace(*s))
+        s++;
+    const char *token = s;
+
+    bool negative = false;
+    if (s < end && (*s == '+' || *s == '-'))
+    {
+        negative = (*s == '-');
+        s++;
+    }
+
+    long mantissa = 0;
+    int digits    = 0;
+    int exponent  = 0;
+    bool any      = false;
+    bool precise  = true;
+    while (s < end && *s >= '0' && *s <= '9')
+    {
+        if (digits < 15)
+        {
+            mantissa = 10 * mantissa + (*s - '0');
+            if (mantissa != 0)
+                digits++;
+        }
+        else
+        {
+            exponent++;
+            precise = false;
+        }
+        s++;
+        any = true;
+    }
+    if (s < end && *s == '.')
+    {
+        s++;
+        while (s < end && *s >= '0' && *s <= '9')
+        {
+            if (digits < 15)
+            {
+                mantissa = 10 * mantissa + (*s - '0');
+                if (mantissa != 0)
+                    digits++;
+                exponent--;
+            }
+            else
+            {
+                precise = false;
+            }
+            s++;
+            any = true;
+        }
+    }
+    if (s < end && (*s == 'e' || *s == 'E'))
+    {
+        s++;
+        long e = 0;
+        s      = mtxParseLong(s, end, &e);
+        if (!s)
+            return NULL;
+        exponent += (int)e;
+    }
+
+    if (any && precise && exponent >= -22 && exponent <= 22)
+    {
+        double value = (double)mantissa;
+        value        = (exponent >= 0) ? value * mtxPow10[exponent]
+                                       : value / mtxPow10[-exponent];
+        *out = (negative) ? -value : value;
+        return s;
+    }
+
+    /* Slow path: copy the whole token (also covers inf/nan) to a
+     * NUL-terminated buffer and let strtod decide. */
+    const char *tokenEnd = token;
+    while (tokenEnd < end && !mtxIsSpace(*tokenEnd))
+        tokenEnd++;
+    char buffer[64];
+    size_t tokenLength = static_cast<size_t>(tokenEnd - token);
+    if (tokenLength == 0 || tokenLength >= sizeof(buffer))
+        return NULL;
+    memcpy(buffer, token, tokenLength);
+    buffer[tokenLength] = '\0';
+    char *parseEnd;
+    *out = strtod(buffer, &parseEnd);
+    if (parseEnd != buffer + tokenLength)
+        return NULL;
+    return tokenEnd;
+}
+
+/* Counts the entry lines (lines with any non-whitespace) in a chunk. */
+static void mtxCountWorker(const char *s, const char *end, long *count)
+{
+    long lines    = 0;
+    bool sawToken = false;
+    for (; s < end; s++)
+    {
+        if (*s == '\n')
+        {
+            if (sawToken)
+                lines++;
+            sawToken = false;
+        }
+        else if (!mtxIsSpace(*s))
+        {
+            sawToken = true;
+        }
+    }
+    if (sawToken)
+        lines++; /* final line without a trailing newline */
+    *count = lines;
+}
+
+/* Parses the entries of one chunk into I/J/val at [k, kEnd), converting
+ * to 0-based indices (and filling unit values for pattern matrices). */
+static void mtxParseWorker(const char *s, const char *end, bool pattern,
+                           long M, long N, Int *I, Int *J, WeightType *val,
+                           long k, long kEnd, bool *ok)
+{
+    while (true)
+    {
+        while (s < end && mtxIsSpace(*s))
+            s++;
+        if (s >= end)
+            break;
+
+        long i = 0, j = 0;
+        double value = 1;
+        s            = mtxParseLong(s, end, &i);
+        if (s)
+            s = mtxParseLong(s, end, &j);
+        if (s && !pattern)
+            s = mtxParseDouble(s, end, &value);
+        if (!s || i < 1 || i > M || j < 1 || j > N || k >= kEnd)
+        {
+            *ok = false;
+            return;
+        }
+
+        I[k]   = i - 1;
+        J[k]   = j - 1;
+        val[k] = value;
+        k++;
+    }
+    *ok = (k == kEnd);
+}
+
+/* Maps the remainder of the open Matrix Market file (the entry lines) and
+ * parses it with one chunk per hardware thread. Returns false on any
+ * anomaly -- mapping failure, malformed entry, or an entry count that
+ * disagrees with the header -- and the caller falls back to the serial
+ * mmio parser, which has not consumed any input. */
+static bool readTripletsParallel(FILE *file, long M, long N, long nz,
+                                 bool pattern, Int *I, Int *J,
+                                 WeightType *val)
+{
+    long offset = ftell(file);
+    if (offset < 0)
+        return false;
+
+    struct stat st;
+    if (fstat(fileno(file), &st) != 0)
+        return false;
+    size_t length = static_cast<size_t>(st.st_size);
+    if ((long)length <= offset)
+        return (nz == 0);
+
+    void *base = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fileno(file), 0);
+    if (base == MAP_FAILED)
+        return false;
+    const char *data = static_cast<const char *>(base) + offset;
+    const char *end  = static_cast<const char *>(base) + length;
+
+    /* One chunk per hardware thread, split at newline boundaries; small
+     * files parse in a single chunk on the calling thread. */
+    size_t bytes = static_cast<size_t>(end - data);
+    long nthreads = 1;
+    long hw       = (long)ThreadPool::maxThreads();
+    if (hw > 1 && bytes >= (size_t)(1 << 20))
+        nthreads = std::min(hw, (long)16);
+
+    std::vector<const char *> bounds(static_cast<size_t>(nthreads) + 1);
+    bounds[0]        = data;
+    bounds[nthreads] = end;
+    for (long t = 1; t < nthreads; t++)
+    {
+        const char *cut = data + (bytes * (size_t)t) / (size_t)nthreads;
+        while (cut < end && *cut != '\n')
+            cut++;
+        if (cut < end)
+            cut++;
+        bounds[t] = std::max(cut, bounds[t - 1]);
+    }
+
+    /* Pass 1: count the entries per chunk, then prefix-sum the counts
+     * into each chunk's first triplet index. */
+    std::vector<long> counts(nthreads, 0);
+    if (nthreads > 1)
+    {
+        const char **boundsData = &bounds[0];
+        long *countsData        = &counts[0];
+        ThreadPool::run((Int)nthreads, [=](Int t) {
+            mtxCountWorker(boundsData[t], boundsData[t + 1], &countsData[t]);
+        });
+    }
+    else
+    {
+        mtxCountWorker(data, end, &counts[0]);
+    }
+
+    long total = 0;
+    std::vector<long> first(nthreads, 0);
+    for (long t = 0; t < nthreads; t++)
+    {
+        first[t] = total;
+        total += counts[t];
+    }
+    if (total != nz)
+    {
+        munmap(base, length);
+        return false;
+    }
+
+    /* Pass 2: parse each chunk into its disjoint triplet range. */
+    bool ok[16]; /* nthreads is capped at 16 above */
+    for (long t = 0; t < nthreads; t++)
+    {
+        ok[t] = true;
+    }
+    if (nthreads > 1)
+    {
+        const char **boundsData = &bounds[0];
+        long *countsData        = &counts[0];
+        long *firstData         = &first[0];
+        bool *okData            = ok;
+        ThreadPool::run((Int)nthreads, [=](Int t) {
+            mtxParseWorker(boundsData[t], boundsData[t + 1], pattern, M, N, I,
+                           J, val, firstData[t], firstData[t] + countsData[t],
+                           &okData[t]);
+        });
+    }
+    else
+    {
+        mtxParseWorker(data, end, pattern, M, N, I, J, val, 0, nz, &ok[0]);
+    }
+
+    munmap(base, length);
+    for (long t = 0; t < nthreads; t++)
+    {
+        if (!ok[t])
+            return false;
+    }
+    return true;
+}
+
+#endif
+
+/* Compressed-input support: gzip and zstd files are recognized by their
+ * magic bytes (not the extension) and stream-decompressed through a pipe
+ * into the parser, so decompression overlaps parsing and nothing touches
+ * the disk twice. Returns the decompressor command, or NULL for plain
+ * text. */
+static const char *matrixDecompressor(const char *filename)
+{
+    FILE *file = fopen(filename, "rb");
+    if (!file)
+        return NULL;
+    unsigned char magic[4] = { 0, 0, 0, 0 };
+    size_t got             = fread(magic, 1, 4, file);
+    fclose(file);
+    if (got >= 2 && magic[0] == 0x1f && magic[1] == 0x8b)
+        return "gzip -dc";
+    if (got >= 4 && magic[0] == 0x28 && magic[1] == 0xb5 && magic[2] == 0x2f
+        && magic[3] == 0xfd)
+        return "zstd -dcq";
+    return NULL;
+}
+
+#if !defined(_WIN32)
+/* Opens a pipe reading the decompressed bytes of filename. */
+static FILE *openMatrixPipe(const char *decompressor, const char *filename)
+{
+    /* Single-quote the filename for the shell, escaping embedded quotes. */
+    std::string command(decompressor);
+    command += " '";
+    for (const char *s = filename; *s; s++)
+    {
+        if (*s == '\'')
+        {
+            command += "'\\''";
+        }
+        else
+        {
+            command += *s;
+        }
+    }
+    command += "'";
+    return popen(command.c_str(), "r");
+}
+#endif
+
+/* fclose or pclose, depending on how the matrix stream was opened. */
+static void closeMatrixStream(FILE *file, bool piped)
+{
+#if !defined(_WIN32)
+    if (piped)
+    {
+        pclose(file);
+        return;
+    }
+#else
+    (void)piped;
+#endif
+    fclose(file);
+}
+
 cs *read_matrix(const char *filename, MM_typecode &matcode)
 {
     LogInfo("Reading Matrix from " << std::string(filename) << "\n");
@@ -86,11 +512,34 @@ cs *read_matrix(const char *filename, MM_typecode &matcode)
         return NULL;
     }
 
+    bool piped               = false;
+    const char *decompressor = matrixDecompressor(filename);
+    if (decompressor)
+    {
+#if !defined(_WIN32)
+        fclose(file);
+        LogInfo("Decompressing through " << std::string(decompressor)
+                                         << "\n");
+        file  = openMatrixPipe(decompressor, filename);
+        piped = true;
+        if (!file)
+        {
+            LogError("Error: Cannot start decompressor\n");
+            return NULL;
+        }
+#else
+        LogError("Error: Compressed input is not supported on this "
+                 "platform\n");
+        fclose(file);
+        return NULL;
+#endif
+    }
+
     LogInfo("Reading Matrix Market banner...");
     if (mm_read_banner(file, &matcode) != 0)
     {
         LogError("Error: Could not process Matrix Market banner\n");
-        fclose(file);
+        closeMatrixStream(file, piped);
         return NULL;
     }
     if (!mm_is_matrix(matcode) || !mm_is_sparse(matcode)
@@ -98,7 +547,7 @@ cs *read_matrix(const char *filename, MM_typecode &matcode)
     {
         LogError(
             "Error: Unsupported matrix format - Must be real and sparse\n");
-        fclose(file);
+        closeMatrixStream(file, piped);
         return NULL;
     }
 
@@ -106,21 +555,27 @@ cs *read_matrix(const char *filename, MM_typecode &matcode)
     if ((mm_read_mtx_crd_size(file, &M, &N, &nz)) != 0)
     {
         LogError("Error: Could not parse matrix dimension and size.\n");
-        fclose(file);
+        closeMatrixStream(file, piped);
         return NULL;
     }
     if (M != N)
     {
         LogError("Error: Matrix must be square.\n");
-        fclose(file);
+        closeMatrixStream(file, piped);
+        return NULL;
+    }
+    if (M > (long)MAX_INT || nz > (long)MAX_INT)
+    {
+        LogError("Error: Matrix too large for this build's index type.\n");
+        closeMatrixStream(file, piped);
         return NULL;
     }
 
     LogInfo("Reading matrix data...\n");
     Int *I = (Int *)SuiteSparse_malloc(static_cast<size_t>(nz), sizeof(Int));
     Int *J = (Int *)SuiteSparse_malloc(static_cast<size_t>(nz), sizeof(Int));
-    double *val
-        = (double *)SuiteSparse_malloc(static_cast<size_t>(nz), sizeof(double));
+    WeightType *val = (WeightType *)SuiteSparse_malloc(
+        static_cast<size_t>(nz), sizeof(WeightType));
 
     if (!I || !J || !val)
     {
@@ -128,20 +583,89 @@ cs *read_matrix(const char *filename, MM_typecode &matcode)
         SuiteSparse_free(I);
         SuiteSparse_free(J);
         SuiteSparse_free(val);
-        fclose(file);
+        closeMatrixStream(file, piped);
         return NULL;
     }
 
-    mm_read_mtx_crd_data(file, M, N, nz, (long*)I, (long*)J, val, matcode);
-    fclose(file); // Close the file
-
-    for (Int k = 0; k < nz; k++)
+    bool parsed = false;
+#if CPP11_OR_LATER && !defined(_WIN32)
+    /* Fast path: map the entry lines and parse them in parallel chunks
+     * (0-based indices and pattern values are produced directly). Any
+     * anomaly falls through to the serial mmio parser below. */
+    parsed = readTripletsParallel(file, M, N, nz, mm_is_pattern(matcode), I,
+                                  J, val);
+#endif
+    if (!parsed)
     {
-        --I[k];
-        --J[k];
-        if (mm_is_pattern(matcode))
-            val[k] = 1;
+        /* The float-weight build cannot alias its value array as double;
+         * stage the values through a double array and narrow them, like
+         * the index staging below. */
+        double *dval = (sizeof(WeightType) == sizeof(double))
+                           ? (double *)val
+                           : (double *)SuiteSparse_malloc(
+                                 static_cast<size_t>(nz), sizeof(double));
+        if (!dval)
+        {
+            LogError("Error: Ran out of memory in Mongoose::read_matrix\n");
+            SuiteSparse_free(I);
+            SuiteSparse_free(J);
+            SuiteSparse_free(val);
+            closeMatrixStream(file, piped);
+            return NULL;
+        }
+        if (sizeof(Int) == sizeof(long))
+        {
+            mm_read_mtx_crd_data(file, M, N, nz, (long *)I, (long *)J, dval,
+                                 matcode);
+        }
+        else
+        {
+            /* The int32 build cannot alias its Int arrays as long; stage
+             * the indices through long arrays and narrow them. */
+            long *lI = (long *)SuiteSparse_malloc(static_cast<size_t>(nz),
+                                                  sizeof(long));
+            long *lJ = (long *)SuiteSparse_malloc(static_cast<size_t>(nz),
+                                                  sizeof(long));
+            if (!lI || !lJ)
+            {
+                LogError("Error: Ran out of memory in Mongoose::read_matrix\n");
+                SuiteSparse_free(lI);
+                SuiteSparse_free(lJ);
+                SuiteSparse_free(I);
+                SuiteSparse_free(J);
+                SuiteSparse_free(val);
+                if ((void *)dval != (void *)val)
+                    SuiteSparse_free(dval);
+                closeMatrixStream(file, piped);
+                return NULL;
+            }
+            mm_read_mtx_crd_data(file, M, N, nz, lI, lJ, dval, matcode);
+            for (Int k = 0; k < nz; k++)
+            {
+                I[k] = (Int)lI[k];
+                J[k] = (Int)lJ[k];
+            }
+            SuiteSparse_free(lI);
+            SuiteSparse_free(lJ);
+        }
+        if ((void *)dval != (void *)val)
+        {
+            for (Int k = 0; k < nz; k++)
+            {
+                val[k] = (WeightType)dval[k];
+            }
+            SuiteSparse_free(dval);
+        }
+
+        for (Int k = 0; k < nz; k++)
+        {
+            --I[k];
+            --J[k];
+            if (mm_is_pattern(matcode))
+                val[k] = 1;
+        }
     }
+    closeMatrixStream(file, piped); // Close the file
 
     cs *A = (cs *)SuiteSparse_malloc(1, sizeof(cs));
     if (!A)
@@ -173,4 +697,657 @@ cs *read_matrix(const char *filename, MM_typecode &matcode)
     return compressed_A;
 }
 
+Graph *read_graph_streaming(const std::string &filename)
+{
+    return read_graph_streaming(filename.c_str());
+}
+
+#if CPP11_OR_LATER && !defined(_WIN32)
+
+/* One CSR entry, used to sort a column by row index. */
+struct MtxEntry
+{
+    Int i;
+    double x;
+};
+
+static bool mtxEntryLess(const MtxEntry &a, const MtxEntry &b)
+{
+    return a.i < b.i;
+}
+
+#endif
+
+Graph *read_graph_streaming(const char *filename)
+{
+#if CPP11_OR_LATER && !defined(_WIN32)
+    if (matrixDecompressor(filename))
+    {
+        /* Compressed input cannot be mapped; the standard loader streams
+         * it through a decompressor pipe instead. */
+        return read_graph(filename);
+    }
+
+    Logger::tic(IOTiming);
+    LogInfo("Streaming graph from file " << std::string(filename) << "\n");
+
+    FILE *file = fopen(filename, "r");
+    if (!file)
+    {
+        LogError("Error: Cannot read file " << std::string(filename) << "\n");
+        Logger::toc(IOTiming);
+        return NULL;
+    }
+
+    MM_typecode matcode;
+    long M = 0, N = 0, nz = 0;
+    if (mm_read_banner(file, &matcode) != 0 || !mm_is_matrix(matcode)
+        || !mm_is_sparse(matcode) || mm_is_complex(matcode)
+        || mm_read_mtx_crd_size(file, &M, &N, &nz) != 0 || M != N)
+    {
+        LogError("Error: Unsupported matrix format - Must be real, sparse, "
+                 "and square\n");
+        fclose(file);
+        Logger::toc(IOTiming);
+        return NULL;
+    }
+    bool pattern = mm_is_pattern(matcode);
+
+    /* Symmetric storage holds one triangle and is mirrored verbatim;
+     * general storage is symmetrized as (A+A')/2, so each entry lands on
+     * both sides at half weight and coincident entries are summed. This
+     * matches what sanitizeMatrix produces on the same input. */
+    bool mirror = mm_is_symmetric(matcode);
+    double scale = (mirror) ? 1.0 : 0.5;
+
+    /* Map the entry lines; the mapping outlives the FILE. */
+    long offset = ftell(file);
+    struct stat st;
+    if (offset < 0 || fstat(fileno(file), &st) != 0)
+    {
+        fclose(file);
+        Logger::toc(IOTiming);
+        return NULL;
+    }
+    size_t length    = static_cast<size_t>(st.st_size);
+    const char *base = NULL;
+    if ((long)length > offset)
+    {
+        void *map = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fileno(file), 0);
+        if (map == MAP_FAILED)
+        {
+            LogError("Error: Cannot map file " << std::string(filename)
+                                               << "\n");
+            fclose(file);
+            Logger::toc(IOTiming);
+            return NULL;
+        }
+        base = static_cast<const char *>(map);
+    }
+    fclose(file);
+    const char *data = (base) ? base + offset : NULL;
+    const char *end  = (base) ? base + length : NULL;
+
+    size_t n = static_cast<size_t>(M);
+    Int *Cp  = (Int *)SuiteSparse_calloc(n + 1, sizeof(Int));
+    Int *Ci        = NULL;
+    WeightType *Cx = NULL;
+    Int *cursor    = NULL;
+    MtxEntry *sortSpace = NULL;
+    bool ok        = (Cp != NULL);
+
+    /* Pass 1: count the symmetrized column degrees (diagonal dropped). */
+    long seen = 0;
+    if (ok)
+    {
+        const char *s = data;
+        while (s && s < end)
+        {
+            while (s < end && mtxIsSpace(*s))
+                s++;
+            if (s >= end)
+                break;
+            long i = 0, j = 0;
+            double value = 1;
+            s            = mtxParseLong(s, end, &i);
+            if (s)
+                s = mtxParseLong(s, end, &j);
+            if (s && !pattern)
+                s = mtxParseDouble(s, end, &value);
+            if (!s || i < 1 || i > M || j < 1 || j > N)
+            {
+                ok = false;
+                break;
+            }
+            if (i != j)
+            {
+                Cp[j]++; /* entry (i,j) lands in column j-1 -> bucket j */
+                Cp[i]++;
+            }
+            seen++;
+        }
+        ok = ok && (seen == nz);
+    }
+
+    Int total = 0;
+    if (ok)
+    {
+        /* The count for column k sits at Cp[k + 1], so an in-place prefix
+         * sum turns the counts into column pointers. */
+        for (size_t k = 1; k <= n; k++)
+        {
+            Cp[k] += Cp[k - 1];
+        }
+        total = Cp[n];
+
+        Ci     = (Int *)SuiteSparse_malloc(static_cast<size_t>(total),
+                                           sizeof(Int));
+        Cx     = (WeightType *)SuiteSparse_malloc(static_cast<size_t>(total),
+                                                  sizeof(WeightType));
+        cursor = (Int *)SuiteSparse_malloc(n, sizeof(Int));
+        ok = (total == 0) || (Ci && Cx && cursor);
+    }
+
+    /* Pass 2: scatter the entries directly into the final CSR arrays. */
+    if (ok && total > 0)
+    {
+        for (size_t k = 0; k < n; k++)
+        {
+            cursor[k] = Cp[k];
+        }
+        const char *s = data;
+        while (s < end)
+        {
+            while (s < end && mtxIsSpace(*s))
+                s++;
+            if (s >= end)
+                break;
+            long i = 0, j = 0;
+            double value = 1;
+            s            = mtxParseLong(s, end, &i);
+            s            = mtxParseLong(s, end, &j);
+            if (!pattern)
+                s = mtxParseDouble(s, end, &value);
+            if (i != j)
+            {
+                Int pj       = cursor[j - 1]++;
+                Ci[pj]       = i - 1;
+                Cx[pj]       = scale * value;
+                Int pi       = cursor[i - 1]++;
+                Ci[pi]       = j - 1;
+                Cx[pi]       = scale * value;
+            }
+        }
+
+        /* Sort each column by row index; the scratch buffer is bounded by
+         * the largest column degree. */
+        Int maxDegree = 0;
+        for (size_t k = 0; k < n; k++)
+        {
+            maxDegree = std::max(maxDegree, Cp[k + 1] - Cp[k]);
+        }
+        sortSpace = (MtxEntry *)SuiteSparse_malloc(
+            static_cast<size_t>(maxDegree), sizeof(MtxEntry));
+        ok = (sortSpace != NULL);
+        if (ok)
+        {
+            for (size_t k = 0; k < n; k++)
+            {
+                Int degree = Cp[k + 1] - Cp[k];
+                Int start  = Cp[k];
+                for (Int d = 0; d < degree; d++)
+                {
+                    sortSpace[d].i = Ci[start + d];
+                    sortSpace[d].x = Cx[start + d];
+                }
+                std::sort(sortSpace, sortSpace + degree, mtxEntryLess);
+                for (Int d = 0; d < degree; d++)
+                {
+                    Ci[start + d] = sortSpace[d].i;
+                    Cx[start + d] = sortSpace[d].x;
+                }
+            }
+            sortSpace = (MtxEntry *)SuiteSparse_free(sortSpace);
+
+            if (!mirror)
+            {
+                /* Merge coincident entries (both storage directions of the
+                 * same edge, and any duplicates) by summing, as cs_add
+                 * does in the sanitizing path. */
+                Int write  = 0;
+                Int oldCp  = Cp[0];
+                for (size_t k = 0; k < n; k++)
+                {
+                    for (Int p = oldCp; p < Cp[k + 1]; p++)
+                    {
+                        if (write > Cp[k] && Ci[write - 1] == Ci[p])
+                        {
+                            Cx[write - 1] += Cx[p];
+                        }
+                        else
+                        {
+                            Ci[write] = Ci[p];
+                            Cx[write] = Cx[p];
+                            write++;
+                        }
+                    }
+                    oldCp     = Cp[k + 1];
+                    Cp[k + 1] = write;
+                }
+                total = write;
+            }
+
+            /* Force edge weights to be positive (see sanitizeMatrix). */
+            for (Int p = 0; p < total; p++)
+            {
+                Cx[p] = fabs(Cx[p]);
+            }
+        }
+    }
+
+    cursor = (Int *)SuiteSparse_free(cursor);
+    if (base)
+    {
+        munmap((void *)base, length);
+    }
+
+    Graph *G = NULL;
+    if (ok)
+    {
+        cs C;
+        C.nzmax = total;
+        C.m     = M;
+        C.n     = N;
+        C.p     = Cp;
+        C.i     = Ci;
+        C.x     = Cx;
+        C.nz    = -1;
+        G       = Graph::create(&C, true); /* the graph owns the arrays */
+    }
+    if (!G)
+    {
+        if (ok)
+        {
+            LogError("Ran out of memory in Mongoose::read_graph_streaming\n");
+        }
+        else
+        {
+            LogError("Error parsing matrix in Mongoose::read_graph_streaming\n");
+        }
+        SuiteSparse_free(Cp);
+        SuiteSparse_free(Ci);
+        SuiteSparse_free(Cx);
+        Logger::toc(IOTiming);
+        return NULL;
+    }
+
+    Logger::toc(IOTiming);
+    return G;
+#else
+    /* No mmap available: use the standard loader. */
+    return read_graph(filename);
+#endif
+}
+
+bool write_graph_binary(const Graph *graph, const std::string &filename)
+{
+    return write_graph_binary(graph, filename.c_str());
+}
+
+static bool writeGraphBinaryHashed(const Graph *graph, const char *filename,
+                                   Int content_hash)
+{
+    if (!graph || !graph->p || !graph->i || !filename)
+        return false;
+
+    Logger::tic(IOTiming);
+    LogInfo("Writing binary graph to file " << std::string(filename) << "\n");
+
+    FILE *file = fopen(filename, "wb");
+    if (!file)
+    {
+        LogError("Error: Cannot write file " << std::string(filename) << "\n");
+        Logger::toc(IOTiming);
+        return false;
+    }
+
+    BinaryGraphHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, binary_graph_magic, sizeof(header.magic));
+    header.version     = 2;
+    header.int_size    = static_cast<Int>(sizeof(Int));
+    header.weight_size = static_cast<Int>(sizeof(WeightType));
+    header.n        = graph->n;
+    header.nz       = graph->nz;
+    header.has_x    = (graph->x != NULL);
+    header.has_w    = (graph->w != NULL);
+    header.content_hash = content_hash;
+
+    size_t n  = static_cast<size_t>(graph->n);
+    size_t nz = static_cast<size_t>(graph->nz);
+
+    bool ok = (fwrite(&header, sizeof(header), 1, file) == 1)
+              && (fwrite(graph->p, sizeof(Int), n + 1, file) == n + 1)
+              && (nz == 0 || fwrite(graph->i, sizeof(Int), nz, file) == nz)
+              && (!graph->x || nz == 0
+                  || fwrite(graph->x, sizeof(WeightType), nz, file) == nz)
+              && (!graph->w || n == 0
+                  || fwrite(graph->w, sizeof(WeightType), n, file) == n);
+    ok = (fclose(file) == 0) && ok;
+
+    if (!ok)
+    {
+        LogError("Error writing binary graph to file\n");
+    }
+    Logger::toc(IOTiming);
+    return ok;
+}
+
+bool write_graph_binary(const Graph *graph, const char *filename)
+{
+    return writeGraphBinaryHashed(graph, filename, 0);
+}
+
+Graph *read_graph_binary(const std::string &filename)
+{
+    return read_graph_binary(filename.c_str());
+}
+
+Graph *read_graph_binary(const char *filename)
+{
+    Logger::tic(IOTiming);
+    LogInfo("Mapping binary graph from file " << std::string(filename)
+                                              << "\n");
+
+    void *base    = NULL;
+    size_t length = 0;
+    size_t mapped = 0; /* nonzero when base is an mmap region */
+
+#if !defined(_WIN32)
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0)
+    {
+        LogError("Error: Cannot read file " << std::string(filename) << "\n");
+        Logger::toc(IOTiming);
+        return NULL;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(BinaryGraphHeader))
+    {
+        LogError("Error: Not a binary graph file\n");
+        close(fd);
+        Logger::toc(IOTiming);
+        return NULL;
+    }
+    length = static_cast<size_t>(st.st_size);
+    base   = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); /* the mapping keeps the file alive */
+    if (base == MAP_FAILED)
+    {
+        LogError("Error: Cannot map file " << std::string(filename) << "\n");
+        Logger::toc(IOTiming);
+        return NULL;
+    }
+    mapped = length;
+#else
+    /* No mmap: read the whole container into one heap block; the arrays
+     * are still used in place with zero parsing. */
+    FILE *file = fopen(filename, "rb");
+    if (!file)
+    {
+        LogError("Error: Cannot read file " << std::string(filename) << "\n");
+        Logger::toc(IOTiming);
+        return NULL;
+    }
+    fseek(file, 0, SEEK_END);
+    long fileSize = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (fileSize < (long)sizeof(BinaryGraphHeader))
+    {
+        LogError("Error: Not a binary graph file\n");
+        fclose(file);
+        Logger::toc(IOTiming);
+        return NULL;
+    }
+    length = static_cast<size_t>(fileSize);
+    base   = SuiteSparse_malloc(length, 1);
+    if (!base || fread(base, 1, length, file) != length)
+    {
+        LogError("Error reading binary graph from file\n");
+        SuiteSparse_free(base);
+        fclose(file);
+        Logger::toc(IOTiming);
+        return NULL;
+    }
+    fclose(file);
+#endif
+
+    /* Validate the header. A foreign byte order or integer width shows up
+     * as a mismatched int_size. */
+    BinaryGraphHeader header;
+    memcpy(&header, base, sizeof(header));
+    size_t n        = static_cast<size_t>(header.n);
+    size_t nz       = static_cast<size_t>(header.nz);
+    size_t expected = sizeof(BinaryGraphHeader) + (n + 1) * sizeof(Int)
+                      + nz * sizeof(Int)
+                      + (header.has_x ? nz : 0) * sizeof(WeightType)
+                      + (header.has_w ? n : 0) * sizeof(WeightType);
+    if (memcmp(header.magic, binary_graph_magic, sizeof(header.magic)) != 0
+        || header.version != 2 || header.int_size != (Int)sizeof(Int)
+        || header.weight_size != (Int)sizeof(WeightType) || header.n < 0
+        || header.nz < 0 || length < expected)
+    {
+        LogError("Error: Not a compatible binary graph file\n");
+#if !defined(_WIN32)
+        munmap(base, length);
+#else
+        SuiteSparse_free(base);
+#endif
+        Logger::toc(IOTiming);
+        return NULL;
+    }
+
+    /* Carve the arrays out of the mapping and wrap them shallowly. */
+    char *cursor = static_cast<char *>(base) + sizeof(BinaryGraphHeader);
+    Int *Gp      = reinterpret_cast<Int *>(cursor);
+    cursor += (n + 1) * sizeof(Int);
+    Int *Gi = reinterpret_cast<Int *>(cursor);
+    cursor += nz * sizeof(Int);
+    WeightType *Gx = NULL;
+    if (header.has_x)
+    {
+        Gx = reinterpret_cast<WeightType *>(cursor);
+        cursor += nz * sizeof(WeightType);
+    }
+    WeightType *Gw = NULL;
+    if (header.has_w)
+    {
+        Gw = reinterpret_cast<WeightType *>(cursor);
+    }
+
+    Graph *G = Graph::create(header.n, header.nz, Gp, Gi, Gx, Gw);
+    BinaryGraphMapping *entry = NULL;
+    if (G)
+    {
+        entry = (BinaryGraphMapping *)SuiteSparse_malloc(
+            1, sizeof(BinaryGraphMapping));
+    }
+    if (!G || !entry)
+    {
+        LogError("Ran out of memory in Mongoose::read_graph_binary\n");
+        if (G)
+            G->~Graph();
+#if !defined(_WIN32)
+        munmap(base, length);
+#else
+        SuiteSparse_free(base);
+#endif
+        Logger::toc(IOTiming);
+        return NULL;
+    }
+
+    entry->graph          = G;
+    entry->base           = base;
+    entry->length         = mapped;
+    entry->next           = binary_graph_mappings;
+    binary_graph_mappings = entry;
+
+    Logger::toc(IOTiming);
+    return G;
+}
+
+void free_graph_binary(Graph *graph)
+{
+    if (!graph)
+        return;
+
+    for (BinaryGraphMapping **link = &binary_graph_mappings; *link;
+         link = &(*link)->next)
+    {
+        BinaryGraphMapping *entry = *link;
+        if (entry->graph == graph)
+        {
+            *link = entry->next;
+            graph->~Graph();
+#if !defined(_WIN32)
+            if (entry->length > 0)
+            {
+                munmap(entry->base, entry->length);
+            }
+            else
+#endif
+            {
+                SuiteSparse_free(entry->base);
+            }
+            SuiteSparse_free(entry);
+            return;
+        }
+    }
+
+    /* Not one of ours: destroy the graph anyway (its arrays are shallow,
+     * so there is nothing else to release). */
+    LogError("free_graph_binary: graph was not read from a binary file\n");
+    graph->~Graph();
+}
+
+/* FNV-1a hash of the file bytes; cheap next to parsing the file. Returns
+ * 0 when the file cannot be read, which doubles as "no hash". */
+static Int graphFileHash(const char *filename)
+{
+    FILE *file = fopen(filename, "rb");
+    if (!file)
+        return 0;
+    unsigned long long hash = 0xcbf29ce484222325ULL;
+    unsigned char buffer[65536];
+    size_t got;
+    while ((got = fread(buffer, 1, sizeof(buffer), file)) > 0)
+    {
+        for (size_t k = 0; k < got; k++)
+        {
+            hash ^= buffer[k];
+            hash *= 0x100000001b3ULL;
+        }
+    }
+    fclose(file);
+    if (hash == 0)
+        hash = 1; /* keep 0 meaning "no hash" */
+    return static_cast<Int>(hash);
+}
+
+/* Loads a cache sidecar into heap-owned arrays (unlike read_graph_binary,
+ * the result is an ordinary Graph with no mapping behind it). Returns NULL
+ * unless the sidecar is a valid container stamped with content_hash. */
+static Graph *readGraphCacheFile(const char *cachename, Int content_hash)
+{
+    FILE *file = fopen(cachename, "rb");
+    if (!file)
+        return NULL;
+
+    BinaryGraphHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1
+        || memcmp(header.magic, binary_graph_magic, sizeof(header.magic)) != 0
+        || header.version != 2 || header.int_size != (Int)sizeof(Int)
+        || header.weight_size != (Int)sizeof(WeightType)
+        || header.content_hash != content_hash || header.n < 0
+        || header.nz < 0 || header.has_w)
+    {
+        fclose(file);
+        return NULL;
+    }
+
+    size_t n  = static_cast<size_t>(header.n);
+    size_t nz = static_cast<size_t>(header.nz);
+
+    Int *Gp    = (Int *)SuiteSparse_malloc(n + 1, sizeof(Int));
+    Int *Gi    = (Int *)SuiteSparse_malloc(nz, sizeof(Int));
+    WeightType *Gx = (header.has_x)
+                         ? (WeightType *)SuiteSparse_malloc(nz,
+                                                            sizeof(WeightType))
+                         : NULL;
+
+    bool ok = Gp && Gi && (!header.has_x || Gx)
+              && (fread(Gp, sizeof(Int), n + 1, file) == n + 1)
+              && (nz == 0 || fread(Gi, sizeof(Int), nz, file) == nz)
+              && (!header.has_x || nz == 0
+                  || fread(Gx, sizeof(WeightType), nz, file) == nz);
+    fclose(file);
+
+    Graph *G = NULL;
+    if (ok)
+    {
+        cs C;
+        C.nzmax = header.nz;
+        C.m     = header.n;
+        C.n     = header.n;
+        C.p     = Gp;
+        C.i     = Gi;
+        C.x     = Gx;
+        C.nz    = -1;
+        G       = Graph::create(&C, true);
+    }
+    if (!G)
+    {
+        SuiteSparse_free(Gp);
+        SuiteSparse_free(Gi);
+        SuiteSparse_free(Gx);
+    }
+    return G;
+}
+
+Graph *read_graph_cached(const std::string &filename)
+{
+    return read_graph_cached(filename.c_str());
+}
+
+Graph *read_graph_cached(const char *filename)
+{
+    if (!filename)
+        return NULL;
+
+    Int hash = graphFileHash(filename);
+    if (hash == 0)
+        return read_graph(filename); /* unreadable; let read_graph report */
+
+    std::string cachename(filename);
+    cachename += ".graphbin";
+
+    Logger::tic(IOTiming);
+    Graph *G = readGraphCacheFile(cachename.c_str(), hash);
+    Logger::toc(IOTiming);
+    if (G)
+    {
+        LogInfo("Loaded sanitized graph from cache "
+                << cachename << "\n");
+        return G;
+    }
+
+    G = read_graph(filename);
+    if (!G)
+        return NULL;
+
+    /* Best effort: a failed write leaves the cache absent, never wrong. */
+    writeGraphBinaryHashed(G, cachename.c_str(), hash);
+    return G;
+}
+
 } // end namespace Mongoose
@@ -10,14 +10,183 @@
  * -------------------------------------------------------------------------- */
 
 #include "Mongoose_ImproveFM.hpp"
+#include "Mongoose_ThreadPool.hpp"
+#include "Mongoose_Workspace.hpp"
 #include "Mongoose_BoundaryHeap.hpp"
 #include "Mongoose_Debug.hpp"
+#include "Mongoose_GainBuckets.hpp"
 #include "Mongoose_Internal.hpp"
 #include "Mongoose_Logger.hpp"
+#include "Mongoose_Random.hpp"
+
+#include "Mongoose_Simd.hpp"
+
+#if MONGOOSE_SIMD_AVX2
+#include <immintrin.h>
+#endif
+
+#if CPP11_OR_LATER
+#include <vector>
+#endif
 
 namespace Mongoose
 {
 
+static void fmRefine_buckets_worker(EdgeCutProblem *graph,
+                                    const EdgeCut_Options *options,
+                                    GainBuckets *buckets);
+static void fmSwapBuckets(EdgeCutProblem *graph, const EdgeCut_Options *options,
+                          GainBuckets *buckets, Int vertex, double gain,
+                          bool oldPartition);
+static void fmSwapDeferred(EdgeCutProblem *graph,
+                           const EdgeCut_Options *options, Int vertex,
+                           double gain, bool oldPartition, Int *dirty,
+                           bool *isDirty, Int *dirtyCount);
+static void flushHeapRepairs(EdgeCutProblem *graph, Int *dirty, bool *isDirty,
+                             Int *dirtyCount);
+
+/* One journaled mutation: the gain and external degree a vertex held
+ * before a move touched it. Restoring entries in reverse order rewinds
+ * the arrays to any earlier point of the sweep. */
+struct JournalEntry
+{
+    Int index;
+    double gain;
+    Int exD;
+};
+
+static void fmRefine_journal_worker(EdgeCutProblem *graph,
+                                    const EdgeCut_Options *options);
+static void fmSwapJournal(EdgeCutProblem *graph,
+                          const EdgeCut_Options *options, Int vertex,
+                          double gain, bool oldPartition,
+                          JournalEntry *journal, Int *journalCount);
+
+//-----------------------------------------------------------------------------
+// Copies the partition/boundary refinement state from one problem to
+// another sharing the same structure (n, nz, p, i, x, w). Used by the
+// speculative multi-try FM sweeps below and by the racing waterdance.
+//-----------------------------------------------------------------------------
+void copyRefinementState(EdgeCutProblem *dst, const EdgeCutProblem *src)
+{
+    Int n = src->n;
+    for (Int k = 0; k < n; k++)
+    {
+        dst->fmData[k] = src->fmData[k];
+    }
+
+    /* The partition is bit-packed; copy it a word at a time. */
+    Int words = EdgeCutProblem::partitionWords(n);
+    for (Int k = 0; k < words; k++)
+    {
+        dst->partition[k] = src->partition[k];
+    }
+    for (Int h = 0; h < 2; h++)
+    {
+        dst->bhSize[h] = src->bhSize[h];
+        for (Int c = 0; c < src->bhSize[h]; c++)
+        {
+            dst->bhHeap[h][c] = src->bhHeap[h][c];
+        }
+    }
+
+    dst->heuCost   = src->heuCost;
+    dst->cutCost   = src->cutCost;
+    dst->cutSize   = src->cutSize;
+    dst->W0        = src->W0;
+    dst->W1        = src->W1;
+    dst->imbalance = src->imbalance;
+    dst->X         = src->X;
+    dst->W         = src->W;
+    dst->H         = src->H;
+    dst->qpLambda  = src->qpLambda;
+}
+
+#if CPP11_OR_LATER
+
+//-----------------------------------------------------------------------------
+// Runs a full FM refinement (all passes) on a thread-private clone.
+//-----------------------------------------------------------------------------
+static void fmTryWorker(EdgeCutProblem *clone, const EdgeCut_Options *options)
+{
+    double heuCost = INFINITY;
+    for (Int i = 0;
+         i < options->FM_max_num_refinements && clone->heuCost < heuCost; i++)
+    {
+        heuCost = clone->heuCost;
+        fmRefine_worker(clone, options);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Speculative multi-try FM: launches FM_num_tries sweeps on thread-private
+// copies of the partition and boundary state, each with a slightly wider
+// candidate scan, and commits the sweep with the lowest heuristic cost.
+// Returns false if the clones could not be allocated (caller refines in
+// place instead).
+//-----------------------------------------------------------------------------
+static bool improveCutUsingFM_multiTry(EdgeCutProblem *graph,
+                                       const EdgeCut_Options *options)
+{
+    Int numTries = options->FM_num_tries;
+
+    /* The per-try option structs live in a raw array: ~EdgeCut_Options
+     * frees `this` (the factory pattern), so they must never be destroyed
+     * as C++ objects. */
+    EdgeCut_Options *tryOptions = (EdgeCut_Options *)SuiteSparse_malloc(
+        static_cast<size_t>(numTries), sizeof(EdgeCut_Options));
+    if (!tryOptions)
+        return false;
+
+    std::vector<EdgeCutProblem *> clones(numTries, (EdgeCutProblem *)NULL);
+    for (Int t = 0; t < numTries; t++)
+    {
+        clones[t] = EdgeCutProblem::create(graph->n, graph->nz, graph->p,
+                                           graph->i, graph->x, graph->w);
+        if (!clones[t])
+        {
+            for (Int u = 0; u < t; u++)
+            {
+                clones[u]->~EdgeCutProblem();
+            }
+            SuiteSparse_free(tryOptions);
+            return false;
+        }
+        copyRefinementState(clones[t], graph);
+
+        /* Each try scans a few more candidates per move than the last, so
+         * the sweeps commit different move sequences. */
+        tryOptions[t]                   = *options;
+        tryOptions[t].FM_consider_count = options->FM_consider_count + t;
+        tryOptions[t].FM_num_tries      = 1;
+    }
+
+    EdgeCutProblem **clonesData = clones.data();
+    ThreadPool::run(numTries, [=](Int t) {
+        fmTryWorker(clonesData[t], &tryOptions[t]);
+    });
+
+    /* Commit the best sweep. */
+    EdgeCutProblem *best = clones[0];
+    for (Int t = 1; t < numTries; t++)
+    {
+        if (clones[t]->heuCost < best->heuCost)
+        {
+            best = clones[t];
+        }
+    }
+    copyRefinementState(graph, best);
+
+    for (Int t = 0; t < numTries; t++)
+    {
+        clones[t]->~EdgeCutProblem();
+    }
+    SuiteSparse_free(tryOptions);
+    return true;
+}
+
+#endif
+
 //-----------------------------------------------------------------------------
 // Wrapper for Fidducia-Mattheyes cut improvement.
 //-----------------------------------------------------------------------------
@@ -28,12 +197,82 @@ void improveCutUsingFM(EdgeCutProblem *graph, const EdgeCut_Options *options)
     if (!options->use_FM)
         return;
 
+#if CPP11_OR_LATER
+    /* Speculative multi-try refinement: idle cores run extra sweeps and
+     * the best one wins. Falls through to in-place refinement if the
+     * thread-private copies cannot be allocated. */
+    if (options->FM_num_tries > 1 && graph->n > 1)
+    {
+        if (improveCutUsingFM_multiTry(graph, options))
+        {
+            Logger::toc(FMTiming);
+            return;
+        }
+    }
+#endif
+
+    /* If requested (and the gains are integral), move the boundary into
+     * gain buckets for the duration of the refinement so every gain update
+     * is O(1) rather than a heapify. */
+    GainBuckets *buckets = NULL;
+    if (options->use_gain_buckets)
+    {
+        Int maxGain = 0;
+        if (gainBucketsSuitable(graph, &maxGain))
+        {
+            buckets = GainBuckets::create(graph->n, maxGain);
+        }
+        /* On OOM or unsuitable gains, fall through to the heaps. */
+    }
+
+    if (buckets)
+    {
+        for (Int h = 0; h < 2; h++)
+        {
+            for (Int c = 0; c < graph->bhSize[h]; c++)
+            {
+                BHEntry entry = graph->bhHeap[h][c];
+                buckets->insert(entry.vertex, static_cast<bool>(h),
+                                static_cast<Int>(entry.gain));
+            }
+        }
+    }
+
     double heuCost = INFINITY;
     for (Int i = 0;
          i < options->FM_max_num_refinements && graph->heuCost < heuCost; i++)
     {
         heuCost = graph->heuCost;
-        fmRefine_worker(graph, options);
+        if (buckets)
+        {
+            fmRefine_buckets_worker(graph, options, buckets);
+        }
+        else if (options->use_FM_move_journal)
+        {
+            fmRefine_journal_worker(graph, options);
+        }
+        else
+        {
+            fmRefine_worker(graph, options);
+        }
+    }
+
+    if (buckets)
+    {
+        /* Rebuild the heaps from the final boundary so the QP phase (and
+         * any later FM pass without buckets) sees a consistent structure.
+         * Gains and external degrees were maintained incrementally. */
+        for (Int k = 0; k < graph->n; k++)
+        {
+            graph->fmData[k].bhIndex = 0;
+        }
+        graph->bhSize[0] = graph->bhSize[1] = 0;
+        for (Int k = 0; k < graph->n; k++)
+        {
+            if (graph->fmData[k].externalDegree > 0)
+                bhInsert(graph, k);
+        }
+        buckets->~GainBuckets();
     }
 
     Logger::toc(FMTiming);
@@ -45,18 +284,38 @@ void improveCutUsingFM(EdgeCutProblem *graph, const EdgeCut_Options *options)
 //-----------------------------------------------------------------------------
 void fmRefine_worker(EdgeCutProblem *graph, const EdgeCut_Options *options)
 {
-    double *Gw          = graph->w;
-    double W            = graph->W;
-    Int **bhHeap        = graph->bhHeap;
-    Int *bhSize         = graph->bhSize;
-    Int *externalDegree = graph->externalDegree;
-    double *gains       = graph->vertexGains;
-    bool *partition     = graph->partition;
+    WeightType *Gw   = graph->w;
+    double W         = graph->W;
+    BHEntry **bhHeap = graph->bhHeap;
+    Int *bhSize      = graph->bhSize;
+    FMVertexData *fm = graph->fmData;
 
-    /* Keep a stack of moved vertices. */
-    Int *stack = graph->matchmap;
+    /* Keep a stack of moved vertices. (This used to borrow matchmap as
+     * scratch, but the matching must survive refinement now that the
+     * hierarchy can be retained for numeric-only re-solves.) */
+    Int *stack = graph->fmStack;
     Int head = 0, tail = 0;
 
+    /* In deferred-repair mode, fmSwap only patches the packed gains and
+     * records the touched boundary vertices here; the heaps are repaired
+     * in one batch before the next candidate extraction. */
+    Int *dirty     = NULL;
+    bool *isDirty  = NULL;
+    Int dirtyCount = 0;
+    if (options->use_deferred_heap_repair)
+    {
+        size_t gn     = static_cast<size_t>(graph->n);
+        Workspace *ws = graph->getWorkspace();
+        dirty         = (ws) ? ws->getInts(gn) : NULL;
+        isDirty       = (dirty) ? ws->getFlags(gn) : NULL;
+        if (!dirty || !isDirty)
+        {
+            /* Out of memory: do the repairs eagerly instead. */
+            dirty   = NULL;
+            isDirty = NULL;
+        }
+    }
+
     /* create & initialize a working cost and a best cost. */
     struct CutCost workingCost, bestCost;
     workingCost.heuCost = bestCost.heuCost = graph->heuCost;
@@ -71,29 +330,60 @@ void fmRefine_worker(EdgeCutProblem *graph, const EdgeCut_Options *options)
 
     Int fmSearchDepth   = options->FM_search_depth;
     Int fmConsiderCount = options->FM_consider_count;
+    bool sampleTies     = options->use_FM_tie_sampling;
     Int i               = 0;
     bool productive     = true;
     for (; i < fmSearchDepth && productive; i++)
     {
         productive = false;
 
+        /* Settle any deferred repairs so the heap tops are current. */
+        if (dirty && dirtyCount > 0)
+        {
+            flushHeapRepairs(graph, dirty, isDirty, &dirtyCount);
+        }
+
         /* Look for the best vertex to swap: */
         struct SwapCandidate bestCandidate;
+        Int tieCount = 0;
         for (Int h = 0; h < 2; h++)
         {
-            Int *heap = bhHeap[h];
-            Int size  = bhSize[h];
+            BHEntry *heap = bhHeap[h];
+            Int size      = bhSize[h];
+
+            /* In sampling mode the candidates after the heap top are drawn
+             * at random from the heap's top window -- the first
+             * fmConsiderCount levels' worth of entries, which hold the
+             * approximate top-k of the boundary -- instead of taken in
+             * strict heap order. On meshes where thousands of boundary
+             * vertices share a gain, the strict prefix pins every step to
+             * the same few entries; the sampled window spreads the moves
+             * over equally good candidates. The true maximum (position 0)
+             * is always considered. */
+            Int window = 0;
+            if (sampleTies && size > fmConsiderCount)
+            {
+                window = fmConsiderCount * MONGOOSE_BH_ARITY + 1;
+                if (window > size)
+                {
+                    window = size;
+                }
+            }
             for (Int c = 0; c < fmConsiderCount && c < size; c++)
             {
+                Int pos = (window > 0 && c > 0)
+                              ? 1 + (Int)(random() % (window - 1))
+                              : c;
+
                 /* Read the vertex, and if it's marked, try the next one. */
-                Int v = heap[c];
+                Int v = heap[pos].vertex;
                 if (graph->isMarked(v))
                 {
                     continue;
                 }
 
-                /* Read the gain for the vertex. */
-                double gain = gains[v];
+                /* Read the gain packed next to the vertex. */
+                double gain = heap[pos].gain;
 
                 /* The balance penalty is the penalty to assess for the move. */
                 double vertexWeight = (Gw) ? Gw[v] : 1;
@@ -122,9 +412,29 @@ void fmRefine_worker(EdgeCutProblem *graph, const EdgeCut_Options *options)
                     bestCandidate.partition    = static_cast<bool>(h);
                     bestCandidate.vertexWeight = vertexWeight;
                     bestCandidate.gain         = gain;
-                    bestCandidate.bhPosition   = c;
+                    bestCandidate.bhPosition   = pos;
                     bestCandidate.imbalance    = imbalance;
                     bestCandidate.heuCost      = heuCost;
+                    tieCount                   = 1;
+                }
+                /* In sampling mode ties are broken uniformly at random via
+                 * reservoir sampling, so meshes where many boundary
+                 * vertices share a gain don't always move the one that
+                 * happens to sit first in heap order. */
+                else if (sampleTies && tieCount > 0
+                         && heuCost == bestCandidate.heuCost)
+                {
+                    tieCount++;
+                    if (random() % tieCount == 0)
+                    {
+                        bestCandidate.vertex       = v;
+                        bestCandidate.partition    = static_cast<bool>(h);
+                        bestCandidate.vertexWeight = vertexWeight;
+                        bestCandidate.gain         = gain;
+                        bestCandidate.bhPosition   = pos;
+                        bestCandidate.imbalance    = imbalance;
+                        bestCandidate.heuCost      = heuCost;
+                    }
                 }
             }
         }
@@ -141,8 +451,17 @@ void fmRefine_worker(EdgeCutProblem *graph, const EdgeCut_Options *options)
             stack[tail++] = bestCandidate.vertex;
 
             /* Swap & update the vertex and its neighbors afterwards. */
-            fmSwap(graph, options, bestCandidate.vertex, bestCandidate.gain,
-                   bestCandidate.partition);
+            if (dirty)
+            {
+                fmSwapDeferred(graph, options, bestCandidate.vertex,
+                               bestCandidate.gain, bestCandidate.partition,
+                               dirty, isDirty, &dirtyCount);
+            }
+            else
+            {
+                fmSwap(graph, options, bestCandidate.vertex,
+                       bestCandidate.gain, bestCandidate.partition);
+            }
 
             /* Update the cut cost. */
             workingCost.cutCost -= 2.0 * bestCandidate.gain;
@@ -166,6 +485,12 @@ void fmRefine_worker(EdgeCutProblem *graph, const EdgeCut_Options *options)
         }
     }
 
+    /* Settle outstanding repairs; the undo sweep works on live heaps. */
+    if (dirty && dirtyCount > 0)
+    {
+        flushHeapRepairs(graph, dirty, isDirty, &dirtyCount);
+    }
+
     /* We've exhausted our search space, so undo all suboptimal moves. */
     for (Int u = tail - 1; u >= head; u--)
     {
@@ -181,13 +506,14 @@ void fmRefine_worker(EdgeCutProblem *graph, const EdgeCut_Options *options)
          * this vertex to the boundary already. */
         if (bhVertexPosition != -1)
         {
-            bhRemove(graph, options, vertex, gains[vertex], partition[vertex],
-                     bhVertexPosition);
+            bhRemove(graph, options, vertex, fm[vertex].gain,
+                     graph->getPartition(vertex), bhVertexPosition);
         }
 
         /* Swap the partition and compute the impact on neighbors. */
-        fmSwap(graph, options, vertex, gains[vertex], partition[vertex]);
-        if (externalDegree[vertex] > 0)
+        fmSwap(graph, options, vertex, fm[vertex].gain,
+               graph->getPartition(vertex));
+        if (fm[vertex].externalDegree > 0)
             bhInsert(graph, vertex);
     }
 
@@ -198,7 +524,7 @@ void fmRefine_worker(EdgeCutProblem *graph, const EdgeCut_Options *options)
     for (Int k = 0; k < head; k++)
     {
         Int vertex = stack[k];
-        if (externalDegree[vertex] > 0 && !graph->BH_inBoundary(vertex))
+        if (fm[vertex].externalDegree > 0 && !graph->BH_inBoundary(vertex))
         {
             bhInsert(graph, vertex);
         }
@@ -207,6 +533,9 @@ void fmRefine_worker(EdgeCutProblem *graph, const EdgeCut_Options *options)
     // clear the marks from all the vertices
     graph->clearMarkArray();
 
+    MONGOOSE_COUNT_ADD(FMMovesAttemptedCounter, tail);
+    MONGOOSE_COUNT_ADD(FMMovesAcceptedCounter, head);
+
     /* Save the best cost back into the graph. */
     graph->heuCost   = bestCost.heuCost;
     graph->cutCost   = bestCost.cutCost;
@@ -216,116 +545,995 @@ void fmRefine_worker(EdgeCutProblem *graph, const EdgeCut_Options *options)
 }
 
 //-----------------------------------------------------------------------------
-// This function swaps the partition of a vertex
+// Gain-bucket variant of fmRefine_worker. The move logic and cost
+// accounting are identical; only the boundary structure differs: candidates
+// are scanned from the highest non-empty bucket downward, and membership
+// updates go through the O(1) bucket operations instead of heapify calls.
 //-----------------------------------------------------------------------------
-void fmSwap(EdgeCutProblem *graph, const EdgeCut_Options *options, Int vertex, double gain,
-            bool oldPartition)
+static void fmRefine_buckets_worker(EdgeCutProblem *graph,
+                                    const EdgeCut_Options *options,
+                                    GainBuckets *buckets)
+{
+    WeightType *Gw   = graph->w;
+    double W         = graph->W;
+    FMVertexData *fm = graph->fmData;
+
+    /* Keep a stack of moved vertices. */
+    Int *stack = graph->fmStack;
+    Int head = 0, tail = 0;
+
+    /* create & initialize a working cost and a best cost. */
+    struct CutCost workingCost, bestCost;
+    workingCost.heuCost = bestCost.heuCost = graph->heuCost;
+    workingCost.cutCost = bestCost.cutCost = graph->cutCost;
+    workingCost.W[0] = bestCost.W[0] = graph->W0;
+    workingCost.W[1] = bestCost.W[1] = graph->W1;
+    workingCost.imbalance = bestCost.imbalance = graph->imbalance;
+
+    /* Tolerance and the linear penalty to assess. */
+    double tol = options->soft_split_tolerance;
+    double H   = graph->H;
+
+    Int fmSearchDepth   = options->FM_search_depth;
+    Int fmConsiderCount = options->FM_consider_count;
+    bool sampleTies     = options->use_FM_tie_sampling;
+    Int i               = 0;
+    bool productive     = true;
+    for (; i < fmSearchDepth && productive; i++)
+    {
+        productive = false;
+
+        /* Look for the best vertex to swap: */
+        struct SwapCandidate bestCandidate;
+        Int tieCount = 0;
+        for (Int h = 0; h < 2; h++)
+        {
+            bool side      = static_cast<bool>(h);
+            Int considered = 0;
+            for (Int b = buckets->maxBucket(side);
+                 b >= 0 && considered < fmConsiderCount; b--)
+            {
+                for (Int v = buckets->head(side, b);
+                     v != -1 && considered < fmConsiderCount;
+                     v = buckets->nextVertex(v))
+                {
+                    considered++;
+
+                    /* If the vertex is marked, try the next one. */
+                    if (graph->isMarked(v))
+                    {
+                        continue;
+                    }
+
+                    /* Read the gain for the vertex. */
+                    double gain = fm[v].gain;
+
+                    /* The balance penalty is the penalty to assess for the
+                     * move. */
+                    double vertexWeight = (Gw) ? Gw[v] : 1;
+                    double imbalance    = workingCost.imbalance
+                                       + (h ? -1.0 : 1.0) * (vertexWeight / W);
+                    double absImbalance = fabs(imbalance);
+                    double imbalanceDelta
+                        = absImbalance - fabs(workingCost.imbalance);
+
+                    /* If the move hurts the balance past tol, add a
+                     * penalty. */
+                    double balPenalty = 0.0;
+                    if (imbalanceDelta > 0 && absImbalance > tol)
+                    {
+                        balPenalty = absImbalance * H;
+                    }
+
+                    /* Heuristic cost is the cut cost reduced by the gain for
+                     * making this move, amplified by any balance impact. */
+                    double heuCost = workingCost.cutCost - (gain - balPenalty);
+
+                    /* If our heuristic value is better than the running
+                     * one: */
+                    if (heuCost < bestCandidate.heuCost)
+                    {
+                        bestCandidate.vertex       = v;
+                        bestCandidate.partition    = side;
+                        bestCandidate.vertexWeight = vertexWeight;
+                        bestCandidate.gain         = gain;
+                        bestCandidate.imbalance    = imbalance;
+                        bestCandidate.heuCost      = heuCost;
+                        tieCount                   = 1;
+                    }
+                    /* In sampling mode, break ties in a bucket (and across
+                     * the two sides) uniformly at random; see
+                     * fmRefine_worker. */
+                    else if (sampleTies && tieCount > 0
+                             && heuCost == bestCandidate.heuCost)
+                    {
+                        tieCount++;
+                        if (random() % tieCount == 0)
+                        {
+                            bestCandidate.vertex       = v;
+                            bestCandidate.partition    = side;
+                            bestCandidate.vertexWeight = vertexWeight;
+                            bestCandidate.gain         = gain;
+                            bestCandidate.imbalance    = imbalance;
+                            bestCandidate.heuCost      = heuCost;
+                        }
+                    }
+                }
+            }
+        }
+
+        /* If we were able to find the best unmoved boundary vertex: */
+        if (bestCandidate.heuCost < INFINITY)
+        {
+            productive = true;
+            graph->mark(bestCandidate.vertex);
+
+            /* Move the vertex from the boundary into the move set. */
+            buckets->remove(bestCandidate.vertex);
+            stack[tail++] = bestCandidate.vertex;
+
+            /* Swap & update the vertex and its neighbors afterwards. */
+            fmSwapBuckets(graph, options, buckets, bestCandidate.vertex,
+                          bestCandidate.gain, bestCandidate.partition);
+
+            /* Update the cut cost. */
+            workingCost.cutCost -= 2.0 * bestCandidate.gain;
+            workingCost.W[bestCandidate.partition]
+                -= bestCandidate.vertexWeight;
+            workingCost.W[!bestCandidate.partition]
+                += bestCandidate.vertexWeight;
+            workingCost.imbalance = bestCandidate.imbalance;
+            double absImbalance   = fabs(bestCandidate.imbalance);
+            workingCost.heuCost
+                = workingCost.cutCost
+                  + (absImbalance > tol ? absImbalance * H : 0.0);
+
+            /* Commit the cut if it's better. */
+            if (workingCost.heuCost < bestCost.heuCost)
+            {
+                bestCost = workingCost;
+                head     = tail;
+                i        = 0;
+            }
+        }
+    }
+
+    /* We've exhausted our search space, so undo all suboptimal moves. */
+    for (Int u = tail - 1; u >= head; u--)
+    {
+        Int vertex = stack[u];
+
+        /* Unmark this vertex. */
+        graph->unmark(vertex);
+
+        /* A previous undo may have put this vertex back on the boundary
+         * already. */
+        if (buckets->contains(vertex))
+        {
+            buckets->remove(vertex);
+        }
+
+        /* Swap the partition and compute the impact on neighbors. */
+        fmSwapBuckets(graph, options, buckets, vertex, fm[vertex].gain,
+                      graph->getPartition(vertex));
+        if (fm[vertex].externalDegree > 0)
+        {
+            buckets->insert(vertex, graph->getPartition(vertex),
+                            static_cast<Int>(fm[vertex].gain));
+        }
+    }
+
+    // clear the marks from all the vertices
+    graph->clearMarkArray();
+
+    /* Re-add any vertices that were moved that are still on the boundary. */
+    for (Int k = 0; k < head; k++)
+    {
+        Int vertex = stack[k];
+        if (fm[vertex].externalDegree > 0 && !buckets->contains(vertex))
+        {
+            buckets->insert(vertex, graph->getPartition(vertex),
+                            static_cast<Int>(fm[vertex].gain));
+        }
+    }
+
+    // clear the marks from all the vertices
+    graph->clearMarkArray();
+
+    MONGOOSE_COUNT_ADD(FMMovesAttemptedCounter, tail);
+    MONGOOSE_COUNT_ADD(FMMovesAcceptedCounter, head);
+
+    /* Save the best cost back into the graph. */
+    graph->heuCost   = bestCost.heuCost;
+    graph->cutCost   = bestCost.cutCost;
+    graph->W0        = bestCost.W[0];
+    graph->W1        = bestCost.W[1];
+    graph->imbalance = bestCost.imbalance;
+}
+
+//-----------------------------------------------------------------------------
+// Gain-bucket variant of fmSwap: identical partition/gain/externalDegree
+// bookkeeping, with bucket membership maintained in place of the heaps.
+//-----------------------------------------------------------------------------
+static void fmSwapBuckets(EdgeCutProblem *graph, const EdgeCut_Options *options,
+                          GainBuckets *buckets, Int vertex, double gain,
+                          bool oldPartition)
 {
-    Int *Gp             = graph->p;
-    Int *Gi             = graph->i;
-    double *Gx          = graph->x;
-    bool *partition     = graph->partition;
-    double *gains       = graph->vertexGains;
-    Int *externalDegree = graph->externalDegree;
-    Int **bhHeap        = graph->bhHeap;
-    Int *bhSize         = graph->bhSize;
+    (void)options; // Unused variable
+
+    Int *Gp          = graph->p;
+    Int *Gi          = graph->i;
+    WeightType *Gx   = graph->x;
+    FMVertexData *fm = graph->fmData;
 
     /* Swap partitions */
     bool newPartition = !oldPartition;
-    partition[vertex] = newPartition;
-    gains[vertex]     = -gain;
+    graph->setPartition(vertex, newPartition);
+    fm[vertex].gain   = -gain;
 
     /* Update neighbors. */
-    Int exD = 0;
-    for (Int p = Gp[vertex]; p < Gp[vertex + 1]; p++)
+    Int exD  = 0;
+    Int pEnd = Gp[vertex + 1];
+    for (Int p = Gp[vertex]; p < pEnd; p++)
     {
+        /* Prefetch a neighbor further down the row (see fmSwap). */
+        if (p + MONGOOSE_PREFETCH_DISTANCE < pEnd)
+        {
+            Int ahead = Gi[p + MONGOOSE_PREFETCH_DISTANCE];
+            graph->prefetchPartition(ahead);
+            MONGOOSE_PREFETCH(&fm[ahead]);
+        }
+
         Int neighbor           = Gi[p];
-        bool neighborPartition = partition[neighbor];
+        bool neighborPartition = graph->getPartition(neighbor);
         bool sameSide          = (newPartition == neighborPartition);
 
-        /* Update the bestCandidate vertex's external degree. */
+        /* Update the moved vertex's external degree. */
         if (!sameSide)
             exD++;
 
         /* Update the neighbor's gain. */
         double edgeWeight   = (Gx) ? Gx[p] : 1;
-        double neighborGain = gains[neighbor];
+        double neighborGain = fm[neighbor].gain;
         neighborGain += 2 * (sameSide ? -edgeWeight : edgeWeight);
-        gains[neighbor] = neighborGain;
+        fm[neighbor].gain = neighborGain;
 
         /* Update the neighbor's external degree. */
-        Int neighborExD = externalDegree[neighbor];
+        Int neighborExD = fm[neighbor].externalDegree;
         neighborExD += (sameSide ? -1 : 1);
-        externalDegree[neighbor] = neighborExD;
-        Int position             = graph->BH_getIndex(neighbor);
+        fm[neighbor].externalDegree = neighborExD;
 
-        /* If the neighbor was in a heap: */
-        if (position != -1)
+        /* If the neighbor was on the boundary: */
+        if (buckets->contains(neighbor))
         {
-            /* If it had its externalDegree reduced to 0, remove it from the
-             * heap. */
+            /* If it had its externalDegree reduced to 0, remove it;
+             * otherwise move it to its new gain bucket. */
             if (neighborExD == 0)
             {
-                bhRemove(graph, options, neighbor, neighborGain,
-                         neighborPartition, position);
+                buckets->remove(neighbor);
             }
-            /* If the neighbor is in the heap, we touched its gain
-             * so make sure the heap property is satisfied. */
             else
             {
-                Int v = neighbor;
-                heapifyUp(graph, bhHeap[neighborPartition], gains, v, position,
-                          neighborGain);
-                v = bhHeap[neighborPartition][position];
-                heapifyDown(graph, bhHeap[neighborPartition],
-                            bhSize[neighborPartition], gains, v, position,
-                            gains[v]);
+                buckets->update(neighbor, neighborPartition,
+                                static_cast<Int>(neighborGain));
             }
         }
-        /* Else the neighbor wasn't in the heap so add it. */
+        /* Else the neighbor wasn't on the boundary so add it. */
         else
         {
             if (!graph->isMarked(neighbor))
             {
-                ASSERT(!graph->BH_inBoundary(neighbor));
-                bhInsert(graph, neighbor);
+                buckets->insert(neighbor, neighborPartition,
+                                static_cast<Int>(neighborGain));
             }
         }
     }
 
-    externalDegree[vertex] = exD;
+    fm[vertex].externalDegree = exD;
 }
 
 //-----------------------------------------------------------------------------
-// This function computes the gain of a vertex
+// This function swaps the partition of a vertex
 //-----------------------------------------------------------------------------
-void calculateGain(EdgeCutProblem *graph, const EdgeCut_Options *options, Int vertex,
-                   double *out_gain, Int *out_externalDegree)
+void fmSwap(EdgeCutProblem *graph, const EdgeCut_Options *options, Int vertex, double gain,
+            bool oldPartition)
 {
-    (void)options; // Unused variable
+    Int *Gp          = graph->p;
+    Int *Gi          = graph->i;
+    WeightType *Gx   = graph->x;
+    FMVertexData *fm = graph->fmData;
+    BHEntry **bhHeap = graph->bhHeap;
+    Int *bhSize      = graph->bhSize;
 
-    Int *Gp         = graph->p;
-    Int *Gi         = graph->i;
-    double *Gx      = graph->x;
-    bool *partition = graph->partition;
+    /* Swap partitions */
+    bool newPartition = !oldPartition;
+    graph->setPartition(vertex, newPartition);
+    fm[vertex].gain   = -gain;
+
+    /* Update neighbors. */
+    Int exD  = 0;
+    Int pEnd = Gp[vertex + 1];
+    for (Int p = Gp[vertex]; p < pEnd; p++)
+    {
+        /* Each edge costs two dependent random reads (the partition word
+         * and the interleaved FM record); hide their latency by
+         * prefetching those of a neighbor further down the row. */
+        if (p + MONGOOSE_PREFETCH_DISTANCE < pEnd)
+        {
+            Int ahead = Gi[p + MONGOOSE_PREFETCH_DISTANCE];
+            graph->prefetchPartition(ahead);
+            MONGOOSE_PREFETCH(&fm[ahead]);
+        }
+
+        Int neighbor           = Gi[p];
+        bool neighborPartition = graph->getPartition(neighbor);
+        bool sameSide          = (newPartition == neighborPartition);
+
+        /* Update the bestCandidate vertex's external degree. */
+        if (!sameSide)
+            exD++;
+
+        /* Update the neighbor's gain. */
+        double edgeWeight   = (Gx) ? Gx[p] : 1;
+        double neighborGain = fm[neighbor].gain;
+        neighborGain += 2 * (sameSide ? -edgeWeight : edgeWeight);
+        fm[neighbor].gain = neighborGain;
+
+        /* Update the neighbor's external degree. */
+        Int neighborExD = fm[neighbor].externalDegree;
+        neighborExD += (sameSide ? -1 : 1);
+        fm[neighbor].externalDegree = neighborExD;
+        Int position                = graph->BH_getIndex(neighbor);
+
+        /* If the neighbor was in a heap: */
+        if (position != -1)
+        {
+            /* If it had its externalDegree reduced to 0, remove it from the
+             * heap. */
+            if (neighborExD == 0)
+            {
+                bhRemove(graph, options, neighbor, neighborGain,
+                         neighborPartition, position);
+            }
+            /* If the neighbor is in the heap, we touched its gain
+             * so refresh its packed copy and make sure the heap
+             * property is satisfied. */
+            else
+            {
+                BHEntry *heap       = bhHeap[neighborPartition];
+                heap[position].gain = neighborGain;
+                heapifyUp(graph, heap, position);
+                heapifyDown(graph, heap, bhSize[neighborPartition], position);
+            }
+        }
+        /* Else the neighbor wasn't in the heap so add it. */
+        else
+        {
+            if (!graph->isMarked(neighbor))
+            {
+                ASSERT(!graph->BH_inBoundary(neighbor));
+                bhInsert(graph, neighbor);
+            }
+        }
+    }
+
+    fm[vertex].externalDegree = exD;
+}
+
+//-----------------------------------------------------------------------------
+// Deferred-repair variant of fmSwap. Gains and external degrees are updated
+// exactly as in fmSwap, and each boundary neighbor's packed heap gain is
+// patched in place, but the heapify calls are skipped; the neighbor is
+// recorded in the dirty buffer instead and repaired by flushHeapRepairs
+// before the next extraction. A degree-d move thus costs d gain updates
+// plus one batched repair instead of d serial heap repairs.
+//-----------------------------------------------------------------------------
+static void fmSwapDeferred(EdgeCutProblem *graph,
+                           const EdgeCut_Options *options, Int vertex,
+                           double gain, bool oldPartition, Int *dirty,
+                           bool *isDirty, Int *dirtyCount)
+{
+    (void)options; // Unused variable
+
+    Int *Gp          = graph->p;
+    Int *Gi          = graph->i;
+    WeightType *Gx   = graph->x;
+    FMVertexData *fm = graph->fmData;
+    BHEntry **bhHeap = graph->bhHeap;
+
+    /* Swap partitions */
+    bool newPartition = !oldPartition;
+    graph->setPartition(vertex, newPartition);
+    fm[vertex].gain   = -gain;
+
+    /* Update neighbors. */
+    Int exD  = 0;
+    Int pEnd = Gp[vertex + 1];
+    for (Int p = Gp[vertex]; p < pEnd; p++)
+    {
+        /* Prefetch a neighbor further down the row (see fmSwap). */
+        if (p + MONGOOSE_PREFETCH_DISTANCE < pEnd)
+        {
+            Int ahead = Gi[p + MONGOOSE_PREFETCH_DISTANCE];
+            graph->prefetchPartition(ahead);
+            MONGOOSE_PREFETCH(&fm[ahead]);
+        }
+
+        Int neighbor           = Gi[p];
+        bool neighborPartition = graph->getPartition(neighbor);
+        bool sameSide          = (newPartition == neighborPartition);
+
+        /* Update the moved vertex's external degree. */
+        if (!sameSide)
+            exD++;
+
+        /* Update the neighbor's gain. */
+        double edgeWeight   = (Gx) ? Gx[p] : 1;
+        double neighborGain = fm[neighbor].gain;
+        neighborGain += 2 * (sameSide ? -edgeWeight : edgeWeight);
+        fm[neighbor].gain = neighborGain;
 
-    bool vp = partition[vertex];
+        /* Update the neighbor's external degree. */
+        Int neighborExD = fm[neighbor].externalDegree;
+        neighborExD += (sameSide ? -1 : 1);
+        fm[neighbor].externalDegree = neighborExD;
+        Int position                = graph->BH_getIndex(neighbor);
+
+        /* If the neighbor was in a heap: */
+        if (position != -1)
+        {
+            /* If it had its externalDegree reduced to 0, remove it from the
+             * heap. */
+            if (neighborExD == 0)
+            {
+                bhRemove(graph, options, neighbor, neighborGain,
+                         neighborPartition, position);
+                if (isDirty[neighbor])
+                {
+                    /* Leave the stale list entry; the flush skips
+                     * vertices that are no longer in a heap. */
+                    isDirty[neighbor] = false;
+                }
+            }
+            /* Otherwise just patch the packed gain and defer the repair. */
+            else
+            {
+                bhHeap[neighborPartition][position].gain = neighborGain;
+                if (!isDirty[neighbor])
+                {
+                    isDirty[neighbor]     = true;
+                    dirty[(*dirtyCount)++] = neighbor;
+                }
+            }
+        }
+        /* Else the neighbor wasn't in the heap so add it. */
+        else
+        {
+            if (!graph->isMarked(neighbor))
+            {
+                bhInsert(graph, neighbor);
+            }
+        }
+    }
+
+    fm[vertex].externalDegree = exD;
+}
+
+//-----------------------------------------------------------------------------
+// Repairs the heaps after a batch of deferred gain updates. When most of
+// the boundary is dirty the heaps are rebuilt wholesale (Floyd's O(size)
+// build); otherwise each dirty vertex is sifted individually from its
+// current position.
+//-----------------------------------------------------------------------------
+static void flushHeapRepairs(EdgeCutProblem *graph, Int *dirty, bool *isDirty,
+                             Int *dirtyCount)
+{
+    Int count      = *dirtyCount;
+    Int boundary   = graph->bhSize[0] + graph->bhSize[1];
+
+    if (4 * count >= boundary)
+    {
+        /* Rebuild both heaps from the bottom up. */
+        for (Int h = 0; h < 2; h++)
+        {
+            BHEntry *heap = graph->bhHeap[h];
+            Int size      = graph->bhSize[h];
+            for (Int position = (size - 2) / MONGOOSE_BH_ARITY; position >= 0;
+                 position--)
+            {
+                heapifyDown(graph, heap, size, position);
+            }
+        }
+        for (Int d = 0; d < count; d++)
+        {
+            isDirty[dirty[d]] = false;
+        }
+    }
+    else
+    {
+        for (Int d = 0; d < count; d++)
+        {
+            Int vertex = dirty[d];
+            if (!isDirty[vertex])
+                continue;
+            isDirty[vertex] = false;
+
+            Int position = graph->BH_getIndex(vertex);
+            if (position == -1)
+                continue;
+
+            bool side     = graph->getPartition(vertex);
+            BHEntry *heap = graph->bhHeap[side];
+            heapifyUp(graph, heap, position);
+            position = graph->BH_getIndex(vertex);
+            heapifyDown(graph, heap, graph->bhSize[side], position);
+        }
+    }
+
+    *dirtyCount = 0;
+}
+
+//-----------------------------------------------------------------------------
+// Journal-mode variant of fmRefine_worker. The forward pass is identical,
+// but every gain/degree mutation is appended to a journal, and the
+// speculative tail past the best prefix is undone by restoring the
+// journaled values in reverse instead of executing inverse moves through
+// fmSwap. Boundary membership is then repaired once per touched vertex.
+//-----------------------------------------------------------------------------
+static void fmRefine_journal_worker(EdgeCutProblem *graph,
+                                    const EdgeCut_Options *options)
+{
+    WeightType *Gw   = graph->w;
+    double W         = graph->W;
+    BHEntry **bhHeap = graph->bhHeap;
+    Int *bhSize      = graph->bhSize;
+    FMVertexData *fm = graph->fmData;
+
+    /* Each vertex moves at most once per sweep (it stays marked), so the
+     * journal holds at most one entry per move plus one per adjacent
+     * edge: n + nz entries cover the worst case. */
+    size_t capacity       = static_cast<size_t>(graph->n + graph->nz);
+    Workspace *ws         = graph->getWorkspace();
+    JournalEntry *journal = (JournalEntry *)(
+        (ws) ? ws->getBytes(capacity * sizeof(JournalEntry)) : NULL);
+    bool *touched
+        = (journal) ? ws->getFlags(static_cast<size_t>(graph->n)) : NULL;
+    if (!journal || !touched)
+    {
+        /* Out of memory: refine with the inverse-move undo instead. */
+        fmRefine_worker(graph, options);
+        return;
+    }
+    Int journalCount = 0;
+    Int journalHead  = 0;
+
+    /* Keep a stack of moved vertices. */
+    Int *stack = graph->fmStack;
+    Int head = 0, tail = 0;
+
+    /* create & initialize a working cost and a best cost. */
+    struct CutCost workingCost, bestCost;
+    workingCost.heuCost = bestCost.heuCost = graph->heuCost;
+    workingCost.cutCost = bestCost.cutCost = graph->cutCost;
+    workingCost.W[0] = bestCost.W[0] = graph->W0;
+    workingCost.W[1] = bestCost.W[1] = graph->W1;
+    workingCost.imbalance = bestCost.imbalance = graph->imbalance;
+
+    /* Tolerance and the linear penalty to assess. */
+    double tol = options->soft_split_tolerance;
+    double H   = graph->H;
+
+    Int fmSearchDepth   = options->FM_search_depth;
+    Int fmConsiderCount = options->FM_consider_count;
+    Int i               = 0;
+    bool productive     = true;
+    for (; i < fmSearchDepth && productive; i++)
+    {
+        productive = false;
+
+        /* Look for the best vertex to swap: */
+        struct SwapCandidate bestCandidate;
+        for (Int h = 0; h < 2; h++)
+        {
+            BHEntry *heap = bhHeap[h];
+            Int size      = bhSize[h];
+            for (Int c = 0; c < fmConsiderCount && c < size; c++)
+            {
+                /* Read the vertex, and if it's marked, try the next one. */
+                Int v = heap[c].vertex;
+                if (graph->isMarked(v))
+                {
+                    continue;
+                }
+
+                /* Read the gain packed next to the vertex. */
+                double gain = heap[c].gain;
+
+                /* The balance penalty is the penalty to assess for the move. */
+                double vertexWeight = (Gw) ? Gw[v] : 1;
+                double imbalance    = workingCost.imbalance
+                                   + (h ? -1.0 : 1.0) * (vertexWeight / W);
+                double absImbalance = fabs(imbalance);
+                double imbalanceDelta
+                    = absImbalance - fabs(workingCost.imbalance);
+
+                /* If the move hurts the balance past tol, add a penalty. */
+                double balPenalty = 0.0;
+                if (imbalanceDelta > 0 && absImbalance > tol)
+                {
+                    balPenalty = absImbalance * H;
+                }
+
+                /* Heuristic cost is the cut cost reduced by the gain for making
+                 * this move. The gain for the move is amplified by any impact
+                 * to the balance penalty. */
+                double heuCost = workingCost.cutCost - (gain - balPenalty);
+
+                /* If our heuristic value is better than the running one: */
+                if (heuCost < bestCandidate.heuCost)
+                {
+                    bestCandidate.vertex       = v;
+                    bestCandidate.partition    = static_cast<bool>(h);
+                    bestCandidate.vertexWeight = vertexWeight;
+                    bestCandidate.gain         = gain;
+                    bestCandidate.bhPosition   = c;
+                    bestCandidate.imbalance    = imbalance;
+                    bestCandidate.heuCost      = heuCost;
+                }
+            }
+        }
+
+        /* If we were able to find the best unmoved boundary vertex: */
+        if (bestCandidate.heuCost < INFINITY)
+        {
+            productive = true;
+            graph->mark(bestCandidate.vertex);
+
+            /* Move the vertex from the boundary into the move set. */
+            bhRemove(graph, options, bestCandidate.vertex, bestCandidate.gain,
+                     bestCandidate.partition, bestCandidate.bhPosition);
+            stack[tail++] = bestCandidate.vertex;
+
+            /* Swap & update the vertex and its neighbors, journaling the
+             * old gains and degrees. */
+            fmSwapJournal(graph, options, bestCandidate.vertex,
+                          bestCandidate.gain, bestCandidate.partition, journal,
+                          &journalCount);
+
+            /* Update the cut cost. */
+            workingCost.cutCost -= 2.0 * bestCandidate.gain;
+            workingCost.W[bestCandidate.partition]
+                -= bestCandidate.vertexWeight;
+            workingCost.W[!bestCandidate.partition]
+                += bestCandidate.vertexWeight;
+            workingCost.imbalance = bestCandidate.imbalance;
+            double absImbalance   = fabs(bestCandidate.imbalance);
+            workingCost.heuCost
+                = workingCost.cutCost
+                  + (absImbalance > tol ? absImbalance * H : 0.0);
+
+            /* Commit the cut if it's better. */
+            if (workingCost.heuCost < bestCost.heuCost)
+            {
+                bestCost    = workingCost;
+                head        = tail;
+                journalHead = journalCount;
+                i           = 0;
+            }
+        }
+    }
+
+    /* Roll the speculative tail back: restore the journaled gains and
+     * degrees in reverse, then flip the undone vertices' partitions. */
+    for (Int j = journalCount - 1; j >= journalHead; j--)
+    {
+        fm[journal[j].index].gain           = journal[j].gain;
+        fm[journal[j].index].externalDegree = journal[j].exD;
+    }
+    for (Int u = tail - 1; u >= head; u--)
+    {
+        Int vertex = stack[u];
+        graph->flipPartition(vertex);
+        graph->unmark(vertex);
+    }
+
+    /* Repair boundary membership once per vertex the tail touched. */
+    for (Int j = journalHead; j < journalCount; j++)
+    {
+        Int vertex = journal[j].index;
+        if (touched[vertex])
+            continue;
+        touched[vertex] = true;
+
+        Int position = graph->BH_getIndex(vertex);
+        if (position != -1)
+        {
+            if (fm[vertex].externalDegree == 0)
+            {
+                bhRemove(graph, options, vertex, fm[vertex].gain,
+                         graph->getPartition(vertex), position);
+            }
+            else
+            {
+                /* Re-sync the packed gain and re-establish heap order. */
+                bool side           = graph->getPartition(vertex);
+                BHEntry *heap       = bhHeap[side];
+                heap[position].gain = fm[vertex].gain;
+                heapifyUp(graph, heap, position);
+                position = graph->BH_getIndex(vertex);
+                heapifyDown(graph, heap, bhSize[side], position);
+            }
+        }
+        else if (fm[vertex].externalDegree > 0 && !graph->isMarked(vertex))
+        {
+            bhInsert(graph, vertex);
+        }
+    }
+
+    // clear the marks from all the vertices
+    graph->clearMarkArray();
+
+    /* Re-add any vertices that were moved that are still on the boundary. */
+    for (Int k = 0; k < head; k++)
+    {
+        Int vertex = stack[k];
+        if (fm[vertex].externalDegree > 0 && !graph->BH_inBoundary(vertex))
+        {
+            bhInsert(graph, vertex);
+        }
+    }
+
+    // clear the marks from all the vertices
+    graph->clearMarkArray();
+
+    MONGOOSE_COUNT_ADD(FMMovesAttemptedCounter, tail);
+    MONGOOSE_COUNT_ADD(FMMovesAcceptedCounter, head);
+
+    /* Save the best cost back into the graph. */
+    graph->heuCost   = bestCost.heuCost;
+    graph->cutCost   = bestCost.cutCost;
+    graph->W0        = bestCost.W[0];
+    graph->W1        = bestCost.W[1];
+    graph->imbalance = bestCost.imbalance;
+}
+
+//-----------------------------------------------------------------------------
+// Journaling variant of fmSwap: identical updates, but each vertex's prior
+// gain and external degree are appended to the journal first.
+//-----------------------------------------------------------------------------
+static void fmSwapJournal(EdgeCutProblem *graph,
+                          const EdgeCut_Options *options, Int vertex,
+                          double gain, bool oldPartition,
+                          JournalEntry *journal, Int *journalCount)
+{
+    Int *Gp          = graph->p;
+    Int *Gi          = graph->i;
+    WeightType *Gx   = graph->x;
+    FMVertexData *fm = graph->fmData;
+    BHEntry **bhHeap = graph->bhHeap;
+    Int *bhSize      = graph->bhSize;
+    Int count        = *journalCount;
+
+    /* Journal, then swap the moved vertex itself. */
+    journal[count].index = vertex;
+    journal[count].gain  = fm[vertex].gain;
+    journal[count].exD   = fm[vertex].externalDegree;
+    count++;
+
+    bool newPartition = !oldPartition;
+    graph->setPartition(vertex, newPartition);
+    fm[vertex].gain   = -gain;
+
+    /* Update neighbors. */
+    Int exD  = 0;
+    Int pEnd = Gp[vertex + 1];
+    for (Int p = Gp[vertex]; p < pEnd; p++)
+    {
+        /* Prefetch a neighbor further down the row (see fmSwap). */
+        if (p + MONGOOSE_PREFETCH_DISTANCE < pEnd)
+        {
+            Int ahead = Gi[p + MONGOOSE_PREFETCH_DISTANCE];
+            graph->prefetchPartition(ahead);
+            MONGOOSE_PREFETCH(&fm[ahead]);
+        }
+
+        Int neighbor           = Gi[p];
+        bool neighborPartition = graph->getPartition(neighbor);
+        bool sameSide          = (newPartition == neighborPartition);
+
+        /* Update the moved vertex's external degree. */
+        if (!sameSide)
+            exD++;
+
+        /* Journal the neighbor before touching it. */
+        journal[count].index = neighbor;
+        journal[count].gain  = fm[neighbor].gain;
+        journal[count].exD   = fm[neighbor].externalDegree;
+        count++;
+
+        /* Update the neighbor's gain. */
+        double edgeWeight   = (Gx) ? Gx[p] : 1;
+        double neighborGain = fm[neighbor].gain;
+        neighborGain += 2 * (sameSide ? -edgeWeight : edgeWeight);
+        fm[neighbor].gain = neighborGain;
+
+        /* Update the neighbor's external degree. */
+        Int neighborExD = fm[neighbor].externalDegree;
+        neighborExD += (sameSide ? -1 : 1);
+        fm[neighbor].externalDegree = neighborExD;
+        Int position                = graph->BH_getIndex(neighbor);
+
+        /* If the neighbor was in a heap: */
+        if (position != -1)
+        {
+            /* If it had its externalDegree reduced to 0, remove it from the
+             * heap. */
+            if (neighborExD == 0)
+            {
+                bhRemove(graph, options, neighbor, neighborGain,
+                         neighborPartition, position);
+            }
+            /* If the neighbor is in the heap, we touched its gain
+             * so refresh its packed copy and make sure the heap
+             * property is satisfied. */
+            else
+            {
+                BHEntry *heap       = bhHeap[neighborPartition];
+                heap[position].gain = neighborGain;
+                heapifyUp(graph, heap, position);
+                heapifyDown(graph, heap, bhSize[neighborPartition], position);
+            }
+        }
+        /* Else the neighbor wasn't in the heap so add it. */
+        else
+        {
+            if (!graph->isMarked(neighbor))
+            {
+                ASSERT(!graph->BH_inBoundary(neighbor));
+                bhInsert(graph, neighbor);
+            }
+        }
+    }
+
+    fm[vertex].externalDegree = exD;
+    *journalCount             = count;
+}
+
+#if MONGOOSE_SIMD_AVX2 && !defined(MONGOOSE_WEIGHT_FLOAT)
+//-----------------------------------------------------------------------------
+// AVX2 body of the gain reduction, four weights at a time. Carries its own
+// target attribute and is entered only behind a simdAVX2() check, so the
+// scalar remainder loop in the caller handles the tail (and everything on
+// hardware without AVX2). Advances *p_inout past the vectorized prefix.
+//-----------------------------------------------------------------------------
+MONGOOSE_TARGET_AVX2
+static void gainScanAVX2(EdgeCutProblem *graph, const Int *Gi,
+                         const WeightType *Gx, bool vp, Int *p_inout, Int pEnd,
+                         double *inout_gain, double *inout_crossWeight,
+                         Int *inout_externalDegree)
+{
+    Int p              = *p_inout;
+    Int externalDegree = *inout_externalDegree;
+
+    __m256d accGain    = _mm256_setzero_pd();
+    __m256d accCross   = _mm256_setzero_pd();
+    const __m256d ones = _mm256_set1_pd(1.0);
+
+    for (; p + 4 <= pEnd; p += 4)
+    {
+        /* The partition bits are fetched by scalar loads; the weight
+         * arithmetic is where the vector width pays off. */
+        bool c0 = (graph->getPartition(Gi[p]) != vp);
+        bool c1 = (graph->getPartition(Gi[p + 1]) != vp);
+        bool c2 = (graph->getPartition(Gi[p + 2]) != vp);
+        bool c3 = (graph->getPartition(Gi[p + 3]) != vp);
+
+        __m256d w = (Gx) ? _mm256_loadu_pd(Gx + p) : ones;
+        __m256d crossMask = _mm256_castsi256_pd(_mm256_set_epi64x(
+            -(Int)c3, -(Int)c2, -(Int)c1, -(Int)c0));
+
+        /* Cross-side weights add to the gain, same-side subtract. */
+        __m256d crossW = _mm256_and_pd(crossMask, w);
+        accGain = _mm256_add_pd(accGain, crossW);
+        accGain = _mm256_sub_pd(accGain, _mm256_andnot_pd(crossMask, w));
+        accCross = _mm256_add_pd(accCross, crossW);
+        externalDegree += (Int)c0 + (Int)c1 + (Int)c2 + (Int)c3;
+    }
+
+    double lanes[4];
+    _mm256_storeu_pd(lanes, accGain);
+    *inout_gain += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    _mm256_storeu_pd(lanes, accCross);
+    *inout_crossWeight += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+
+    *p_inout             = p;
+    *inout_externalDegree = externalDegree;
+}
+#endif
+
+//-----------------------------------------------------------------------------
+// This function computes the gain, the cut (cross-side) edge weight, and
+// the external degree of a vertex. The reduction over the adjacency slice
+// is a two-accumulator masked sum over x[] keyed by the neighbor's
+// partition side; with AVX2 the weights are consumed four at a time with
+// the side test folded into a mask/andnot blend.
+//-----------------------------------------------------------------------------
+void calculateGainAndCut(EdgeCutProblem *graph, Int vertex, double *out_gain,
+                         double *out_cutWeight, Int *out_externalDegree)
+{
+    Int *Gp    = graph->p;
+    Int *Gi    = graph->i;
+    WeightType *Gx = graph->x;
+
+    bool vp = graph->getPartition(vertex);
 
     double gain        = 0.0;
+    double crossWeight = 0.0;
     Int externalDegree = 0;
-    for (Int p = Gp[vertex]; p < Gp[vertex + 1]; p++)
+    Int p              = Gp[vertex];
+    Int pEnd           = Gp[vertex + 1];
+
+    /* Unit weights: the reduction collapses to a count of cross-side
+     * neighbors; the gain and cut weight fall straight out of the count,
+     * so the weight loads and multiplies vanish. */
+    if (!Gx)
     {
-        double ew     = (Gx ? Gx[p] : 1.0);
-        bool sameSide = (partition[Gi[p]] == vp);
-        gain += (sameSide ? -ew : ew);
+        for (; p < pEnd; p++)
+        {
+            if (p + MONGOOSE_PREFETCH_DISTANCE < pEnd)
+            {
+                graph->prefetchPartition(Gi[p + MONGOOSE_PREFETCH_DISTANCE]);
+            }
+            externalDegree += (graph->getPartition(Gi[p]) != vp);
+        }
+        Int degree          = pEnd - Gp[vertex];
+        *out_gain           = static_cast<double>(2 * externalDegree - degree);
+        *out_cutWeight      = static_cast<double>(externalDegree);
+        *out_externalDegree = externalDegree;
+        return;
+    }
 
-        if (!sameSide)
+#if MONGOOSE_SIMD_AVX2 && !defined(MONGOOSE_WEIGHT_FLOAT)
+    if (simdAVX2() && pEnd - p >= 8)
+    {
+        gainScanAVX2(graph, Gi, Gx, vp, &p, pEnd, &gain, &crossWeight,
+                     &externalDegree);
+    }
+#endif
+
+    for (; p < pEnd; p++)
+    {
+        if (p + MONGOOSE_PREFETCH_DISTANCE < pEnd)
+        {
+            graph->prefetchPartition(Gi[p + MONGOOSE_PREFETCH_DISTANCE]);
+        }
+        double ew  = (Gx ? Gx[p] : 1.0);
+        bool cross = (graph->getPartition(Gi[p]) != vp);
+        gain += (cross ? ew : -ew);
+        if (cross)
+        {
+            crossWeight += ew;
             externalDegree++;
+        }
     }
 
     /* Save outputs */
     *out_gain           = gain;
+    *out_cutWeight      = crossWeight;
     *out_externalDegree = externalDegree;
 }
 
+//-----------------------------------------------------------------------------
+// This function computes the gain of a vertex
+//-----------------------------------------------------------------------------
+void calculateGain(EdgeCutProblem *graph, const EdgeCut_Options *options, Int vertex,
+                   double *out_gain, Int *out_externalDegree)
+{
+    (void)options; // Unused variable
+
+    double cutWeight = 0.0;
+    calculateGainAndCut(graph, vertex, out_gain, &cutWeight,
+                        out_externalDegree);
+}
+
 } // end namespace Mongoose
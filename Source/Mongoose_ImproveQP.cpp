@@ -15,6 +15,7 @@
 #include "Mongoose_ImproveFM.hpp"
 #include "Mongoose_Internal.hpp"
 #include "Mongoose_Logger.hpp"
+#include "Mongoose_QPBackend.hpp"
 #include "Mongoose_QPBoundary.hpp"
 #include "Mongoose_QPLinks.hpp"
 #include "Mongoose_QPNapsack.hpp"
@@ -30,19 +31,27 @@ bool improveCutUsingQP(EdgeCutProblem *graph, const EdgeCut_Options *options, bo
     Logger::tic(QPTiming);
 
     /* Unpack structure fields */
-    Int n               = graph->n;
-    Int *Gp             = graph->p;
-    double *Gx          = graph->x; // edge weights
-    double *Gw          = graph->w; // vertex weights
-    double *gains       = graph->vertexGains;
-    Int *externalDegree = graph->externalDegree;
-
-    /* create workspaces */
-    QPDelta *QP = QPDelta::Create(n);
+    Int n            = graph->n;
+    Int *Gp          = graph->p;
+    WeightType *Gx   = graph->x; // edge weights
+    WeightType *Gw   = graph->w; // vertex weights
+    FMVertexData *fm = graph->fmData;
+
+    /* Reuse the pooled workspace sized for the finest level (see
+     * EdgeCutProblem::create); every coarse level fits inside it. If
+     * pooling is unavailable -- it failed to allocate, or the graph was
+     * never coarsened -- fall back to a per-call workspace. */
+    QPDelta *QP = graph->qpWorkspace;
+    bool ownQP  = false;
     if (!QP)
     {
-        Logger::toc(QPTiming);
-        return false;
+        QP    = QPDelta::Create(n);
+        ownQP = true;
+        if (!QP)
+        {
+            Logger::toc(QPTiming);
+            return false;
+        }
     }
 
     // set the QP parameters
@@ -62,9 +71,8 @@ bool improveCutUsingQP(EdgeCutProblem *graph, const EdgeCut_Options *options, bo
     ASSERT(QP->lo <= QP->hi);
 
     /* Convert the guess from discrete to continuous. */
-    double *D       = QP->D;
-    double *guess   = QP->x;
-    bool *partition = graph->partition;
+    QPScalar *D     = QP->D;
+    QPScalar *guess = QP->x;
     for (Int k = 0; k < n; k++)
     {
         if (isInitial)
@@ -73,7 +81,7 @@ bool improveCutUsingQP(EdgeCutProblem *graph, const EdgeCut_Options *options, bo
         }
         else
         {
-            if (partition[k])
+            if (graph->getPartition(k))
             {
                 guess[k] = graph->BH_inBoundary(k) ? 0.75 : 1.0;
             }
@@ -85,14 +93,22 @@ bool improveCutUsingQP(EdgeCutProblem *graph, const EdgeCut_Options *options, bo
         double maxWeight = 0;
         for (Int p = Gp[k]; p < Gp[k + 1]; p++)
         {
-            maxWeight = std::max(maxWeight, (Gx) ? Gx[p] : 1);
+            maxWeight = std::max(maxWeight, (Gx) ? (double)Gx[p] : 1.);
         }
         D[k] = maxWeight;
     }
 
     // lo <= a'x <= hi might not hold here
 
-    QP->lambda = 0;
+    /* Warm start the napsack from the multiplier the last QP pass on this
+     * graph converged to (0 on the first pass); the projection changes
+     * little between dances, so the up/down heap walks start adjacent to
+     * the solution. */
+    QP->lambda = graph->qpLambda;
+
+    /* QP->b (a'x) is recomputed by QPLinks below; clear whatever a previous
+     * use of the pooled workspace left there before the projection test. */
+    QP->b = 0;
     if (QP->b < QP->lo || QP->b > QP->hi)
     {
         QP->lambda = QPNapsack(guess, n, QP->lo, QP->hi, graph->w, QP->lambda,
@@ -103,16 +119,22 @@ bool improveCutUsingQP(EdgeCutProblem *graph, const EdgeCut_Options *options, bo
     // Build the FreeSet, compute grad, possibly adjust QP->lo and QP->hi
     if (!QPLinks(graph, options, QP))
     {
+        if (ownQP)
+        {
+            QP->~QPDelta();
+            SuiteSparse_free(QP);
+        }
         Logger::toc(QPTiming);
         return false;
     }
 
     // lo <= a'x <= hi now holds (lo and hi are modified as needed in QPLinks)
 
-    /* Do one run of gradient projection. */
-    QPGradProj(graph, options, QP);
+    /* Do one run of gradient projection (through the accelerator backend
+     * when one is registered and accepts this level). */
+    qpGradProjDispatch(graph, options, QP);
     QPBoundary(graph, options, QP);
-    QPGradProj(graph, options, QP);
+    qpGradProjDispatch(graph, options, QP);
     QPBoundary(graph, options, QP);
 
     /* Use the CutCost to keep track of impacts to the cut cost. */
@@ -126,12 +148,12 @@ bool improveCutUsingQP(EdgeCutProblem *graph, const EdgeCut_Options *options, bo
     for (Int k = 0; k < n; k++)
     {
         bool newPartition = (guess[k] > 0.5);
-        bool oldPartition = partition[k];
+        bool oldPartition = graph->getPartition(k);
 
         if (newPartition != oldPartition)
         {
             /* Update the cut cost. */
-            cost.cutCost -= 2 * gains[k];
+            cost.cutCost -= 2 * fm[k].gain;
             cost.W[oldPartition] -= (Gw) ? Gw[k] : 1;
             cost.W[newPartition] += (Gw) ? Gw[k] : 1;
             cost.imbalance
@@ -145,14 +167,14 @@ bool improveCutUsingQP(EdgeCutProblem *graph, const EdgeCut_Options *options, bo
              * this vertex to the boundary already. */
             if (bhVertexPosition != -1)
             {
-                bhRemove(graph, options, k, gains[k], partition[k],
+                bhRemove(graph, options, k, fm[k].gain, oldPartition,
                          bhVertexPosition);
             }
 
             /* Swap the partition and compute the impact on neighbors. */
-            fmSwap(graph, options, k, gains[k], partition[k]);
+            fmSwap(graph, options, k, fm[k].gain, oldPartition);
 
-            if (externalDegree[k] > 0)
+            if (fm[k].externalDegree > 0)
                 bhInsert(graph, k);
         }
     }
@@ -160,9 +182,15 @@ bool improveCutUsingQP(EdgeCutProblem *graph, const EdgeCut_Options *options, bo
     // clear the marks from all the vertices
     graph->clearMarkArray();
 
-    /* Free the QP structure */
-    QP->~QPDelta();
-    SuiteSparse_free(QP);
+    /* Keep the converged multiplier as the warm start for the next dance. */
+    graph->qpLambda = QP->lambda;
+
+    /* Free the QP structure (pooled workspaces stay with the hierarchy) */
+    if (ownQP)
+    {
+        QP->~QPDelta();
+        SuiteSparse_free(QP);
+    }
 
     /* Write the cut cost back to the graph. */
     graph->cutCost      = cost.cutCost;
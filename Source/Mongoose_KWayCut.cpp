@@ -0,0 +1,376 @@
+/* ========================================================================== */
+/* === Source/Mongoose_KWayCut.cpp ========================================== */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+#include "Mongoose_KWayCut.hpp"
+#include "Mongoose_Internal.hpp"
+#include "Mongoose_Logger.hpp"
+#include "Mongoose_ThreadPool.hpp"
+
+#include <vector>
+
+namespace Mongoose
+{
+
+KWayCut::~KWayCut()
+{
+    SuiteSparse_free(partition);
+    SuiteSparse_free(part_weights);
+    SuiteSparse_free(this);
+}
+
+/* One node of the recursion tree: a subgraph of the input together with
+ * the map back to input vertex ids, the number of parts it must still be
+ * split into, and the first part id it owns. */
+struct BisectTask
+{
+    Graph *graph;   /* NULL for an empty side                        */
+    Int *vertexMap; /* local -> input vertex ids; NULL = identity    */
+    Int k;
+    Int partOffset;
+    bool ownsGraph; /* false only on the root (the caller's graph)   */
+};
+
+static void releaseTask(BisectTask *task)
+{
+    if (task->ownsGraph && task->graph)
+    {
+        task->graph->~Graph();
+    }
+    task->graph     = NULL;
+    task->vertexMap = (Int *)SuiteSparse_free(task->vertexMap);
+}
+
+/* Extracts the induced subgraph of one bisection side, renumbering its
+ * vertices contiguously. The parent is already sanitized (sorted,
+ * symmetric, zero-free diagonal) and an induced subgraph preserves all of
+ * that, so no re-sanitization happens anywhere in the recursion. An empty
+ * side yields *subOut = NULL, which the driver treats as nothing left to
+ * assign. */
+static bool extractSide(const Graph *G, const Int *parentMap,
+                        const bool *side, bool whichSide, Graph **subOut,
+                        Int **mapOut)
+{
+    *subOut = NULL;
+    *mapOut = NULL;
+
+    Int n        = G->n;
+    Int *localId = (Int *)SuiteSparse_malloc(static_cast<size_t>(n),
+                                             sizeof(Int));
+    if (!localId)
+        return false;
+
+    Int nsub = 0;
+    for (Int v = 0; v < n; v++)
+    {
+        localId[v] = (side[v] == whichSide) ? nsub++ : -1;
+    }
+    if (nsub == 0)
+    {
+        SuiteSparse_free(localId);
+        return true;
+    }
+
+    const Int *Gp        = G->p;
+    const Int *Gi        = G->i;
+    const WeightType *Gx = G->x;
+    const WeightType *Gw = G->w;
+
+    Int nzsub = 0;
+    for (Int v = 0; v < n; v++)
+    {
+        if (localId[v] < 0)
+            continue;
+        for (Int q = Gp[v]; q < Gp[v + 1]; q++)
+        {
+            if (localId[Gi[q]] >= 0)
+                nzsub++;
+        }
+    }
+
+    Int *map = (Int *)SuiteSparse_malloc(static_cast<size_t>(nsub),
+                                         sizeof(Int));
+    Graph *sub = Graph::create(nsub, nzsub);
+    if (sub && Gx)
+    {
+        sub->x = (WeightType *)SuiteSparse_malloc(
+            static_cast<size_t>(nzsub), sizeof(WeightType));
+    }
+    if (sub && Gw)
+    {
+        sub->w = (WeightType *)SuiteSparse_malloc(static_cast<size_t>(nsub),
+                                                  sizeof(WeightType));
+    }
+    if (!map || !sub || (Gx && !sub->x) || (Gw && !sub->w))
+    {
+        SuiteSparse_free(localId);
+        SuiteSparse_free(map);
+        if (sub)
+            sub->~Graph();
+        return false;
+    }
+
+    Int nz = 0;
+    for (Int v = 0; v < n; v++)
+    {
+        Int j = localId[v];
+        if (j < 0)
+            continue;
+        map[j] = parentMap ? parentMap[v] : v;
+        if (Gw)
+        {
+            sub->w[j] = Gw[v];
+        }
+        for (Int q = Gp[v]; q < Gp[v + 1]; q++)
+        {
+            Int u = localId[Gi[q]];
+            if (u < 0)
+                continue;
+            sub->i[nz] = u;
+            if (Gx)
+            {
+                sub->x[nz] = Gx[q];
+            }
+            nz++;
+        }
+        sub->p[j + 1] = nz;
+    }
+
+    SuiteSparse_free(localId);
+    *subOut = sub;
+    *mapOut = map;
+    return true;
+}
+
+/* Bisects one branch into its two child tasks. The cut edges' weight is
+ * reported so the driver can total the k-way cut cost: an edge cut here
+ * appears in neither child, so each cut edge is counted exactly once over
+ * the whole recursion. */
+static bool bisectBranch(const BisectTask *task,
+                         const EdgeCut_Options *memberOptions,
+                         BisectTask *child0, BisectTask *child1,
+                         double *cutCost)
+{
+    child0->graph     = child1->graph = NULL;
+    child0->vertexMap = child1->vertexMap = NULL;
+    child0->ownsGraph = child1->ownsGraph = true;
+
+    Int k0 = task->k / 2;
+
+    EdgeCut *cut = edge_cut(task->graph, memberOptions);
+    if (!cut)
+        return false;
+    *cutCost = cut->cut_cost;
+
+    /* target_split constrains the partition-1 side's weight share, so the
+     * k0-part child is carved from side 1 (its target k0/k is what the
+     * driver put in memberOptions). */
+    bool ok = extractSide(task->graph, task->vertexMap, cut->partition, true,
+                          &child0->graph, &child0->vertexMap)
+              && extractSide(task->graph, task->vertexMap, cut->partition,
+                             false, &child1->graph, &child1->vertexMap);
+
+    child0->k          = k0;
+    child0->partOffset = task->partOffset;
+    child1->k          = task->k - k0;
+    child1->partOffset = task->partOffset + k0;
+
+    cut->~EdgeCut();
+    return ok;
+}
+
+/* Assigns every vertex of a finished task to one part (or, when the task
+ * has fewer vertices than parts, one vertex per part in order). */
+static void assignLeaf(const BisectTask *task, Int *partition,
+                       double *part_weights)
+{
+    const Graph *G       = task->graph;
+    const Int *map       = task->vertexMap;
+    const WeightType *Gw = G->w;
+
+    for (Int j = 0; j < G->n; j++)
+    {
+        Int part = task->partOffset + std::min(j, task->k - 1);
+        Int v    = map ? map[j] : j;
+
+        partition[v] = part;
+        part_weights[part] += (Gw) ? (double)Gw[j] : 1.;
+    }
+}
+
+KWayCut *kway_cut(const Graph *graph, Int k)
+{
+    // use default options if not present
+    EdgeCut_Options *options = EdgeCut_Options::create();
+
+    if (!options)
+        return NULL;
+
+    KWayCut *result = kway_cut(graph, k, options);
+
+    options->~EdgeCut_Options();
+
+    return (result);
+}
+
+KWayCut *kway_cut(const Graph *graph, Int k, const EdgeCut_Options *options)
+{
+    if (!graph || !options)
+        return NULL;
+
+    if (k < 1)
+    {
+        LogError("Fatal Error: kway_cut requires k of at least one.");
+        return NULL;
+    }
+
+    KWayCut *result = (KWayCut *)SuiteSparse_malloc(1, sizeof(KWayCut));
+    if (!result)
+        return NULL;
+
+    result->n            = graph->n;
+    result->k            = k;
+    result->cut_cost     = 0.;
+    result->partition    = (Int *)SuiteSparse_malloc(
+        static_cast<size_t>(graph->n), sizeof(Int));
+    result->part_weights = (double *)SuiteSparse_calloc(
+        static_cast<size_t>(k), sizeof(double));
+    if (!result->partition || !result->part_weights)
+    {
+        result->~KWayCut();
+        return NULL;
+    }
+
+    BisectTask root;
+    root.graph      = (Graph *)graph;
+    root.vertexMap  = NULL;
+    root.k          = k;
+    root.partOffset = 0;
+    root.ownsGraph  = false;
+
+    std::vector<BisectTask> current(1, root);
+    bool failed = false;
+
+    /* One batch of independent bisections per recursion depth: depth d
+     * has up to 2^d branches, so the tree parallelizes even though the
+     * batches submitted from inside pool jobs would run inline. (Without
+     * C++11 threads the batches run serially, same results.) */
+    while (!current.empty() && !failed)
+    {
+        std::vector<BisectTask> branches;
+        for (size_t s = 0; s < current.size(); s++)
+        {
+            BisectTask *task = &current[s];
+            if (!task->graph || task->graph->n == 0)
+            {
+                releaseTask(task);
+            }
+            else if (task->k == 1 || task->graph->n <= task->k)
+            {
+                assignLeaf(task, result->partition, result->part_weights);
+                releaseTask(task);
+            }
+            else
+            {
+                branches.push_back(*task);
+            }
+        }
+        current.clear();
+        if (branches.empty())
+            break;
+
+        Int nb = (Int)branches.size();
+
+        /* Raw array for the per-branch options: ~EdgeCut_Options frees
+         * `this` (the factory pattern), so these copies must never be
+         * destroyed as C++ objects. */
+        EdgeCut_Options *memberOptions
+            = (EdgeCut_Options *)SuiteSparse_malloc(static_cast<size_t>(nb),
+                                                    sizeof(EdgeCut_Options));
+        if (!memberOptions)
+        {
+            for (Int t = 0; t < nb; t++)
+            {
+                releaseTask(&branches[t]);
+            }
+            failed = true;
+            break;
+        }
+        for (Int t = 0; t < nb; t++)
+        {
+            memberOptions[t] = *options;
+
+            /* The split ratio follows the part counts, and the seed is
+             * keyed off the branch's (unique) part offset, so results do
+             * not depend on how branches land on workers. */
+            memberOptions[t].target_split = (double)(branches[t].k / 2)
+                                            / (double)branches[t].k;
+            memberOptions[t].random_seed
+                = options->random_seed + branches[t].partOffset;
+        }
+
+        std::vector<BisectTask> children(static_cast<size_t>(2 * nb));
+        std::vector<double> cutCosts(static_cast<size_t>(nb), 0.);
+        std::vector<char> ok(static_cast<size_t>(nb), 0);
+
+#if CPP11_OR_LATER
+        BisectTask *branchesData = branches.data();
+        BisectTask *childrenData = children.data();
+        double *cutCostsData     = cutCosts.data();
+        char *okData             = ok.data();
+
+        ThreadPool::run(nb, [=](Int t) {
+            okData[t] = bisectBranch(&branchesData[t], &memberOptions[t],
+                                     &childrenData[2 * t],
+                                     &childrenData[2 * t + 1],
+                                     &cutCostsData[t]);
+        });
+#else
+        for (Int t = 0; t < nb; t++)
+        {
+            ok[t] = bisectBranch(&branches[t], &memberOptions[t],
+                                 &children[2 * t], &children[2 * t + 1],
+                                 &cutCosts[t]);
+        }
+#endif
+
+        SuiteSparse_free(memberOptions);
+
+        for (Int t = 0; t < nb; t++)
+        {
+            releaseTask(&branches[t]);
+            if (!ok[t])
+            {
+                failed = true;
+            }
+            result->cut_cost += cutCosts[t];
+        }
+
+        if (failed)
+        {
+            for (Int t = 0; t < 2 * nb; t++)
+            {
+                releaseTask(&children[t]);
+            }
+            break;
+        }
+        current.swap(children);
+    }
+
+    if (failed)
+    {
+        result->~KWayCut();
+        return NULL;
+    }
+
+    return result;
+}
+
+} // end namespace Mongoose
@@ -21,15 +21,45 @@
 #include "Mongoose_Logger.hpp"
 #include "Mongoose_Debug.hpp"
 #include "Mongoose_Internal.hpp"
+#include <cstring>
 #include <iomanip>
 
+#if CPP11_OR_LATER
+#include <functional>
+#include <mutex>
+#include <thread>
+#endif
+
 namespace Mongoose
 {
 
 int Logger::debugLevel = None;
 bool Logger::timingOn  = false;
 clock_t Logger::clocks[6];
-float Logger::times[6];
+float Logger::cpuTimes[6];
+#if CPP11_OR_LATER
+std::chrono::steady_clock::time_point Logger::wallClocks[6];
+float Logger::wallTimes[6];
+std::atomic<Int> Logger::counters[MONGOOSE_COUNTER_COUNT];
+#else
+Int Logger::counters[MONGOOSE_COUNTER_COUNT];
+#endif
+bool Logger::tracingOn      = false;
+FILE *Logger::traceFile     = NULL;
+bool Logger::traceFirstEvent = true;
+bool Logger::allocAccountingOn   = false;
+bool Logger::allocAccountingUsed = false;
+int Logger::allocPhaseStack[8];
+int Logger::allocPhaseDepth   = 0;
+size_t Logger::allocLiveBytes = 0;
+size_t Logger::allocCounts[MONGOOSE_ALLOC_PHASES];
+size_t Logger::allocBytes[MONGOOSE_ALLOC_PHASES];
+size_t Logger::allocPeaks[MONGOOSE_ALLOC_PHASES];
+
+#if CPP11_OR_LATER
+/* Serializes trace-event writes from concurrent tic/toc calls. */
+static std::mutex traceLock;
+#endif
 
 void Logger::setDebugLevel(int debugType)
 {
@@ -41,20 +71,302 @@ void Logger::setTimingFlag(bool tFlag)
     timingOn = tFlag;
 }
 
+/* Start emitting Chrome trace-event JSON to the given file. Every tic/toc
+ * pair becomes a begin/end event named after its phase, with nanosecond
+ * timestamps and the emitting thread's id, so a run can be opened in
+ * chrome://tracing or Perfetto. Passing NULL (or calling closeTraceFile)
+ * finishes the JSON array and closes the file. Tracing needs the C++11
+ * monotonic clock; on older builds this is a no-op. */
+void Logger::setTraceFile(const char *path)
+{
+#if CPP11_OR_LATER
+    std::lock_guard<std::mutex> guard(traceLock);
+    tracingOn = false;
+    if (traceFile)
+    {
+        fprintf(traceFile, "\n]\n");
+        fclose(traceFile);
+        traceFile = NULL;
+    }
+    if (!path)
+        return;
+
+    FILE *file = fopen(path, "w");
+    if (!file)
+    {
+        LogError("Error: Unable to open trace file for writing.\n");
+        return;
+    }
+    fprintf(file, "[\n");
+    traceFile       = file;
+    traceFirstEvent = true;
+    tracingOn       = true;
+#else
+    (void)path;
+#endif
+}
+
+void Logger::closeTraceFile()
+{
+    setTraceFile(NULL);
+}
+
+/* Writes one trace event. Only called from tic/toc when tracing is on. */
+void Logger::traceEvent(bool begin, TimingType timingType)
+{
+#if CPP11_OR_LATER
+    static const char *phaseNames[6]
+        = { "Matching", "Coarsening", "Refinement", "FM", "QP", "IO" };
+
+    double micros = std::chrono::duration<double, std::micro>(
+                        std::chrono::steady_clock::now().time_since_epoch())
+                        .count();
+    size_t tid = std::hash<std::thread::id>()(std::this_thread::get_id());
+
+    std::lock_guard<std::mutex> guard(traceLock);
+    if (!traceFile)
+        return;
+    /* ts is in microseconds by the trace-event spec; three decimals keep
+     * the clock's nanosecond resolution. */
+    fprintf(traceFile,
+            "%s{\"name\":\"%s\",\"cat\":\"mongoose\",\"ph\":\"%c\","
+            "\"ts\":%.3f,\"pid\":1,\"tid\":%zu}",
+            traceFirstEvent ? "" : ",\n", phaseNames[timingType],
+            begin ? 'B' : 'E', micros, tid & 0xffffff);
+    traceFirstEvent = false;
+#else
+    (void)begin;
+    (void)timingType;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+// Allocation accounting shim
+//-----------------------------------------------------------------------------
+// Each accounted block carries a 16-byte header holding its size, so the
+// free/realloc side knows how many live bytes to retire without a size
+// map. 16 bytes preserves max_align_t alignment for the caller's data.
+
+#if CPP11_OR_LATER
+/* Serializes the accounting bookkeeping against allocations from worker
+ * threads (parallel matching, clone racing). */
+static std::mutex allocLock;
+#define ALLOC_GUARD() std::lock_guard<std::mutex> guard(allocLock)
+#else
+#define ALLOC_GUARD()
+#endif
+
+struct AllocHeader
+{
+    size_t size;
+    size_t pad;
+};
+
+/* The handlers in place before startAllocAccounting, restored by stop. */
+static void *(*savedMalloc)(size_t)          = NULL;
+static void *(*savedCalloc)(size_t, size_t)  = NULL;
+static void *(*savedRealloc)(void *, size_t) = NULL;
+static void (*savedFree)(void *)             = NULL;
+
+static void *accountedMalloc(size_t size)
+{
+    AllocHeader *header
+        = (AllocHeader *)savedMalloc(size + sizeof(AllocHeader));
+    if (!header)
+        return NULL;
+    header->size = size;
+    Logger::recordAlloc(size);
+    return header + 1;
+}
+
+static void *accountedCalloc(size_t count, size_t size)
+{
+    size_t bytes = count * size;
+    void *block  = accountedMalloc(bytes);
+    if (block)
+    {
+        memset(block, 0, bytes);
+    }
+    return block;
+}
+
+static void *accountedRealloc(void *block, size_t newSize)
+{
+    if (!block)
+        return accountedMalloc(newSize);
+    AllocHeader *header = ((AllocHeader *)block) - 1;
+    size_t oldSize      = header->size;
+    AllocHeader *grown
+        = (AllocHeader *)savedRealloc(header, newSize + sizeof(AllocHeader));
+    if (!grown)
+        return NULL;
+    grown->size = newSize;
+    Logger::recordFree(oldSize);
+    Logger::recordAlloc(newSize);
+    return grown + 1;
+}
+
+static void accountedFree(void *block)
+{
+    if (!block)
+        return;
+    AllocHeader *header = ((AllocHeader *)block) - 1;
+    Logger::recordFree(header->size);
+    savedFree(header);
+}
+
+void Logger::allocPushPhase(TimingType timingType)
+{
+    ALLOC_GUARD();
+    if (allocPhaseDepth < 7)
+    {
+        allocPhaseStack[++allocPhaseDepth] = timingType;
+    }
+}
+
+void Logger::allocPopPhase()
+{
+    ALLOC_GUARD();
+    if (allocPhaseDepth > 0)
+    {
+        allocPhaseDepth--;
+    }
+}
+
+void Logger::recordAlloc(size_t size)
+{
+    ALLOC_GUARD();
+    int phase = allocPhaseStack[allocPhaseDepth];
+    allocCounts[phase]++;
+    allocBytes[phase] += size;
+    allocLiveBytes += size;
+    if (allocLiveBytes > allocPeaks[phase])
+    {
+        allocPeaks[phase] = allocLiveBytes;
+    }
+}
+
+void Logger::recordFree(size_t size)
+{
+    ALLOC_GUARD();
+    allocLiveBytes -= size;
+}
+
+void Logger::startAllocAccounting()
+{
+    if (allocAccountingOn)
+        return;
+
+    for (int phase = 0; phase < MONGOOSE_ALLOC_PHASES; phase++)
+    {
+        allocCounts[phase] = 0;
+        allocBytes[phase]  = 0;
+        allocPeaks[phase]  = 0;
+    }
+    allocLiveBytes      = 0;
+    allocPhaseDepth     = 0;
+    allocPhaseStack[0]  = MONGOOSE_ALLOC_PHASES - 1; /* "outside" slot */
+
+    savedMalloc  = SuiteSparse_config.malloc_func;
+    savedCalloc  = SuiteSparse_config.calloc_func;
+    savedRealloc = SuiteSparse_config.realloc_func;
+    savedFree    = SuiteSparse_config.free_func;
+
+    SuiteSparse_config.malloc_func  = accountedMalloc;
+    SuiteSparse_config.calloc_func  = accountedCalloc;
+    SuiteSparse_config.realloc_func = accountedRealloc;
+    SuiteSparse_config.free_func    = accountedFree;
+
+    allocAccountingOn   = true;
+    allocAccountingUsed = true;
+}
+
+void Logger::stopAllocAccounting()
+{
+    if (!allocAccountingOn)
+        return;
+
+    SuiteSparse_config.malloc_func  = savedMalloc;
+    SuiteSparse_config.calloc_func  = savedCalloc;
+    SuiteSparse_config.realloc_func = savedRealloc;
+    SuiteSparse_config.free_func    = savedFree;
+    allocAccountingOn = false;
+}
+
+size_t Logger::getAllocCount(int phase)
+{
+    return allocCounts[phase];
+}
+
+size_t Logger::getAllocBytes(int phase)
+{
+    return allocBytes[phase];
+}
+
+size_t Logger::getAllocPeak(int phase)
+{
+    return allocPeaks[phase];
+}
+
+void Logger::resetCounters()
+{
+    for (int c = 0; c < MONGOOSE_COUNTER_COUNT; c++)
+    {
+        counters[c] = 0;
+    }
+}
+
 void Logger::printTimingInfo()
 {
     std::cout << " Matching:   " << std::setprecision(4)
-              << times[MatchingTiming] << "s\n";
+              << getTime(MatchingTiming) << "s wall, " << std::setprecision(4)
+              << getCPUTime(MatchingTiming) << "s cpu\n";
     std::cout << " Coarsening: " << std::setprecision(4)
-              << times[CoarseningTiming] << "s\n";
+              << getTime(CoarseningTiming) << "s wall, " << std::setprecision(4)
+              << getCPUTime(CoarseningTiming) << "s cpu\n";
     std::cout << " Refinement: " << std::setprecision(4)
-              << times[RefinementTiming] << "s\n";
-    std::cout << " FM:         " << std::setprecision(4) << times[FMTiming]
-              << "s\n";
-    std::cout << " QP:         " << std::setprecision(4) << times[QPTiming]
-              << "s\n";
-    std::cout << " IO:         " << std::setprecision(4) << times[IOTiming]
-              << "s\n";
+              << getTime(RefinementTiming) << "s wall, " << std::setprecision(4)
+              << getCPUTime(RefinementTiming) << "s cpu\n";
+    std::cout << " FM:         " << std::setprecision(4) << getTime(FMTiming)
+              << "s wall, " << std::setprecision(4) << getCPUTime(FMTiming)
+              << "s cpu\n";
+    std::cout << " QP:         " << std::setprecision(4) << getTime(QPTiming)
+              << "s wall, " << std::setprecision(4) << getCPUTime(QPTiming)
+              << "s cpu\n";
+    std::cout << " IO:         " << std::setprecision(4) << getTime(IOTiming)
+              << "s wall, " << std::setprecision(4) << getCPUTime(IOTiming)
+              << "s cpu\n";
+
+    if (allocAccountingUsed)
+    {
+        static const char *allocPhaseNames[MONGOOSE_ALLOC_PHASES]
+            = { "Matching:  ", "Coarsening:", "Refinement:", "FM:        ",
+                "QP:        ", "IO:        ", "(outside): " };
+        std::cout << " Allocations (count, bytes, peak live bytes):\n";
+        for (int phase = 0; phase < MONGOOSE_ALLOC_PHASES; phase++)
+        {
+            std::cout << "  " << allocPhaseNames[phase] << " "
+                      << getAllocCount(phase) << ", " << getAllocBytes(phase)
+                      << ", " << getAllocPeak(phase) << "\n";
+        }
+    }
+
+#if MONGOOSE_COUNTERS
+    std::cout << " FM moves attempted:  " << getCounter(FMMovesAttemptedCounter)
+              << "\n";
+    std::cout << " FM moves accepted:   " << getCounter(FMMovesAcceptedCounter)
+              << "\n";
+    std::cout << " Heap sift-up steps:  " << getCounter(HeapSiftUpCounter)
+              << "\n";
+    std::cout << " Heap sift-down steps: "
+              << getCounter(HeapSiftDownCounter) << "\n";
+    std::cout << " QP gradproj iterations: "
+              << getCounter(QPGradProjIterationsCounter) << "\n";
+    std::cout << " Napsack breakpoint pops: "
+              << getCounter(NapsackBreakpointsCounter) << "\n";
+    std::cout << " Mark-array clears:   " << getCounter(MarkArrayClearsCounter)
+              << "\n";
+#endif
 }
 
 } // end namespace Mongoose
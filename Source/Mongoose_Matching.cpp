@@ -19,9 +19,26 @@
  */
 
 #include "Mongoose_Matching.hpp"
+#include "Mongoose_ThreadPool.hpp"
+#include "Mongoose_Workspace.hpp"
 #include "Mongoose_Debug.hpp"
 #include "Mongoose_Internal.hpp"
 #include "Mongoose_Logger.hpp"
+#include "Mongoose_Random.hpp"
+#include "Mongoose_UnionFind.hpp"
+
+#if CPP11_OR_LATER
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <vector>
+#endif
+
+#include "Mongoose_Simd.hpp"
+
+#if MONGOOSE_SIMD_AVX2
+#include <immintrin.h>
+#endif
 
 namespace Mongoose
 {
@@ -38,6 +55,10 @@ void match(EdgeCutProblem *graph, const EdgeCut_Options *options)
         matching_Random(graph, options);
         break;
 
+    case RandomBlock:
+        matching_RandomBlock(graph, options);
+        break;
+
     case HEM:
         matching_HEM(graph, options);
         break;
@@ -59,6 +80,85 @@ void match(EdgeCutProblem *graph, const EdgeCut_Options *options)
 //-----------------------------------------------------------------------------
 // Cleans up a matching by matching remaining unmatched vertices to themselves
 //-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+// Finds a matched vertex whose aggregate can absorb one more vertex, using
+// union-find over the current matching. Advances *cursor past aggregates that
+// are already full, so the amortized cost over a cleanup sweep is O(n). The
+// previous implementation rescanned matchtype[] from vertex 0 for every
+// leftover vertex, which was quadratic on graphs with many leftovers.
+// Returns -1 if every aggregate is full.
+//-----------------------------------------------------------------------------
+static Int findCommunityHost(EdgeCutProblem *graph, UnionFind *aggregates,
+                             Int *cursor)
+{
+    for (Int i = *cursor; i < graph->n; i++)
+    {
+        if (graph->isMatched(i) && aggregates->size(i) < 3)
+        {
+            *cursor = i;
+            return i;
+        }
+    }
+    *cursor = graph->n;
+    return -1;
+}
+
+//-----------------------------------------------------------------------------
+// Two-hop pass: match unmatched vertices that share a common neighbor.
+// Hub-heavy (power-law) graphs leave many orphans behind, because every
+// neighbor of a leaf is a high-degree vertex that is matched already; pairing
+// the leaves through their shared hub keeps coarsening shrinking instead of
+// stalling. Runs in O(nz): each hub remembers one unmatched vertex waiting
+// at it, and the next unmatched vertex to arrive is matched with it.
+//-----------------------------------------------------------------------------
+static void matching_TwoHop(EdgeCutProblem *graph)
+{
+    Int n   = graph->n;
+    Int *Gp = graph->p;
+    Int *Gi = graph->i;
+
+    /* waiting[m] is an unmatched vertex adjacent to m, or -1; borrowed
+     * from the pooled workspace rather than allocated per level. */
+    Workspace *ws = graph->getWorkspace();
+    Int *waiting  = (ws) ? ws->getInts(static_cast<size_t>(n)) : NULL;
+    if (!waiting)
+        return; /* Out of memory: leftovers become orphans as before. */
+    for (Int k = 0; k < n; k++)
+        waiting[k] = -1;
+
+    for (Int k = 0; k < n; k++)
+    {
+        if (graph->isMatched(k))
+            continue;
+
+        /* Look for an unmatched vertex waiting at one of our neighbors. */
+        bool matched = false;
+        for (Int p = Gp[k]; p < Gp[k + 1] && !matched; p++)
+        {
+            Int partner = waiting[Gi[p]];
+            if (partner != -1 && partner != k && !graph->isMatched(partner))
+            {
+                graph->createMatch(k, partner, MatchType_Brotherly);
+                matched = true;
+            }
+        }
+
+        /* Otherwise wait at every neighbor not already taken. */
+        if (!matched)
+        {
+            for (Int p = Gp[k]; p < Gp[k + 1]; p++)
+            {
+                Int neighbor = Gi[p];
+                if (waiting[neighbor] == -1
+                    || graph->isMatched(waiting[neighbor]))
+                {
+                    waiting[neighbor] = k;
+                }
+            }
+        }
+    }
+}
+
 void matching_Cleanup(EdgeCutProblem *graph, const EdgeCut_Options *options)
 {
     (void)options; // Unused variable
@@ -66,6 +166,29 @@ void matching_Cleanup(EdgeCutProblem *graph, const EdgeCut_Options *options)
     Int n   = graph->n;
     Int *Gp = graph->p;
 
+    /* Pair up leftover vertices that share a common neighbor before falling
+     * back to orphan self-matches. */
+    matching_TwoHop(graph);
+
+    /* Union-find over the matching, built lazily the first time a leftover
+     * vertex needs to join an existing aggregate (community matching only). */
+    UnionFind *aggregates = NULL;
+    Int hostCursor        = 0;
+    if (options->do_community_matching)
+    {
+        aggregates = UnionFind::create(n);
+        if (aggregates)
+        {
+            for (Int k = 0; k < n; k++)
+            {
+                if (graph->isMatched(k))
+                {
+                    aggregates->unite(k, graph->getMatch(k));
+                }
+            }
+        }
+    }
+
     /* Match unmatched vertices to themselves. */
     for (Int k = 0; k < n; k++)
     {
@@ -82,21 +205,21 @@ void matching_Cleanup(EdgeCutProblem *graph, const EdgeCut_Options *options)
                 else
                 {
                     graph->createMatch(k, graph->singleton, MatchType_Standard);
+                    if (aggregates)
+                        aggregates->unite(k, graph->singleton);
                     graph->singleton = -1;
                 }
             }
             else
             {
                 // Not a singleton
-                if (options->do_community_matching)
+                Int host = (aggregates)
+                    ? findCommunityHost(graph, aggregates, &hostCursor)
+                    : -1;
+                if (host != -1)
                 {
-                    int i;
-                    for (i = 0; i < graph->n; i++)
-                    {
-                        if (graph->matchtype[i] != MatchType_Community)
-                            break;
-                    }
-                    graph->createCommunityMatch(i, k, MatchType_Community);
+                    graph->createCommunityMatch(host, k, MatchType_Community);
+                    aggregates->unite(host, k);
                 }
                 else
                 {
@@ -109,16 +232,14 @@ void matching_Cleanup(EdgeCutProblem *graph, const EdgeCut_Options *options)
     if (graph->singleton != -1)
     {
         // Leftover singleton
-        Int k = graph->singleton;
-        if (options->do_community_matching)
+        Int k    = graph->singleton;
+        Int host = (aggregates)
+            ? findCommunityHost(graph, aggregates, &hostCursor)
+            : -1;
+        if (host != -1)
         {
-            int i;
-            for (i = 0; i < graph->n; i++)
-            {
-                if (graph->matchtype[i] != MatchType_Community)
-                    break;
-            }
-            graph->createCommunityMatch(i, k, MatchType_Community);
+            graph->createCommunityMatch(host, k, MatchType_Community);
+            aggregates->unite(host, k);
         }
         else
         {
@@ -126,6 +247,11 @@ void matching_Cleanup(EdgeCutProblem *graph, const EdgeCut_Options *options)
         }
     }
 
+    if (aggregates)
+    {
+        aggregates->~UnionFind();
+    }
+
 #ifndef NDEBUG
     /* Every vertex must be matched in no more than a 3-way matching. */
     for (Int k = 0; k < n; k++)
@@ -231,6 +357,79 @@ void matching_Random(EdgeCutProblem *graph, const EdgeCut_Options *options)
 #endif
 }
 
+//-----------------------------------------------------------------------------
+// This is a block-randomized matching strategy. Vertices are visited in
+// randomly permuted order, but the permutation is applied to cache-sized
+// blocks of consecutive vertices rather than to individual vertices: the
+// blocks are shuffled, and each block is swept sequentially. The sweep
+// within a block streams through p/i/x in index order, so the matching
+// stays memory-friendly on large graphs while retaining enough randomness
+// to avoid the pathological matchings a purely natural order can produce.
+//-----------------------------------------------------------------------------
+void matching_RandomBlock(EdgeCutProblem *graph, const EdgeCut_Options *options)
+{
+    (void)options; // Unused variable
+
+    Int n   = graph->n;
+    Int *Gp = graph->p;
+    Int *Gi = graph->i;
+
+    /* One block spans enough vertices that the p/i/x slices it touches
+     * cover several pages; the shuffle only disturbs locality at block
+     * boundaries. */
+    const Int blockSize = 4096;
+    Int nBlocks         = (n + blockSize - 1) / blockSize;
+
+    Workspace *ws   = graph->getWorkspace();
+    Int *blockOrder = (ws) ? ws->getInts(static_cast<size_t>(nBlocks)) : NULL;
+    if (!blockOrder)
+    {
+        /* Out of memory: fall back to the natural-order sweep. */
+        matching_Random(graph, options);
+        return;
+    }
+
+    for (Int b = 0; b < nBlocks; b++)
+    {
+        blockOrder[b] = b;
+    }
+
+    /* Fisher-Yates shuffle of the block visitation order. */
+    for (Int b = nBlocks - 1; b > 0; b--)
+    {
+        Int r         = random() % (b + 1);
+        Int temp      = blockOrder[b];
+        blockOrder[b] = blockOrder[r];
+        blockOrder[r] = temp;
+    }
+
+    for (Int b = 0; b < nBlocks; b++)
+    {
+        Int start = blockOrder[b] * blockSize;
+        Int end   = std::min(start + blockSize, n);
+        for (Int k = start; k < end; k++)
+        {
+            /* Consider only unmatched vertices */
+            if (graph->isMatched(k))
+                continue;
+
+            bool unmatched = true;
+            for (Int p = Gp[k]; p < Gp[k + 1] && unmatched; p++)
+            {
+                Int neighbor = Gi[p];
+
+                /* Consider only unmatched neighbors */
+                if (graph->isMatched(neighbor))
+                    continue;
+
+                unmatched = false;
+
+                graph->createMatch(k, neighbor, MatchType_Standard);
+            }
+        }
+    }
+}
+
 //-----------------------------------------------------------------------------
 // This is the implementation of stall-reducing matching
 //-----------------------------------------------------------------------------
@@ -239,7 +438,7 @@ void matching_SR(EdgeCutProblem *graph, const EdgeCut_Options *options)
     Int n      = graph->n;
     Int *Gp    = graph->p;
     Int *Gi    = graph->i;
-    double *Gx = graph->x;
+    WeightType *Gx = graph->x;
 
 #ifndef NDEBUG
     /* In order for us to use Passive-Aggressive matching,
@@ -261,19 +460,30 @@ void matching_SR(EdgeCutProblem *graph, const EdgeCut_Options *options)
         if (graph->isMatched(k))
             continue;
 
-        Int heaviestNeighbor  = -1;
-        double heaviestWeight = -1.0;
+        Int heaviestNeighbor = -1;
 
-        for (Int p = Gp[k]; p < Gp[k + 1]; p++)
+        if (!Gx)
         {
-            Int neighbor = Gi[p];
-
-            /* Keep track of the heaviest. */
-            double x = (Gx) ? Gx[p] : 1;
-            if (x > heaviestWeight)
+            /* Unit weights: the first neighbor is already the heaviest. */
+            if (Gp[k] < Gp[k + 1])
             {
-                heaviestWeight   = x;
-                heaviestNeighbor = neighbor;
+                heaviestNeighbor = Gi[Gp[k]];
+            }
+        }
+        else
+        {
+            double heaviestWeight = -1.0;
+            for (Int p = Gp[k]; p < Gp[k + 1]; p++)
+            {
+                Int neighbor = Gi[p];
+
+                /* Keep track of the heaviest. */
+                double x = Gx[p];
+                if (x > heaviestWeight)
+                {
+                    heaviestWeight   = x;
+                    heaviestNeighbor = neighbor;
+                }
             }
         }
 
@@ -390,36 +600,237 @@ void matching_SRdeg(EdgeCutProblem *graph, const EdgeCut_Options *options)
     ASSERT(graph->cn < n);
 }
 
+#if MONGOOSE_SIMD_AVX2 && !defined(MONGOOSE_WEIGHT_FLOAT)                      \
+    && !defined(MONGOOSE_INT32)
 //-----------------------------------------------------------------------------
-// This is a vanilla implementation of heavy edge matching
+// AVX2 body of the heaviest-unmatched-neighbor scan, four edges at a time.
+// Compiled with its own target attribute and entered only when simdAVX2()
+// says the hardware has it, so the library binary stays deployable on
+// plain x86-64. Advances *p_inout past the vectorized prefix (the caller's
+// scalar loop finishes the remainder) and returns the position of the
+// heaviest free edge found, or -1. The epi64 gather assumes the 64-bit
+// Int, hence the MONGOOSE_INT32 exclusion.
 //-----------------------------------------------------------------------------
-void matching_HEM(EdgeCutProblem *graph, const EdgeCut_Options *options)
+MONGOOSE_TARGET_AVX2
+static Int heaviestScanAVX2(const Int *Gi, const WeightType *Gx,
+                            const Int *matching, Int *p_inout, Int pEnd,
+                            double *inout_heaviestWeight)
 {
-    (void)options; // Unused variable
+    Int p                 = *p_inout;
+    double heaviestWeight = *inout_heaviestWeight;
 
-    Int n      = graph->n;
+    const __m256i zero   = _mm256_setzero_si256();
+    const __m256d negInf = _mm256_set1_pd(-HUGE_VAL);
+
+    __m256d vmax = negInf;                 /* per-lane best weight   */
+    __m256i vpos = _mm256_set1_epi64x(-1); /* per-lane best position */
+
+    for (; p + 4 <= pEnd; p += 4)
+    {
+        __m256i idx = _mm256_loadu_si256((const __m256i *)(Gi + p));
+
+        /* matching[neighbor] == 0 means unmatched. */
+        __m256i match = _mm256_i64gather_epi64((const long long *)matching,
+                                               idx, 8);
+        __m256d eligible
+            = _mm256_castsi256_pd(_mm256_cmpeq_epi64(match, zero));
+
+        /* Ineligible lanes get -inf so they never win the max. */
+        __m256d weight = _mm256_loadu_pd(Gx + p);
+        weight         = _mm256_blendv_pd(negInf, weight, eligible);
+
+        /* Track the first strictly heavier edge per lane. */
+        __m256d heavier = _mm256_cmp_pd(weight, vmax, _CMP_GT_OQ);
+        vmax            = _mm256_blendv_pd(vmax, weight, heavier);
+        __m256i posNow  = _mm256_set_epi64x(p + 3, p + 2, p + 1, p);
+        vpos            = _mm256_castpd_si256(
+            _mm256_blendv_pd(_mm256_castsi256_pd(vpos),
+                             _mm256_castsi256_pd(posNow), heavier));
+    }
+
+    /* Horizontal reduction: heaviest weight wins; on ties the earliest
+     * edge position wins, matching the scalar scan order. */
+    double lmax[4];
+    long long lpos[4];
+    _mm256_storeu_pd(lmax, vmax);
+    _mm256_storeu_si256((__m256i *)lpos, vpos);
+
+    Int bestPos = -1;
+    for (int lane = 0; lane < 4; lane++)
+    {
+        if (lpos[lane] == -1)
+            continue;
+        if (lmax[lane] > heaviestWeight
+            || (lmax[lane] == heaviestWeight && lpos[lane] < bestPos))
+        {
+            heaviestWeight = lmax[lane];
+            bestPos        = lpos[lane];
+        }
+    }
+
+    *p_inout             = p;
+    *inout_heaviestWeight = heaviestWeight;
+    return bestPos;
+}
+#endif
+
+//-----------------------------------------------------------------------------
+// Finds the heaviest unmatched neighbor in the adjacency slice of vertex k,
+// exactly as the scalar loop in matching_HEM does (first strictly heavier
+// edge wins). On AVX2 targets the scan runs four edges at a time: the row
+// indices are loaded as a vector, the matched mask is gathered from
+// matching[], and a lane-wise max-reduction tracks both the weight and the
+// edge position. Short rows and unweighted graphs use the scalar loop.
+//-----------------------------------------------------------------------------
+static inline Int heaviestUnmatchedNeighbor(EdgeCutProblem *graph, Int k,
+                                            Int sample)
+{
     Int *Gp    = graph->p;
     Int *Gi    = graph->i;
-    double *Gx = graph->x;
+    WeightType *Gx = graph->x;
+
+    Int pStart = Gp[k];
+    Int pEnd   = Gp[k + 1];
+
+    Int heaviestNeighbor  = -1;
+    double heaviestWeight = -1.0;
+    Int p                 = pStart;
+
+    /* Sampled scan for high-degree rows: try `sample` random edges and
+     * take the heaviest free one. Only when every sampled neighbor is
+     * already matched does the full scan below run, so the per-vertex
+     * work is O(sample) in the common case but the HEM invariant (an
+     * unmatched vertex has no unmatched neighbor) still holds. */
+    Int degree = pEnd - pStart;
+    if (sample > 0 && degree > 4 * sample)
+    {
+        for (Int s = 0; s < sample; s++)
+        {
+            Int q        = pStart + (random() % degree);
+            Int neighbor = Gi[q];
+            if (neighbor == k || graph->isMatched(neighbor))
+                continue;
 
-    for (Int k = 0; k < n; k++)
+            double x = (Gx) ? Gx[q] : 1;
+            if (x > heaviestWeight)
+            {
+                heaviestWeight   = x;
+                heaviestNeighbor = neighbor;
+            }
+        }
+        if (heaviestNeighbor != -1)
+            return heaviestNeighbor;
+    }
+
+    /* Unit weights: every edge ties at weight 1 and only a strictly
+     * heavier edge replaces the running best, so the first unmatched
+     * neighbor wins. Stop scanning as soon as one is found. */
+    if (!Gx)
     {
-        /* Consider only unmatched vertices */
+        for (; p < pEnd; p++)
+        {
+            Int neighbor = Gi[p];
+            if (!graph->isMatched(neighbor))
+                return neighbor;
+        }
+        return -1;
+    }
+
+#if MONGOOSE_SIMD_AVX2 && !defined(MONGOOSE_WEIGHT_FLOAT)                      \
+    && !defined(MONGOOSE_INT32)
+    if (simdAVX2() && Gx && pEnd - pStart >= 8)
+    {
+        Int bestPos = heaviestScanAVX2(Gi, Gx, graph->matching, &p, pEnd,
+                                       &heaviestWeight);
+        if (bestPos != -1)
+        {
+            heaviestNeighbor = Gi[bestPos];
+        }
+    }
+#endif
+
+    /* Scalar scan (whole row, the remainder of a SIMD scan, or all rows on
+     * non-AVX2 targets and unweighted graphs). */
+    for (; p < pEnd; p++)
+    {
+        Int neighbor = Gi[p];
+
+        /* Consider only unmatched neighbors */
+        if (graph->isMatched(neighbor))
+            continue;
+
+        /* Keep track of the heaviest. */
+        double x = (Gx) ? Gx[p] : 1;
+        if (x > heaviestWeight)
+        {
+            heaviestWeight   = x;
+            heaviestNeighbor = neighbor;
+        }
+    }
+
+    return heaviestNeighbor;
+}
+
+#if CPP11_OR_LATER
+
+//-----------------------------------------------------------------------------
+// Parallel claiming phase for heavy edge matching
+//-----------------------------------------------------------------------------
+// Worker threads sweep disjoint vertex ranges, find each vertex's heaviest
+// unclaimed neighbor, and claim the pair with compare-and-swap on a scratch
+// claim array (matching[] itself also carries matchmap/cn bookkeeping, so the
+// pairs are committed serially afterwards). Vertices that lose a race are
+// simply left unclaimed; the serial sweep in matching_HEM acts as the
+// conflict-resolution second pass.
+static void matching_HEM_claim(EdgeCutProblem *graph,
+                               std::atomic<Int> *claim, Int kBegin, Int kEnd,
+                               Int sample)
+{
+    Int *Gp    = graph->p;
+    Int *Gi    = graph->i;
+    WeightType *Gx = graph->x;
+
+    for (Int k = kBegin; k < kEnd; k++)
+    {
+        /* Consider only unmatched, unclaimed vertices */
         if (graph->isMatched(k))
             continue;
+        if (claim[k].load(std::memory_order_relaxed) != -1)
+            continue;
 
         Int heaviestNeighbor  = -1;
         double heaviestWeight = -1.0;
-        for (Int p = Gp[k]; p < Gp[k + 1]; p++)
+        Int pBegin            = Gp[k];
+        Int degree            = Gp[k + 1] - Gp[k];
+        bool sampled          = (sample > 0 && degree > 4 * sample);
+        Int scans             = sampled ? sample : degree;
+        for (Int s = 0; s < scans; s++)
         {
+            /* A vertex whose whole sample is taken stays unclaimed here;
+             * the serial sweep (which falls back to a full scan) matches
+             * it afterwards. */
+            Int p        = sampled ? pBegin + (random() % degree)
+                                   : pBegin + s;
             Int neighbor = Gi[p];
+            if (neighbor == k)
+                continue;
 
-            /* Consider only unmatched neighbors */
+            /* Consider only unmatched, unclaimed neighbors */
             if (graph->isMatched(neighbor))
                 continue;
+            if (claim[neighbor].load(std::memory_order_relaxed) != -1)
+                continue;
+
+            /* With unit weights the first eligible neighbor is already
+             * the heaviest; stop scanning. */
+            if (!Gx)
+            {
+                heaviestNeighbor = neighbor;
+                break;
+            }
 
             /* Keep track of the heaviest. */
-            double x = (Gx) ? Gx[p] : 1;
+            double x = Gx[p];
             if (x > heaviestWeight)
             {
                 heaviestWeight   = x;
@@ -427,6 +838,103 @@ void matching_HEM(EdgeCutProblem *graph, const EdgeCut_Options *options)
             }
         }
 
+        if (heaviestNeighbor == -1)
+            continue;
+
+        /* Claim ourselves first, then the neighbor. If the neighbor was
+         * claimed by another thread in the meantime, release our own claim
+         * and move on; the serial sweep will match k later. */
+        Int expected = -1;
+        if (!claim[k].compare_exchange_strong(expected, heaviestNeighbor))
+            continue;
+
+        expected = -1;
+        if (!claim[heaviestNeighbor].compare_exchange_strong(expected, k))
+        {
+            claim[k].store(-1);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Multi-threaded heavy edge matching, used when options->num_threads > 1
+//-----------------------------------------------------------------------------
+static void matching_HEM_parallel(EdgeCutProblem *graph,
+                                  const EdgeCut_Options *options)
+{
+    Int n = graph->n;
+
+    Int nthreads = std::min(options->num_threads, n);
+
+    /* Scratch claim array: claim[k] is the partner vertex k has claimed,
+     * or -1 if unclaimed. Borrowed from the pooled workspace; the atomics
+     * are re-initialized by placement new on every borrow. */
+    Workspace *ws           = graph->getWorkspace();
+    std::atomic<Int> *claim = static_cast<std::atomic<Int> *>(
+        (ws) ? ws->getBytes(static_cast<size_t>(n) * sizeof(std::atomic<Int>))
+             : NULL);
+    if (!claim)
+        return; /* Out of memory: fall back to the serial sweep. */
+
+    for (Int k = 0; k < n; k++)
+    {
+        new (&claim[k]) std::atomic<Int>(-1);
+    }
+
+    /* Claim pairs in parallel over disjoint vertex ranges, one pool job
+     * per range. */
+    Int chunk = (n + nthreads - 1) / nthreads;
+    ThreadPool::run(nthreads, [=](Int t) {
+        Int kBegin = t * chunk;
+        Int kEnd   = std::min(kBegin + chunk, n);
+        if (kBegin < kEnd)
+        {
+            matching_HEM_claim(graph, claim, kBegin, kEnd,
+                               options->matching_sample_size);
+        }
+    });
+
+    /* Commit mutually claimed pairs. createMatch updates matchmap and the
+     * coarse vertex count, so this pass stays serial. */
+    for (Int k = 0; k < n; k++)
+    {
+        Int partner = claim[k].load(std::memory_order_relaxed);
+        if (partner > k && claim[partner].load(std::memory_order_relaxed) == k)
+        {
+            graph->createMatch(k, partner, MatchType_Standard);
+        }
+    }
+}
+
+#endif
+
+//-----------------------------------------------------------------------------
+// This is a vanilla implementation of heavy edge matching
+//-----------------------------------------------------------------------------
+void matching_HEM(EdgeCutProblem *graph, const EdgeCut_Options *options)
+{
+#if CPP11_OR_LATER
+    /* Claim the bulk of the matching in parallel if requested. The serial
+     * sweep below then doubles as the conflict-resolution pass, matching any
+     * vertices whose claims were lost to another thread. */
+    if (options->num_threads > 1 && graph->n > 1)
+    {
+        matching_HEM_parallel(graph, options);
+    }
+#endif
+
+    Int n = graph->n;
+
+    for (Int k = 0; k < n; k++)
+    {
+        /* Consider only unmatched vertices */
+        if (graph->isMatched(k))
+            continue;
+
+        Int heaviestNeighbor
+            = heaviestUnmatchedNeighbor(graph, k,
+                                        options->matching_sample_size);
+
         /* Match to the heaviest. */
         if (heaviestNeighbor != -1)
         {
@@ -446,9 +954,9 @@ void matching_HEM(EdgeCutProblem *graph, const EdgeCut_Options *options)
             continue;
 
         /* Check condition 2 */
-        for (Int p = Gp[k]; p < Gp[k + 1]; p++)
+        for (Int p = graph->p[k]; p < graph->p[k + 1]; p++)
         {
-            ASSERT(graph->matching[Gi[p]]);
+            ASSERT(graph->matching[graph->i[p]]);
         }
     }
 #endif
@@ -0,0 +1,416 @@
+/* ========================================================================== */
+/* === Source/Mongoose_NestedDissection.cpp ================================= */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+#include "Mongoose_NestedDissection.hpp"
+#include "Mongoose_Internal.hpp"
+#include "Mongoose_Logger.hpp"
+#include "Mongoose_ThreadPool.hpp"
+#include "Mongoose_VertexSeparator.hpp"
+
+#include <vector>
+
+namespace Mongoose
+{
+
+/* Subgraphs at or below this many vertices are ordered locally instead of
+ * dissected further: at this size a separator no longer pays for itself
+ * and a greedy minimum-degree order does better. */
+static const Int ND_SMALL = 64;
+
+Ordering::~Ordering()
+{
+    SuiteSparse_free(perm);
+    SuiteSparse_free(iperm);
+    SuiteSparse_free(this);
+}
+
+/* One node of the dissection tree: a subgraph, the map back to input
+ * vertex ids, and the first position of its permutation range (the range
+ * length is the subgraph size). */
+struct DissectTask
+{
+    Graph *graph;   /* NULL for an empty side                      */
+    Int *vertexMap; /* local -> input vertex ids; NULL = identity  */
+    Int first;
+    bool ownsGraph; /* false only on the root (the caller's graph) */
+};
+
+static void releaseTask(DissectTask *task)
+{
+    if (task->ownsGraph && task->graph)
+    {
+        task->graph->~Graph();
+    }
+    task->graph     = NULL;
+    task->vertexMap = (Int *)SuiteSparse_free(task->vertexMap);
+}
+
+/* Greedy minimum-degree order of one small subgraph into
+ * perm[first ... first + n). Degrees are recounted among the
+ * uneliminated neighbors on every pick; quadratic, but only ever run on
+ * ND_SMALL-sized leaves. */
+static void orderLocal(const Graph *G, const Int *map, Int *perm, Int first)
+{
+    Int n         = G->n;
+    const Int *Gp = G->p;
+    const Int *Gi = G->i;
+
+    /* A leaf is tiny, so a stack-free quadratic scan with one local
+     * bitmapish array is fine. */
+    std::vector<char> eliminated(static_cast<size_t>(n), 0);
+
+    for (Int k = 0; k < n; k++)
+    {
+        Int best       = -1;
+        Int bestDegree = 0;
+        for (Int v = 0; v < n; v++)
+        {
+            if (eliminated[v])
+                continue;
+            Int degree = 0;
+            for (Int q = Gp[v]; q < Gp[v + 1]; q++)
+            {
+                if (!eliminated[Gi[q]])
+                    degree++;
+            }
+            if (best < 0 || degree < bestDegree)
+            {
+                best       = v;
+                bestDegree = degree;
+            }
+        }
+        eliminated[best] = 1;
+        perm[first + k]  = map ? map[best] : best;
+    }
+}
+
+/* Extracts the induced subgraph of one side of a dissection (labels from
+ * VertexSeparator: 0, 1, or 2 for the separator), renumbering its
+ * vertices contiguously. The parent is already sanitized and an induced
+ * subgraph stays that way, so no re-sanitization happens anywhere in the
+ * tree. An empty side yields *subOut = NULL. */
+static bool extractPart(const Graph *G, const Int *parentMap,
+                        const Int *labels, Int whichPart, Graph **subOut,
+                        Int **mapOut)
+{
+    *subOut = NULL;
+    *mapOut = NULL;
+
+    Int n        = G->n;
+    Int *localId = (Int *)SuiteSparse_malloc(static_cast<size_t>(n),
+                                             sizeof(Int));
+    if (!localId)
+        return false;
+
+    Int nsub = 0;
+    for (Int v = 0; v < n; v++)
+    {
+        localId[v] = (labels[v] == whichPart) ? nsub++ : -1;
+    }
+    if (nsub == 0)
+    {
+        SuiteSparse_free(localId);
+        return true;
+    }
+
+    const Int *Gp        = G->p;
+    const Int *Gi        = G->i;
+    const WeightType *Gx = G->x;
+    const WeightType *Gw = G->w;
+
+    Int nzsub = 0;
+    for (Int v = 0; v < n; v++)
+    {
+        if (localId[v] < 0)
+            continue;
+        for (Int q = Gp[v]; q < Gp[v + 1]; q++)
+        {
+            if (localId[Gi[q]] >= 0)
+                nzsub++;
+        }
+    }
+
+    Int *map = (Int *)SuiteSparse_malloc(static_cast<size_t>(nsub),
+                                         sizeof(Int));
+    Graph *sub = Graph::create(nsub, nzsub);
+    if (sub && Gx)
+    {
+        sub->x = (WeightType *)SuiteSparse_malloc(
+            static_cast<size_t>(nzsub), sizeof(WeightType));
+    }
+    if (sub && Gw)
+    {
+        sub->w = (WeightType *)SuiteSparse_malloc(static_cast<size_t>(nsub),
+                                                  sizeof(WeightType));
+    }
+    if (!map || !sub || (Gx && !sub->x) || (Gw && !sub->w))
+    {
+        SuiteSparse_free(localId);
+        SuiteSparse_free(map);
+        if (sub)
+            sub->~Graph();
+        return false;
+    }
+
+    Int nz = 0;
+    for (Int v = 0; v < n; v++)
+    {
+        Int j = localId[v];
+        if (j < 0)
+            continue;
+        map[j] = parentMap ? parentMap[v] : v;
+        if (Gw)
+        {
+            sub->w[j] = Gw[v];
+        }
+        for (Int q = Gp[v]; q < Gp[v + 1]; q++)
+        {
+            Int u = localId[Gi[q]];
+            if (u < 0)
+                continue;
+            sub->i[nz] = u;
+            if (Gx)
+            {
+                sub->x[nz] = Gx[q];
+            }
+            nz++;
+        }
+        sub->p[j + 1] = nz;
+    }
+
+    SuiteSparse_free(localId);
+    *subOut = sub;
+    *mapOut = map;
+    return true;
+}
+
+/* Processes one dissection task: orders a small subgraph locally, or
+ * separates it, writes the separator at the tail of the task's range,
+ * and emits the two side tasks. */
+static bool dissectTask(const DissectTask *task,
+                        const EdgeCut_Options *memberOptions,
+                        DissectTask *child0, DissectTask *child1, Int *perm)
+{
+    child0->graph     = child1->graph = NULL;
+    child0->vertexMap = child1->vertexMap = NULL;
+    child0->ownsGraph = child1->ownsGraph = true;
+
+    const Graph *G = task->graph;
+    const Int *map = task->vertexMap;
+    Int n          = G->n;
+
+    if (n <= ND_SMALL)
+    {
+        orderLocal(G, map, perm, task->first);
+        return true;
+    }
+
+    VertexSeparator *sep = vertex_separator(G, memberOptions);
+    if (!sep)
+        return false;
+    const Int *labels = sep->partition;
+
+    Int n0 = 0, n1 = 0;
+    for (Int v = 0; v < n; v++)
+    {
+        if (labels[v] == 0)
+            n0++;
+        else if (labels[v] == 1)
+            n1++;
+    }
+
+    if (n0 == n || n1 == n)
+    {
+        /* No progress (an extreme cut put everything on one side): fall
+         * back to the natural order rather than recursing forever. */
+        for (Int v = 0; v < n; v++)
+        {
+            perm[task->first + v] = map ? map[v] : v;
+        }
+        sep->~VertexSeparator();
+        return true;
+    }
+
+    /* The separator is eliminated last: its vertices take the tail of
+     * this task's permutation range, in natural order. */
+    Int pos = task->first + n0 + n1;
+    for (Int v = 0; v < n; v++)
+    {
+        if (labels[v] == 2)
+        {
+            perm[pos++] = map ? map[v] : v;
+        }
+    }
+
+    bool ok = extractPart(G, map, labels, 0, &child0->graph,
+                          &child0->vertexMap)
+              && extractPart(G, map, labels, 1, &child1->graph,
+                             &child1->vertexMap);
+
+    child0->first = task->first;
+    child1->first = task->first + n0;
+
+    sep->~VertexSeparator();
+    return ok;
+}
+
+Ordering *nested_dissection(const Graph *graph)
+{
+    // use default options if not present
+    EdgeCut_Options *options = EdgeCut_Options::create();
+
+    if (!options)
+        return NULL;
+
+    Ordering *result = nested_dissection(graph, options);
+
+    options->~EdgeCut_Options();
+
+    return (result);
+}
+
+Ordering *nested_dissection(const Graph *graph,
+                            const EdgeCut_Options *options)
+{
+    if (!graph || !options)
+        return NULL;
+
+    Ordering *result = (Ordering *)SuiteSparse_malloc(1, sizeof(Ordering));
+    if (!result)
+        return NULL;
+
+    size_t n      = static_cast<size_t>(graph->n);
+    result->n     = graph->n;
+    result->perm  = (Int *)SuiteSparse_malloc(n, sizeof(Int));
+    result->iperm = (Int *)SuiteSparse_malloc(n, sizeof(Int));
+    if (!result->perm || !result->iperm)
+    {
+        result->~Ordering();
+        return NULL;
+    }
+
+    DissectTask root;
+    root.graph     = (Graph *)graph;
+    root.vertexMap = NULL;
+    root.first     = 0;
+    root.ownsGraph = false;
+
+    std::vector<DissectTask> current(1, root);
+    bool failed = false;
+
+    /* One batch of independent tasks per dissection depth, like the k-way
+     * driver: depth d has up to 2^d tasks, which is where the tree's
+     * parallelism comes from. (Without C++11 threads the batches run
+     * serially, same results.) */
+    while (!current.empty() && !failed)
+    {
+        std::vector<DissectTask> live;
+        for (size_t s = 0; s < current.size(); s++)
+        {
+            if (!current[s].graph || current[s].graph->n == 0)
+            {
+                releaseTask(&current[s]);
+            }
+            else
+            {
+                live.push_back(current[s]);
+            }
+        }
+        current.clear();
+        if (live.empty())
+            break;
+
+        Int nt = (Int)live.size();
+
+        /* Raw array for the per-task options: ~EdgeCut_Options frees
+         * `this` (the factory pattern), so these copies must never be
+         * destroyed as C++ objects. */
+        EdgeCut_Options *memberOptions
+            = (EdgeCut_Options *)SuiteSparse_malloc(static_cast<size_t>(nt),
+                                                    sizeof(EdgeCut_Options));
+        if (!memberOptions)
+        {
+            for (Int t = 0; t < nt; t++)
+            {
+                releaseTask(&live[t]);
+            }
+            failed = true;
+            break;
+        }
+        for (Int t = 0; t < nt; t++)
+        {
+            /* Seeds keyed off the task's permutation range make the
+             * ordering independent of worker scheduling. */
+            memberOptions[t] = *options;
+            memberOptions[t].random_seed
+                = options->random_seed + live[t].first;
+        }
+
+        std::vector<DissectTask> children(static_cast<size_t>(2 * nt));
+        std::vector<char> ok(static_cast<size_t>(nt), 0);
+
+        Int *perm = result->perm;
+
+#if CPP11_OR_LATER
+        DissectTask *liveData     = live.data();
+        DissectTask *childrenData = children.data();
+        char *okData              = ok.data();
+
+        ThreadPool::run(nt, [=](Int t) {
+            okData[t] = dissectTask(&liveData[t], &memberOptions[t],
+                                    &childrenData[2 * t],
+                                    &childrenData[2 * t + 1], perm);
+        });
+#else
+        for (Int t = 0; t < nt; t++)
+        {
+            ok[t] = dissectTask(&live[t], &memberOptions[t],
+                                &children[2 * t], &children[2 * t + 1], perm);
+        }
+#endif
+
+        SuiteSparse_free(memberOptions);
+
+        for (Int t = 0; t < nt; t++)
+        {
+            releaseTask(&live[t]);
+            if (!ok[t])
+            {
+                failed = true;
+            }
+        }
+
+        if (failed)
+        {
+            for (Int t = 0; t < 2 * nt; t++)
+            {
+                releaseTask(&children[t]);
+            }
+            break;
+        }
+        current.swap(children);
+    }
+
+    if (failed)
+    {
+        result->~Ordering();
+        return NULL;
+    }
+
+    for (Int k = 0; k < result->n; k++)
+    {
+        result->iperm[result->perm[k]] = k;
+    }
+
+    return result;
+}
+
+} // end namespace Mongoose
@@ -0,0 +1,67 @@
+/* ========================================================================== */
+/* === Source/Mongoose_QPBackend.cpp ======================================== */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+#include "Mongoose_QPBackend.hpp"
+#include "Mongoose_Internal.hpp"
+#include "Mongoose_QPGradProj.hpp"
+
+namespace Mongoose
+{
+
+static const QP_Backend *qp_backend = NULL;
+
+void setQPBackend(const QP_Backend *backend)
+{
+    qp_backend = backend;
+}
+
+const QP_Backend *getQPBackend()
+{
+    return qp_backend;
+}
+
+double qpGradProjDispatch(EdgeCutProblem *graph,
+                          const EdgeCut_Options *options, QPDelta *qpDelta)
+{
+    const QP_Backend *backend = qp_backend;
+    if (backend)
+    {
+        if (graph->qpBackendState == 0)
+        {
+            /* First pass at this level: upload the CSR once. A NULL
+             * handle declines the level for good, so a backend is never
+             * asked twice about the same graph. */
+            graph->qpBackendHandle
+                = backend->setup(backend->context, graph->n, graph->nz,
+                                 graph->p, graph->i, graph->x, graph->w);
+            graph->qpBackendState = (graph->qpBackendHandle) ? 1 : -1;
+        }
+        if (graph->qpBackendState == 1)
+        {
+            return backend->gradproj(backend->context,
+                                     graph->qpBackendHandle, graph, options,
+                                     qpDelta);
+        }
+    }
+    return QPGradProj(graph, options, qpDelta);
+}
+
+void qpBackendReleaseLevel(EdgeCutProblem *graph)
+{
+    if (graph->qpBackendHandle && qp_backend && qp_backend->release)
+    {
+        qp_backend->release(qp_backend->context, graph->qpBackendHandle);
+    }
+    graph->qpBackendHandle = NULL;
+    graph->qpBackendState  = 0;
+}
+
+} // end namespace Mongoose
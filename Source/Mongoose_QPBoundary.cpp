@@ -37,14 +37,55 @@
 /* ========================================================================== */
 
 #include "Mongoose_QPBoundary.hpp"
+#include "Mongoose_ThreadPool.hpp"
 #include "Mongoose_Debug.hpp"
 #include "Mongoose_Internal.hpp"
 
+#if CPP11_OR_LATER
+#include <vector>
+#endif
+
 #define EMPTY (-1)
 
 namespace Mongoose
 {
 
+#if CPP11_OR_LATER
+
+//-----------------------------------------------------------------------------
+// Parallel screen for the step-2 flip tests.
+//-----------------------------------------------------------------------------
+// The flip decisions in step 2 are coupled through the running value of b,
+// so the pass itself must stay serial. The expensive part, however, is the
+// gradient test evaluated for every bound vertex; those reads are screened
+// here in parallel against the gradient as it stands on entry to step 2.
+// The serial pass below re-evaluates the test only for vertices whose
+// gradient an earlier flip has since touched, so the results are identical
+// to the serial sweep.
+static void qpFlipScreenWorker(const QPScalar *grad, const QPScalar *D,
+                               const Int *FreeSet_status, Int *candidate,
+                               Int kBegin, Int kEnd)
+{
+    for (Int k = kBegin; k < kEnd; k++)
+    {
+        Int status = FreeSet_status[k];
+        if (status > 0)
+        {
+            candidate[k] = (0.5 * D[k] + grad[k] >= 0) ? 1 : 0;
+        }
+        else if (status < 0)
+        {
+            candidate[k] = (grad[k] - 0.5 * D[k] <= 0) ? 1 : 0;
+        }
+        else
+        {
+            candidate[k] = 0;
+        }
+    }
+}
+
+#endif
+
 void QPBoundary(EdgeCutProblem *graph, const EdgeCut_Options *options, QPDelta *QP)
 {
     (void)options; // Unused variable
@@ -70,8 +111,8 @@ void QPBoundary(EdgeCutProblem *graph, const EdgeCut_Options *options, QPDelta *
         return;
     }
 
-    double *x    = QP->x;        /* current estimate of solution */
-    double *grad = QP->gradient; /* gradient at current x */
+    QPScalar *x  = QP->x;        /* current estimate of solution */
+    QPScalar *grad = QP->gradient; /* gradient at current x */
     Int ib       = QP->ib;       /* ib = +1, -1, or 0 ,
          if b = hi, lo, or lo < b < hi, respectively.  Note there are cases
          where roundoff occurs, and ib can be zero even though b == lo or
@@ -82,16 +123,16 @@ void QPBoundary(EdgeCutProblem *graph, const EdgeCut_Options *options, QPDelta *
 
     /* problem specification for the graph G */
     Int n      = graph->n; /* problem dimension */
-    double *Ex = graph->x; /* numerical values for edge weights */
+    WeightType *Ex = graph->x; /* numerical values for edge weights */
     Int *Ei    = graph->i; /* adjacent vertices for each vertex */
     Int *Ep    = graph->p; /* points into Ex or Ei */
-    double *a  = graph->w; /* a'x = b, lo <= b <= hi */
+    WeightType *a = graph->w; /* a'x = b, lo <= b <= hi */
 
     double lo = QP->lo;
     double hi = QP->hi;
 
     /* work array */
-    double *D = QP->D; /* diagonal of quadratic */
+    QPScalar *D = QP->D; /* diagonal of quadratic */
 
     PR(("\n----- QPBoundary start: [\n"));
     DEBUG(QPcheckCom(graph, options, QP, 1, QP->nFreeSet, QP->b)); // check b
@@ -201,6 +242,119 @@ void QPBoundary(EdgeCutProblem *graph, const EdgeCut_Options *options, QPDelta *
 
     PR(("Boundary step 2:\n"));
 
+#if CPP11_OR_LATER
+    Int nthreads = std::min(options->num_threads, n);
+    if (nthreads > 1)
+    {
+        /* Screen the flip tests in parallel (see qpFlipScreenWorker), then
+         * apply the flips in the usual serial index order. A flip's
+         * gradient scatter invalidates the screened test for the touched
+         * neighbors; those are tracked (borrowing the sparse-gradient touch
+         * arrays, whose all-zero/false invariant is restored below) and
+         * re-tested exactly, so this produces the same flips as the serial
+         * sweep. */
+        Int *candidate = QP->wi[0];
+        Int *touchList = QP->touchList;
+        bool *touched  = QP->touched;
+        Int nTouched   = 0;
+
+        Int chunk = (n + nthreads - 1) / nthreads;
+        ThreadPool::run(nthreads, [=](Int t) {
+            Int kBegin = t * chunk;
+            Int kEnd   = std::min(kBegin + chunk, n);
+            if (kBegin < kEnd)
+            {
+                qpFlipScreenWorker(grad, D, FreeSet_status, candidate, kBegin,
+                                   kEnd);
+            }
+        });
+
+        for (Int k = 0; k < n; k++)
+        {
+            Int FreeSet_status_k = FreeSet_status[k];
+            if (FreeSet_status_k == 0)
+            {
+                // k is in FreeSet so it cannot be flipped 0->1 or 1->0
+                continue;
+            }
+
+            bool flip_lowers_cost;
+            if (touched[k])
+            {
+                flip_lowers_cost = (FreeSet_status_k > 0)
+                                       ? (0.5 * D[k] + grad[k] >= 0)
+                                       : (grad[k] - 0.5 * D[k] <= 0);
+            }
+            else
+            {
+                flip_lowers_cost = (candidate[k] != 0);
+            }
+            if (!flip_lowers_cost)
+                continue;
+
+            double ak = (a) ? a[k] : 1;
+            if (FreeSet_status_k > 0) /* try changing x_k from 1 to 0 */
+            {
+                if (b - ak >= lo)
+                {
+                    b -= ak;
+                    ib                = (b <= lo ? -1 : 0);
+                    x[k]              = 0.0;
+                    FreeSet_status[k] = -1;
+                }
+            }
+            else /* try changing x_k from 0 to 1 */
+            {
+                if (b + ak <= hi)
+                {
+                    b += ak;
+                    ib                = (b >= hi ? 1 : 0);
+                    x[k]              = 1.0;
+                    FreeSet_status[k] = +1;
+                }
+            }
+
+            if (FreeSet_status_k != FreeSet_status[k])
+            {
+                if (FreeSet_status_k == 1) /* x [k] was 1, now it is 0 */
+                {
+                    for (Int p = Ep[k]; p < Ep[k + 1]; p++)
+                    {
+                        Int e = Ei[p];
+                        grad[e] += (Ex) ? Ex[p] : 1;
+                        if (!touched[e])
+                        {
+                            touched[e]            = true;
+                            touchList[nTouched++] = e;
+                        }
+                    }
+                    grad[k] += D[k];
+                }
+                else /* x [k] was 0, now it is 1 */
+                {
+                    for (Int p = Ep[k]; p < Ep[k + 1]; p++)
+                    {
+                        Int e = Ei[p];
+                        grad[e] -= (Ex) ? Ex[p] : 1;
+                        if (!touched[e])
+                        {
+                            touched[e]            = true;
+                            touchList[nTouched++] = e;
+                        }
+                    }
+                    grad[k] -= D[k];
+                }
+            }
+        }
+
+        /* Restore the all-false invariant on the borrowed touch arrays. */
+        for (Int t = 0; t < nTouched; t++)
+        {
+            touched[touchList[t]] = false;
+        }
+    }
+    else
+#endif
     for (Int k = 0; k < n; k++)
     {
         Int FreeSet_status_k = FreeSet_status[k];
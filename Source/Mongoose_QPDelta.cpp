@@ -22,16 +22,16 @@ QPDelta *QPDelta::Create(Int numVars)
     if (!ret)
         return NULL;
 
-    ret->x = (double *)SuiteSparse_malloc(static_cast<size_t>(numVars),
-                                          sizeof(double));
+    ret->x = (QPScalar *)SuiteSparse_malloc(static_cast<size_t>(numVars),
+                                            sizeof(QPScalar));
     ret->FreeSet_status
         = (Int *)SuiteSparse_malloc(static_cast<size_t>(numVars), sizeof(Int));
     ret->FreeSet_list = (Int *)SuiteSparse_malloc(
         static_cast<size_t>(numVars + 1), sizeof(Int));
-    ret->gradient = (double *)SuiteSparse_malloc(static_cast<size_t>(numVars),
-                                                 sizeof(double));
-    ret->D        = (double *)SuiteSparse_malloc(static_cast<size_t>(numVars),
-                                          sizeof(double));
+    ret->gradient = (QPScalar *)SuiteSparse_malloc(static_cast<size_t>(numVars),
+                                                   sizeof(QPScalar));
+    ret->D        = (QPScalar *)SuiteSparse_malloc(static_cast<size_t>(numVars),
+                                            sizeof(QPScalar));
 
     for (int i = 0; i < WISIZE; i++)
     {
@@ -41,10 +41,17 @@ QPDelta *QPDelta::Create(Int numVars)
 
     for (Int i = 0; i < WXSIZE; i++)
     {
-        ret->wx[i] = (double *)SuiteSparse_malloc(static_cast<size_t>(numVars),
-                                                  sizeof(double));
+        ret->wx[i] = (QPScalar *)SuiteSparse_malloc(
+            static_cast<size_t>(numVars), sizeof(QPScalar));
     }
 
+    ret->Dgrad = (QPScalar *)SuiteSparse_calloc(static_cast<size_t>(numVars),
+                                                sizeof(QPScalar));
+    ret->touchList
+        = (Int *)SuiteSparse_malloc(static_cast<size_t>(numVars), sizeof(Int));
+    ret->touched = (bool *)SuiteSparse_calloc(static_cast<size_t>(numVars),
+                                              sizeof(bool));
+
 #ifndef NDEBUG
     ret->check_cost = INFINITY;
 #endif
@@ -53,7 +60,8 @@ QPDelta *QPDelta::Create(Int numVars)
         || !ret->D || !ret->wi[0]
         || !ret->wi[1]
         //|| !ret->Change_location
-        || !ret->wx[0] || !ret->wx[1] || !ret->wx[2])
+        || !ret->wx[0] || !ret->wx[1] || !ret->wx[2] || !ret->Dgrad
+        || !ret->touchList || !ret->touched)
     {
         ret->~QPDelta();
         ret = (QPDelta *)SuiteSparse_free(ret);
@@ -64,11 +72,11 @@ QPDelta *QPDelta::Create(Int numVars)
 
 QPDelta::~QPDelta()
 {
-    x              = (double *)SuiteSparse_free(x);
+    x              = (QPScalar *)SuiteSparse_free(x);
     FreeSet_status = (Int *)SuiteSparse_free(FreeSet_status);
     FreeSet_list   = (Int *)SuiteSparse_free(FreeSet_list);
-    gradient       = (double *)SuiteSparse_free(gradient);
-    D              = (double *)SuiteSparse_free(D);
+    gradient       = (QPScalar *)SuiteSparse_free(gradient);
+    D              = (QPScalar *)SuiteSparse_free(D);
     // Change_location = (Int*) SuiteSparse_free(Change_location);
 
     for (Int i = 0; i < WISIZE; i++)
@@ -78,8 +86,12 @@ QPDelta::~QPDelta()
 
     for (Int i = 0; i < WXSIZE; i++)
     {
-        wx[i] = (double *)SuiteSparse_free(wx[i]);
+        wx[i] = (QPScalar *)SuiteSparse_free(wx[i]);
     }
+
+    Dgrad     = (QPScalar *)SuiteSparse_free(Dgrad);
+    touchList = (Int *)SuiteSparse_free(touchList);
+    touched   = (bool *)SuiteSparse_free(touched);
 }
 
 } // end namespace Mongoose
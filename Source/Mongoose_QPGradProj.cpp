@@ -22,20 +22,112 @@
  */
 
 #include "Mongoose_QPGradProj.hpp"
+#include "Mongoose_ThreadPool.hpp"
 #include "Mongoose_Debug.hpp"
 #include "Mongoose_Internal.hpp"
 #include "Mongoose_Logger.hpp"
 #include "Mongoose_QPNapsack.hpp"
 
+#if CPP11_OR_LATER
+#include <vector>
+#endif
+
 #define EMPTY (-1)
 
 namespace Mongoose
 {
 
+#if CPP11_OR_LATER
+
+//-----------------------------------------------------------------------------
+// Parallel stepsize kernel: Dgrad = -(A+D)g_F over a row range.
+//-----------------------------------------------------------------------------
+// The serial code scatters -grad[i] down column i for each free i; since the
+// matrix is symmetric the same result is obtained by gathering along row k
+// from free neighbors, which gives each row a single writer and lets worker
+// threads sweep disjoint row ranges with no synchronization. (The gather
+// accumulates in a different order, so the last bits of Dgrad can differ
+// from the serial scatter; both are valid evaluations of the same sum.)
+static void qpDgradWorker(const Int *Ep, const Int *Ei, const WeightType *Ex,
+                          const QPScalar *D, const QPScalar *grad,
+                          const Int *FreeSet_status, QPScalar *Dgrad,
+                          Int kBegin, Int kEnd)
+{
+    for (Int k = kBegin; k < kEnd; k++)
+    {
+        double s = 0.;
+        if (Ex)
+        {
+            for (Int p = Ep[k]; p < Ep[k + 1]; p++)
+            {
+                Int i = Ei[p];
+                if (FreeSet_status[i] == 0)
+                {
+                    s += grad[i] * Ex[p];
+                }
+            }
+        }
+        else
+        {
+            /* Unit weights: gather free neighbors' gradients directly. */
+            for (Int p = Ep[k]; p < Ep[k + 1]; p++)
+            {
+                Int i = Ei[p];
+                if (FreeSet_status[i] == 0)
+                {
+                    s += grad[i];
+                }
+            }
+        }
+        if (FreeSet_status[k] == 0)
+        {
+            s += grad[k] * D[k];
+        }
+        Dgrad[k] = -s;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Parallel fused update: apply the gradient change and form the next trial
+// point in one streaming pass (see the serial loop in QPGradProj).
+//-----------------------------------------------------------------------------
+static void qpGradStepWorker(QPScalar *grad, const QPScalar *Dgrad,
+                             double alpha, const QPScalar *x, QPScalar *y,
+                             Int kBegin, Int kEnd)
+{
+    for (Int k = kBegin; k < kEnd; k++)
+    {
+        grad[k] += alpha * Dgrad[k];
+        y[k] = x[k] - grad[k];
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Runs nthreads jobs over disjoint row ranges on the shared thread pool.
+// The ranges are fixed by the job number, so the decomposition (and the
+// result) does not depend on which pool worker runs which range.
+//-----------------------------------------------------------------------------
+template <typename Worker>
+static void qpParallelRows(Int n, Int nthreads, Worker worker)
+{
+    Int chunk = (n + nthreads - 1) / nthreads;
+    ThreadPool::run(nthreads, [=](Int t) {
+        Int kBegin = t * chunk;
+        Int kEnd   = std::min(kBegin + chunk, n);
+        if (kBegin < kEnd)
+        {
+            worker(kBegin, kEnd);
+        }
+    });
+}
+
+#endif
+
 // save the current state of the solution, just before returning from QPGradProj
 inline void saveContext(EdgeCutProblem *graph, QPDelta *QP, Int it, double err,
                         Int nFreeSet, Int ib, double lo, double hi)
 {
+    MONGOOSE_COUNT_ADD(QPGradProjIterationsCounter, it);
     QP->its      = it;
     QP->err      = err;
     QP->nFreeSet = nFreeSet;
@@ -64,49 +156,75 @@ double QPGradProj(EdgeCutProblem *graph, const EdgeCut_Options *options, QPDelta
     /* Unpack the relevant structures                                         */
     /* ---------------------------------------------------------------------- */
 
-    double tol  = options->gradproj_tolerance;
-    double *wx1 = qpDelta->wx[0]; /* work array for napsack and here as y */
-    double *wx2 = qpDelta->wx[1]; /* work array for napsack and here as Dgrad */
-    double *wx3 = qpDelta->wx[2]; /* work array used here for d=y-x */
+    double tol    = options->gradproj_tolerance;
+    QPScalar *wx1 = qpDelta->wx[0]; /* work array for napsack and here as y */
+    QPScalar *wx2 = qpDelta->wx[1]; /* work array for napsack, here as Dgrad */
+    QPScalar *wx3 = qpDelta->wx[2]; /* work array used here for d=y-x */
     Int *wi1    = qpDelta->wi[0]; /* work array for napsack
                                 and here as changeList */
     Int *wi2 = qpDelta->wi[1];    /* work array only for napsack */
 
     /* Output and Input */
-    double *x = qpDelta->x; /* current estimate of solution            */
+    QPScalar *x = qpDelta->x; /* current estimate of solution          */
     Int *FreeSet_status = qpDelta->FreeSet_status;
     /* FreeSet_status [i] = +1,-1, or 0 if x_i = 1,0, or 0 < x_i < 1 */
 
     Int nFreeSet = qpDelta->nFreeSet; /* number of i such that 0 < x_i < 1 */
     Int *FreeSet_list = qpDelta->FreeSet_list; /* list of free indices */
 
-    double *grad = qpDelta->gradient; /* gradient at current x */
+    QPScalar *grad = qpDelta->gradient; /* gradient at current x */
 
     /* Unpack the problem's parameters. */
     Int n      = graph->n; /* problem dimension */
     Int *Ep    = graph->p; /* points into Ex or Ei */
     Int *Ei    = graph->i; /* adjacent vertices for each vertex */
-    double *Ex = graph->x; /* edge weights */
-    double *Ew = graph->w; /* vertex weights; a'x = b, lo <= b <= hi */
+    WeightType *Ex = graph->x; /* edge weights */
+    WeightType *Ew = graph->w; /* vertex weights; a'x = b, lo <= b <= hi */
 
     double lo = qpDelta->lo;
     double hi = qpDelta->hi;
 
-    double *D = qpDelta->D; /* diagonal of quadratic */
+    QPScalar *D = qpDelta->D; /* diagonal of quadratic */
 
     /* gradient projection parameters */
     Int limit = options->gradproj_iteration_limit; /* max number of iterations */
 
+#if CPP11_OR_LATER
+    /* Worker threads for the stepsize kernel and gradient updates. */
+    Int nthreads = std::min(options->num_threads, n);
+#endif
+
     /* work arrays */
-    double *y     = wx1;
-    double *wx    = wx2;
-    double *d     = wx3;
-    double *Dgrad = wx; /* gradient change       ; used in napsack as wx  */
+    QPScalar *y     = wx1;
+    QPScalar *wx    = wx2;
+    QPScalar *d     = wx3;
+    QPScalar *Dgrad = wx; /* gradient change     ; used in napsack as wx  */
 
     /* components of x change; used in napsack as wi1 */
     Int *changeList     = wi1;
     Int *changeLocation = wi2;
 
+    /* Sparse-gradient mode: scatter into a dedicated all-zero array and
+     * track exactly which entries get written, so the clears and gradient
+     * updates cost O(touched) instead of O(n) per iteration. */
+    bool sparseGrad = options->use_QP_sparse_gradient;
+    Int *touchList  = qpDelta->touchList;
+    bool *touched   = qpDelta->touched;
+    Int nTouched    = 0;
+    if (sparseGrad)
+    {
+        Dgrad = qpDelta->Dgrad;
+    }
+
+    /* Barzilai-Borwein step: measure the previous accepted move against the
+     * gradient change it produced and use that ratio as the next step
+     * length. Both sums fall out of quantities each iteration already forms
+     * (d and Dgrad over the change list), so BB iterations skip the
+     * -(A+D)g_F product below entirely. */
+    bool bbStep  = options->use_QP_BB_step;
+    double bbNum = 0.; /* ||dx||^2 of the previous move (unscaled)     */
+    double bbDen = 0.; /* -dx'(A+D)dx of the previous move (unscaled)  */
+
     /* compute error, take step along projected gradient */
     Int ib = 0; /* initialize ib so that lo < b < hi */
     // double lambda = 0.;
@@ -117,6 +235,12 @@ double QPGradProj(EdgeCutProblem *graph, const EdgeCut_Options *options, QPDelta
     DEBUG(FreeSet_dump("QPGradProj: start", n, FreeSet_list, nFreeSet,
                        FreeSet_status, 0, x));
 
+    /* Form the first trial point. Subsequent iterations re-form y inside
+     * the same streaming pass that applies the gradient change, so the
+     * gradient is not read twice per iteration. */
+    for (Int k = 0; k < n; k++)
+        y[k] = x[k] - grad[k];
+
     while (err > tol)
     {
 
@@ -161,9 +285,8 @@ double QPGradProj(EdgeCutProblem *graph, const EdgeCut_Options *options, QPDelta
         }
 #endif
 
-        /* Moving in the gradient direction. */
-        for (Int k = 0; k < n; k++)
-            y[k] = x[k] - grad[k];
+        /* y = x - grad was already formed, fused with the last gradient
+         * update (or just before the loop on the first iteration). */
 
         /* Run the napsack. */
         lambda = QPNapsack(y, n, lo, hi, Ew, lambda, FreeSet_status, wx, wi1,
@@ -172,12 +295,13 @@ double QPGradProj(EdgeCutProblem *graph, const EdgeCut_Options *options, QPDelta
         /* Compute the maximum error. */
         err = -INFINITY;
         for (Int k = 0; k < n; k++)
-            err = std::max(err, fabs(y[k] - x[k]));
+            err = std::max(err, (double)fabs(y[k] - x[k]));
 
         /* If we converged or got exhausted, save context and exit. */
         if ((err <= tol) || (it >= limit))
         {
             PR(("QPGradProj exhausted:"));
+            qpDelta->lambda = lambda; /* warm start for the next call */
             saveContext(graph, qpDelta, it, err, nFreeSet, ib, lo, hi);
             DEBUG(QPcheckCom(graph, options, qpDelta, 1, qpDelta->nFreeSet,
                              qpDelta->b));
@@ -190,54 +314,151 @@ double QPGradProj(EdgeCutProblem *graph, const EdgeCut_Options *options, QPDelta
         it++;
 
         /* compute stepsize st = g_F'g_F/-g_F'(A+D)g_F */
-        for (Int k = 0; k < n; k++)
-            Dgrad[k] = 0.;
-
         DEBUG(FreeSet_dump("QPGradProj:1", n, FreeSet_list, nFreeSet,
                            FreeSet_status, 0, x));
 
-        // for each i in the FreeSet:
-        for (Int ifree = 0; ifree < nFreeSet; ifree++)
+        if (bbStep && bbDen > 0.)
         {
-            /* compute -(A+D)g_F */
-            Int i    = FreeSet_list[ifree];
-            double s = grad[i];
-            for (Int p = Ep[i]; p < Ep[i + 1]; p++)
+            /* BB length from the previous accepted move; the stepsize
+             * matvec and its dot products are not needed. */
+            double st = std::max(bbNum / bbDen, 0.001);
+            for (Int j = 0; j < n; j++)
+                y[j] = x[j] - st * grad[j];
+            lambda = QPNapsack(y, n, lo, hi, Ew, lambda, FreeSet_status, wx,
+                               wi1, wi2, tol);
+        }
+        else
+        {
+#if CPP11_OR_LATER
+            if (nthreads > 1 && !sparseGrad)
             {
-                Dgrad[Ei[p]] -= s * ((Ex) ? Ex[p] : 1);
+                /* Gather-form Dgrad = -(A+D)g_F, partitioned by rows. */
+                qpParallelRows(n, nthreads, [=](Int kBegin, Int kEnd) {
+                    qpDgradWorker(Ep, Ei, Ex, D, grad, FreeSet_status, Dgrad,
+                                  kBegin, kEnd);
+                });
             }
-            Dgrad[i] -= s * D[i];
-        }
+            else
+#endif
+            if (sparseGrad)
+            {
+                /* Dgrad is all-zero on entry; scatter, recording touches. */
+                for (Int ifree = 0; ifree < nFreeSet; ifree++)
+                {
+                    /* compute -(A+D)g_F */
+                    Int i    = FreeSet_list[ifree];
+                    double s = grad[i];
+                    if (Ex)
+                    {
+                        for (Int p = Ep[i]; p < Ep[i + 1]; p++)
+                        {
+                            Int e = Ei[p];
+                            Dgrad[e] -= s * Ex[p];
+                            if (!touched[e])
+                            {
+                                touched[e]            = true;
+                                touchList[nTouched++] = e;
+                            }
+                        }
+                    }
+                    else
+                    {
+                        /* Unit weights: scatter -s directly. */
+                        for (Int p = Ep[i]; p < Ep[i + 1]; p++)
+                        {
+                            Int e = Ei[p];
+                            Dgrad[e] -= s;
+                            if (!touched[e])
+                            {
+                                touched[e]            = true;
+                                touchList[nTouched++] = e;
+                            }
+                        }
+                    }
+                    Dgrad[i] -= s * D[i];
+                    if (!touched[i])
+                    {
+                        touched[i]            = true;
+                        touchList[nTouched++] = i;
+                    }
+                }
+            }
+            else
+            {
+                for (Int k = 0; k < n; k++)
+                    Dgrad[k] = 0.;
 
-        double st_num = 0.;
-        double st_den = 0.;
+                // for each i in the FreeSet:
+                for (Int ifree = 0; ifree < nFreeSet; ifree++)
+                {
+                    /* compute -(A+D)g_F */
+                    Int i    = FreeSet_list[ifree];
+                    double s = grad[i];
+                    if (Ex)
+                    {
+                        for (Int p = Ep[i]; p < Ep[i + 1]; p++)
+                        {
+                            Dgrad[Ei[p]] -= s * Ex[p];
+                        }
+                    }
+                    else
+                    {
+                        /* Unit weights: scatter -s directly. */
+                        for (Int p = Ep[i]; p < Ep[i + 1]; p++)
+                        {
+                            Dgrad[Ei[p]] -= s;
+                        }
+                    }
+                    Dgrad[i] -= s * D[i];
+                }
+            }
 
-        DEBUG(FreeSet_dump("QPGradProj:2", n, FreeSet_list, nFreeSet,
-                           FreeSet_status, 0, x));
+            double st_num = 0.;
+            double st_den = 0.;
 
-        for (Int jfree = 0; jfree < nFreeSet; jfree++)
-        {
-            Int j = FreeSet_list[jfree];
-            st_num += grad[j] * grad[j];
-            st_den += grad[j] * Dgrad[j];
-        }
+            DEBUG(FreeSet_dump("QPGradProj:2", n, FreeSet_list, nFreeSet,
+                               FreeSet_status, 0, x));
 
-        /* st = g_F'g_F/-g_F'(A+D)g_F unless the denominator <= 0 */
-        if (st_den > 0.)
-        {
-            // PR (("change y\n")) ;
-            double st = std::max(st_num / st_den, 0.001);
-            for (Int j = 0; j < n; j++)
-                y[j] = x[j] - st * grad[j];
-            lambda = QPNapsack(y, n, lo, hi, Ew, lambda, FreeSet_status, wx,
-                               wi1, wi2, tol);
+            for (Int jfree = 0; jfree < nFreeSet; jfree++)
+            {
+                Int j = FreeSet_list[jfree];
+                st_num += grad[j] * grad[j];
+                st_den += grad[j] * Dgrad[j];
+            }
+
+            /* Restore the all-zero invariant on Dgrad before the step
+             * change scatter below reuses it. */
+            if (sparseGrad)
+            {
+                for (Int k = 0; k < nTouched; k++)
+                {
+                    Int e      = touchList[k];
+                    Dgrad[e]   = 0.;
+                    touched[e] = false;
+                }
+                nTouched = 0;
+            }
+
+            /* st = g_F'g_F/-g_F'(A+D)g_F unless the denominator <= 0 */
+            if (st_den > 0.)
+            {
+                // PR (("change y\n")) ;
+                double st = std::max(st_num / st_den, 0.001);
+                for (Int j = 0; j < n; j++)
+                    y[j] = x[j] - st * grad[j];
+                lambda = QPNapsack(y, n, lo, hi, Ew, lambda, FreeSet_status,
+                                   wx, wi1, wi2, tol);
+            }
         }
 
         /* otherwise st = 1 and y is as computed above */
         Int nc   = 0; /* number of changes (number of j for which y_j != x_j) */
         double s = 0.;
-        for (Int j = 0; j < n; j++)
-            Dgrad[j] = 0.;
+        if (!sparseGrad) /* in sparse mode Dgrad is already all-zero */
+        {
+            for (Int j = 0; j < n; j++)
+                Dgrad[j] = 0.;
+        }
 
         // consider vertices j in the FreeSet_list
         for (Int jfree = 0; jfree < nFreeSet; jfree++)
@@ -256,11 +477,39 @@ double QPGradProj(EdgeCutProblem *graph, const EdgeCut_Options *options, QPDelta
                 changeList[nc]    = j;
                 changeLocation[j] = jfree;
                 nc++;
-                for (Int p = Ep[j]; p < Ep[j + 1]; p++)
+                if (Ex)
                 {
-                    Dgrad[Ei[p]] -= ((Ex) ? Ex[p] : 1) * t;
+                    for (Int p = Ep[j]; p < Ep[j + 1]; p++)
+                    {
+                        Int e = Ei[p];
+                        Dgrad[e] -= Ex[p] * t;
+                        if (sparseGrad && !touched[e])
+                        {
+                            touched[e]            = true;
+                            touchList[nTouched++] = e;
+                        }
+                    }
+                }
+                else
+                {
+                    /* Unit weights: scatter -t directly. */
+                    for (Int p = Ep[j]; p < Ep[j + 1]; p++)
+                    {
+                        Int e = Ei[p];
+                        Dgrad[e] -= t;
+                        if (sparseGrad && !touched[e])
+                        {
+                            touched[e]            = true;
+                            touchList[nTouched++] = e;
+                        }
+                    }
                 }
                 Dgrad[j] -= D[j] * t;
+                if (sparseGrad && !touched[j])
+                {
+                    touched[j]            = true;
+                    touchList[nTouched++] = j;
+                }
             }
         }
 
@@ -281,11 +530,39 @@ double QPGradProj(EdgeCutProblem *graph, const EdgeCut_Options *options, QPDelta
                 changeList[nc]    = j;
                 changeLocation[j] = EMPTY; // j not in FreeSet
                 nc++;
-                for (Int p = Ep[j]; p < Ep[j + 1]; p++)
+                if (Ex)
                 {
-                    Dgrad[Ei[p]] -= ((Ex) ? Ex[p] : 1) * t;
+                    for (Int p = Ep[j]; p < Ep[j + 1]; p++)
+                    {
+                        Int e = Ei[p];
+                        Dgrad[e] -= Ex[p] * t;
+                        if (sparseGrad && !touched[e])
+                        {
+                            touched[e]            = true;
+                            touchList[nTouched++] = e;
+                        }
+                    }
+                }
+                else
+                {
+                    /* Unit weights: scatter -t directly. */
+                    for (Int p = Ep[j]; p < Ep[j + 1]; p++)
+                    {
+                        Int e = Ei[p];
+                        Dgrad[e] -= t;
+                        if (sparseGrad && !touched[e])
+                        {
+                            touched[e]            = true;
+                            touchList[nTouched++] = e;
+                        }
+                    }
                 }
                 Dgrad[j] -= D[j] * t;
+                if (sparseGrad && !touched[j])
+                {
+                    touched[j]            = true;
+                    touchList[nTouched++] = j;
+                }
             }
         }
 
@@ -294,7 +571,20 @@ double QPGradProj(EdgeCutProblem *graph, const EdgeCut_Options *options, QPDelta
         /* If directional derivative has wrong sign, save context and exit. */
         if (s >= 0.)
         {
+            /* Restore the Dgrad invariant for the next call. */
+            if (sparseGrad)
+            {
+                for (Int k = 0; k < nTouched; k++)
+                {
+                    Int e      = touchList[k];
+                    Dgrad[e]   = 0.;
+                    touched[e] = false;
+                }
+                nTouched = 0;
+            }
+
             PR(("QPGradProj directional derivative has wrong sign\n"));
+            qpDelta->lambda = lambda; /* warm start for the next call */
             saveContext(graph, qpDelta, it, err, nFreeSet, ib, lo, hi);
             DEBUG(FreeSet_dump("QPGradProj wrong sign", n, FreeSet_list,
                                nFreeSet, FreeSet_status, 0, x));
@@ -343,6 +633,23 @@ double QPGradProj(EdgeCutProblem *graph, const EdgeCut_Options *options, QPDelta
             t += Dgrad[j] * d[j]; /* -dg'd */
         }
 
+        if (bbStep)
+        {
+            /* BB length for the next iteration. The scale applied to the
+             * move below cancels between ||dx||^2 and dx'(gradient change),
+             * leaving sums over the unscaled direction d; t is already
+             * -d'(A+D)d, positive exactly when the curvature guard for the
+             * fixed step would hold. */
+            double dxdx = 0.;
+            for (Int k = 0; k < nc; k++)
+            {
+                Int j = changeList[k];
+                dxdx += (double)d[j] * (double)d[j];
+            }
+            bbNum = dxdx;
+            bbDen = t;
+        }
+
         // PR (("MIN ATTAINED AT Y? s %g t %g s+t %g\n", s, t, s+t)) ;
 
         if (s + t <= 0) /* min attained at y, slope at y <= 0 */
@@ -436,9 +743,41 @@ double QPGradProj(EdgeCutProblem *graph, const EdgeCut_Options *options, QPDelta
                     FreeSet_status[j] = FreeSet_status_j;
                 }
             }
-            for (Int j = 0; j < n; j++)
+            /* Apply the gradient change and form the next trial point in
+             * one pass. */
+#if CPP11_OR_LATER
+            if (nthreads > 1 && !sparseGrad)
             {
-                grad[j] += Dgrad[j];
+                qpParallelRows(n, nthreads, [=](Int kBegin, Int kEnd) {
+                    qpGradStepWorker(grad, Dgrad, 1.0, x, y, kBegin, kEnd);
+                });
+            }
+            else
+#endif
+            if (sparseGrad)
+            {
+                /* Only the touched entries of Dgrad are nonzero; restore
+                 * the all-zero invariant as they are consumed. */
+                for (Int k = 0; k < nTouched; k++)
+                {
+                    Int e = touchList[k];
+                    grad[e] += Dgrad[e];
+                    Dgrad[e]   = 0.;
+                    touched[e] = false;
+                }
+                nTouched = 0;
+                for (Int j = 0; j < n; j++)
+                {
+                    y[j] = x[j] - grad[j];
+                }
+            }
+            else
+            {
+                for (Int j = 0; j < n; j++)
+                {
+                    grad[j] += Dgrad[j];
+                    y[j] = x[j] - grad[j];
+                }
             }
         }
         else /* partial step towards y, st < 1 */
@@ -467,9 +806,41 @@ double QPGradProj(EdgeCutProblem *graph, const EdgeCut_Options *options, QPDelta
                 x[j] += st * d[j];
             }
 
-            for (Int k = 0; k < n; k++)
+            /* Apply the partial gradient change and form the next trial
+             * point in one pass. */
+#if CPP11_OR_LATER
+            if (nthreads > 1 && !sparseGrad)
+            {
+                qpParallelRows(n, nthreads, [=](Int kBegin, Int kEnd) {
+                    qpGradStepWorker(grad, Dgrad, st, x, y, kBegin, kEnd);
+                });
+            }
+            else
+#endif
+            if (sparseGrad)
             {
-                grad[k] += st * Dgrad[k];
+                /* Only the touched entries of Dgrad are nonzero; restore
+                 * the all-zero invariant as they are consumed. */
+                for (Int k = 0; k < nTouched; k++)
+                {
+                    Int e = touchList[k];
+                    grad[e] += st * Dgrad[e];
+                    Dgrad[e]   = 0.;
+                    touched[e] = false;
+                }
+                nTouched = 0;
+                for (Int j = 0; j < n; j++)
+                {
+                    y[j] = x[j] - grad[j];
+                }
+            }
+            else
+            {
+                for (Int k = 0; k < n; k++)
+                {
+                    grad[k] += st * Dgrad[k];
+                    y[k] = x[k] - grad[k];
+                }
             }
         }
 
@@ -499,6 +870,8 @@ double QPGradProj(EdgeCutProblem *graph, const EdgeCut_Options *options, QPDelta
     DEBUG(FreeSet_dump("QPGradProj end", n, FreeSet_list, nFreeSet,
                        FreeSet_status, 0, x));
 
+    qpDelta->lambda = lambda; /* warm start for the next call */
+
     PR(("------- QPGradProj end ]\n"));
     return err;
 }
@@ -21,20 +21,20 @@ bool QPLinks(EdgeCutProblem *graph, const EdgeCut_Options *options, QPDelta *QP)
     (void)options; // Unused variable
 
     /* Inputs */
-    double *x = QP->x;
+    QPScalar *x = QP->x;
 
     /* Unpack structures. */
     Int n      = graph->n;
     Int *Ep    = graph->p;
     Int *Ei    = graph->i;
-    double *Ex = graph->x;
-    double *a  = graph->w;
+    WeightType *Ex = graph->x;
+    WeightType *a  = graph->w;
 
     /* working array */
-    double *D           = QP->D;
+    QPScalar *D         = QP->D;
     Int *FreeSet_status = QP->FreeSet_status;
     Int *FreeSet_list   = QP->FreeSet_list;
-    double *grad        = QP->gradient; /* gradient at current x */
+    QPScalar *grad      = QP->gradient; /* gradient at current x */
 
     // FreeSet is empty
     Int nFreeSet = 0;
@@ -57,9 +57,20 @@ bool QPLinks(EdgeCutProblem *graph, const EdgeCut_Options *options, QPDelta *QP)
 
         s += ((a) ? a[k] : 1) * xk;
         double r = 0.5 - xk;
-        for (Int p = Ep[k]; p < Ep[k + 1]; p++)
+        if (Ex)
         {
-            grad[Ei[p]] += r * ((Ex) ? Ex[p] : 1);
+            for (Int p = Ep[k]; p < Ep[k + 1]; p++)
+            {
+                grad[Ei[p]] += r * Ex[p];
+            }
+        }
+        else
+        {
+            /* Unit weights: scatter r directly. */
+            for (Int p = Ep[k]; p < Ep[k + 1]; p++)
+            {
+                grad[Ei[p]] += r;
+            }
         }
         if (xk >= 1.)
         {
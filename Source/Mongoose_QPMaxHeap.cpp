@@ -27,7 +27,7 @@ namespace Mongoose
 
 void QPMaxHeap_build(Int *heap, /* on input, an unsorted set of elements */
                      Int size,  /* number of elements to build into the heap */
-                     double *x)
+                     QPScalar *x)
 {
     for (Int p = size / 2; p >= 1; p--)
         QPMaxHeapify(p, heap, size, x);
@@ -42,7 +42,7 @@ void QPMaxHeap_build(Int *heap, /* on input, an unsorted set of elements */
 Int QPMaxHeap_delete /* return new size of heap */
     (Int *heap,      /* containing indices into x, 1..n on input */
      Int size,       /* number of items in heap */
-     const double *x /* not modified */
+     const QPScalar *x /* not modified */
     )
 {
     if (size <= 1)
@@ -63,7 +63,7 @@ Int QPMaxHeap_delete /* return new size of heap */
 
 Int QPMaxHeap_add(Int leaf,        /* the new leaf */
                   Int *heap,       /* size n, containing indices into x */
-                  const double *x, /* not modified */
+                  const QPScalar *x, /* not modified */
                   Int size /* number of elements in heap not counting new one */
 )
 {
@@ -108,7 +108,7 @@ Int QPMaxHeap_add(Int leaf,        /* the new leaf */
 void QPMaxHeapify(Int p,          /* start at vertex p in the heap */
                   Int *heap,      /* size n, containing indices into x */
                   Int size,       /* heap [ ... nheap] is in use */
-                  const double *x /* not modified */
+                  const QPScalar *x /* not modified */
 )
 {
     Int left, right, e, hleft, hright;
@@ -27,7 +27,7 @@ namespace Mongoose
 
 void QPMinHeap_build(Int *heap, /* on input, an unsorted set of elements */
                      Int size,  /* number of elements to build into the heap */
-                     double *x)
+                     QPScalar *x)
 {
     Int p;
 
@@ -46,7 +46,7 @@ void QPMinHeap_build(Int *heap, /* on input, an unsorted set of elements */
 Int QPMinHeap_delete /* return new size of heap */
     (Int *heap,      /* containing indices into x, 1..n on input */
      Int size,       /* number of items in heap */
-     const double *x /* not modified */
+     const QPScalar *x /* not modified */
     )
 {
     if (size <= 1)
@@ -70,7 +70,7 @@ Int QPMinHeap_delete /* return new size of heap */
 Int QPMinHeap_add(
     Int leaf,        /* the new leaf */
     Int *heap,       /* size n, containing indices into x */
-    const double *x, /* not modified */
+    const QPScalar *x, /* not modified */
     Int nheap        /* number of elements in heap not counting new one */
 )
 {
@@ -114,7 +114,7 @@ Int QPMinHeap_add(
 void QPMinHeapify(Int p,          /* start at vertex p in the heap */
                   Int *heap,      /* size n, containing indices into x */
                   Int size,       /* heap [ ... nheap] is in use */
-                  const double *x /* not modified */
+                  const QPScalar *x /* not modified */
 )
 {
     Int left, right, e, hleft, hright;
@@ -28,16 +28,117 @@
 #include "Mongoose_Logger.hpp"
 #include "Mongoose_QPMinHeap.hpp"
 
+#include "Mongoose_Simd.hpp"
+
+#if MONGOOSE_SIMD_AVX2
+#include <immintrin.h>
+#endif
+
 namespace Mongoose
 {
 
+#if MONGOOSE_SIMD_AVX2 && !defined(MONGOOSE_QP_FLOAT)                       \
+    && !defined(MONGOOSE_WEIGHT_FLOAT)
+/* AVX2 body of the heap-construction classification, four entries per
+ * step. The breakpoints, slope sums, and candidate minima are all
+ * computed branch-free under lane masks; only the heap appends fall back
+ * to a short scalar sweep over the mask bits, so the heaps fill in the
+ * same index order as the scalar loop. (Lanes that land in neither heap
+ * get a harmless breakpoint written; breakpts is per-call workspace and
+ * only heap members are read.) Compiled with its own target attribute
+ * and entered only behind a simdAVX2() check; advances *i_inout past the
+ * vectorized prefix and assigns the running sums and minima, which the
+ * caller's scalar remainder loop then extends. */
+MONGOOSE_TARGET_AVX2
+static void napUpClassifyAVX2(const QPScalar *x, const WeightType *a, Int n,
+                              double lambda, QPScalar *breakpts,
+                              Int *bound_heap, Int *free_heap, Int *io_n_bound,
+                              Int *io_n_free, double *out_asum,
+                              double *out_a2sum, double *out_minbound,
+                              double *out_minfree, Int *i_inout)
+{
+    Int i       = *i_inout;
+    Int n_bound = *io_n_bound;
+    Int n_free  = *io_n_free;
+
+    const __m256d ones   = _mm256_set1_pd(1.0);
+    const __m256d zeros  = _mm256_setzero_pd();
+    const __m256d inf    = _mm256_set1_pd(INFINITY);
+    const __m256d lamv   = _mm256_set1_pd(lambda);
+    __m256d asumv        = _mm256_setzero_pd();
+    __m256d a2sumv       = _mm256_setzero_pd();
+    __m256d minboundv    = inf;
+    __m256d minfreev     = inf;
+
+    for (; i + 4 <= n; i += 4)
+    {
+        __m256d xv  = _mm256_loadu_pd(x + i);
+        __m256d av  = (a) ? _mm256_loadu_pd(a + i) : ones;
+        __m256d xiv = _mm256_sub_pd(xv, _mm256_mul_pd(av, lamv));
+
+        __m256d boundMask = _mm256_cmp_pd(xiv, ones, _CMP_GT_OQ);
+        __m256d freeMask  = _mm256_andnot_pd(
+            boundMask, _mm256_cmp_pd(xiv, zeros, _CMP_GT_OQ));
+
+        __m256d tb = _mm256_div_pd(_mm256_sub_pd(xv, ones), av);
+        __m256d tf = _mm256_div_pd(xv, av);
+
+        asumv = _mm256_add_pd(
+            asumv, _mm256_and_pd(boundMask, av));
+        asumv = _mm256_add_pd(
+            asumv, _mm256_and_pd(freeMask, _mm256_mul_pd(xv, av)));
+        a2sumv = _mm256_add_pd(
+            a2sumv, _mm256_and_pd(freeMask, _mm256_mul_pd(av, av)));
+
+        minboundv = _mm256_min_pd(minboundv,
+                                  _mm256_blendv_pd(inf, tb, boundMask));
+        minfreev  = _mm256_min_pd(minfreev,
+                                  _mm256_blendv_pd(inf, tf, freeMask));
+
+        _mm256_storeu_pd(breakpts + i, _mm256_blendv_pd(tf, tb, boundMask));
+
+        int bm = _mm256_movemask_pd(boundMask);
+        int fm = _mm256_movemask_pd(freeMask);
+        for (Int l = 0; l < 4; l++)
+        {
+            if ((bm >> l) & 1)
+            {
+                n_bound++;
+                bound_heap[n_bound] = i + l;
+            }
+            else if ((fm >> l) & 1)
+            {
+                n_free++;
+                free_heap[n_free] = i + l;
+            }
+        }
+    }
+
+    double lanes[4];
+    _mm256_storeu_pd(lanes, asumv);
+    *out_asum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    _mm256_storeu_pd(lanes, a2sumv);
+    *out_a2sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    _mm256_storeu_pd(lanes, minboundv);
+    *out_minbound = std::min(std::min(lanes[0], lanes[1]),
+                             std::min(lanes[2], lanes[3]));
+    _mm256_storeu_pd(lanes, minfreev);
+    *out_minfree = std::min(std::min(lanes[0], lanes[1]),
+                            std::min(lanes[2], lanes[3]));
+
+    *io_n_bound = n_bound;
+    *io_n_free  = n_free;
+    *i_inout    = i;
+}
+#endif
+
 double QPNapUp         /* return lambda */
-    (const double *x,  /* holds y on input, not modified */
+    (const QPScalar *x,  /* holds y on input, not modified */
      const Int n,      /* size of x */
      double lambda,    /* initial guess for the shift */
-     const double *a,  /* input constraint vector */
+     const WeightType *a, /* input constraint vector */
      double b,         /* input constraint scalar */
-     double *breakpts, /* break points */
+     QPScalar *breakpts, /* break points */
      Int *bound_heap,  /* work array */
      Int *free_heap    /* work array */
     )
@@ -57,7 +158,19 @@ double QPNapUp         /* return lambda */
     asum    = 0.;
     a2sum   = 0.;
 
-    for (i = 0; i < n; i++)
+    i = 0;
+
+#if MONGOOSE_SIMD_AVX2 && !defined(MONGOOSE_QP_FLOAT)                       \
+    && !defined(MONGOOSE_WEIGHT_FLOAT)
+    if (simdAVX2() && n >= 8)
+    {
+        napUpClassifyAVX2(x, a, n, lambda, breakpts, bound_heap, free_heap,
+                          &n_bound, &n_free, &asum, &a2sum, &minbound,
+                          &minfree, &i);
+    }
+#endif
+
+    for (; i < n; i++)
     {
         ai        = (a) ? a[i] : 1;
         double xi = x[i] - ai * lambda;
@@ -115,6 +228,7 @@ double QPNapUp         /* return lambda */
         {
             while (breakpts[e = free_heap[1]] <= lambda)
             {
+                MONGOOSE_COUNT(NapsackBreakpointsCounter);
                 ai = (a) ? a[e] : 1;
                 a2sum -= ai * ai;
                 asum -= ai * x[e];
@@ -131,6 +245,7 @@ double QPNapUp         /* return lambda */
         {
             while (breakpts[e = bound_heap[1]] <= lambda)
             {
+                MONGOOSE_COUNT(NapsackBreakpointsCounter);
                 n_bound = QPMinHeap_delete(bound_heap, n_bound, breakpts);
                 ai      = (a) ? a[e] : 1;
                 a2sum += ai * ai;
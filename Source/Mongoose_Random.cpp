@@ -9,26 +9,73 @@
  * Mongoose is also available under other licenses; contact authors for details.
  * -------------------------------------------------------------------------- */
 
+/**
+ * Pseudorandom number generation
+ *
+ * Mongoose draws one random number per vertex per coarsening level in the
+ * randomized matching and guess-cut phases, so the generator needs to be
+ * only a handful of cycles per draw. We use xoshiro256++ (Blackman and
+ * Vigna), seeded through splitmix64 so that small user seeds still produce
+ * well-mixed state. This replaces the much slower std::ranlux24_base.
+ */
+
 #include "Mongoose_Random.hpp"
 
 #if CPP11_OR_LATER
-#include <random>
+#include <cstdint>
 #endif
 
 namespace Mongoose
 {
 
 #if CPP11_OR_LATER
-std::random_device rd;
-std::ranlux24_base generator(rd());
-std::uniform_int_distribution<> distribution;
+
+/* xoshiro256++ generator state.
+ *
+ * The state is thread-local so that concurrent edge_cut() calls on
+ * independent graphs each draw from their own stream instead of racing on
+ * shared generator state. edge_cut() seeds the calling thread's stream from
+ * options->random_seed, so results stay reproducible per call regardless of
+ * how calls are scheduled across threads. */
+static thread_local uint64_t rngState[4]
+    = { 0x9E3779B97F4A7C15ULL, 0xBF58476D1CE4E5B9ULL, 0x94D049BB133111EBULL,
+        0x2545F4914F6CDD1DULL };
+
+static inline uint64_t rotl64(uint64_t x, int k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+/* splitmix64: used only to expand a seed into the xoshiro state */
+static inline uint64_t splitmix64(uint64_t &state)
+{
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z          = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z          = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
 #endif
 
 Int random()
 {
 #if CPP11_OR_LATER
-    // Use C++11 random object
-    return distribution(generator);
+    // xoshiro256++ step
+    const uint64_t result = rotl64(rngState[0] + rngState[3], 23) + rngState[0];
+
+    const uint64_t t = rngState[1] << 17;
+    rngState[2] ^= rngState[0];
+    rngState[3] ^= rngState[1];
+    rngState[1] ^= rngState[2];
+    rngState[0] ^= rngState[3];
+    rngState[2] ^= t;
+    rngState[3] = rotl64(rngState[3], 45);
+
+    /* Return a nonnegative Int: keep the top bits (the best-mixed in
+     * xoshiro256++), reduced to the positive range of whatever width Int
+     * has -- under MONGOOSE_INT32 a plain one-bit shift would truncate to
+     * 32 bits and go negative half the time. */
+    return static_cast<Int>(result >> (65 - 8 * static_cast<int>(sizeof(Int))));
 #else
     // Forced to use non-reentrant std::rand
     return std::rand();
@@ -38,8 +85,12 @@ Int random()
 void setRandomSeed(Int seed)
 {
 #if CPP11_OR_LATER
-    // Use C++11 random object
-    generator.seed(static_cast<unsigned int>(seed));
+    // Expand the seed into the full generator state via splitmix64
+    uint64_t state = static_cast<uint64_t>(seed);
+    for (int k = 0; k < 4; k++)
+    {
+        rngState[k] = splitmix64(state);
+    }
 #else
     // Forced to use non-reentrant std::rand
     std::srand(static_cast<unsigned int>(seed));
@@ -22,18 +22,19 @@ EdgeCutProblem *refine(EdgeCutProblem *graph, const EdgeCut_Options *options)
 {
     Logger::tic(RefinementTiming);
 
-    EdgeCutProblem *P             = graph->parent;
-    Int cn               = graph->n;
-    bool *cPartition     = graph->partition;
-    double *fGains       = P->vertexGains;
-    Int *fExternalDegree = P->externalDegree;
+    EdgeCutProblem *P = graph->parent;
+    Int cn            = graph->n;
+    FMVertexData *fFM = P->fmData;
 
-    /* Transfer cut costs and partition details upwards. */
+    /* Transfer cut costs and partition details upwards. The napsack
+     * multiplier projects directly: coarsening preserves the total vertex
+     * weight, so the dual stays on the same scale across levels. */
     P->heuCost   = graph->heuCost;
     P->cutCost   = graph->cutCost;
     P->W0        = graph->W0;
     P->W1        = graph->W1;
     P->imbalance = graph->imbalance;
+    P->qpLambda  = graph->qpLambda;
 
     /* For each vertex in the coarse graph. */
     for (Int k = 0; k < cn; k++)
@@ -55,28 +56,32 @@ EdgeCutProblem *refine(EdgeCutProblem *graph, const EdgeCut_Options *options)
             }
         }
         /* Transfer the partition choices to the fine level. */
-        bool cp = cPartition[k];
+        bool cp = graph->getPartition(k);
         for (Int i = 0; i < 3 && v[i] != -1; i++)
         {
-            Int vertex           = v[i];
-            P->partition[vertex] = cp;
+            P->setPartition(v[i], cp);
         }
     }
     /* See if we can relax the boundary constraint and recompute gains for
      * vertices on the boundary.
      * NOTE: For this, we only need to go through the set of vertices that
-     * were on the boundary in the coarse representation. */
+     * were on the boundary in the coarse representation: a fine vertex can
+     * only start on the fine boundary if the coarse vertex it was matched
+     * into was on the coarse boundary, so seeding the heaps from that set
+     * (via invmatchmap) is exact. This is why no bhLoad -- which would
+     * recompute gains for all n vertices -- is needed on the way back up;
+     * the only full bhLoad happens at the coarsest level in guessCut. */
     for (Int h = 0; h < 2; h++)
     {
         /* Get the appropriate heap's data. */
-        Int *heap = graph->bhHeap[h];
-        Int size  = graph->bhSize[h];
+        BHEntry *heap = graph->bhHeap[h];
+        Int size      = graph->bhSize[h];
 
         /* Go through all the boundary vertices. */
         for (Int hpos = 0; hpos < size; hpos++)
         {
             /* Get the coarse vertex from the heap. */
-            Int k = heap[hpos];
+            Int k = heap[hpos].vertex;
 
             /* Load up the inverse matching */
             Int v[3] = { -1, -1, -1 };
@@ -107,16 +112,16 @@ EdgeCutProblem *refine(EdgeCutProblem *graph, const EdgeCut_Options *options)
                 /* Only add relevant vertices to the boundary heap. */
                 if (externalDegree > 0)
                 {
-                    fExternalDegree[vertex] = externalDegree;
-                    fGains[vertex]          = gain;
+                    fFM[vertex].externalDegree = externalDegree;
+                    fFM[vertex].gain           = gain;
                     bhInsert(P, vertex);
                 }
             }
         }
     }
 
-    /* Now that we're done with the coarse graph, we can release it. */
-    graph->~EdgeCutProblem();
+    /* The caller decides whether the coarse graph is released now or kept
+     * for a later numeric-only re-solve. */
 
     Logger::toc(RefinementTiming);
 
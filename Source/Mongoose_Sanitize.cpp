@@ -10,51 +10,142 @@
  * -------------------------------------------------------------------------- */
 
 #include "Mongoose_Sanitize.hpp"
+#include "Mongoose_ThreadPool.hpp"
 #include "Mongoose_Internal.hpp"
 
+#if CPP11_OR_LATER
+#include <algorithm>
+#include <vector>
+#endif
+
 using namespace std;
 
 namespace Mongoose
 {
 
 cs *sanitizeMatrix(cs *compressed_A, bool symmetricTriangular,
-                   bool makeEdgeWeightsBinary)
+                   bool makeEdgeWeightsBinary, bool keepLargestComponent)
 {
     cs *cleanMatrix;
     if (symmetricTriangular)
     {
-        cleanMatrix = mirrorTriangular(compressed_A);
+        /* The header already declares symmetry, so the mirrored-CSR
+         * construction builds the full matrix directly (dropping the
+         * diagonal in the same pass) instead of round-tripping through
+         * a triplet matrix. Its columns are unsorted; one transpose
+         * sorts them, and since the matrix is symmetric the transpose
+         * is the matrix itself. */
+        cs *mirrored = mirrorTriangular(compressed_A);
+        if (!mirrored)
+        {
+            return NULL;
+        }
+        cleanMatrix = cs_transpose(mirrored, 1);
+        cs_spfree(mirrored);
+        if (!cleanMatrix)
+        {
+            return NULL;
+        }
     }
     else
     {
+        /* Fused symmetrize kernel: one scatter pass per column merges
+         * column j of A and of A' at half weight, computing
+         * (A + A')/2 with coincident entries summed in place via a mark
+         * array and the diagonal dropped as it streams by. This
+         * replaces the separate add, removeDiagonal, and sorting passes
+         * of the unfused pipeline. */
         cs *A_transpose = cs_transpose(compressed_A, 1);
         if (!A_transpose)
         {
             return NULL;
         }
-        cleanMatrix = cs_add(compressed_A, A_transpose, 0.5, 0.5);
-        cs_spfree(A_transpose);
-    }
 
-    if (!cleanMatrix)
-    {
-        return NULL;
-    }
+        Int n       = compressed_A->n;
+        Int nzmax   = compressed_A->p[n] + A_transpose->p[n];
+        bool values = (compressed_A->x != NULL);
 
-    removeDiagonal(cleanMatrix);
+        cs *C  = cs_spalloc(n, n, nzmax, values, 0);
+        Int *w = (Int *)SuiteSparse_malloc(static_cast<size_t>(n),
+                                           sizeof(Int));
+        if (!C || !w)
+        {
+            cs_spfree(A_transpose);
+            cs_spfree(C);
+            SuiteSparse_free(w);
+            return NULL;
+        }
+        for (Int j = 0; j < n; j++)
+        {
+            w[j] = -1;
+        }
 
-    cs *cleanMatrix_transpose = cs_transpose(cleanMatrix, 1);
-    cs_spfree(cleanMatrix);
+        Int *Cp    = C->p;
+        Int *Ci    = C->i;
+        WeightType *Cx = C->x;
+        Int nz     = 0;
 
-    if (!cleanMatrix_transpose)
-    {
-        return NULL;
+        for (Int j = 0; j < n; j++)
+        {
+            /* w[i] >= colStart marks row i as already scattered into
+             * column j; C's entry count only grows, so stale marks from
+             * earlier columns always fall below colStart. */
+            Int colStart = nz;
+            Cp[j]        = nz;
+
+            const cs *sources[2] = { compressed_A, A_transpose };
+            for (int s = 0; s < 2; s++)
+            {
+                Int *Sp    = sources[s]->p;
+                Int *Si    = sources[s]->i;
+                WeightType *Sx = sources[s]->x;
+                for (Int p = Sp[j]; p < Sp[j + 1]; p++)
+                {
+                    Int i = Si[p];
+                    if (i == j)
+                        continue; /* drop the diagonal */
+                    if (w[i] < colStart)
+                    {
+                        w[i]   = nz;
+                        Ci[nz] = i;
+                        if (values)
+                            Cx[nz] = 0.5 * Sx[p];
+                        nz++;
+                    }
+                    else if (values)
+                    {
+                        Cx[w[i]] += 0.5 * Sx[p];
+                    }
+                }
+            }
+        }
+        Cp[n] = nz;
+
+        SuiteSparse_free(w);
+        cs_spfree(A_transpose);
+
+        /* C is symmetric with unsorted columns; one transpose sorts
+         * them and reproduces the matrix itself. */
+        cleanMatrix = cs_transpose(C, 1);
+        cs_spfree(C);
+        if (!cleanMatrix)
+        {
+            return NULL;
+        }
     }
-    cleanMatrix = cs_transpose(cleanMatrix_transpose, 1);
-    cs_spfree(cleanMatrix_transpose);
-    if (!cleanMatrix)
+
+    if (keepLargestComponent)
     {
-        return NULL;
+        cs *largest = extractLargestComponent(cleanMatrix);
+        if (largest != cleanMatrix)
+        {
+            cs_spfree(cleanMatrix);
+            cleanMatrix = largest;
+        }
+        if (!cleanMatrix)
+        {
+            return NULL;
+        }
     }
 
     if (cleanMatrix->x)
@@ -80,12 +171,100 @@ cs *sanitizeMatrix(cs *compressed_A, bool symmetricTriangular,
     return cleanMatrix;
 }
 
+bool matrixIsSanitized(const cs *A, bool requireBinary)
+{
+    if (!A || A->n != A->m || A->nz != -1 || !A->p || !A->i)
+        return false;
+
+    Int n       = A->n;
+    Int *Ap     = A->p;
+    Int *Ai     = A->i;
+    WeightType *Ax = A->x;
+
+    /* cursor[i] walks the upper part of column i (rows < i) as the mirrors
+     * of those entries stream by in the lower parts of earlier columns;
+     * symmetry holds exactly when every upper entry is consumed by its
+     * mirror, in order. */
+    Int *cursor = (Int *)SuiteSparse_malloc(static_cast<size_t>(n),
+                                            sizeof(Int));
+    if (!cursor)
+        return false;
+    for (Int j = 0; j < n; j++)
+    {
+        cursor[j] = Ap[j];
+    }
+
+    bool sane = true;
+    for (Int j = 0; j < n && sane; j++)
+    {
+        Int pEnd = Ap[j + 1];
+        if (Ap[j] > pEnd)
+        {
+            sane = false;
+            break;
+        }
+        for (Int p = Ap[j]; p < pEnd; p++)
+        {
+            Int i = Ai[p];
+
+            /* Sorted columns, indices in range, zero-free diagonal. */
+            if (i < 0 || i >= n || i == j || (p > Ap[j] && Ai[p - 1] >= i))
+            {
+                sane = false;
+                break;
+            }
+            if (Ax)
+            {
+                /* sanitizeMatrix leaves |values| (or all ones). */
+                if (requireBinary ? (Ax[p] != 1) : (Ax[p] < 0))
+                {
+                    sane = false;
+                    break;
+                }
+            }
+            if (i < j)
+            {
+                /* Upper entry: must be the one its mirror consumed. */
+                continue;
+            }
+
+            /* Lower entry (i > j): consume its mirror (j, i) from the
+             * front of column i's unvisited upper part. */
+            if (cursor[i] >= Ap[i + 1] || Ai[cursor[i]] != j
+                || (Ax && Ax[cursor[i]] != Ax[p]))
+            {
+                sane = false;
+                break;
+            }
+            cursor[i]++;
+        }
+
+        /* Every upper entry of column j must have been consumed by the
+         * time its own column is reached, or some mirror was missing. */
+        if (sane)
+        {
+            Int pUpper = Ap[j];
+            while (pUpper < pEnd && Ai[pUpper] < j)
+            {
+                pUpper++;
+            }
+            if (cursor[j] != pUpper)
+            {
+                sane = false;
+            }
+        }
+    }
+
+    SuiteSparse_free(cursor);
+    return sane;
+}
+
 void removeDiagonal(cs *A)
 {
     Int n      = A->n;
     Int *Ap    = A->p;
     Int *Ai    = A->i;
-    double *Ax = A->x;
+    WeightType *Ax = A->x;
     Int nz     = 0;
     Int old_Ap = Ap[0];
 
@@ -106,50 +285,313 @@ void removeDiagonal(cs *A)
     }
 }
 
-// Requires A to be a triangular matrix with no diagonal.
+// Mirrors a triangular matrix into the full symmetric matrix in compressed
+// form, dropping any diagonal entries in the same pass. The columns of the
+// result are not sorted by row index; since the result is symmetric, one
+// cs_transpose sorts them without changing the matrix.
 cs *mirrorTriangular(cs *A)
 {
     if (!A)
         return NULL;
-    Int A_n  = A->n;
-    Int A_nz = A->p[A_n];
-    Int B_nz = 2 * A_nz;
+    Int A_n = A->n;
 
-    bool values = (A->x != NULL);
+    Int *Ap    = A->p;
+    Int *Ai    = A->i;
+    WeightType *Ax = A->x;
+    bool values = (Ax != NULL);
 
-    // allocate B in triplet form, with values Bx if A has values
-    cs *B = cs_spalloc(A_n, A_n, B_nz, values, 1);
-    if (!B)
+    // Count the mirrored column degrees, skipping the diagonal.
+    Int *next = (Int *)SuiteSparse_calloc(static_cast<size_t>(A_n),
+                                          sizeof(Int));
+    if (!next)
         return NULL;
+    Int C_nz = 0;
+    for (Int j = 0; j < A_n; j++)
+    {
+        for (Int p = Ap[j]; p < Ap[j + 1]; p++)
+        {
+            Int i = Ai[p];
+            if (i == j)
+                continue;
+            next[i]++;
+            next[j]++;
+            C_nz += 2;
+        }
+    }
 
-    Int *Ap    = A->p;
-    Int *Ai    = A->i;
-    double *Ax = A->x;
-    Int *Bj    = B->p;
-    Int *Bi    = B->i;
-    double *Bx = B->x;
-    Int nz     = 0;
+    cs *C = cs_spalloc(A_n, A_n, C_nz, values, 0);
+    if (!C)
+    {
+        SuiteSparse_free(next);
+        return NULL;
+    }
+
+    Int *Cp    = C->p;
+    Int *Ci    = C->i;
+    WeightType *Cx = C->x;
 
+    // Column pointers from the counts; next[j] becomes column j's cursor.
+    Cp[0] = 0;
+    for (Int j = 0; j < A_n; j++)
+    {
+        Cp[j + 1] = Cp[j] + next[j];
+        next[j]   = Cp[j];
+    }
+
+    // Scatter each off-diagonal entry and its mirror image.
     for (Int j = 0; j < A_n; j++)
     {
         for (Int p = Ap[j]; p < Ap[j + 1]; p++)
         {
-            Bi[nz] = Ai[p];
-            Bj[nz] = j;
+            Int i = Ai[p];
+            if (i == j)
+                continue;
+            Ci[next[j]] = i;
             if (values)
-                Bx[nz] = Ax[p];
-            nz++;
-            Bi[nz] = j;
-            Bj[nz] = Ai[p];
+                Cx[next[j]] = Ax[p];
+            next[j]++;
+            Ci[next[i]] = j;
             if (values)
-                Bx[nz] = Ax[p];
+                Cx[next[i]] = Ax[p];
+            next[i]++;
+        }
+    }
+
+    SuiteSparse_free(next);
+    return C;
+}
+
+/* Follows parent pointers to the root of v's tree, halving the path on
+ * the way up. */
+static inline Int componentRoot(Int *parent, Int v)
+{
+    while (parent[v] != v)
+    {
+        parent[v] = parent[parent[v]];
+        v         = parent[v];
+    }
+    return v;
+}
+
+#if CPP11_OR_LATER
+
+/* One label-propagation sweep chunk: every vertex takes the smallest
+ * label in its closed neighborhood. Reading labelIn and writing labelOut
+ * keeps the sweep race-free. */
+static void componentSweepWorker(const Int *Ap, const Int *Ai,
+                                 const Int *labelIn, Int *labelOut, Int lo,
+                                 Int hi, bool *changed)
+{
+    bool any = false;
+    for (Int j = lo; j < hi; j++)
+    {
+        Int best = labelIn[j];
+        for (Int p = Ap[j]; p < Ap[j + 1]; p++)
+        {
+            Int li = labelIn[Ai[p]];
+            if (li < best)
+                best = li;
+        }
+        labelOut[j] = best;
+        any         = any || (best != labelIn[j]);
+    }
+    *changed = any;
+}
+
+/* Parallel component labeling: label-propagation sweeps alternated with a
+ * serial pointer-jumping compression, so labels hop between whole
+ * label trees instead of single vertices and the sweep count stays
+ * logarithmic rather than proportional to the graph diameter. Returns
+ * false (leaving label untouched) when the graph is too small to benefit
+ * or the scratch array cannot be allocated. */
+static bool componentLabelsParallel(const cs *A, Int *label)
+{
+    Int n       = A->n;
+    Int hw = ThreadPool::maxThreads();
+    if (hw < 2 || n < (Int)(1 << 16))
+        return false;
+    Int nthreads = std::min(hw, (Int)16);
+
+    Int *spare = (Int *)SuiteSparse_malloc(static_cast<size_t>(n),
+                                           sizeof(Int));
+    if (!spare)
+        return false;
+
+    const Int *Ap = A->p;
+    const Int *Ai = A->i;
+    for (Int v = 0; v < n; v++)
+    {
+        label[v] = v;
+    }
+
+    Int *cur     = label;
+    Int *alt     = spare;
+    Int chunk    = (n + nthreads - 1) / nthreads;
+    bool changed = true;
+    while (changed)
+    {
+        bool flags[16]; /* nthreads is capped at 16 above */
+        bool *flagsData = flags;
+        ThreadPool::run(nthreads, [=](Int t) {
+            Int lo       = t * chunk;
+            Int hi       = std::min(lo + chunk, n);
+            flagsData[t] = false;
+            if (lo < hi)
+            {
+                componentSweepWorker(Ap, Ai, cur, alt, lo, hi, &flagsData[t]);
+            }
+        });
+
+        changed = false;
+        for (Int t = 0; t < nthreads; t++)
+        {
+            changed = changed || flags[t];
+        }
+
+        /* Compress: labels only point at smaller indices, so one
+         * ascending pass pins every vertex to its tree's root. */
+        for (Int v = 0; v < n; v++)
+        {
+            alt[v] = alt[alt[v]];
+        }
+
+        std::swap(cur, alt);
+    }
+
+    if (cur != label)
+    {
+        for (Int v = 0; v < n; v++)
+        {
+            label[v] = cur[v];
+        }
+    }
+    SuiteSparse_free(spare);
+    return true;
+}
+
+#endif
+
+cs *extractLargestComponent(cs *A)
+{
+    if (!A)
+        return NULL;
+    Int n = A->n;
+    if (n <= 1)
+        return A;
+
+    Int *Ap    = A->p;
+    Int *Ai    = A->i;
+    WeightType *Ax = A->x;
+
+    Int *label
+        = (Int *)SuiteSparse_malloc(static_cast<size_t>(n), sizeof(Int));
+    if (!label)
+        return NULL;
+
+    bool labeled = false;
+#if CPP11_OR_LATER
+    labeled = componentLabelsParallel(A, label);
+#endif
+    if (!labeled)
+    {
+        /* Union-find over the edges, with the smallest vertex index as
+         * each component's root. */
+        for (Int v = 0; v < n; v++)
+        {
+            label[v] = v;
+        }
+        for (Int j = 0; j < n; j++)
+        {
+            for (Int p = Ap[j]; p < Ap[j + 1]; p++)
+            {
+                Int ri = componentRoot(label, Ai[p]);
+                Int rj = componentRoot(label, j);
+                if (ri < rj)
+                {
+                    label[rj] = ri;
+                }
+                else if (rj < ri)
+                {
+                    label[ri] = rj;
+                }
+            }
+        }
+        for (Int v = 0; v < n; v++)
+        {
+            label[v] = componentRoot(label, v);
+        }
+    }
+
+    /* Size each component and find the largest (ties break toward the
+     * smallest root, keeping the result deterministic). */
+    Int *scratch
+        = (Int *)SuiteSparse_calloc(static_cast<size_t>(n), sizeof(Int));
+    if (!scratch)
+    {
+        SuiteSparse_free(label);
+        return NULL;
+    }
+    for (Int v = 0; v < n; v++)
+    {
+        scratch[label[v]]++;
+    }
+    Int bestRoot = 0;
+    for (Int v = 1; v < n; v++)
+    {
+        if (scratch[v] > scratch[bestRoot])
+            bestRoot = v;
+    }
+    if (scratch[bestRoot] == n)
+    {
+        /* Already connected; hand the matrix back untouched. */
+        SuiteSparse_free(label);
+        SuiteSparse_free(scratch);
+        return A;
+    }
+
+    /* Renumber the kept vertices, preserving their relative order, and
+     * count the surviving entries (every neighbor of a kept vertex is in
+     * the same component). */
+    Int C_n  = 0;
+    Int C_nz = 0;
+    for (Int v = 0; v < n; v++)
+    {
+        if (label[v] == bestRoot)
+        {
+            scratch[v] = C_n++;
+            C_nz += Ap[v + 1] - Ap[v];
+        }
+    }
+
+    cs *C = cs_spalloc(C_n, C_n, C_nz, (Ax != NULL), 0);
+    if (!C)
+    {
+        SuiteSparse_free(label);
+        SuiteSparse_free(scratch);
+        return NULL;
+    }
+
+    Int *Cp    = C->p;
+    Int *Ci    = C->i;
+    WeightType *Cx = C->x;
+    Int nz     = 0;
+    for (Int j = 0; j < n; j++)
+    {
+        if (label[j] != bestRoot)
+            continue;
+        Cp[scratch[j]] = nz;
+        for (Int p = Ap[j]; p < Ap[j + 1]; p++)
+        {
+            Ci[nz] = scratch[Ai[p]];
+            if (Cx)
+                Cx[nz] = Ax[p];
             nz++;
         }
     }
-    B->nz = nz;
-    cs *C = cs_compress(B);
-    cs_spfree(B);
+    Cp[C_n] = nz;
 
+    SuiteSparse_free(label);
+    SuiteSparse_free(scratch);
     return C;
 }
 
@@ -0,0 +1,63 @@
+/* ========================================================================== */
+/* === Source/Mongoose_Simd.cpp ============================================= */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+#include "Mongoose_Simd.hpp"
+
+namespace Mongoose
+{
+
+static SimdIsa detectIsa()
+{
+#if defined(MONGOOSE_FORCE_SIMD_SCALAR)
+    return SimdIsa_Scalar;
+#elif defined(MONGOOSE_FORCE_SIMD_AVX2)
+    return SimdIsa_AVX2;
+#elif MONGOOSE_SIMD_AVX2
+#if defined(__GNUC__) || defined(__clang__)
+    if (__builtin_cpu_supports("avx512f"))
+        return SimdIsa_AVX512;
+    if (__builtin_cpu_supports("avx2"))
+        return SimdIsa_AVX2;
+    return SimdIsa_Scalar;
+#else
+    /* No runtime probe, but the whole build targets AVX2 already. */
+    return SimdIsa_AVX2;
+#endif
+#else
+    return SimdIsa_Scalar;
+#endif
+}
+
+/* Dynamic initialization runs before main, so the kernels never see an
+ * undetected state. */
+static SimdIsa simd_isa_detected = detectIsa();
+static SimdIsa simd_isa_bound    = simd_isa_detected;
+bool simd_avx2_enabled           = (simd_isa_detected >= SimdIsa_AVX2);
+
+SimdIsa simdIsaDetected()
+{
+    return simd_isa_detected;
+}
+
+SimdIsa simdIsa()
+{
+    return simd_isa_bound;
+}
+
+void setSimdIsa(SimdIsa isa)
+{
+    if (isa > simd_isa_detected)
+        isa = simd_isa_detected;
+    simd_isa_bound    = isa;
+    simd_avx2_enabled = (isa >= SimdIsa_AVX2);
+}
+
+} // end namespace Mongoose
@@ -0,0 +1,344 @@
+/* ========================================================================== */
+/* === Source/Mongoose_ThreadPool.cpp ======================================= */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+#include "Mongoose_ThreadPool.hpp"
+
+#if CPP11_OR_LATER
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(MONGOOSE_NUMA) && defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace Mongoose
+{
+
+namespace
+{
+
+/* Set on pool worker threads, so a job that submits a batch of its own
+ * can be detected and run inline instead of deadlocking the pool. */
+#if defined(__GNUC__) || defined(__clang__)
+static __thread bool onPoolWorker = false;
+#else
+static thread_local bool onPoolWorker = false;
+#endif
+
+/* The pool proper. Workers sleep between batches; a batch is published
+ * by bumping the generation counter, and its jobs are claimed with an
+ * atomic cursor so the fastest workers take the most jobs. The process
+ * keeps one pool for its lifetime; the destructor joins the workers at
+ * exit. */
+class Pool
+{
+public:
+    Pool()
+    {
+        job        = NULL;
+        njobs      = 0;
+        cursor     = 0;
+        jobsDone   = 0;
+        generation = 0;
+        shutdown   = false;
+
+        unsigned hw  = std::thread::hardware_concurrency();
+        Int nworkers = (hw > 1) ? (Int)hw - 1 : 0;
+        for (Int t = 0; t < nworkers; t++)
+        {
+            try
+            {
+                workers.emplace_back(&Pool::workerMain, this, t);
+            }
+            catch (...)
+            {
+                break; /* run with the workers we got */
+            }
+        }
+    }
+
+    ~Pool()
+    {
+        {
+            std::lock_guard<std::mutex> hold(lock);
+            shutdown = true;
+        }
+        wake.notify_all();
+        for (size_t t = 0; t < workers.size(); t++)
+        {
+            workers[t].join();
+        }
+
+        /* Run any tasks still queued at shutdown so their side effects
+         * (promises, callbacks) are never abandoned. The workers are gone;
+         * nested batches must run inline. */
+        onPoolWorker = true;
+        while (!tasks.empty())
+        {
+            tasks.front()();
+            tasks.pop_front();
+        }
+        onPoolWorker = false;
+    }
+
+    bool hasWorkers() const
+    {
+        return !workers.empty();
+    }
+
+    void enqueue(const std::function<void()> &task)
+    {
+        {
+            std::lock_guard<std::mutex> hold(lock);
+            tasks.push_back(task);
+        }
+        wake.notify_one();
+    }
+
+    void run(Int batchJobs, const std::function<void(Int)> &batchJob)
+    {
+        /* One batch at a time; concurrent submitters queue up here. */
+        std::lock_guard<std::mutex> batchHold(batchLock);
+
+        unsigned batchGeneration;
+        {
+            std::lock_guard<std::mutex> hold(lock);
+            job             = &batchJob;
+            njobs           = batchJobs;
+            jobsDone        = 0;
+            batchGeneration = ++generation;
+            /* Publishing the generation inside the cursor retires any
+             * worker still holding the previous batch's job pointer; see
+             * claimJobs. */
+            cursor = (unsigned long long)batchGeneration << 32;
+        }
+        wake.notify_all();
+
+        /* The submitting thread works the batch alongside the pool. It is
+         * flagged like a worker while it does, so a job that submits a
+         * nested batch runs it inline rather than re-entering run(). */
+        onPoolWorker = true;
+        claimJobs(&batchJob, batchJobs, batchGeneration);
+        onPoolWorker = false;
+
+        std::unique_lock<std::mutex> hold(lock);
+        while (jobsDone < batchJobs)
+        {
+            batchDone.wait(hold);
+        }
+        job = NULL;
+    }
+
+private:
+    /* Claims and runs jobs until the batch is exhausted. A worker can
+     * reach here holding a stale batch: it copied the job pointer under
+     * the lock, was preempted, and the batch completed and run() returned
+     * (destroying the caller's job) before its first claim. The cursor
+     * therefore carries the batch generation in its upper half and the
+     * next job index in its lower half, and every claim is a CAS that
+     * re-validates the generation: a stale worker's CAS sees the mismatch
+     * and drops out without invoking the dead job, stealing the live
+     * batch's indices, or crediting the live batch's jobsDone. A claim
+     * that does succeed pins the batch -- run() cannot return (and so no
+     * new generation can be published) until the completion is counted. */
+    void claimJobs(const std::function<void(Int)> *myJob, Int myNJobs,
+                   unsigned myGeneration)
+    {
+        Int completed = 0;
+        for (;;)
+        {
+            unsigned long long ticket = cursor.load();
+            if ((unsigned)(ticket >> 32) != myGeneration)
+                break;
+            Int t = (Int)(ticket & 0xffffffffULL);
+            if (t >= myNJobs)
+                break;
+            if (!cursor.compare_exchange_weak(ticket, ticket + 1))
+                continue;
+            (*myJob)(t);
+            completed++;
+        }
+        if (completed > 0)
+        {
+            std::lock_guard<std::mutex> hold(lock);
+            jobsDone += completed;
+            if (jobsDone >= myNJobs)
+            {
+                batchDone.notify_all();
+            }
+        }
+    }
+
+    void workerMain(Int workerIndex)
+    {
+        onPoolWorker = true;
+
+#if defined(MONGOOSE_NUMA) && defined(__linux__)
+        /* Pin worker t to CPU t+1 (the submitting thread typically stays
+         * on CPU 0), so the same worker sees the same node every batch
+         * and the first-touch placement keeps paying off. Best effort:
+         * a failed pin just leaves the worker floating. */
+        unsigned ncpu = std::thread::hardware_concurrency();
+        if (ncpu > 1)
+        {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            CPU_SET((int)(((unsigned)workerIndex + 1) % ncpu), &cpus);
+            pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpus);
+        }
+#else
+        (void)workerIndex;
+#endif
+
+        unsigned seen = 0;
+        for (;;)
+        {
+            const std::function<void(Int)> *myJob;
+            Int myNJobs;
+            std::function<void()> myTask;
+            {
+                std::unique_lock<std::mutex> hold(lock);
+                while (!shutdown && generation == seen && tasks.empty())
+                {
+                    wake.wait(hold);
+                }
+                if (shutdown)
+                    return;
+                if (generation != seen)
+                {
+                    /* Batches first: they are the latency-sensitive inner
+                     * phases of a solve already in flight. */
+                    seen    = generation;
+                    myJob   = job;
+                    myNJobs = njobs;
+                }
+                else
+                {
+                    myJob = NULL;
+                    myNJobs = 0;
+                    myTask = tasks.front();
+                    tasks.pop_front();
+                }
+            }
+            if (myJob)
+            {
+                claimJobs(myJob, myNJobs, seen);
+            }
+            else if (myTask)
+            {
+                myTask();
+            }
+        }
+    }
+
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks; /* pending submit()ed tasks */
+    std::mutex batchLock; /* serializes run() callers          */
+    std::mutex lock;      /* guards the batch state below      */
+    std::condition_variable wake;
+    std::condition_variable batchDone;
+    const std::function<void(Int)> *job;
+    Int njobs;
+    /* Batch generation (upper 32 bits) and next job index (lower 32);
+     * claimed together so stale workers cannot touch a newer batch. */
+    std::atomic<unsigned long long> cursor;
+    Int jobsDone;
+    unsigned generation;
+    bool shutdown;
+};
+
+static Pool *getPool()
+{
+    /* Created lazily on the first parallel batch; joined at exit. */
+    static Pool pool;
+    return &pool;
+}
+
+} // end anonymous namespace
+
+void ThreadPool::run(Int njobs, const std::function<void(Int)> &job)
+{
+    if (njobs <= 0)
+        return;
+
+    /* Inline cases: trivial batches, and batches submitted from inside a
+     * pool job (the pool cannot wait on itself). */
+    if (njobs == 1 || onPoolWorker)
+    {
+        for (Int t = 0; t < njobs; t++)
+        {
+            job(t);
+        }
+        return;
+    }
+
+    getPool()->run(njobs, job);
+}
+
+void ThreadPool::submit(const std::function<void()> &task)
+{
+    Pool *pool = getPool();
+
+    /* No worker will ever pick the task up (single-CPU machine), or the
+     * submitter is a pool worker itself (a queued task could then wait on
+     * a worker that never frees up): complete synchronously. */
+    if (!pool->hasWorkers() || onPoolWorker)
+    {
+        bool wasWorker = onPoolWorker;
+        onPoolWorker   = true;
+        task();
+        onPoolWorker = wasWorker;
+        return;
+    }
+
+    pool->enqueue(task);
+}
+
+Int ThreadPool::maxThreads()
+{
+    unsigned hw = std::thread::hardware_concurrency();
+    return (hw > 1) ? (Int)hw : 1;
+}
+
+void ThreadPool::firstTouch(void *ptr, size_t bytes, Int nparts)
+{
+#ifdef MONGOOSE_NUMA
+    if (!ptr || bytes == 0)
+        return;
+    if (nparts < 1)
+        nparts = 1;
+    size_t chunk = (bytes + (size_t)nparts - 1) / (size_t)nparts;
+    char *base   = (char *)ptr;
+    ThreadPool::run(nparts, [=](Int t) {
+        size_t lo = (size_t)t * chunk;
+        if (lo >= bytes)
+            return;
+        size_t hi = std::min(lo + chunk, bytes);
+        memset(base + lo, 0, hi - lo);
+    });
+#else
+    (void)ptr;
+    (void)bytes;
+    (void)nparts;
+#endif
+}
+
+} // end namespace Mongoose
+
+#endif
@@ -0,0 +1,60 @@
+/* ========================================================================== */
+/* === Source/Mongoose_UnionFind.cpp ======================================== */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+#include "Mongoose_UnionFind.hpp"
+#include "Mongoose_Debug.hpp"
+
+#include <new>
+
+namespace Mongoose
+{
+
+/* Constructor & Destructor */
+UnionFind::UnionFind()
+{
+    n      = 0;
+    parent = NULL;
+}
+
+UnionFind *UnionFind::create(const Int _n)
+{
+    void *memoryLocation = SuiteSparse_malloc(1, sizeof(UnionFind));
+    if (!memoryLocation)
+        return NULL;
+
+    // Placement new
+    UnionFind *uf = new (memoryLocation) UnionFind();
+
+    uf->n = _n;
+    uf->parent
+        = (Int *)SuiteSparse_malloc(static_cast<size_t>(_n), sizeof(Int));
+    if (!uf->parent)
+    {
+        uf->~UnionFind();
+        return NULL;
+    }
+
+    /* Every vertex starts as a singleton aggregate. */
+    for (Int k = 0; k < _n; k++)
+    {
+        uf->parent[k] = -1;
+    }
+
+    return uf;
+}
+
+UnionFind::~UnionFind()
+{
+    parent = (Int *)SuiteSparse_free(parent);
+    SuiteSparse_free(this);
+}
+
+} // end namespace Mongoose
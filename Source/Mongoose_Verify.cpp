@@ -0,0 +1,175 @@
+/* ========================================================================== */
+/* === Source/Mongoose_Verify.cpp =========================================== */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+#include "Mongoose_Verify.hpp"
+#include "Mongoose_Internal.hpp"
+#include "Mongoose_Logger.hpp"
+
+#if CPP11_OR_LATER
+#include "Mongoose_ThreadPool.hpp"
+#include <vector>
+#endif
+
+#include <algorithm>
+#include <cmath>
+
+namespace Mongoose
+{
+
+/* Relative tolerance for the floating-point metrics: the verifier's
+ * summation order differs from the solver's, so exact equality would
+ * reject correct results on large-weight graphs. */
+static const double VERIFY_RELATIVE_TOL = 1e-9;
+
+/* Minimum edges per pool job; below this a chunk costs more to dispatch
+ * than to sweep. */
+static const Int VERIFY_EDGES_PER_JOB = 1 << 16;
+
+/* Partial sums for one vertex range of the edge sweep. Every cut edge is
+ * seen from both endpoints, so cutCost and cutSize come out doubled and
+ * are halved once after the reduction. */
+struct VerifySums
+{
+    double cutCost;
+    Int cutSize;
+    double W[2];
+};
+
+static void sweepRange(const bool *partition, const Graph *graph, Int kBegin,
+                       Int kEnd, VerifySums *sums)
+{
+    const Int *Gp        = graph->p;
+    const Int *Gi        = graph->i;
+    const WeightType *Gx = graph->x;
+    const WeightType *Gw = graph->w;
+
+    double cutCost = 0.0;
+    Int cutSize    = 0;
+    double W[2]    = { 0.0, 0.0 };
+
+    for (Int k = kBegin; k < kEnd; k++)
+    {
+        bool side = partition[k];
+        W[side ? 1 : 0] += (Gw) ? Gw[k] : 1;
+        for (Int p = Gp[k]; p < Gp[k + 1]; p++)
+        {
+            if (partition[Gi[p]] != side)
+            {
+                cutCost += (Gx) ? Gx[p] : 1;
+                cutSize++;
+            }
+        }
+    }
+
+    sums->cutCost = cutCost;
+    sums->cutSize = cutSize;
+    sums->W[0]    = W[0];
+    sums->W[1]    = W[1];
+}
+
+static bool closeEnough(double measured, double stored)
+{
+    return (fabs(measured - stored)
+            <= VERIFY_RELATIVE_TOL * (1 + fabs(stored)));
+}
+
+bool verify(const EdgeCut *result, const Graph *graph)
+{
+    return verify(result, graph, 0.5);
+}
+
+bool verify(const EdgeCut *result, const Graph *graph, double target_split)
+{
+    if (!result || !graph || !result->partition)
+    {
+        LogError("verify: NULL result, graph, or partition\n");
+        return false;
+    }
+    if (result->n != graph->n)
+    {
+        LogError("verify: result has " << result->n << " vertices, graph has "
+                                       << graph->n << "\n");
+        return false;
+    }
+
+    Int n = graph->n;
+    VerifySums total;
+
+#if CPP11_OR_LATER
+    Int njobs = std::min(ThreadPool::maxThreads(),
+                         graph->nz / VERIFY_EDGES_PER_JOB + 1);
+    std::vector<VerifySums> partial(static_cast<size_t>(njobs));
+
+    const bool *partition = result->partition;
+    VerifySums *partials  = partial.data();
+    Int chunk             = (n + njobs - 1) / njobs;
+    ThreadPool::run(njobs, [=](Int t) {
+        Int kBegin = t * chunk;
+        Int kEnd   = std::min(kBegin + chunk, n);
+        sweepRange(partition, graph, std::min(kBegin, n), kEnd,
+                   &partials[t]);
+    });
+
+    total.cutCost = 0.0;
+    total.cutSize = 0;
+    total.W[0]    = 0.0;
+    total.W[1]    = 0.0;
+    for (Int t = 0; t < njobs; t++)
+    {
+        total.cutCost += partial[t].cutCost;
+        total.cutSize += partial[t].cutSize;
+        total.W[0] += partial[t].W[0];
+        total.W[1] += partial[t].W[1];
+    }
+#else
+    sweepRange(result->partition, graph, 0, n, &total);
+#endif
+
+    /* Each cut edge was counted from both endpoints. */
+    total.cutCost /= 2;
+    total.cutSize /= 2;
+
+    double W = total.W[0] + total.W[1];
+    double imbalance
+        = (W > 0) ? fabs(target_split - std::min(total.W[0], total.W[1]) / W)
+                  : 0.0;
+
+    bool ok = true;
+    if (total.cutSize != result->cut_size)
+    {
+        LogError("verify: cut_size is " << total.cutSize << ", result claims "
+                                        << result->cut_size << "\n");
+        ok = false;
+    }
+    if (!closeEnough(total.cutCost, result->cut_cost))
+    {
+        LogError("verify: cut_cost is " << total.cutCost << ", result claims "
+                                        << result->cut_cost << "\n");
+        ok = false;
+    }
+    if (!closeEnough(total.W[0], result->w0)
+        || !closeEnough(total.W[1], result->w1))
+    {
+        LogError("verify: partition weights are "
+                 << total.W[0] << "/" << total.W[1] << ", result claims "
+                 << result->w0 << "/" << result->w1 << "\n");
+        ok = false;
+    }
+    if (!closeEnough(imbalance, result->imbalance))
+    {
+        LogError("verify: imbalance is " << imbalance << ", result claims "
+                                         << result->imbalance << "\n");
+        ok = false;
+    }
+    return ok;
+}
+
+} // end namespace Mongoose
@@ -0,0 +1,319 @@
+/* ========================================================================== */
+/* === Source/Mongoose_VertexSeparator.cpp ================================== */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+#include "Mongoose_VertexSeparator.hpp"
+#include "Mongoose_Debug.hpp"
+#include "Mongoose_Internal.hpp"
+#include "Mongoose_Logger.hpp"
+
+namespace Mongoose
+{
+
+VertexSeparator::~VertexSeparator()
+{
+    SuiteSparse_free(partition);
+    SuiteSparse_free(this);
+}
+
+/* The bipartite cover problem lives on the boundary of the cut: side-0
+ * endpoints of cut edges on the left, side-1 endpoints on the right, one
+ * bipartite edge per cut edge. All scratch is carved from one block since
+ * every array is O(boundary), which is typically far smaller than n. */
+struct CoverProblem
+{
+    Int nLeft, nRight;
+    Int *leftVertex;  /* left local id -> graph vertex     */
+    Int *rightVertex; /* right local id -> graph vertex    */
+    Int *bp;          /* left-indexed CSR of cut edges     */
+    Int *bi;          /* right local ids                   */
+    Int *matchLeft;   /* left -> matched right, -1 if free */
+    Int *matchRight;  /* right -> matched left, -1 if free */
+    Int *visited;     /* right-side DFS stamps             */
+    Int *stack;       /* iterative augmenting-path DFS     */
+    Int *stackEdge;
+};
+
+/* Searches for an augmenting path from one free left vertex, iteratively
+ * (a path can be as long as the matching, so recursion is avoided like in
+ * the hierarchy destructor). Returns true and flips the path if found. */
+static bool augment(CoverProblem *cp, Int start, Int stamp)
+{
+    Int top          = 0;
+    cp->stack[0]     = start;
+    cp->stackEdge[0] = cp->bp[start];
+
+    while (top >= 0)
+    {
+        Int l = cp->stack[top];
+        Int q = cp->stackEdge[top]++;
+
+        if (q >= cp->bp[l + 1])
+        {
+            /* Left vertex exhausted: back up. */
+            top--;
+            continue;
+        }
+
+        Int r = cp->bi[q];
+        if (cp->visited[r] == stamp)
+            continue;
+        cp->visited[r] = stamp;
+
+        Int owner = cp->matchRight[r];
+        if (owner >= 0)
+        {
+            /* Occupied: try to re-match the owner further along. */
+            top++;
+            cp->stack[top]     = owner;
+            cp->stackEdge[top] = cp->bp[owner];
+            continue;
+        }
+
+        /* Free right vertex: flip the alternating path recorded on the
+         * stack. Each stack level's current edge is the one it took. */
+        while (top >= 0)
+        {
+            Int lv = cp->stack[top];
+            Int rv = cp->bi[cp->stackEdge[top] - 1];
+            Int prev           = cp->matchLeft[lv];
+            cp->matchLeft[lv]  = rv;
+            cp->matchRight[rv] = lv;
+            (void)prev;
+            top--;
+        }
+        return true;
+    }
+    return false;
+}
+
+VertexSeparator *vertex_separator(const Graph *graph)
+{
+    // use default options if not present
+    EdgeCut_Options *options = EdgeCut_Options::create();
+
+    if (!options)
+        return NULL;
+
+    VertexSeparator *result = vertex_separator(graph, options);
+
+    options->~EdgeCut_Options();
+
+    return (result);
+}
+
+VertexSeparator *vertex_separator(const Graph *graph,
+                                  const EdgeCut_Options *options)
+{
+    if (!graph)
+        return NULL;
+
+    EdgeCut *cut = edge_cut(graph, options);
+    if (!cut)
+        return NULL;
+
+    Int n                = graph->n;
+    const Int *Gp        = graph->p;
+    const Int *Gi        = graph->i;
+    const WeightType *Gw = graph->w;
+    const bool *side     = cut->partition;
+
+    VertexSeparator *result
+        = (VertexSeparator *)SuiteSparse_malloc(1, sizeof(VertexSeparator));
+    Int *partition = (Int *)SuiteSparse_malloc(static_cast<size_t>(n),
+                                               sizeof(Int));
+    Int *localId = (Int *)SuiteSparse_malloc(static_cast<size_t>(n),
+                                             sizeof(Int));
+    if (!result || !partition || !localId)
+    {
+        SuiteSparse_free(result);
+        SuiteSparse_free(partition);
+        SuiteSparse_free(localId);
+        cut->~EdgeCut();
+        return NULL;
+    }
+
+    /* Find the boundary: endpoints of cut edges, numbered per side. */
+    Int nLeft = 0, nRight = 0, nCut = 0;
+    for (Int v = 0; v < n; v++)
+    {
+        partition[v] = side[v] ? 1 : 0;
+        localId[v]   = -1;
+        for (Int q = Gp[v]; q < Gp[v + 1]; q++)
+        {
+            if (side[Gi[q]] != side[v])
+            {
+                localId[v] = side[v] ? nRight++ : nLeft++;
+                break;
+            }
+        }
+    }
+    for (Int v = 0; v < n; v++)
+    {
+        if (side[v])
+            continue;
+        for (Int q = Gp[v]; q < Gp[v + 1]; q++)
+        {
+            if (side[Gi[q]])
+                nCut++;
+        }
+    }
+
+    CoverProblem cp;
+    cp.nLeft  = nLeft;
+    cp.nRight = nRight;
+
+    /* One block for all the O(boundary) scratch. */
+    size_t scratchItems = static_cast<size_t>(
+        nLeft + nRight + (nLeft + 1) + nCut + nLeft + nRight + nRight + nLeft
+        + nLeft);
+    Int *scratch = (Int *)SuiteSparse_malloc(
+        (scratchItems > 0) ? scratchItems : 1, sizeof(Int));
+    if (!scratch)
+    {
+        SuiteSparse_free(result);
+        SuiteSparse_free(partition);
+        SuiteSparse_free(localId);
+        cut->~EdgeCut();
+        return NULL;
+    }
+    Int *cursor    = scratch;
+    cp.leftVertex  = cursor; cursor += nLeft;
+    cp.rightVertex = cursor; cursor += nRight;
+    cp.bp          = cursor; cursor += nLeft + 1;
+    cp.bi          = cursor; cursor += nCut;
+    cp.matchLeft   = cursor; cursor += nLeft;
+    cp.matchRight  = cursor; cursor += nRight;
+    cp.visited     = cursor; cursor += nRight;
+    cp.stack       = cursor; cursor += nLeft;
+    cp.stackEdge   = cursor;
+
+    for (Int v = 0; v < n; v++)
+    {
+        if (localId[v] < 0)
+            continue;
+        if (side[v])
+            cp.rightVertex[localId[v]] = v;
+        else
+            cp.leftVertex[localId[v]] = v;
+    }
+
+    /* CSR of the cut edges, left-indexed. */
+    cp.bp[0] = 0;
+    Int nz   = 0;
+    for (Int l = 0; l < nLeft; l++)
+    {
+        Int v = cp.leftVertex[l];
+        for (Int q = Gp[v]; q < Gp[v + 1]; q++)
+        {
+            Int u = Gi[q];
+            if (side[u])
+                cp.bi[nz++] = localId[u];
+        }
+        cp.bp[l + 1] = nz;
+    }
+
+    /* Maximum matching by augmenting paths (Kuhn). */
+    for (Int l = 0; l < nLeft; l++)
+        cp.matchLeft[l] = -1;
+    for (Int r = 0; r < nRight; r++)
+    {
+        cp.matchRight[r] = -1;
+        cp.visited[r]    = -1;
+    }
+    Int matched = 0;
+    for (Int l = 0; l < nLeft; l++)
+    {
+        if (augment(&cp, l, l))
+            matched++;
+    }
+
+    /* Konig: mark everything alternating-reachable from the free left
+     * vertices (non-matching edges rightward, matching edges leftward).
+     * The cover is the unreached left side plus the reached right side. */
+    for (Int r = 0; r < nRight; r++)
+        cp.visited[r] = -1;
+    for (Int l = 0; l < nLeft; l++)
+        cp.stackEdge[l] = 0; /* reuse as left-reached flags */
+    Int top = -1;
+    for (Int l = 0; l < nLeft; l++)
+    {
+        if (cp.matchLeft[l] < 0)
+        {
+            cp.stackEdge[l] = 1;
+            cp.stack[++top] = l;
+        }
+    }
+    while (top >= 0)
+    {
+        Int l = cp.stack[top--];
+        for (Int q = cp.bp[l]; q < cp.bp[l + 1]; q++)
+        {
+            Int r = cp.bi[q];
+            if (cp.visited[r] >= 0 || cp.matchLeft[l] == r)
+                continue;
+            cp.visited[r] = 1;
+            Int owner     = cp.matchRight[r];
+            if (owner >= 0 && !cp.stackEdge[owner])
+            {
+                cp.stackEdge[owner] = 1;
+                cp.stack[++top]     = owner;
+            }
+        }
+    }
+
+    Int sepSize       = 0;
+    double sepWeight  = 0.;
+    for (Int l = 0; l < nLeft; l++)
+    {
+        if (!cp.stackEdge[l]) /* unreached left: in the cover */
+        {
+            Int v        = cp.leftVertex[l];
+            partition[v] = 2;
+            sepSize++;
+            sepWeight += (Gw) ? (double)Gw[v] : 1.;
+        }
+    }
+    for (Int r = 0; r < nRight; r++)
+    {
+        if (cp.visited[r] >= 0) /* reached right: in the cover */
+        {
+            Int v        = cp.rightVertex[r];
+            partition[v] = 2;
+            sepSize++;
+            sepWeight += (Gw) ? (double)Gw[v] : 1.;
+        }
+    }
+    ASSERT(sepSize == matched); /* Konig: |min cover| = |max matching| */
+    (void)matched;
+
+    double w0 = 0., w1 = 0.;
+    for (Int v = 0; v < n; v++)
+    {
+        if (partition[v] == 0)
+            w0 += (Gw) ? (double)Gw[v] : 1.;
+        else if (partition[v] == 1)
+            w1 += (Gw) ? (double)Gw[v] : 1.;
+    }
+
+    SuiteSparse_free(scratch);
+    SuiteSparse_free(localId);
+    cut->~EdgeCut();
+
+    result->partition  = partition;
+    result->n          = n;
+    result->sep_size   = sepSize;
+    result->sep_weight = sepWeight;
+    result->w0         = w0;
+    result->w1         = w1;
+    return result;
+}
+
+} // end namespace Mongoose
@@ -13,17 +13,199 @@
 #include "Mongoose_ImproveFM.hpp"
 #include "Mongoose_ImproveQP.hpp"
 #include "Mongoose_Internal.hpp"
+#include "Mongoose_Logger.hpp"
+
+#if CPP11_OR_LATER
+#include <thread>
+#endif
 
 namespace Mongoose
 {
 
+#if CPP11_OR_LATER
+
+//-----------------------------------------------------------------------------
+// Runs the QP improver on the clone; carries back whether QP actually ran.
+//-----------------------------------------------------------------------------
+static void qpRaceWorker(EdgeCutProblem *clone, const EdgeCut_Options *options,
+                         bool *ranQP)
+{
+    *ranQP = improveCutUsingQP(clone, options);
+}
+
+//-----------------------------------------------------------------------------
+// Recomputes imbalance -- and the heuCost derived from it -- exactly from
+// the committed part weights, the way improveCutUsingQP does after its swap
+// loop. FM only tracks imbalance incrementally across a sweep, so its stored
+// value drifts from the exact split; the race must compare candidates on
+// exact costs or it systematically favors the one whose drift understates
+// the balance penalty.
+//-----------------------------------------------------------------------------
+static void recomputeSplitCost(EdgeCutProblem *graph,
+                               const EdgeCut_Options *options)
+{
+    graph->imbalance
+        = options->target_split - std::min(graph->W0, graph->W1) / graph->W;
+    double absImbalance = fabs(graph->imbalance);
+    graph->heuCost      = graph->cutCost
+                     + (absImbalance > options->soft_split_tolerance
+                            ? absImbalance * graph->H
+                            : 0.0);
+}
+
+//-----------------------------------------------------------------------------
+// Racing waterdance: each dance starts FM (in place) and QP (on a clone of
+// the same starting cut) concurrently and keeps whichever improver found
+// the lower heuristic cost. Returns false if the clone could not be
+// allocated, in which case the caller falls back to the alternating dance.
+//-----------------------------------------------------------------------------
+static bool waterdance_racing(EdgeCutProblem *graph,
+                              const EdgeCut_Options *options)
+{
+    EdgeCutProblem *clone = EdgeCutProblem::create(graph->n, graph->nz,
+                                                   graph->p, graph->i,
+                                                   graph->x, graph->w);
+    if (!clone)
+        return false;
+
+    /* Lend the clone the pooled QP workspace: FM never touches it, so the
+     * QP thread has it to itself. The clone never owns the pool, so its
+     * destructor leaves the workspace with the hierarchy. */
+    clone->qpWorkspace = graph->qpWorkspace;
+
+    Int numDances = options->num_dances;
+    bool runQP    = true;
+    for (Int i = 0; i < numDances; i++)
+    {
+        /* Time budget: stop dancing once the solve's deadline passes. */
+        if (graph->deadline > 0 && Logger::wallSeconds() >= graph->deadline)
+        {
+            break;
+        }
+
+        double danceStart = graph->heuCost;
+
+        if (!runQP)
+        {
+            improveCutUsingFM(graph, options);
+            recomputeSplitCost(graph, options);
+            if (options->use_dance_convergence
+                && danceStart - graph->heuCost
+                       <= options->dance_tolerance * danceStart)
+            {
+                break;
+            }
+            continue;
+        }
+
+        copyRefinementState(clone, graph);
+        double before = graph->heuCost;
+
+        bool ranQP = false;
+        std::thread qpThread(qpRaceWorker, clone, options, &ranQP);
+        improveCutUsingFM(graph, options);
+        qpThread.join();
+
+        /* Both candidates carry incrementally tracked imbalance (FM's
+         * directly; QP's through the starting value it inherited when no
+         * swap corrects it). Make both exact before judging the race, so
+         * the winner is committed with a verifiable cost. */
+        recomputeSplitCost(graph, options);
+        recomputeSplitCost(clone, options);
+
+        if (clone->heuCost < graph->heuCost)
+        {
+            copyRefinementState(graph, clone);
+        }
+        else if (ranQP)
+        {
+            /* QP lost the race, but its converged multiplier still warm
+             * starts the napsack next dance. */
+            graph->qpLambda = clone->qpLambda;
+        }
+
+        /* The adaptive gate applies to QP's realized improvement over the
+         * shared starting cut, exactly as in the alternating dance. */
+        if (options->use_QP_adaptive_gate && ranQP)
+        {
+            if (before - clone->heuCost <= options->QP_gate_tolerance * before)
+            {
+                runQP = false;
+            }
+        }
+
+        /* Convergence exit: once a full dance moves heuCost by less than
+         * the relative tolerance, the remaining dances are no-ops. */
+        if (options->use_dance_convergence
+            && danceStart - graph->heuCost
+                   <= options->dance_tolerance * danceStart)
+        {
+            break;
+        }
+    }
+
+    clone->qpWorkspace = NULL; /* borrowed */
+    clone->~EdgeCutProblem();
+    return true;
+}
+
+#endif
+
 void waterdance(EdgeCutProblem *graph, const EdgeCut_Options *options)
 {
+#if CPP11_OR_LATER
+    /* Racing dances: FM and QP explore the same starting cut on separate
+     * threads and the better result wins. Falls through to the alternating
+     * dance if the cut-state clone cannot be allocated. */
+    if (options->use_dance_racing && graph->n > 1)
+    {
+        if (waterdance_racing(graph, options))
+            return;
+    }
+#endif
+
     Int numDances = options->num_dances;
+    bool runQP    = true;
     for (Int i = 0; i < numDances; i++)
     {
+        /* Time budget: stop dancing once the solve's deadline passes. */
+        if (graph->deadline > 0 && Logger::wallSeconds() >= graph->deadline)
+        {
+            break;
+        }
+
+        double danceStart = graph->heuCost;
+
         improveCutUsingFM(graph, options);
-        improveCutUsingQP(graph, options);
+        if (runQP)
+        {
+            double before = graph->heuCost;
+            bool ranQP    = improveCutUsingQP(graph, options);
+
+            /* Adaptive gate: once a QP pass realizes less than the
+             * configured relative improvement, retire QP for the remaining
+             * dances at this level; FM has converged to a cut that QP
+             * cannot better, and each pass still pays the QPLinks setup
+             * plus several full-array sweeps. */
+            if (options->use_QP_adaptive_gate && ranQP)
+            {
+                if (before - graph->heuCost
+                    <= options->QP_gate_tolerance * before)
+                {
+                    runQP = false;
+                }
+            }
+        }
+
+        /* Convergence exit: once a full dance (FM plus QP) moves heuCost
+         * by less than the relative tolerance, the cut has settled and
+         * the remaining dances would re-run both improvers to no effect. */
+        if (options->use_dance_convergence
+            && danceStart - graph->heuCost
+                   <= options->dance_tolerance * danceStart)
+        {
+            break;
+        }
     }
 }
 
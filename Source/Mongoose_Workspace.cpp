@@ -0,0 +1,88 @@
+/* ========================================================================== */
+/* === Source/Mongoose_Workspace.cpp ======================================== */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * Mongoose Graph Partitioning Library  Copyright (C) 2017-2018,
+ * Scott P. Kolodziej, Nuri S. Yeralan, Timothy A. Davis, William W. Hager
+ * Mongoose is licensed under Version 3 of the GNU General Public License.
+ * Mongoose is also available under other licenses; contact authors for details.
+ * -------------------------------------------------------------------------- */
+
+#include "Mongoose_Workspace.hpp"
+
+#include <cstring>
+#include <new>
+
+namespace Mongoose
+{
+
+/* Constructor & Destructor */
+Workspace::Workspace()
+{
+    ints      = NULL;
+    intCount  = 0;
+    flags     = NULL;
+    flagCount = 0;
+    raw       = NULL;
+    rawBytes  = 0;
+}
+
+Workspace *Workspace::create()
+{
+    void *memoryLocation = SuiteSparse_malloc(1, sizeof(Workspace));
+    if (!memoryLocation)
+        return NULL;
+
+    // Placement new
+    Workspace *workspace = new (memoryLocation) Workspace();
+    return workspace;
+}
+
+Workspace::~Workspace()
+{
+    SuiteSparse_free(ints);
+    SuiteSparse_free(flags);
+    SuiteSparse_free(raw);
+    SuiteSparse_free(this);
+}
+
+Int *Workspace::getInts(size_t count)
+{
+    if (count > intCount)
+    {
+        SuiteSparse_free(ints);
+        ints     = (Int *)SuiteSparse_malloc(count, sizeof(Int));
+        intCount = (ints) ? count : 0;
+    }
+    return ints;
+}
+
+bool *Workspace::getFlags(size_t count)
+{
+    if (count > flagCount)
+    {
+        SuiteSparse_free(flags);
+        flags     = (bool *)SuiteSparse_malloc(count, sizeof(bool));
+        flagCount = (flags) ? count : 0;
+    }
+    if (flags)
+    {
+        memset(flags, 0, count * sizeof(bool));
+    }
+    return flags;
+}
+
+void *Workspace::getBytes(size_t bytes)
+{
+    if (bytes > rawBytes)
+    {
+        SuiteSparse_free(raw);
+        /* SuiteSparse_malloc returns 16-byte aligned blocks. */
+        raw      = SuiteSparse_malloc(bytes, 1);
+        rawBytes = (raw) ? bytes : 0;
+    }
+    return raw;
+}
+
+} // end namespace Mongoose
@@ -0,0 +1,297 @@
+//------------------------------------------------------------------------------
+// Per-kernel microbenchmarks for the multilevel pipeline.
+//
+// Runs each hot kernel -- matching_HEM, coarsen, bhLoad (which heapifies
+// the boundary), improveCutUsingFM, improveCutUsingQP (gradient
+// projection), QPNapsack, sanitizeMatrix, and read_graph -- in isolation
+// over a generated grid and any Matrix Market files given on the command
+// line, reporting nanoseconds per edge (per vertex for the napsack,
+// which never touches edges). The harness is self-contained: each
+// measurement clones the problem so kernels always see the state they
+// would see inside edge_cut, takes the minimum over repetitions to
+// shed scheduling noise, and needs no third-party benchmark library.
+//
+// Usage: mongoose_bench [graph.mtx ...]
+//------------------------------------------------------------------------------
+
+#include "Mongoose_BoundaryHeap.hpp"
+#include "Mongoose_Coarsening.hpp"
+#include "Mongoose_EdgeCutProblem.hpp"
+#include "Mongoose_Generator.hpp"
+#include "Mongoose_IO.hpp"
+#include "Mongoose_ImproveFM.hpp"
+#include "Mongoose_ImproveQP.hpp"
+#include "Mongoose_Matching.hpp"
+#include "Mongoose_QPNapsack.hpp"
+#include "Mongoose_Random.hpp"
+#include "Mongoose_Sanitize.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+using namespace Mongoose;
+
+/* Repetitions per kernel; the minimum is reported. */
+static const int BENCH_REPS = 5;
+
+static double benchTimestamp()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
+
+static void report(const char *kernel, const char *input, double seconds,
+                   Int work, const char *unit)
+{
+    printf("%-18s %-24s %10.2f ns/%s\n", kernel, input,
+           1e9 * seconds / (double)work, unit);
+}
+
+/* A fresh shallow clone of the input problem, initialized the way
+ * edge_cut would hand it to the kernels. */
+static EdgeCutProblem *cloneProblem(EdgeCutProblem *prob,
+                                    const EdgeCut_Options *options)
+{
+    EdgeCutProblem *clone = EdgeCutProblem::create(
+        prob->n, prob->nz, prob->p, prob->i, prob->x, prob->w);
+    if (clone)
+    {
+        clone->initialize(options);
+    }
+    return clone;
+}
+
+/* Random balanced-ish partition plus loaded boundary heaps, the state FM
+ * and QP start from. */
+static void loadRandomCut(EdgeCutProblem *clone,
+                          const EdgeCut_Options *options)
+{
+    for (Int k = 0; k < clone->n; k++)
+    {
+        clone->setPartition(k, (Mongoose::random() % 2 == 0));
+    }
+    bhLoad(clone, options);
+}
+
+static void benchGraph(const char *name, Graph *graph,
+                       const EdgeCut_Options *options)
+{
+    Int nz = graph->nz;
+
+    EdgeCutProblem *prob = EdgeCutProblem::create(graph);
+    if (!prob)
+    {
+        printf("%-18s %-24s        out of memory\n", "all", name);
+        return;
+    }
+    prob->initialize(options);
+
+    double tMatch = -1, tCoarsen = -1, tLoad = -1, tFM = -1, tQP = -1;
+    for (int rep = 0; rep < BENCH_REPS; rep++)
+    {
+        setRandomSeed(options->random_seed);
+
+        /* Matching and coarsening want an unmatched level, so each rep
+         * measures on a fresh clone. */
+        EdgeCutProblem *clone = cloneProblem(prob, options);
+        if (!clone)
+            break;
+
+        double t0 = benchTimestamp();
+        matching_HEM(clone, options);
+        double t1 = benchTimestamp();
+        if (tMatch < 0 || t1 - t0 < tMatch)
+            tMatch = t1 - t0;
+
+        matching_Cleanup(clone, options);
+
+        t0                     = benchTimestamp();
+        EdgeCutProblem *coarse = coarsen(clone, options);
+        t1                     = benchTimestamp();
+        if (coarse)
+        {
+            if (tCoarsen < 0 || t1 - t0 < tCoarsen)
+                tCoarsen = t1 - t0;
+            coarse->~EdgeCutProblem();
+            clone->child = NULL;
+        }
+
+        /* Refinement kernels start from a random cut with loaded heaps;
+         * resetCutState between measurements returns the clone there. */
+        for (Int k = 0; k < clone->n; k++)
+        {
+            clone->setPartition(k, (Mongoose::random() % 2 == 0));
+        }
+        t0 = benchTimestamp();
+        bhLoad(clone, options);
+        t1 = benchTimestamp();
+        if (tLoad < 0 || t1 - t0 < tLoad)
+            tLoad = t1 - t0;
+
+        t0 = benchTimestamp();
+        improveCutUsingFM(clone, options);
+        t1 = benchTimestamp();
+        if (tFM < 0 || t1 - t0 < tFM)
+            tFM = t1 - t0;
+
+        clone->resetCutState();
+        loadRandomCut(clone, options);
+        t0 = benchTimestamp();
+        improveCutUsingQP(clone, options);
+        t1 = benchTimestamp();
+        if (tQP < 0 || t1 - t0 < tQP)
+            tQP = t1 - t0;
+
+        clone->~EdgeCutProblem();
+    }
+
+    if (tMatch >= 0)
+        report("matching_HEM", name, tMatch, nz, "edge");
+    if (tCoarsen >= 0)
+        report("coarsen", name, tCoarsen, nz, "edge");
+    if (tLoad >= 0)
+        report("bhLoad", name, tLoad, nz, "edge");
+    if (tFM >= 0)
+        report("fmRefine", name, tFM, nz, "edge");
+    if (tQP >= 0)
+        report("QPGradProj", name, tQP, nz, "edge");
+
+    /* Napsack: a random fractional point projected onto the balance
+     * interval, sized like this graph's finest QP subproblem. */
+    Int n            = prob->n;
+    QPScalar *x      = (QPScalar *)SuiteSparse_malloc(n, sizeof(QPScalar));
+    QPScalar *work   = (QPScalar *)SuiteSparse_malloc(n, sizeof(QPScalar));
+    Int *status      = (Int *)SuiteSparse_malloc(n, sizeof(Int));
+    Int *heap1       = (Int *)SuiteSparse_malloc(n + 1, sizeof(Int));
+    Int *heap2       = (Int *)SuiteSparse_malloc(n + 1, sizeof(Int));
+    QPScalar *xStart = (QPScalar *)SuiteSparse_malloc(n, sizeof(QPScalar));
+    if (x && work && status && heap1 && heap2 && xStart)
+    {
+        setRandomSeed(options->random_seed);
+        for (Int k = 0; k < n; k++)
+        {
+            xStart[k] = (QPScalar)(Mongoose::random() % 1000) / 1000.;
+            status[k] = 0;
+        }
+        double tNapsack = -1;
+        for (int rep = 0; rep < BENCH_REPS; rep++)
+        {
+            memcpy(x, xStart, static_cast<size_t>(n) * sizeof(QPScalar));
+            double t0 = benchTimestamp();
+            QPNapsack(x, n, 0.45 * n, 0.55 * n, prob->w, 0., status, work,
+                      heap1, heap2, 1e-10);
+            double t1 = benchTimestamp();
+            if (tNapsack < 0 || t1 - t0 < tNapsack)
+                tNapsack = t1 - t0;
+        }
+        report("QPNapsack", name, tNapsack, n, "vertex");
+    }
+    SuiteSparse_free(x);
+    SuiteSparse_free(work);
+    SuiteSparse_free(status);
+    SuiteSparse_free(heap1);
+    SuiteSparse_free(heap2);
+    SuiteSparse_free(xStart);
+
+    prob->~EdgeCutProblem();
+}
+
+/* I/O-side kernels only make sense on real files. */
+static void benchFile(const char *path)
+{
+    double tRead = -1, tSanitize = -1;
+    Int nz       = 0;
+    for (int rep = 0; rep < BENCH_REPS; rep++)
+    {
+        double t0    = benchTimestamp();
+        Graph *graph = read_graph(path);
+        double t1    = benchTimestamp();
+        if (!graph)
+        {
+            printf("%-18s %-24s        read failed\n", "read_graph", path);
+            return;
+        }
+        if (tRead < 0 || t1 - t0 < tRead)
+            tRead = t1 - t0;
+        nz = graph->nz;
+
+        /* Sanitize a compressed copy of the graph, the same call
+         * read_graph makes on the raw matrix. */
+        cs A;
+        A.n  = graph->n;
+        A.m  = graph->n;
+        A.p  = graph->p;
+        A.i  = graph->i;
+        A.x  = graph->x;
+        A.nz = -1;
+        A.nzmax = graph->nz;
+
+        t0            = benchTimestamp();
+        cs *sanitized = sanitizeMatrix(&A, false, false);
+        t1            = benchTimestamp();
+        if (sanitized)
+        {
+            if (tSanitize < 0 || t1 - t0 < tSanitize)
+                tSanitize = t1 - t0;
+            cs_spfree(sanitized);
+        }
+
+        graph->~Graph();
+    }
+    if (tRead >= 0 && nz > 0)
+        report("read_graph", path, tRead, nz, "edge");
+    if (tSanitize >= 0 && nz > 0)
+        report("sanitizeMatrix", path, tSanitize, nz, "edge");
+}
+
+int main(int argc, const char **argv)
+{
+    SuiteSparse_start();
+
+    EdgeCut_Options *options = EdgeCut_Options::create();
+    if (!options)
+    {
+        SuiteSparse_finish();
+        return EXIT_FAILURE;
+    }
+
+    /* Generated corpus: one mesh, one power-law, one geometric graph,
+     * so the benchmark covers the main structure families without any
+     * input files. Larger scaling sweeps just change these parameters. */
+    struct
+    {
+        const char *name;
+        Graph *graph;
+    } generated[] = {
+        { "grid-200x200", generate_grid(200) },
+        { "grid3d-32", generate_grid_3d(32) },
+        { "rmat-s16-e8", generate_rmat(16, 8, 0.57, 0.19, 0.19) },
+        { "geometric-50k", generate_geometric(50000, 0.005) },
+    };
+    for (size_t g = 0; g < sizeof(generated) / sizeof(generated[0]); g++)
+    {
+        setRandomSeed(0);
+        if (generated[g].graph)
+        {
+            benchGraph(generated[g].name, generated[g].graph, options);
+            generated[g].graph->~Graph();
+        }
+    }
+
+    for (int a = 1; a < argc; a++)
+    {
+        benchFile(argv[a]);
+        Graph *graph = read_graph(argv[a]);
+        if (graph)
+        {
+            benchGraph(argv[a], graph, options);
+            graph->~Graph();
+        }
+    }
+
+    options->~EdgeCut_Options();
+    SuiteSparse_finish();
+    return EXIT_SUCCESS;
+}
@@ -49,6 +49,23 @@ int runMemoryTest(const std::string &inputFile)
         return EXIT_FAILURE; // Return early if we failed.
     }
 
+    /* Accounted reference solve: reports each phase's allocation count,
+     * bytes, and peak live bytes alongside the timing info, before the
+     * failure-injection shims below take over the allocators. */
+    Logger::startAllocAccounting();
+    Graph *accounted_G = read_graph(inputFile);
+    if (accounted_G)
+    {
+        EdgeCut *accounted_result = edge_cut(accounted_G, options);
+        if (accounted_result)
+        {
+            accounted_result->~EdgeCut();
+        }
+        accounted_G->~Graph();
+    }
+    Logger::stopAllocAccounting();
+    Logger::printTimingInfo();
+
     /* Override SuiteSparse memory management with custom testers. */
     SuiteSparse_config.malloc_func = myMalloc;
     SuiteSparse_config.calloc_func = myCalloc;
@@ -0,0 +1,71 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/CMake/cmake_colors.cmake"
+  "/root/repo/CMakeLists.txt"
+  "/root/repo/Version/Mongoose_Version.hpp.in"
+  "/root/repo/Version/codemeta.json.in"
+  "/root/repo/Version/title-info.tex.in"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/GNUInstallDirs.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "/root/repo/Include/Mongoose_Version.hpp"
+  "/root/repo/Doc/title-info.tex"
+  "/root/repo/codemeta.json"
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "CMakeFiles/mongoose_lib.dir/DependInfo.cmake"
+  "CMakeFiles/mongoose_dylib.dir/DependInfo.cmake"
+  "CMakeFiles/mongoose_lib_int32.dir/DependInfo.cmake"
+  "CMakeFiles/mongoose_lib_dbg.dir/DependInfo.cmake"
+  "CMakeFiles/mongoose_exe.dir/DependInfo.cmake"
+  "CMakeFiles/demo_exe.dir/DependInfo.cmake"
+  "CMakeFiles/mongoose_test_io.dir/DependInfo.cmake"
+  "CMakeFiles/mongoose_test_edgesep.dir/DependInfo.cmake"
+  "CMakeFiles/mongoose_test_memory.dir/DependInfo.cmake"
+  "CMakeFiles/mongoose_test_performance.dir/DependInfo.cmake"
+  "CMakeFiles/mongoose_test_reference.dir/DependInfo.cmake"
+  "CMakeFiles/mongoose_bench.dir/DependInfo.cmake"
+  "CMakeFiles/mongoose_unit_test_io.dir/DependInfo.cmake"
+  "CMakeFiles/mongoose_unit_test_graph.dir/DependInfo.cmake"
+  "CMakeFiles/mongoose_unit_test_edgesep.dir/DependInfo.cmake"
+  "CMakeFiles/purge.dir/DependInfo.cmake"
+  "CMakeFiles/userguide.dir/DependInfo.cmake"
+  )
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/demo_exe.dir/Demo/demo.o"
+  "CMakeFiles/demo_exe.dir/Demo/demo.o.d"
+  "bin/demo"
+  "bin/demo.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/demo_exe.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
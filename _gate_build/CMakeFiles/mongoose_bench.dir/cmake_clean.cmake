@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mongoose_bench.dir/Tests/Mongoose_Benchmark_exe.o"
+  "CMakeFiles/mongoose_bench.dir/Tests/Mongoose_Benchmark_exe.o.d"
+  "tests/mongoose_bench"
+  "tests/mongoose_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/mongoose_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
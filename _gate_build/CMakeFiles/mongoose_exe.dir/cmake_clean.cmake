@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mongoose_exe.dir/Executable/mongoose.o"
+  "CMakeFiles/mongoose_exe.dir/Executable/mongoose.o.d"
+  "bin/mongoose"
+  "bin/mongoose.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/mongoose_exe.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
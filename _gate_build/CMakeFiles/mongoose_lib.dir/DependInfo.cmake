@@ -0,0 +1,62 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/External/mmio/Source/mmio.c" "CMakeFiles/mongoose_lib.dir/External/mmio/Source/mmio.c.o" "gcc" "CMakeFiles/mongoose_lib.dir/External/mmio/Source/mmio.c.o.d"
+  "/root/repo/SuiteSparse_config/SuiteSparse_config.c" "CMakeFiles/mongoose_lib.dir/SuiteSparse_config/SuiteSparse_config.c.o" "gcc" "CMakeFiles/mongoose_lib.dir/SuiteSparse_config/SuiteSparse_config.c.o.d"
+  "/root/repo/Source/Mongoose_Arena.cpp" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_Arena.o" "gcc" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_Arena.o.d"
+  "/root/repo/Source/Mongoose_Autotune.cpp" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_Autotune.o" "gcc" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_Autotune.o.d"
+  "/root/repo/Source/Mongoose_BoundaryHeap.cpp" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_BoundaryHeap.o" "gcc" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_BoundaryHeap.o.d"
+  "/root/repo/Source/Mongoose_CSparse.cpp" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_CSparse.o" "gcc" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_CSparse.o.d"
+  "/root/repo/Source/Mongoose_Coarsening.cpp" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_Coarsening.o" "gcc" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_Coarsening.o.d"
+  "/root/repo/Source/Mongoose_Debug.cpp" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_Debug.o" "gcc" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_Debug.o.d"
+  "/root/repo/Source/Mongoose_EdgeCut.cpp" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_EdgeCut.o" "gcc" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_EdgeCut.o.d"
+  "/root/repo/Source/Mongoose_EdgeCutOptions.cpp" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_EdgeCutOptions.o" "gcc" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_EdgeCutOptions.o.d"
+  "/root/repo/Source/Mongoose_EdgeCutProblem.cpp" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_EdgeCutProblem.o" "gcc" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_EdgeCutProblem.o.d"
+  "/root/repo/Source/Mongoose_GainBuckets.cpp" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_GainBuckets.o" "gcc" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_GainBuckets.o.d"
+  "/root/repo/Source/Mongoose_Generator.cpp" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_Generator.o" "gcc" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_Generator.o.d"
+  "/root/repo/Source/Mongoose_Graph.cpp" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_Graph.o" "gcc" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_Graph.o.d"
+  "/root/repo/Source/Mongoose_GuessCut.cpp" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_GuessCut.o" "gcc" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_GuessCut.o.d"
+  "/root/repo/Source/Mongoose_IO.cpp" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_IO.o" "gcc" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_IO.o.d"
+  "/root/repo/Source/Mongoose_ImproveFM.cpp" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_ImproveFM.o" "gcc" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_ImproveFM.o.d"
+  "/root/repo/Source/Mongoose_ImproveQP.cpp" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_ImproveQP.o" "gcc" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_ImproveQP.o.d"
+  "/root/repo/Source/Mongoose_KWayCut.cpp" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_KWayCut.o" "gcc" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_KWayCut.o.d"
+  "/root/repo/Source/Mongoose_Logger.cpp" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_Logger.o" "gcc" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_Logger.o.d"
+  "/root/repo/Source/Mongoose_Matching.cpp" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_Matching.o" "gcc" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_Matching.o.d"
+  "/root/repo/Source/Mongoose_NestedDissection.cpp" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_NestedDissection.o" "gcc" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_NestedDissection.o.d"
+  "/root/repo/Source/Mongoose_QPBackend.cpp" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_QPBackend.o" "gcc" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_QPBackend.o.d"
+  "/root/repo/Source/Mongoose_QPBoundary.cpp" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_QPBoundary.o" "gcc" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_QPBoundary.o.d"
+  "/root/repo/Source/Mongoose_QPDelta.cpp" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_QPDelta.o" "gcc" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_QPDelta.o.d"
+  "/root/repo/Source/Mongoose_QPGradProj.cpp" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_QPGradProj.o" "gcc" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_QPGradProj.o.d"
+  "/root/repo/Source/Mongoose_QPLinks.cpp" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_QPLinks.o" "gcc" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_QPLinks.o.d"
+  "/root/repo/Source/Mongoose_QPMaxHeap.cpp" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_QPMaxHeap.o" "gcc" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_QPMaxHeap.o.d"
+  "/root/repo/Source/Mongoose_QPMinHeap.cpp" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_QPMinHeap.o" "gcc" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_QPMinHeap.o.d"
+  "/root/repo/Source/Mongoose_QPNapDown.cpp" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_QPNapDown.o" "gcc" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_QPNapDown.o.d"
+  "/root/repo/Source/Mongoose_QPNapUp.cpp" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_QPNapUp.o" "gcc" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_QPNapUp.o.d"
+  "/root/repo/Source/Mongoose_QPNapsack.cpp" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_QPNapsack.o" "gcc" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_QPNapsack.o.d"
+  "/root/repo/Source/Mongoose_Random.cpp" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_Random.o" "gcc" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_Random.o.d"
+  "/root/repo/Source/Mongoose_Refinement.cpp" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_Refinement.o" "gcc" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_Refinement.o.d"
+  "/root/repo/Source/Mongoose_Reorder.cpp" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_Reorder.o" "gcc" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_Reorder.o.d"
+  "/root/repo/Source/Mongoose_Sanitize.cpp" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_Sanitize.o" "gcc" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_Sanitize.o.d"
+  "/root/repo/Source/Mongoose_Simd.cpp" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_Simd.o" "gcc" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_Simd.o.d"
+  "/root/repo/Source/Mongoose_ThreadPool.cpp" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_ThreadPool.o" "gcc" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_ThreadPool.o.d"
+  "/root/repo/Source/Mongoose_UnionFind.cpp" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_UnionFind.o" "gcc" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_UnionFind.o.d"
+  "/root/repo/Source/Mongoose_Verify.cpp" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_Verify.o" "gcc" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_Verify.o.d"
+  "/root/repo/Source/Mongoose_Version.cpp" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_Version.o" "gcc" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_Version.o.d"
+  "/root/repo/Source/Mongoose_VertexSeparator.cpp" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_VertexSeparator.o" "gcc" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_VertexSeparator.o.d"
+  "/root/repo/Source/Mongoose_Waterdance.cpp" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_Waterdance.o" "gcc" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_Waterdance.o.d"
+  "/root/repo/Source/Mongoose_Workspace.cpp" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_Workspace.o" "gcc" "CMakeFiles/mongoose_lib.dir/Source/Mongoose_Workspace.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
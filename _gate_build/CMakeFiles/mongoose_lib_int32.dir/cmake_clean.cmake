@@ -0,0 +1,97 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mongoose_lib_int32.dir/External/mmio/Source/mmio.c.o"
+  "CMakeFiles/mongoose_lib_int32.dir/External/mmio/Source/mmio.c.o.d"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_Arena.o"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_Arena.o.d"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_Autotune.o"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_Autotune.o.d"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_BoundaryHeap.o"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_BoundaryHeap.o.d"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_CSparse.o"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_CSparse.o.d"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_Coarsening.o"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_Coarsening.o.d"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_Debug.o"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_Debug.o.d"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_EdgeCut.o"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_EdgeCut.o.d"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_EdgeCutOptions.o"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_EdgeCutOptions.o.d"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_EdgeCutProblem.o"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_EdgeCutProblem.o.d"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_GainBuckets.o"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_GainBuckets.o.d"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_Generator.o"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_Generator.o.d"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_Graph.o"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_Graph.o.d"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_GuessCut.o"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_GuessCut.o.d"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_IO.o"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_IO.o.d"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_ImproveFM.o"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_ImproveFM.o.d"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_ImproveQP.o"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_ImproveQP.o.d"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_KWayCut.o"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_KWayCut.o.d"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_Logger.o"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_Logger.o.d"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_Matching.o"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_Matching.o.d"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_NestedDissection.o"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_NestedDissection.o.d"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_QPBackend.o"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_QPBackend.o.d"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_QPBoundary.o"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_QPBoundary.o.d"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_QPDelta.o"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_QPDelta.o.d"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_QPGradProj.o"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_QPGradProj.o.d"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_QPLinks.o"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_QPLinks.o.d"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_QPMaxHeap.o"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_QPMaxHeap.o.d"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_QPMinHeap.o"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_QPMinHeap.o.d"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_QPNapDown.o"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_QPNapDown.o.d"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_QPNapUp.o"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_QPNapUp.o.d"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_QPNapsack.o"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_QPNapsack.o.d"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_Random.o"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_Random.o.d"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_Refinement.o"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_Refinement.o.d"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_Reorder.o"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_Reorder.o.d"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_Sanitize.o"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_Sanitize.o.d"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_Simd.o"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_Simd.o.d"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_ThreadPool.o"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_ThreadPool.o.d"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_UnionFind.o"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_UnionFind.o.d"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_Verify.o"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_Verify.o.d"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_Version.o"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_Version.o.d"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_VertexSeparator.o"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_VertexSeparator.o.d"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_Waterdance.o"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_Waterdance.o.d"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_Workspace.o"
+  "CMakeFiles/mongoose_lib_int32.dir/Source/Mongoose_Workspace.o.d"
+  "CMakeFiles/mongoose_lib_int32.dir/SuiteSparse_config/SuiteSparse_config.c.o"
+  "CMakeFiles/mongoose_lib_int32.dir/SuiteSparse_config/SuiteSparse_config.c.o.d"
+  "lib/libmongoose_int32.a"
+  "lib/libmongoose_int32.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C CXX)
+  include(CMakeFiles/mongoose_lib_int32.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
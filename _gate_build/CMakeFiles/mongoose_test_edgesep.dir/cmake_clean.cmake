@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mongoose_test_edgesep.dir/Tests/Mongoose_Test_EdgeSeparator.o"
+  "CMakeFiles/mongoose_test_edgesep.dir/Tests/Mongoose_Test_EdgeSeparator.o.d"
+  "CMakeFiles/mongoose_test_edgesep.dir/Tests/Mongoose_Test_EdgeSeparator_exe.o"
+  "CMakeFiles/mongoose_test_edgesep.dir/Tests/Mongoose_Test_EdgeSeparator_exe.o.d"
+  "tests/mongoose_test_edgesep"
+  "tests/mongoose_test_edgesep.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/mongoose_test_edgesep.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
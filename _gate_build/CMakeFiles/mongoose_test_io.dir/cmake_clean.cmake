@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mongoose_test_io.dir/Tests/Mongoose_Test_IO.o"
+  "CMakeFiles/mongoose_test_io.dir/Tests/Mongoose_Test_IO.o.d"
+  "CMakeFiles/mongoose_test_io.dir/Tests/Mongoose_Test_IO_exe.o"
+  "CMakeFiles/mongoose_test_io.dir/Tests/Mongoose_Test_IO_exe.o.d"
+  "tests/mongoose_test_io"
+  "tests/mongoose_test_io.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/mongoose_test_io.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
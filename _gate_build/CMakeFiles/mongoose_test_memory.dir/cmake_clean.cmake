@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mongoose_test_memory.dir/Tests/Mongoose_Test_Memory.o"
+  "CMakeFiles/mongoose_test_memory.dir/Tests/Mongoose_Test_Memory.o.d"
+  "CMakeFiles/mongoose_test_memory.dir/Tests/Mongoose_Test_Memory_exe.o"
+  "CMakeFiles/mongoose_test_memory.dir/Tests/Mongoose_Test_Memory_exe.o.d"
+  "tests/mongoose_test_memory"
+  "tests/mongoose_test_memory.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/mongoose_test_memory.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
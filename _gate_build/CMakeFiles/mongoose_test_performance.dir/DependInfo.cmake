@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/Tests/Mongoose_Test_Performance.cpp" "CMakeFiles/mongoose_test_performance.dir/Tests/Mongoose_Test_Performance.o" "gcc" "CMakeFiles/mongoose_test_performance.dir/Tests/Mongoose_Test_Performance.o.d"
+  "/root/repo/Tests/Mongoose_Test_Performance_exe.cpp" "CMakeFiles/mongoose_test_performance.dir/Tests/Mongoose_Test_Performance_exe.o" "gcc" "CMakeFiles/mongoose_test_performance.dir/Tests/Mongoose_Test_Performance_exe.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gate_build/CMakeFiles/mongoose_lib.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mongoose_test_performance.dir/Tests/Mongoose_Test_Performance.o"
+  "CMakeFiles/mongoose_test_performance.dir/Tests/Mongoose_Test_Performance.o.d"
+  "CMakeFiles/mongoose_test_performance.dir/Tests/Mongoose_Test_Performance_exe.o"
+  "CMakeFiles/mongoose_test_performance.dir/Tests/Mongoose_Test_Performance_exe.o.d"
+  "tests/mongoose_test_performance"
+  "tests/mongoose_test_performance.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/mongoose_test_performance.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mongoose_test_reference.dir/Tests/Mongoose_Test_Reference.o"
+  "CMakeFiles/mongoose_test_reference.dir/Tests/Mongoose_Test_Reference.o.d"
+  "CMakeFiles/mongoose_test_reference.dir/Tests/Mongoose_Test_Reference_exe.o"
+  "CMakeFiles/mongoose_test_reference.dir/Tests/Mongoose_Test_Reference_exe.o.d"
+  "tests/mongoose_test_reference"
+  "tests/mongoose_test_reference.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/mongoose_test_reference.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mongoose_unit_test_edgesep.dir/Tests/Mongoose_UnitTest_EdgeSep_exe.o"
+  "CMakeFiles/mongoose_unit_test_edgesep.dir/Tests/Mongoose_UnitTest_EdgeSep_exe.o.d"
+  "tests/mongoose_unit_test_edgesep"
+  "tests/mongoose_unit_test_edgesep.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/mongoose_unit_test_edgesep.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mongoose_unit_test_graph.dir/Tests/Mongoose_UnitTest_Graph_exe.o"
+  "CMakeFiles/mongoose_unit_test_graph.dir/Tests/Mongoose_UnitTest_Graph_exe.o.d"
+  "tests/mongoose_unit_test_graph"
+  "tests/mongoose_unit_test_graph.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/mongoose_unit_test_graph.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mongoose_unit_test_io.dir/Tests/Mongoose_UnitTest_IO_exe.o"
+  "CMakeFiles/mongoose_unit_test_io.dir/Tests/Mongoose_UnitTest_IO_exe.o.d"
+  "tests/mongoose_unit_test_io"
+  "tests/mongoose_unit_test_io.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/mongoose_unit_test_io.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
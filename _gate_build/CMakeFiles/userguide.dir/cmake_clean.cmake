@@ -0,0 +1,8 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/userguide"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/userguide.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,30 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo
+# Build directory: /root/repo/_gate_build
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(IO_Test "./runTests" "-min" "1" "-max" "15" "-t" "io" "-k")
+set_tests_properties(IO_Test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;334;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(Edge_Separator_Test "./runTests" "-min" "1" "-max" "15" "-t" "edgesep")
+set_tests_properties(Edge_Separator_Test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;343;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(Edge_Separator_Test_2 "./runTests" "-t" "edgesep" "-i" "21" "39" "191" "1557" "1562" "353" "2468" "1470" "1380" "505" "182" "201" "2331" "760" "1389" "2401" "2420" "242" "250" "1530" "1533" "360" "1437")
+set_tests_properties(Edge_Separator_Test_2 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;344;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(Weighted_Edge_Separator_Test "./runTests" "-t" "edgesep" "-i" "2624")
+set_tests_properties(Weighted_Edge_Separator_Test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;345;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(Target_Split_Test "./runTests" "-min" "1" "-max" "15" "-t" "edgesep" "-s" "0.3")
+set_tests_properties(Target_Split_Test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;346;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(Memory_Test "./runTests" "-min" "1" "-max" "15" "-t" "memory")
+set_tests_properties(Memory_Test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;355;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(Performance_Test "./runTests" "-min" "1" "-max" "15" "-t" "performance" "-p")
+set_tests_properties(Performance_Test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;363;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(Performance_Test_2 "./runTests" "-t" "performance" "-i" "21" "39" "1557" "1562" "353" "2468" "1470" "1380" "505" "182" "201" "2331" "760" "1389" "2401" "2420" "242" "250" "1530" "1533" "-p")
+set_tests_properties(Performance_Test_2 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;364;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(Performance_Regression "./runPerfRegression" "--exe" "./tests/mongoose_test_performance" "--matrix-dir" "/root/repo/Matrix" "--manifest" "./perf_corpus.txt" "--baseline-dir" "./PerfBaselines")
+set_tests_properties(Performance_Regression PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;369;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(Unit_Test_IO "./tests/mongoose_unit_test_io")
+set_tests_properties(Unit_Test_IO PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;394;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(Unit_Test_Graph "./tests/mongoose_unit_test_graph")
+set_tests_properties(Unit_Test_Graph PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;400;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(Unit_Test_EdgeSep "./tests/mongoose_unit_test_edgesep")
+set_tests_properties(Unit_Test_EdgeSep PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;406;add_test;/root/repo/CMakeLists.txt;0;")